@@ -53,6 +53,46 @@ if (USE_VECTORIZATION)
         message(WARNING "vectorization not yet supported on this compiler")
         message(STATUS "you can enable vectorization support by editing cmake/modules/vectorization.cmake")
     endif ()
+
+    # additional instruction sets for which the VectorizedCellProcessor is compiled. The most capable one, that is
+    # supported by the executing cpu, is selected at startup (override with --vcp-isa).
+    set(VCP_DISPATCH_TARGETS_OPTIONS "AVX;AVX2;AVX512")
+    set(VCP_DISPATCH_TARGETS "" CACHE STRING "Additional instruction sets of the VectorizedCellProcessor, that are\
+ selected at runtime (list of ${VCP_DISPATCH_TARGETS_OPTIONS}).")
+
+    if (VCP_DISPATCH_TARGETS)
+        # all other code is compiled for VECTOR_INSTRUCTIONS, so this has to be an explicit baseline.
+        set(VCP_DISPATCH_BASELINES "NONE;SSE;AVX;AVX2")
+        list(FIND VCP_DISPATCH_BASELINES "${VECTOR_INSTRUCTIONS}" VCP_DISPATCH_BASELINE_RANK)
+        if (VCP_DISPATCH_BASELINE_RANK EQUAL -1)
+            message(FATAL_ERROR "VCP_DISPATCH_TARGETS requires VECTOR_INSTRUCTIONS to be one of ${VCP_DISPATCH_BASELINES}.")
+        endif ()
+
+        # the variants are compiled through target pragmas, which the classic intel compiler does not support.
+        if (NOT (CMAKE_CXX_COMPILER_ID MATCHES "GNU" OR CMAKE_CXX_COMPILER_ID MATCHES "Clang"
+                OR CMAKE_CXX_COMPILER_ID STREQUAL "IntelLLVM"))
+            message(FATAL_ERROR "VCP_DISPATCH_TARGETS is not supported on this compiler.")
+        endif ()
+
+        # keep the targets sorted by capability.
+        set(VCP_DISPATCH_ISAS "")
+        foreach (isa ${VCP_DISPATCH_TARGETS_OPTIONS})
+            list(FIND VCP_DISPATCH_TARGETS ${isa} isa_requested)
+            # targets at or below the baseline are already covered by the baseline itself.
+            list(FIND VCP_DISPATCH_BASELINES ${isa} isa_rank)
+            if (NOT isa_requested EQUAL -1 AND (isa_rank EQUAL -1 OR isa_rank GREATER VCP_DISPATCH_BASELINE_RANK))
+                list(APPEND VCP_DISPATCH_ISAS ${isa})
+            endif ()
+        endforeach ()
+        foreach (isa ${VCP_DISPATCH_TARGETS})
+            list(FIND VCP_DISPATCH_TARGETS_OPTIONS ${isa} isa_known)
+            if (isa_known EQUAL -1)
+                message(SEND_ERROR "\"${isa}\" is an unknown VCP_DISPATCH_TARGETS option.\
+     Available options: ${VCP_DISPATCH_TARGETS_OPTIONS}")
+            endif ()
+        endforeach ()
+        MESSAGE(STATUS "VectorizedCellProcessor runtime dispatch: ${VECTOR_INSTRUCTIONS};${VCP_DISPATCH_ISAS}")
+    endif ()
 elseif ()
     MESSAGE(STATUS "vectorization disabled")
     if (CMAKE_CXX_COMPILER_ID MATCHES "GNU")
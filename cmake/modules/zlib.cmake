@@ -0,0 +1,12 @@
+# zlib for the compressed output of the VTUMoleculeWriter
+option(ENABLE_ZLIB "Enable zlib compression of the VTUMoleculeWriter output" OFF)
+if(ENABLE_ZLIB)
+    find_package(ZLIB REQUIRED)
+    message(STATUS "Using zlib.")
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DENABLE_ZLIB")
+    include_directories(SYSTEM ${ZLIB_INCLUDE_DIRS})
+    set(ZLIB_LIB ${ZLIB_LIBRARIES})
+else()
+    message(STATUS "Not using zlib.")
+    set(ZLIB_LIB "")
+endif()
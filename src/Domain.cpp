@@ -148,11 +148,35 @@ Comp2Param& Domain::getComp2Params(){
 	return _comp2params;
 }
 
+//! appends the kinetic energies and numbers of molecules and rotational DOF of the thermostats to the collective communication
+static void appendThermostatSums(DomainDecompBase* domainDecomp, const std::vector<double>& summv2,
+		const std::vector<double>& sumIw2, const std::vector<unsigned long>& numMolecules,
+		const std::vector<unsigned long>& rotDOF) {
+	for(size_t i = 0; i < summv2.size(); i++) {
+		domainDecomp->collCommAppendDouble(summv2[i]);
+		domainDecomp->collCommAppendDouble(sumIw2[i]);
+		domainDecomp->collCommAppendUnsLong(numMolecules[i]);
+		domainDecomp->collCommAppendUnsLong(rotDOF[i]);
+	}
+}
+
+//! reads the sums appended by appendThermostatSums from the collective communication
+static void getThermostatSums(DomainDecompBase* domainDecomp, std::vector<double>& summv2,
+		std::vector<double>& sumIw2, std::vector<unsigned long>& numMolecules, std::vector<unsigned long>& rotDOF) {
+	for(size_t i = 0; i < summv2.size(); i++) {
+		summv2[i] = domainDecomp->collCommGetDouble();
+		sumIw2[i] = domainDecomp->collCommGetDouble();
+		numMolecules[i] = domainDecomp->collCommGetUnsLong();
+		rotDOF[i] = domainDecomp->collCommGetUnsLong();
+	}
+}
+
 void Domain::calculateGlobalValues(
 		DomainDecompBase* domainDecomp,
 		ParticleContainer* particleContainer,
 		bool collectThermostatVelocities,
-		double Tfactor
+		double Tfactor,
+		bool thermostatNeedsCurrentValues
 		) {
 	double Upot = _localUpot;
 	double Virial = _localVirial;
@@ -166,20 +190,6 @@ void Domain::calculateGlobalValues(
 	// of m_Ukin, m_Upot and Pressure had to be moved from Thermostat / upd_F  
 	// to this point           
 
-	/* FIXME stuff for the ensemble class */
-	domainDecomp->collCommInit(2, 654);
-	domainDecomp->collCommAppendDouble(Upot);
-	domainDecomp->collCommAppendDouble(Virial);
-	domainDecomp->collCommAllreduceSumAllowPrevious();
-	Upot = domainDecomp->collCommGetDouble();
-	Virial = domainDecomp->collCommGetDouble();
-	domainDecomp->collCommFinalize();
-
-	// Process 0 has to add the dipole correction:
-	// m_UpotCorr and m_VirialCorr already contain constant (internal) dipole correction
-	_globalUpot = Upot + _UpotCorr;
-	_globalVirial = Virial + _VirialCorr;
-
 	/*
 	 * thermostat ID 0 represents the entire system
 	 */
@@ -201,27 +211,59 @@ void Domain::calculateGlobalValues(
 			this->_local2KERot[0] += this->_local2KERot[thermit->first];
 		}
 	}
+
+	// number of molecules on the local process. After the reduce operation
+	// num_molecules will contain the global number of molecules
+	const size_t numThermostats = _universalThermostatN.size();
+	std::vector<double> thermostatSummv2(numThermostats), thermostatSumIw2(numThermostats);
+	std::vector<unsigned long> thermostatN(numThermostats), thermostatRotDOF(numThermostats);
 	int thermid = 0;
 	for (thermit = _universalThermostatN.begin(); thermit != _universalThermostatN.end(); thermit++, thermid++)
 	{
-		// number of molecules on the local process. After the reduce operation
-		// num_molecules will contain the global number of molecules
-		unsigned long numMolecules = _localThermostatN[thermit->first];
-		double summv2 = _local2KETrans[thermit->first];
-		unsigned long rotDOF = _localRotationalDOF[thermit->first];
-		double sumIw2 = (rotDOF > 0)? _local2KERot[thermit->first]: 0.0;
-
-		domainDecomp->collCommInit(4, 12+thermid);
-		domainDecomp->collCommAppendDouble(summv2);
-		domainDecomp->collCommAppendDouble(sumIw2);
-		domainDecomp->collCommAppendUnsLong(numMolecules);
-		domainDecomp->collCommAppendUnsLong(rotDOF);
-		domainDecomp->collCommAllreduceSumAllowPrevious();
-		summv2 = domainDecomp->collCommGetDouble();
-		sumIw2 = domainDecomp->collCommGetDouble();
-		numMolecules = domainDecomp->collCommGetUnsLong();
-		rotDOF = domainDecomp->collCommGetUnsLong();
+		thermostatN[thermid] = _localThermostatN[thermit->first];
+		thermostatSummv2[thermid] = _local2KETrans[thermit->first];
+		thermostatRotDOF[thermid] = _localRotationalDOF[thermit->first];
+		thermostatSumIw2[thermid] = (thermostatRotDOF[thermid] > 0)? _local2KERot[thermit->first]: 0.0;
+	}
+
+	/* FIXME stuff for the ensemble class */
+	// Upot and the virial are only reported, so they may lag behind with overlapping collectives.
+	// By default the sums of the thermostats are reduced together with them, exact velocity scaling needs them blocking.
+	const int numThermostatValues = 4 * numThermostats;
+	domainDecomp->collCommInit(thermostatNeedsCurrentValues ? 2 : 2 + numThermostatValues, 654);
+	domainDecomp->collCommAppendDouble(Upot);
+	domainDecomp->collCommAppendDouble(Virial);
+	if(not thermostatNeedsCurrentValues) {
+		appendThermostatSums(domainDecomp, thermostatSummv2, thermostatSumIw2, thermostatN, thermostatRotDOF);
+	}
+	domainDecomp->collCommAllreduceSumAllowPrevious();
+	Upot = domainDecomp->collCommGetDouble();
+	Virial = domainDecomp->collCommGetDouble();
+	if(not thermostatNeedsCurrentValues) {
+		getThermostatSums(domainDecomp, thermostatSummv2, thermostatSumIw2, thermostatN, thermostatRotDOF);
+	}
+	domainDecomp->collCommFinalize();
+
+	if(thermostatNeedsCurrentValues) {
+		domainDecomp->collCommInit(numThermostatValues, 12);
+		appendThermostatSums(domainDecomp, thermostatSummv2, thermostatSumIw2, thermostatN, thermostatRotDOF);
+		domainDecomp->collCommAllreduceSum();
+		getThermostatSums(domainDecomp, thermostatSummv2, thermostatSumIw2, thermostatN, thermostatRotDOF);
 		domainDecomp->collCommFinalize();
+	}
+
+	// Process 0 has to add the dipole correction:
+	// m_UpotCorr and m_VirialCorr already contain constant (internal) dipole correction
+	_globalUpot = Upot + _UpotCorr;
+	_globalVirial = Virial + _VirialCorr;
+
+	thermid = 0;
+	for (thermit = _universalThermostatN.begin(); thermit != _universalThermostatN.end(); thermit++, thermid++)
+	{
+		double summv2 = thermostatSummv2[thermid];
+		double sumIw2 = thermostatSumIw2[thermid];
+		unsigned long numMolecules = thermostatN[thermid];
+		unsigned long rotDOF = thermostatRotDOF[thermid];
 		global_log->debug() << "[ thermostat ID " << thermit->first << "]\tN = " << numMolecules << "\trotDOF = " << rotDOF
 			<< "\tmv2 = " <<  summv2 << "\tIw2 = " << sumIw2 << endl;
 
@@ -257,10 +257,18 @@ public:
 	//! @param particleContainer particle Container
 	//! @param collectThermostatVelocities flag stating whether the directed velocity should be collected for the corresponding thermostats
 	//! @param Tfactor temporary factor applied to the temperature during equilibration
+	//! @param thermostatNeedsCurrentValues flag stating whether the thermostat sums are reduced without lag for exact velocity scaling
 	//!
 	//! Essentially, this method calculates all thermophysical values
 	//! that require communication between the subdomains of the system.
 	//!
+	//! All sums are collected in a single reduction. With overlapping collectives (see DomainDecompMPIBase) it is
+	//! completed only in the next call, so that the global values lag one time step behind. By default, this includes
+	//! the sums of the thermostats, so the velocities are scaled with the factors of the previous time step. Only if
+	//! exact scaling is requested (thermostatNeedsCurrentValues), the sums of the thermostats are reduced separately
+	//! and blocking, so that the velocities are scaled based on the current time step. Then only the potential energy
+	//! and the virial lag behind.
+	//!
 	//! In particular, it determines:
 	//!   - the potential energy and the virial
 	//!   - if (collectThermostatVelocities == true), the directed velocity associated with the appropriately marked thermostats
@@ -281,13 +289,13 @@ public:
 	//! _universalSelectiveThermostatWarning, and _universalSelectiveThermostatError.
 	void calculateGlobalValues(
 			DomainDecompBase* domainDecomp, ParticleContainer* particleContainer,
-			bool collectThermostatVelocities, double Tfactor
+			bool collectThermostatVelocities, double Tfactor, bool thermostatNeedsCurrentValues
 	);
 
 	/* FIXME: alternatively: default values for function parameters */
 	//! @brief calls this->calculateGlobalValues with Tfactor = 1 and without velocity collection
 	void calculateGlobalValues(DomainDecompBase* domainDecomp, ParticleContainer* particleContainer) {
-		this->calculateGlobalValues(domainDecomp, particleContainer, false, 1.0);
+		this->calculateGlobalValues(domainDecomp, particleContainer, false, 1.0, true);
 	}
 
 	//! @brief calculate _localSummv2 and _localSumIw2
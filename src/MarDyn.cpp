@@ -43,6 +43,8 @@ void initOptions(optparse::OptionParser *op) {
 	op->add_option("--print-meminfo").dest("print-meminfo").type("bool").action("store_true").set_default(false).help("Print memory consumtion info (default: %default)");
 	op->add_option("--logfile").dest("logfile").type("string").metavar("PREFIX").set_default("MarDyn").help("enable output to logfile using given prefix for the filename (default: %default)");
 	op->add_option("--legacy-cell-processor").dest("legacy-cell-processor").type("bool").action("store_true").set_default(false).help("use legacyCellProcessor (AoS) (default: %default)");
+	op->add_option("--vcp-isa").dest("vcp-isa").type("string").metavar("ISA").set_default("").help("instruction set of the vectorizedCellProcessor, e.g. AVX2 (default: best one supported by the cpu)");
+	op->add_option("--cell-instrumentation").dest("cell-instrumentation").type("bool").action("store_true").set_default(false).help("record pair counts, hit rates and times per cell in the force calculation, output e.g. via the VTKGridWriter (default: %default)");
 	op->add_option("--final-checkpoint").dest("final-checkpoint").type("int").metavar("(1|0)").set_default(1).help("enable/disable final checkopint (default: %default)");
 	op->add_option("--timed-checkpoint").dest("timed-checkpoint").type("float").metavar("TIME").set_default(-1).help("Execution time of the simulation in seconds after which a checkpoint is forced, disable: -1. (default: %default)");
 #ifdef ENABLE_SIGHANDLER
@@ -205,6 +207,17 @@ int main(int argc, char** argv) {
 		global_log->info() << "--legacy-cell-processor specified, using legacyCellProcessor" << endl;
 	}
 
+	if( options.is_set_by_user("vcp-isa") ) {
+		string vcpInstructionSet(options.get("vcp-isa"));
+		simulation.setVCPInstructionSet(vcpInstructionSet);
+		global_log->info() << "--vcp-isa specified, using " << vcpInstructionSet << " for the vectorizedCellProcessor" << endl;
+	}
+
+	if ( (int) options.get("cell-instrumentation") > 0 ) {
+		simulation.enableCellInstrumentation();
+		global_log->info() << "--cell-instrumentation specified, instrumenting the cell processor" << endl;
+	}
+
 	if ( (int) options.get("final-checkpoint") > 0 ) {
 		simulation.enableFinalCheckpoint();
 		global_log->info() << "Final checkpoint enabled" << endl;
@@ -34,8 +34,9 @@
 
 #include "particleContainer/adapter/ParticlePairs2PotForceAdapter.h"
 #include "particleContainer/adapter/LegacyCellProcessor.h"
-#include "particleContainer/adapter/VectorizedCellProcessor.h"
+#include "particleContainer/adapter/VectorizedCellProcessorDispatch.h"
 #include "particleContainer/adapter/VCP1CLJRMM.h"
+#include "particleContainer/adapter/InstrumentedCellProcessor.h"
 #include "integrators/Integrator.h"
 #include "integrators/Leapfrog.h"
 #include "integrators/LeapfrogRMM.h"
@@ -71,6 +72,7 @@
 #include "longRange/LongRangeCorrection.h"
 #include "longRange/Homogeneous.h"
 #include "longRange/Planar.h"
+#include "longRange/SmoothParticleMeshEwald.h"
 
 #include "bhfmm/FastMultipoleMethod.h"
 #include "bhfmm/cellProcessors/VectorizedLJP2PCellProcessor.h"
@@ -89,6 +91,7 @@ Simulation::Simulation()
 	_collectThermostatDirectedVelocity(100),
 	// ANDERSEN DEPRECATED
 	_thermostatType(VELSCALE_THERMOSTAT),
+	_exactVelocityScaling(false),
 	_numberOfTimesteps(1),
 	_simstep(0),
 	_initSimulation(0),
@@ -109,6 +112,7 @@ Simulation::Simulation()
 	_longRangeCorrection(nullptr),
 	_temperatureControl(nullptr),
 	_FMM(nullptr),
+	_SPME(nullptr),
 	_timerProfiler(),
 #ifdef TASKTIMINGPROFILE
 	_taskTimingProfiler(new TaskTimingProfiler),
@@ -145,6 +149,8 @@ Simulation::~Simulation() {
 	_temperatureControl = nullptr;
 	delete _FMM;
 	_FMM = nullptr;
+	delete _SPME;
+	_SPME = nullptr;
 
 	/* destruct plugins and remove from plugin list */
 	_plugins.remove_if([](PluginBase *pluginPtr) {delete pluginPtr; return true;} );
@@ -293,6 +299,16 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 			xmlconfig.changecurrentnode("..");
 		}
 
+		if (xmlconfig.changecurrentnode("electrostatic[@type='SmoothParticleMeshEwald']")) {
+			if (_FMM != nullptr) {
+				global_log->error() << "SmoothParticleMeshEwald and FastMultipoleMethod cannot be combined." << endl;
+				Simulation::exit(1);
+			}
+			_SPME = new SmoothParticleMeshEwald();
+			_SPME->readXML(xmlconfig);
+			xmlconfig.changecurrentnode("..");
+		}
+
 		/* parallelisation */
 		if(xmlconfig.changecurrentnode("parallelisation")) {
 			string parallelisationtype("DomainDecomposition");
@@ -485,6 +501,8 @@ void Simulation::readXML(XMLfileUnits& xmlconfig) {
 				}
 			}
 			xmlconfig.changecurrentnode(oldpath);
+			xmlconfig.getNodeValue("exactScaling", _exactVelocityScaling);
+			global_log->info() << "Exact velocity scaling: " << (_exactVelocityScaling ? "yes" : "no") << endl;
 			xmlconfig.changecurrentnode("..");
 		}
 		else {
@@ -723,6 +741,14 @@ void Simulation::initConfigXML(const string& inputfilename) {
 }
 
 void Simulation::updateForces() {
+	// Without force exchange and FMM the forces of halo molecules are not needed afterwards. The integrator may
+	// then sum up the forces in the same pass as its own update. Plugins and the ensemble that change the forces or
+	// insert molecules in afterForces() have to run before that update, so they rule it out.
+	if (not _moleculeContainer->requiresForceExchange() and _FMM == nullptr and not forcesRequiredBeforeIntegration()
+			and _integrator->eventSiteForcesCalculated(_moleculeContainer, _domain)) {
+		return;
+	}
+
 	#if defined(_OPENMP)
 	#pragma omp parallel
 	#endif
@@ -734,6 +760,18 @@ void Simulation::updateForces() {
 	} // end pragma omp parallel
 }
 
+bool Simulation::forcesRequiredBeforeIntegration() const {
+	if (_ensemble->requiresForcesBeforeIntegration()) {
+		return true;
+	}
+	for (auto plugin : _plugins) {
+		if (plugin->requiresForcesBeforeIntegration()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 void Simulation::prepare_start() {
 	global_log->info() << "Initializing simulation" << endl;
 
@@ -741,7 +779,7 @@ void Simulation::prepare_start() {
 	if (!_legacyCellProcessor) {
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 		global_log->info() << "Using vectorized cell processor." << endl;
-		_cellProcessor = new VectorizedCellProcessor( *_domain, _cutoffRadius, _LJCutoffRadius);
+		_cellProcessor = vcp::createVectorizedCellProcessor( *_domain, _cutoffRadius, _LJCutoffRadius, _vcpInstructionSet);
 #else
 		global_log->info() << "Using reduced memory mode (RMM) cell processor." << endl;
 		_cellProcessor = new VCP1CLJRMM( *_domain, _cutoffRadius, _LJCutoffRadius);
@@ -769,12 +807,44 @@ void Simulation::prepare_start() {
 		_cellProcessor = new bhfmm::VectorizedLJP2PCellProcessor(*_domain, _LJCutoffRadius, _cutoffRadius);
 	}
 
+	if (_SPME != nullptr) {
+		_SPME->init(_domain, _domainDecomposition, _cutoffRadius);
+
+		// the charges are handled by the SPME
+		delete _cellProcessor;
+		_cellProcessor = new bhfmm::VectorizedLJP2PCellProcessor(*_domain, _LJCutoffRadius, _cutoffRadius);
+	}
+
 #ifdef ENABLE_MPI
 	if(auto *kdd = dynamic_cast<KDDecomposition*>(_domainDecomposition); kdd != nullptr){
 		kdd->fillTimeVecs(&_cellProcessor);
 	}
 #endif
 
+	if (_cellInstrumentation) {
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+		if (_FMM == nullptr) {
+			global_log->info() << "Instrumenting the cell processor." << endl;
+			_cellProcessor = new InstrumentedCellProcessor(_cellProcessor);
+		} else {
+			global_log->warning() << "Cell instrumentation is not supported with the FMM, ignoring it." << endl;
+		}
+#else
+		global_log->warning() << "Cell instrumentation is not supported in reduced memory mode, ignoring it." << endl;
+#endif
+	}
+
+#if defined(ENABLE_MPI) && !defined(ENABLE_REDUCED_MEMORY_MODE)
+	// the cell timing load model samples the times of the cell processor
+	if (_FMM == nullptr) {
+		if (auto *kdd = dynamic_cast<KDDecomposition*>(_domainDecomposition); kdd != nullptr) {
+			kdd->instrumentCellProcessor(&_cellProcessor);
+		} else if (auto *gdd = dynamic_cast<GeneralDomainDecomposition*>(_domainDecomposition); gdd != nullptr) {
+			gdd->instrumentCellProcessor(&_cellProcessor);
+		}
+	}
+#endif
+
 	global_log->info() << "Clearing halos" << endl;
 	_moleculeContainer->deleteOuterParticles();
 	global_log->info() << "Updating domain decomposition" << endl;
@@ -810,6 +880,12 @@ void Simulation::prepare_start() {
 		global_log->fatal() << "No _longRangeCorrection set!" << endl;
 		Simulation::exit(93742);
 	}
+	// the SPME adds site forces as well
+	if (_SPME != nullptr) {
+		global_log->info() << "Performing initial SPME force calculation" << endl;
+		_SPME->computeElectrostatics(_moleculeContainer);
+	}
+
 	// longRangeCorrection is a site-wise force plugin, so we have to call it before updateForces()
 	_longRangeCorrection->calculateLongRange();
 
@@ -876,7 +952,7 @@ void Simulation::prepare_start() {
 	_domain->calculateVelocitySums(_moleculeContainer);
 
 	_domain->calculateGlobalValues(_domainDecomposition, _moleculeContainer,
-			true, 1.0);
+			true, 1.0, exactVelocityScaling());
 	global_log->debug() << "Calculating global values finished." << endl;
 
 	_ensemble->prepare_start();
@@ -1016,6 +1092,11 @@ void Simulation::simulate() {
 				plugin->siteWiseForces(_moleculeContainer, _domainDecomposition, _simstep);
 			}
 
+			if (_SPME != nullptr) {
+				global_log->debug() << "Performing SPME calculation" << endl;
+				_SPME->computeElectrostatics(_moleculeContainer);
+			}
+
 			// longRangeCorrection is a site-wise force plugin, so we have to call it before updateForces()
 			_longRangeCorrection->calculateLongRange();
 
@@ -1072,7 +1153,7 @@ void Simulation::simulate() {
 		// calculate the global macroscopic values from the local values
 		global_log->debug() << "Calculate macroscopic values" << endl;
 		_domain->calculateGlobalValues(_domainDecomposition, _moleculeContainer,
-				(!(_simstep % _collectThermostatDirectedVelocity)), Tfactor(_simstep));
+				(!(_simstep % _collectThermostatDirectedVelocity)), Tfactor(_simstep), exactVelocityScaling());
 
 		// scale velocity and angular momentum
         // TODO: integrate into Temperature Control
@@ -1217,6 +1298,16 @@ void Simulation::finalize() {
 		temp->printTimers();
 	}
 
+	if (auto * instrumented = dynamic_cast<InstrumentedCellProcessor*>(_cellProcessor);
+			instrumented != nullptr and instrumented->isCountingPairs()) {
+		const InstrumentedCellProcessor::CellCounters total = instrumented->getTotalCounters();
+		global_log->info() << "Cell instrumentation (since last reset, " << instrumented->getNumTraversals()
+				<< " traversals): " << total.pairs << " molecule pairs, hit rate "
+				<< (total.pairs > 0 ? static_cast<double>(total.hits) / total.pairs : 0.) << ", "
+				<< total.time << " s in the cell processor, thread imbalance (max/mean) "
+				<< instrumented->getThreadImbalance() << endl;
+	}
+
 #ifdef TASKTIMINGPROFILE
 	std::string outputFileName = "taskTimings_"
 								 + std::to_string(std::time(nullptr))
@@ -1248,6 +1339,10 @@ void Simulation::updateParticleContainerAndDecomposition(double lastTraversalTim
 	bool forceRebalancing = false;
 	global_simulation->timers()->start("SIMULATION_MPI_OMP_COMMUNICATION");
 	_domainDecomposition->balanceAndExchange(lastTraversalTime, forceRebalancing, _moleculeContainer, _domain);
+	// a new cell size (e.g. from the cellsInCutoff tuning) is applied, when all particles are at their final place.
+	if (_moleculeContainer->adaptCellSize()) {
+		_domainDecomposition->exchangeHaloAfterRebuild(_moleculeContainer, _domain);
+	}
 	global_simulation->timers()->stop("SIMULATION_MPI_OMP_COMMUNICATION");
 
 	// The cache of the molecules must be updated/build after the exchange process,
@@ -1303,6 +1398,10 @@ double Simulation::Tfactor(unsigned long simstep) {
 		return 4 - 10.0 * xi / 3.0;
 }
 
+bool Simulation::exactVelocityScaling() const {
+	return _exactVelocityScaling && !_domain->NVE() && _temperatureControl == nullptr && _thermostatType == VELSCALE_THERMOSTAT;
+}
+
 void Simulation::initialize() {
 	int ownrank = 0;
 #ifdef ENABLE_MPI
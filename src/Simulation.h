@@ -52,6 +52,7 @@ class Homogeneous;
 class Planar;
 class TemperatureControl;
 class MemoryProfiler;
+class SmoothParticleMeshEwald;
 
 // by Stefan Becker
 const int VELSCALE_THERMOSTAT = 1;
@@ -71,6 +72,8 @@ private:
 	Simulation(Simulation &simulation);
 	Simulation& operator=(Simulation &simulation);
 	void updateForces();
+	//! true if a plugin or the ensemble changes forces or molecules in afterForces()
+	bool forcesRequiredBeforeIntegration() const;
 
 public:
 	/** Instantiate simulation object */
@@ -110,6 +113,9 @@ public:
 	         <thermostat type='VelocityScaling' componentId=STRING><!-- componentId can be component id or 'global' -->
 	           <temperature>DOUBLE</temperature>
 	         </thermostat>
+	         <!-- scale with the kinetic energy of the current step instead of the one of the previous step when the
+	              collectives overlap, at the cost of a blocking reduction every step; default false -->
+	         <exactScaling>BOOL</exactScaling>
 	       </thermostats>
 	     </algorithm>
 	     <output>
@@ -272,6 +278,9 @@ public:
 	 */
 	double Tfactor(unsigned long simstep);
 
+	//! @brief whether the velocity scaling thermostat is active and has to scale with the sums of the current step
+	bool exactVelocityScaling() const;
+
 	void initCanonical(unsigned long t) { this->_initCanonical = t; }
 	void initGrandCanonical(unsigned long t) { this->_initGrandCanonical = t; }
 	void initStatistics(unsigned long t) { this->_initStatistics = t; }
@@ -332,6 +341,9 @@ private:
 	//! appropriate tokens stored as constants at the top of this file
 	int _thermostatType;
 
+	//! reduce the sums of the velocity scaling thermostat blocking, see exactVelocityScaling()
+	bool _exactVelocityScaling;
+
 	unsigned long _numberOfTimesteps;
 public:
     unsigned long getNumberOfTimesteps() const;
@@ -391,6 +403,9 @@ private:
 	/** The Fast Multipole Method object */
 	bhfmm::FastMultipoleMethod* _FMM;
 
+	/** The smooth particle mesh Ewald object */
+	SmoothParticleMeshEwald* _SPME;
+
 	/** manager for all timers in the project except the MarDyn main timer */
 	TimerProfiler _timerProfiler;
 
@@ -426,6 +441,12 @@ public:
 
 	void useLegacyCellProcessor() { _legacyCellProcessor = true; }
 
+	/** Use the given instruction set for the vectorizedCellProcessor instead of the detected one. */
+	void setVCPInstructionSet(const std::string& instructionSet) { _vcpInstructionSet = instructionSet; }
+
+	/** Record pair counts, hit rates and times per cell in the force calculation (see InstrumentedCellProcessor). */
+	void enableCellInstrumentation() { _cellInstrumentation = true; }
+
 	void enableMemoryProfiler() {
 		_memoryProfiler = std::make_shared<MemoryProfiler>();
 		_memoryProfiler->registerObject(reinterpret_cast<MemoryProfilable**>(&_moleculeContainer));
@@ -473,6 +494,12 @@ private:
 	/** use legacyCellProcessor instead of vectorizedCellProcessor */
 	bool _legacyCellProcessor = false;
 
+	/** instruction set of the vectorizedCellProcessor, empty: detect at startup */
+	std::string _vcpInstructionSet;
+
+	/** wrap the cell processor into an InstrumentedCellProcessor */
+	bool _cellInstrumentation = false;
+
 	/** List of plugins to use */
 	std::list<PluginBase*> _plugins;
 
@@ -5,10 +5,14 @@
  *      Author: tchipev
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include <utils/threeDimensionalMapping.h>
 #include "FastMultipoleMethod.h"
 #include "Simulation.h"
 #include "Domain.h"
+#include "parallel/DomainDecompBase.h"
 #include "utils/Logger.h"
 #include "bhfmm/containers/UniformPseudoParticleContainer.h"
 #include "bhfmm/containers/AdaptivePseudoParticleContainer.h"
@@ -52,6 +56,18 @@ void FastMultipoleMethod::readXML(XMLfileUnits& xmlconfig) {
 	} else {
 		global_log->info() << "FastMultipoleMethod: Periodicity is on." << endl;
 	}
+
+	xmlconfig.getNodeValue("farFieldInterval", _farFieldInterval);
+	if (_farFieldInterval == 0) {
+		global_log->error() << "FastMultipoleMethod: farFieldInterval has to be at least 1" << endl;
+		Simulation::exit(5);
+	}
+	if (_farFieldInterval > 1) {
+		xmlconfig.getNodeValue("farFieldEnergyTolerance", _farFieldEnergyTolerance);
+		global_log->info() << "FastMultipoleMethod: far field is recomputed every " << _farFieldInterval
+				<< " steps, tolerated error of the far-field energy relative to the potential energy: "
+				<< _farFieldEnergyTolerance << endl;
+	}
 }
 
 void FastMultipoleMethod::setParameters(unsigned LJSubdivisionFactor,
@@ -79,6 +95,17 @@ void FastMultipoleMethod::init(double globalDomainLength[3], double bBoxMin[3],
 			<< pow(_LJCellSubdivisionFactor, 3)
 			<< " cells for electrostatic calculations in FMM" << endl;
 
+	if (_farFieldInterval > 1) {
+#ifdef QUICKSCHED
+		global_log->error() << "Fast Multipole Method: farFieldInterval > 1 is not supported with Quicksched" << endl;
+		Simulation::exit(5);
+#endif
+		if (_adaptive) {
+			global_log->error() << "Fast Multipole Method: farFieldInterval > 1 is only supported by the uniform container" << endl;
+			Simulation::exit(5);
+		}
+	}
+
 	_P2PProcessor = new VectorizedChargeP2PCellProcessor(
 			*(global_simulation->getDomain()));
 #ifdef QUICKSCHED
@@ -128,6 +155,20 @@ void FastMultipoleMethod::computeElectrostatics(ParticleContainer* ljContainer)
 	// build
 	_pseudoParticleContainer->build(ljContainer);
 
+	const bool recomputeFarField = _numComputations % _farFieldInterval == 0;
+	const bool monitorFarField = _farFieldInterval > 1 and _numComputations > 0;
+	++_numComputations;
+	if (not recomputeFarField) {
+		// P2P
+		_pseudoParticleContainer->nearFieldPass(_P2PProcessor);
+		// L2P of the local expansions of the last recomputation
+		_pseudoParticleContainer->reusedFarFieldPass(_L2PProcessor);
+		return;
+	}
+
+	// far-field energy of the reused expansions, before they are recomputed
+	const double reusedFarFieldUpot = monitorFarField ? _pseudoParticleContainer->getLocalFarFieldUpot() : 0.0;
+
 	// clear expansions
 	_pseudoParticleContainer->clear();
 
@@ -157,6 +198,30 @@ void FastMultipoleMethod::computeElectrostatics(ParticleContainer* ljContainer)
 	_pseudoParticleContainer->downwardPass(_L2PProcessor);
 #endif
 
+	if (monitorFarField) {
+		monitorFarFieldEnergy(reusedFarFieldUpot, _pseudoParticleContainer->getLocalFarFieldUpot());
+	}
+}
+
+void FastMultipoleMethod::monitorFarFieldEnergy(double localReusedUpot, double localRecomputedUpot) {
+	DomainDecompBase& domainDecomp = global_simulation->domainDecomposition();
+	domainDecomp.collCommInit(3);
+	domainDecomp.collCommAppendDouble(localReusedUpot);
+	domainDecomp.collCommAppendDouble(localRecomputedUpot);
+	domainDecomp.collCommAppendDouble(global_simulation->getDomain()->getLocalUpot());
+	domainDecomp.collCommAllreduceSum();
+	const double reusedUpot = domainDecomp.collCommGetDouble();
+	const double recomputedUpot = domainDecomp.collCommGetDouble();
+	const double upot = domainDecomp.collCommGetDouble();
+	domainDecomp.collCommFinalize();
+
+	// relative to the complete potential energy, as the far field is often only a small part of it
+	const double relativeError = std::abs(reusedUpot - recomputedUpot) / std::max(std::abs(upot), 1e-300);
+	global_log->debug() << "FastMultipoleMethod: relative error of the reused far-field energy: " << relativeError << endl;
+	if (relativeError > _farFieldEnergyTolerance) {
+		global_log->warning() << "FastMultipoleMethod: far-field energy of the reused expansions deviates by "
+				<< relativeError << " (relative to the potential energy) from the recomputed one, consider decreasing farFieldInterval" << endl;
+	}
 }
 
 void FastMultipoleMethod::printTimers() {
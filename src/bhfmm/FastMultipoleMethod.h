@@ -16,6 +16,8 @@
 #include "quicksched.h"
 #endif
 
+class UniformPseudoParticleContainerTest;
+
 namespace bhfmm {
 class FastMultipoleMethod;
 class UniformPseudoParticleContainer;
@@ -43,11 +45,15 @@ struct qsched_payload {
 };
 #endif
 class FastMultipoleMethod {
+	friend class ::UniformPseudoParticleContainerTest;
 public:
 	FastMultipoleMethod() : _order(-1),
                             _LJCellSubdivisionFactor(0),
                             _wellSeparated(0),
-                            _adaptive(false)
+                            _adaptive(false),
+                            _farFieldInterval(1),
+                            _farFieldEnergyTolerance(1e-6),
+                            _numComputations(0)
     {}
 	~FastMultipoleMethod();
 
@@ -58,8 +64,18 @@ public:
 	   <electrostatic type="FastMultipoleMethod">
 		 <orderOfExpansions>UNSIGNED INTEGER</orderOfExpansions>
 		 <LJCellSubdivisionFactor>INTEGER</LJCellSubdivisionFactor>
+		 <!-- multiple time stepping: far field is recomputed every farFieldInterval calls only (default 1) -->
+		 <farFieldInterval>UNSIGNED INTEGER</farFieldInterval>
+		 <farFieldEnergyTolerance>DOUBLE</farFieldEnergyTolerance>
 	   </electrostatic>
 	   \endcode
+	 *
+	 * With a farFieldInterval k > 1, the near field (P2P) is computed in every call, while the multipole and local
+	 * expansions are recomputed in every k-th call only. In between, the far field is evaluated (L2P) from the local
+	 * expansions of the last recomputation at the current positions. At every recomputation, the global far-field
+	 * energy of the reused expansions is compared with the one of the recomputed expansions and a warning is issued,
+	 * if their deviation relative to the potential energy exceeds farFieldEnergyTolerance (default 1e-6), as k is
+	 * then too large for the energy to be conserved.
 	 */
 	void readXML(XMLfileUnits& xmlconfig);
 
@@ -90,12 +106,19 @@ public:
 	};
 
 private:
+	//! compares the global far-field energies of the reused and the recomputed local expansions
+	void monitorFarFieldEnergy(double localReusedUpot, double localRecomputedUpot);
+
 	int _order;
 	unsigned _LJCellSubdivisionFactor;
 	int _wellSeparated;
 	int _adaptive;
 	int _periodic;
 
+	unsigned _farFieldInterval;
+	double _farFieldEnergyTolerance;
+	unsigned long _numComputations;
+
 	PseudoParticleContainer * _pseudoParticleContainer;
 
 	VectorizedChargeP2PCellProcessor *_P2PProcessor;
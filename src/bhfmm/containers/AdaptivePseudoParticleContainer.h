@@ -48,6 +48,14 @@ public:
 	void upwardPass(P2MCellProcessor * cp);
 	void horizontalPass(VectorizedChargeP2PCellProcessor * cp);
 	void downwardPass(L2PCellProcessor *cp);
+	// not supported, see FastMultipoleMethod::init()
+	void nearFieldPass(VectorizedChargeP2PCellProcessor * /*cp*/) {
+	}
+	void reusedFarFieldPass(L2PCellProcessor * /*cp*/) {
+	}
+	double getLocalFarFieldUpot() {
+		return 0.0;
+	}
 
 	void processMultipole(ParticleCellPointers& /*cell*/) {
 	}
@@ -56,6 +56,12 @@ public:
 	virtual void horizontalPass(VectorizedChargeP2PCellProcessor * cp) = 0;
 	virtual void downwardPass(L2PCellProcessor *cp) = 0;
 
+	// multiple time stepping: P2P only, and L2P of the local expansions of the last downward pass
+	virtual void nearFieldPass(VectorizedChargeP2PCellProcessor * cp) = 0;
+	virtual void reusedFarFieldPass(L2PCellProcessor *cp) = 0;
+	// far-field energy of the local molecules in the current local expansions, no forces are applied
+	virtual double getLocalFarFieldUpot() = 0;
+
 	// P2M
 	virtual void processMultipole(ParticleCellPointers& cell) = 0;
 	// L2P
@@ -317,10 +317,9 @@ UniformPseudoParticleContainer::UniformPseudoParticleContainer(
 	_globalNumCells = pow(_globalNumCellsPerDim, 3);
 #if defined(ENABLE_MPI)
 	_globalLevelNumCells = pow(8,_globalLevel);
-	_occVector = new int[_globalLevelNumCells];
-	std::fill(_occVector, _occVector + _globalLevelNumCells, 0);
 #endif
 	_coeffVectorLength = 0;
+	_coeffVector = nullptr;
 	_expansionSize = 0;
 	for (int j = 0; j <= _maxOrd; j++) {
 		for (int k = 0; k <= j; k++) {
@@ -381,6 +380,46 @@ UniformPseudoParticleContainer::UniformPseudoParticleContainer(
 			Simulation::exit(1);
 		}
 	}
+
+	//order of the global level cells in the allgather: every process owns a rectangular block of cells on the global level
+	{
+		int numProcs;
+		MPI_Comm_size(_comm, &numProcs);
+		int ownPosition[3];
+		Vector3<int> ownCells;
+		for(int d = 0; d < 3; d++){
+			ownPosition[d] = _processorPositionGlobalLevel[d];
+			ownCells[d] = pow(2,_globalLevel) / _numProcessorsPerDim[d];
+		}
+		std::vector<int> positions(3 * numProcs);
+		MPI_Allgather(ownPosition, 3, MPI_INT, positions.data(), 3, MPI_INT, _comm);
+		const int mpCells = pow(2,_globalLevel);
+		for(int rank = 0; rank < numProcs; rank++){
+			for(int z = 0; z < ownCells[2]; z++){
+				for(int y = 0; y < ownCells[1]; y++){
+					for(int x = 0; x < ownCells[0]; x++){
+						const int cellIndex = ((positions[3 * rank + 2] + z) * mpCells + positions[3 * rank + 1] + y) * mpCells + positions[3 * rank] + x;
+						_globalLevelGatherCells.push_back(cellIndex);
+					}
+				}
+			}
+		}
+		//every cell has to be owned by exactly one process, otherwise fall back to the allreduce
+		std::vector<int> sortedCells(_globalLevelGatherCells);
+		std::sort(sortedCells.begin(), sortedCells.end());
+		_gatherGlobalLevel = _globalLevel > 0 and static_cast<int>(sortedCells.size()) == _globalLevelNumCells;
+		for(size_t i = 0; _gatherGlobalLevel and i < sortedCells.size(); i++){
+			_gatherGlobalLevel = sortedCells[i] == static_cast<int>(i);
+		}
+		if(_gatherGlobalLevel){
+			Log::global_log->info() << "UniformPseudoParticleContainer: multipole expansions of the global level are allgathered" << std::endl;
+			_globalLevelSendBuffer.resize(ownCells[0] * ownCells[1] * ownCells[2] * 2 * _expansionSize);
+			_globalLevelRecvBuffer.resize(_globalLevelNumCells * 2 * _expansionSize);
+		}
+		else{
+			_globalLevelGatherCells.clear();
+		}
+	}
 #endif
 
 #if defined(ENABLE_MPI)
@@ -488,6 +527,7 @@ UniformPseudoParticleContainer::UniformPseudoParticleContainer(
 	_coeffVectorLength = _expansionSize*numCells;
 #endif
 
+	delete[] _coeffVector;
 	_coeffVector = new double[_coeffVectorLength * 2];
 	std::fill(_coeffVector, _coeffVector + _coeffVectorLength * 2, 0.0);
 	Log::global_log->info() << "UniformPseudoParticleContainer: coeffVectorLength="
@@ -535,7 +575,6 @@ UniformPseudoParticleContainer::~UniformPseudoParticleContainer() {
 	delete _leafContainer;
 	delete[] _coeffVector;
 #if defined(ENABLE_MPI)
-	delete[] _occVector;
 	if(!_overlapComm){
 		delete _multipoleBuffer;
 		delete _multipoleRecBuffer;
@@ -1151,7 +1190,7 @@ int UniformPseudoParticleContainer::optimizeAllReduce(/*ParticleContainer* ljCon
 				*(global_simulation->getDomain()));
 	double minTime = pow(2,100);
 	int bestStopLevel = 1;
-	std::vector<double> timeArray(_globalLevel);
+	std::vector<double> timeArray(_globalLevel + 2);
 	for(int stopLevel = 1; stopLevel <= _globalLevel + 1; stopLevel++){ //iterate over possible stopping level
 		_stopLevel = stopLevel;
 		if(_globalLevel >= 1 and not(_globalLevel == 1 and _fuseGlobalCommunication)){
@@ -1173,6 +1212,7 @@ int UniformPseudoParticleContainer::optimizeAllReduce(/*ParticleContainer* ljCon
 		}
 		_coeffVectorLength = _expansionSize*numCells;
 
+		delete[] _coeffVector;
 		_coeffVector = new double[_coeffVectorLength * 2];
 
 		_leafContainer->clearParticles();
@@ -1357,6 +1397,9 @@ void UniformPseudoParticleContainer::upwardPass(P2MCellProcessor* cp) {
 			AllReduceMultipoleMomentsLevelToTop(pow(8,_stopLevel - 1), _stopLevel - 1);
 		}
 	}
+	else if(_gatherGlobalLevel){
+		GatherGlobalLevelMultipoleMomentsStart();
+	}
 	else{
 		AllReduceMultipoleMomentsLevelToTop(_globalLevelNumCells,_globalLevel);
 	}
@@ -1459,6 +1502,9 @@ void UniformPseudoParticleContainer::horizontalPass(
 				}
 				communicateHaloGlobalValues(_stopLevel);
 			}
+			else if(_gatherGlobalLevel){
+				GatherGlobalLevelMultipoleMomentsSetValues();
+			}
 			else{
 				AllReduceMultipoleMomentsSetValues(pow(8,_globalLevel), _globalLevel);
 			}
@@ -1711,6 +1757,18 @@ void UniformPseudoParticleContainer::downwardPass(L2PCellProcessor* cp) {
 	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_FMM_COMPLETE");
 }
 
+void UniformPseudoParticleContainer::nearFieldPass(VectorizedChargeP2PCellProcessor* cp) {
+	// P2P
+	_leafContainer->traverseCellPairs(*cp);
+}
+
+void UniformPseudoParticleContainer::reusedFarFieldPass(L2PCellProcessor* cp) {
+	// L2P, the local expansions of the max level are kept until the next clear()
+	_leafContainer->traverseCells(*cp);
+
+	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_FMM_COMPLETE");
+}
+
 void UniformPseudoParticleContainer::CombineMpCell_Global(double */*cellWid*/, int mpCells, int curLevel){
 	int iDir,
 		m1       = 0,
@@ -3244,7 +3302,7 @@ void UniformPseudoParticleContainer::processMultipole(ParticleCellPointers& cell
 	(*mpCellMaxLevel)[maxLevel][cellIndex].occ = Occupied;
 }
 
-void UniformPseudoParticleContainer::processFarField(ParticleCellPointers& cell) {
+MpCell& UniformPseudoParticleContainer::getMaxLevelMpCell(ParticleCellPointers& cell) {
 	int                               cellIndexV[3];
 	std::vector<std::vector<MpCell> > *mpCellMaxLevel;
 
@@ -3285,6 +3343,12 @@ void UniformPseudoParticleContainer::processFarField(ParticleCellPointers& cell)
 	int cellIndex = ((_globalNumCellsPerDim * cellIndexV[2] + cellIndexV[1]) * _globalNumCellsPerDim) + cellIndexV[0];
 #endif
 
+	return (*mpCellMaxLevel)[maxLevel][cellIndex];
+}
+
+void UniformPseudoParticleContainer::processFarField(ParticleCellPointers& cell) {
+	const MpCell& mpCell = getMaxLevelMpCell(cell);
+
 	SolidHarmonicsExpansion leLocal(_maxOrd);
 
 	int             currentParticleCount = cell.getMoleculeCount();
@@ -3311,7 +3375,7 @@ void UniformPseudoParticleContainer::processFarField(ParticleCellPointers& cell)
 				dr[k] = molecule1.r(k) + dii[k];
 			}       // for k closed
 
-			(*mpCellMaxLevel)[maxLevel][cellIndex].local.actOnTarget(dr, chargei.q(), u, f_vec3);
+			mpCell.local.actOnTarget(dr, chargei.q(), u, f_vec3);
 			f[0] = f_vec3[0];
 			f[1] = f_vec3[1];
 			f[2] = f_vec3[2];
@@ -3329,13 +3393,50 @@ void UniformPseudoParticleContainer::processFarField(ParticleCellPointers& cell)
 		}// for j closed
 	} // current particle closed
 
+#if defined(_OPENMP)
+	#pragma omp critical (UniformPseudoParticleContainer_processFarField)
+#endif
+	{
 		_domain->setLocalUpot(uSum + _domain->getLocalUpot());
 		_domain->setLocalVirial(virialSum + _domain->getLocalVirial());
+	}
 	//	_domain->addLocalP_xx(P_xxSum);
 	//	_domain->addLocalP_yy(P_yySum);
 	//	_domain->addLocalP_zz(P_zzSum);
 }
 
+double UniformPseudoParticleContainer::getLocalFarFieldUpot() {
+	std::vector<ParticleCellPointers>& cells = _leafContainer->getCells();
+	double uSum = 0.0;
+
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static) reduction(+:uSum)
+	#endif
+	for (size_t cellIndex = 0; cellIndex < cells.size(); cellIndex++) {
+		ParticleCellPointers& cell = cells[cellIndex];
+		if (cell.isHaloCell()) {
+			continue;
+		}
+		const MpCell& mpCell = getMaxLevelMpCell(cell);
+		for (int i = 0; i < cell.getMoleculeCount(); i++) {
+			Molecule& molecule = cell.moleculesAt(i);
+			for (unsigned j = 0; j < molecule.numCharges(); j++) {
+				const std::array<double, 3> dii = molecule.charge_d(j);
+				const Charge& charge = static_cast<const Charge&>(molecule.component()->charge(j));
+				Vector3<double> dr;
+				for (int k = 0; k < 3; k++) {
+					dr[k] = molecule.r(k) + dii[k];
+				}
+				double u = 0.0;
+				Vector3<double> f;
+				mpCell.local.actOnTarget(dr, charge.q(), u, f);
+				uSum += 0.5 * u;
+			}
+		}
+	}
+	return uSum;
+}
+
 void UniformPseudoParticleContainer::clear() {
 	for (int n = 0; n < _maxLevel-_globalLevel; n++) {
 		Vector3<int> localMpCells = _numCellsOnGlobalLevel * pow(2, n + 1) + Vector3<int>(4);
@@ -3373,43 +3474,9 @@ void UniformPseudoParticleContainer::clear() {
 	// clear the MPI buffers
 #ifdef ENABLE_MPI
 	std::fill(_coeffVector, _coeffVector + _coeffVectorLength*2, 0.0);
-	std::fill(_occVector, _occVector + _globalLevelNumCells, 0);
 #endif
 }
 
-void UniformPseudoParticleContainer::AllReduceMultipoleMoments() {
-	global_simulation->timers()->start("UNIFORM_PSEUDO_PARTICLE_CONTAINER_ALL_REDUCE");
-#ifdef ENABLE_MPI
-	int coeffIndex = 0;
-	for (int cellIndex = 0; cellIndex < _globalNumCells; cellIndex++) {
-		const MpCell & currentCell = _mpCellGlobalTop[_maxLevel][cellIndex];
-
-		// NOTE: coeffIndex modified in following call:
-		currentCell.multipole.writeValuesToMPIBuffer(_coeffVector, coeffIndex);
-
-		mardyn_assert(cellIndex < _globalNumCells);
-		_occVector[cellIndex] = currentCell.occ;
-	}
-
-	MPI_Allreduce(MPI_IN_PLACE, _coeffVector, _coeffVectorLength*2, MPI_DOUBLE, MPI_SUM, _comm);
-	MPI_Allreduce(MPI_IN_PLACE, _occVector, _globalLevelNumCells, MPI_INT, MPI_SUM, _comm);
-
-
-	coeffIndex = 0;
-	for (int cellIndex = 0; cellIndex < _globalLevelNumCells; cellIndex++) {
-		MpCell & currentCell = _mpCellGlobalTop[_maxLevel][cellIndex];
-
-		currentCell.occ = _occVector[cellIndex];
-		currentCell.multipole.readValuesFromMPIBuffer(_coeffVector, coeffIndex);
-
-	}
-
-	std::fill(_coeffVector, _coeffVector + _coeffVectorLength * 2, 0.0);
-
-#endif
-	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_ALL_REDUCE");
-}
-
 void UniformPseudoParticleContainer::AllReduceMultipoleMomentsLevelToTop(int numCellsLevel,int startingLevel) {
 	global_simulation->timers()->start("UNIFORM_PSEUDO_PARTICLE_CONTAINER_ALL_REDUCE");
 #ifdef ENABLE_MPI
@@ -3453,6 +3520,57 @@ void UniformPseudoParticleContainer::AllReduceMultipoleMomentsSetValues(int numC
 	}
 #endif
 }
+void UniformPseudoParticleContainer::GatherGlobalLevelMultipoleMomentsStart() {
+	global_simulation->timers()->start("UNIFORM_PSEUDO_PARTICLE_CONTAINER_ALL_REDUCE");
+#ifdef ENABLE_MPI
+	int myRank;
+	MPI_Comm_rank(_comm, &myRank);
+	const int valuesPerCell = 2 * _expansionSize;
+	const int numOwnCells = _globalLevelSendBuffer.size() / valuesPerCell;
+	int coeffIndex = 0;
+	for (int i = 0; i < numOwnCells; i++) {
+		const MpCell & currentCell = _mpCellGlobalTop[_globalLevel][_globalLevelGatherCells[myRank * numOwnCells + i]];
+
+		// NOTE: coeffIndex modified in following call:
+		currentCell.multipole.writeValuesToMPIBuffer(_globalLevelSendBuffer.data(), coeffIndex);
+	}
+	MPI_Iallgather(_globalLevelSendBuffer.data(), coeffIndex, MPI_DOUBLE, _globalLevelRecvBuffer.data(), coeffIndex,
+			MPI_DOUBLE, _comm, &_allReduceRequest);
+#endif
+	global_simulation->timers()->stop("UNIFORM_PSEUDO_PARTICLE_CONTAINER_ALL_REDUCE");
+}
+
+void UniformPseudoParticleContainer::GatherGlobalLevelMultipoleMomentsSetValues() {
+#ifdef ENABLE_MPI
+	int coeffIndex = 0;
+	for (int cellIndex : _globalLevelGatherCells) {
+		_mpCellGlobalTop[_globalLevel][cellIndex].multipole.readValuesFromMPIBuffer(_globalLevelRecvBuffer.data(), coeffIndex);
+	}
+
+	//M2M of the levels above on every process; the occupancy is not changed, as it marks the cells of this process
+	int mpCells = pow(2, _globalLevel);
+	for (int curLevel = _globalLevel - 1; curLevel >= 1; curLevel--) {
+		const int mpCellsN = mpCells;
+		mpCells /= 2;
+		for (int m1 = 0; m1 < mpCells * mpCells * mpCells; m1++) {
+			const int m1x = m1 % mpCells;
+			const int m1y = (m1 / mpCells) % mpCells;
+			const int m1z = m1 / (mpCells * mpCells);
+			MpCell & currentCell = _mpCellGlobalTop[curLevel][m1];
+			currentCell.multipole.clear();
+			for (int iDir = 0; iDir < 8; iDir++) { //iterate over 8 children of m1
+				int m2v[3] = {2 * m1x, 2 * m1y, 2 * m1z};
+				if (IsOdd(iDir)) m2v[0]     = m2v[0] + 1;
+				if (IsOdd(iDir / 2)) m2v[1] = m2v[1] + 1;
+				if (IsOdd(iDir / 4)) m2v[2] = m2v[2] + 1;
+				const int m2 = (m2v[2] * mpCellsN + m2v[1]) * mpCellsN + m2v[0];
+				currentCell.multipole.addMultipoleParticle(_mpCellGlobalTop[curLevel + 1][m2].multipole);
+			}
+		}
+	}
+#endif
+}
+
 void UniformPseudoParticleContainer::AllReduceLocalMoments(int mpCells, int _curLevel) {
 	global_simulation->timers()->start("UNIFORM_PSEUDO_PARTICLE_CONTAINER_ALL_REDUCE_ME");
 
@@ -31,9 +31,11 @@
 
 class Domain;
 class DomainDecompBase;
+class UniformPseudoParticleContainerTest;
 
 namespace bhfmm {
 class UniformPseudoParticleContainer: public PseudoParticleContainer {
+	friend class ::UniformPseudoParticleContainerTest;
 public:
 	UniformPseudoParticleContainer(double domainLength[3],
 								   double bBoxMin[3],
@@ -54,6 +56,9 @@ public:
 	void upwardPass(P2MCellProcessor * cp);
 	void horizontalPass(VectorizedChargeP2PCellProcessor * cp);
 	void downwardPass(L2PCellProcessor *cp);
+	void nearFieldPass(VectorizedChargeP2PCellProcessor * cp);
+	void reusedFarFieldPass(L2PCellProcessor *cp);
+	double getLocalFarFieldUpot();
 
 	// P2M
 	void processMultipole(ParticleCellPointers& cell);
@@ -89,6 +94,9 @@ public:
     };
 
 private:
+	//! the cell of the max level, whose local expansion acts on the molecules of the leaf cell
+	MpCell& getMaxLevelMpCell(ParticleCellPointers& cell);
+
 	LeafNodesContainer* _leafContainer;
 	int _wellSep;
 	int _maxLevel;	//number of tree levels
@@ -111,7 +119,6 @@ private:
 	int _globalNumCellsPerDim;
 	Domain* _domain;
 	int _globalNumCells;	//total amount of cells
-	int* _occVector; // array for MPI allgather
 
 	int _coeffVectorLength; //size of MPI buffer for multipole coefficients
 	int _expansionSize; //size of one local or multipole expansion in doubles
@@ -121,6 +128,9 @@ private:
 	HaloBufferNoOverlap<double> * _multipoleRecBuffer, *_multipoleBuffer; //Buffer with use for non-overlapping communication
 	HaloBufferOverlap<double> * _multipoleRecBufferOverlap, * _multipoleBufferOverlap, * _multipoleBufferOverlapGlobal, * _multipoleRecBufferOverlapGlobal; //Buffers for receiving and sending of global and local tree halos
 	MPI_Request _allReduceRequest; //request that is used to check if Iallreduce of global reduce has finished
+	bool _gatherGlobalLevel; //if true, the global level is allgathered instead of an allreduce of all global levels (used without avoidAllReduce)
+	std::vector<int> _globalLevelGatherCells; //indices of the global level cells in the order of the allgather buffer (grouped by rank)
+	std::vector<double> _globalLevelSendBuffer, _globalLevelRecvBuffer; //allgather buffers: multipole values of each cell (the occupancy is not exchanged, it marks the cells of this process)
 #endif
 	bool _periodicBC;
 	bool _avoidAllReduce; //if true then local reduces are performed according to stopping level; if false global allreduce is performed
@@ -173,8 +183,19 @@ private:
 	void PropagateCellLo_Local(double *cellWid, Vector3<int> localMpCells, int curLevel, Vector3<int> offset);
 
 	// for parallelization
-	void AllReduceMultipoleMoments();
 	void AllReduceLocalMoments(int mpCells, int _curLevel);
+	/**
+	 * Allgather of the multipole expansions on the global level is started, every process contributes the cells it
+	 * owns. Replaces the allreduce of all global levels: the communication volume does not contain the levels above
+	 * and no reduction has to be done.
+	 * Asynchronous collective communication
+	 */
+	void GatherGlobalLevelMultipoleMomentsStart();
+	/**
+	 * Allgather of the global level is completed by writing the received values, the levels above are then computed
+	 * locally (M2M) on every process
+	 */
+	void GatherGlobalLevelMultipoleMomentsSetValues();
 	/**
 	 * Allreduce of all Multipole expansions from one level to the top is started
 	 * Asynchronous collective communication
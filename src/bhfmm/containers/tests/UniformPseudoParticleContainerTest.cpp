@@ -0,0 +1,86 @@
+/*
+ * UniformPseudoParticleContainerTest.cpp
+ */
+
+#include "bhfmm/containers/tests/UniformPseudoParticleContainerTest.h"
+#include "bhfmm/FastMultipoleMethod.h"
+#include "bhfmm/containers/UniformPseudoParticleContainer.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+TEST_SUITE_REGISTRATION(UniformPseudoParticleContainerTest);
+#else
+#pragma message "Compilation info: UniformPseudoParticleContainerTest disabled in reduced memory mode"
+#endif
+
+UniformPseudoParticleContainerTest::UniformPseudoParticleContainerTest() {
+}
+
+UniformPseudoParticleContainerTest::~UniformPseudoParticleContainerTest() {
+}
+
+std::vector<std::array<double, 3>> UniformPseudoParticleContainerTest::computeForces(double cutoffRadius,
+		bool gatherGlobalLevel) {
+	double globalDomainLength[3] = {8., 8., 8.};
+	double LJCellLength[3] = {cutoffRadius, cutoffRadius, cutoffRadius};
+	unsigned LJSubdivisionFactor = 1;
+	int orderOfExpansions = 2;
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, "FMMCharge.inp", cutoffRadius);
+	double bBoxMin[3];
+	double bBoxMax[3];
+	for (int d = 0; d < 3; ++d) {
+		bBoxMin[d] = _domainDecomposition->getBoundingBoxMin(d, _domain);
+		bBoxMax[d] = _domainDecomposition->getBoundingBoxMax(d, _domain);
+	}
+
+	bhfmm::FastMultipoleMethod fmm;
+	fmm.setParameters(LJSubdivisionFactor, orderOfExpansions, true, false);
+	fmm.init(globalDomainLength, bBoxMin, bBoxMax, LJCellLength, container);
+#ifdef ENABLE_MPI
+	auto uniform = static_cast<bhfmm::UniformPseudoParticleContainer*>(fmm._pseudoParticleContainer);
+	if (not uniform->_avoidAllReduce) {
+		// with a single process there is no global level to exchange
+		ASSERT_EQUAL(_domainDecomposition->getNumProcs() > 1, uniform->_gatherGlobalLevel);
+	}
+	if (not gatherGlobalLevel) {
+		uniform->_gatherGlobalLevel = false;
+		uniform->_globalLevelGatherCells.clear();
+	}
+#endif
+
+	fmm.computeElectrostatics(container);
+
+	std::vector<std::array<double, 3>> forces;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		m->calcFM();
+		forces.push_back({m->F(0), m->F(1), m->F(2)});
+	}
+	delete container;
+	return forces;
+}
+
+void UniformPseudoParticleContainerTest::testGlobalLevelAllgather() {
+	if (_domainDecomposition->getNumProcs() == 1) {
+		test_log->info() << "UniformPseudoParticleContainerTest::testGlobalLevelAllgather only compares the global "
+				<< "level exchange with more than one process" << std::endl;
+	}
+	const double cutoffRadius = 1.0;
+	const std::vector<std::array<double, 3>> gathered = computeForces(cutoffRadius, true);
+
+	// reset variables, which are not visible here
+	tearDown();
+	setUp();
+
+	const std::vector<std::array<double, 3>> reduced = computeForces(cutoffRadius, false);
+
+	ASSERT_EQUAL(reduced.size(), gathered.size());
+	for (size_t i = 0; i < gathered.size(); ++i) {
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_DOUBLES_EQUAL_MSG("Forces of allgather and allreduce of the global level should be equal",
+					reduced[i][d], gathered[i][d], 1e-10);
+		}
+	}
+}
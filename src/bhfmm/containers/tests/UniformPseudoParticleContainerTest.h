@@ -0,0 +1,39 @@
+/*
+ * UniformPseudoParticleContainerTest.h
+ */
+
+#ifndef SRC_BHFMM_CONTAINERS_TESTS_UNIFORMPSEUDOPARTICLECONTAINERTEST_H_
+#define SRC_BHFMM_CONTAINERS_TESTS_UNIFORMPSEUDOPARTICLECONTAINERTEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+#include <array>
+#include <vector>
+
+class UniformPseudoParticleContainerTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(UniformPseudoParticleContainerTest);
+
+	TEST_METHOD(testGlobalLevelAllgather);
+
+	TEST_SUITE_END();
+
+public:
+	UniformPseudoParticleContainerTest();
+	virtual ~UniformPseudoParticleContainerTest();
+
+	/**
+	 * Compares the forces of the allgather of the global level with the ones of the allreduce of all global levels.
+	 * Only meaningful with more than one process.
+	 */
+	void testGlobalLevelAllgather();
+
+private:
+	/**
+	 * Computes the FMM forces of the molecules in FMMCharge.inp.
+	 * @param gatherGlobalLevel if false, the allreduce of all global levels is used
+	 */
+	std::vector<std::array<double, 3>> computeForces(double cutoffRadius, bool gatherGlobalLevel);
+};
+
+#endif /* SRC_BHFMM_CONTAINERS_TESTS_UNIFORMPSEUDOPARTICLECONTAINERTEST_H_ */
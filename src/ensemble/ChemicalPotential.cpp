@@ -471,11 +471,17 @@ void ChemicalPotential::grandcanonicalStep(
 	bool hasInsertion = true;
 	double ins[3];
 	unsigned nextid = 0;
+	std::vector<Molecule> testMolecules;
+	std::vector<double> energies;
+	// Widom test insertions are never accepted and do not change the container, so they are evaluated in one batch.
+	std::vector<Molecule> widomMolecules;
 	while (hasDeletion || hasInsertion) {
 		if (hasDeletion) {
 			auto m = this->getDeletion(moleculeContainer, minco, maxco);
 			if(m.isValid()) {
-				DeltaUpot = -1.0 * moleculeContainer->getEnergy(&particlePairsHandler, &(*m), *cellProcessor);
+				testMolecules.assign(1, *m);
+				moleculeContainer->getEnergies(&particlePairsHandler, testMolecules, *cellProcessor, energies);
+				DeltaUpot = -1.0 * energies[0];
 
 				accept = this->decideDeletion(DeltaUpot / T);
 #ifndef NDEBUG
@@ -551,11 +557,16 @@ void ChemicalPotential::grandcanonicalStep(
 			 << ins[1] << "/" << ins[2] << ")? " << endl;
 			 */
 #endif
+			if (this->isWidom()) {
+				widomMolecules.push_back(tmp);
+				continue;
+			}
 
 //			unsigned long cellid = moleculeContainer->getCellIndexOfMolecule(m);
 //			moleculeContainer->_cells[cellid].addParticle(m);
-			DeltaUpot = moleculeContainer->getEnergy(&particlePairsHandler, mit,
-					*cellProcessor);
+			testMolecules.assign(1, tmp);
+			moleculeContainer->getEnergies(&particlePairsHandler, testMolecules, *cellProcessor, energies);
+			DeltaUpot = energies[0];
 			domain->submitDU(this->getComponentID(), DeltaUpot, ins);
 			accept = this->decideInsertion(DeltaUpot / T);
 
@@ -589,6 +600,16 @@ void ChemicalPotential::grandcanonicalStep(
 			}
 		}
 	}
+
+	if (not widomMolecules.empty()) {
+		moleculeContainer->getEnergies(&particlePairsHandler, widomMolecules, *cellProcessor, energies);
+		for (size_t i = 0; i < widomMolecules.size(); ++i) {
+			for (int d = 0; d < 3; d++)
+				ins[d] = widomMolecules[i].r(d);
+			domain->submitDU(this->getComponentID(), energies[i], ins);
+			this->decideInsertion(energies[i] / T);
+		}
+	}
 #ifndef NDEBUG
 	for (auto m = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
 		// cout << *m << "\n";
@@ -115,6 +115,9 @@ public:
 				CellProcessor* cellProcessor,
 				unsigned long simstep) {};
 
+	/*! true, if afterForces() inserts or removes molecules, see PluginBase::requiresForcesBeforeIntegration() */
+	virtual bool requiresForcesBeforeIntegration() const { return false; }
+
 	/*! runs before temperature control is applied, but after force calculations */
 	virtual void beforeThermostat(unsigned long simstep, unsigned long initStatistics) {};
 
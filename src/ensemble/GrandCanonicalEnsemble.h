@@ -89,6 +89,9 @@ public:
 					 CellProcessor* cellProcessor,
 					 unsigned long simstep) override;
 
+	/*! inserts and deletes molecules in afterForces() */
+	bool requiresForcesBeforeIntegration() const override { return true; }
+
 	/*! stores a molecule as a sample for a given component */
 	void storeSample(Molecule* m, uint32_t componentid) override;
 
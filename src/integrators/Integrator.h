@@ -65,6 +65,17 @@ public:
 	//! @param domain needed because some macroscopic values (Thermostat) might influence the integrator
 	virtual void eventNewTimestep(ParticleContainer* moleculeContainer, Domain* domain) = 0;
 
+	//! @brief informs the integrator about available site forces, which are not yet summed up per molecule
+	//!
+	//! An integrator may sum up the forces and torques of the molecules (Molecule::calcFM()) in the same pass
+	//! over the molecules as the steps it would otherwise do in eventForcesCalculated(). This saves a full sweep
+	//! through memory per time step. Only the molecules the integrator updates (inner and boundary) are handled,
+	//! so the caller must only use this if the forces of halo molecules are not needed.
+	//! @return true if the forces have been finalised, false if the caller has to do that itself
+	virtual bool eventSiteForcesCalculated(ParticleContainer* /*moleculeContainer*/, Domain* /*domain*/) {
+		return false;
+	}
+
 	//! set the time between two time steps
 	void setTimestepLength(double dt) {
 		_timestepLength = dt;
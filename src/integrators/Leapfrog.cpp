@@ -30,6 +30,12 @@ void Leapfrog::readXML(XMLfileUnits& xmlconfig) {
 	xmlconfig.getNodeValueReduced("timestep", _timestepLength);
 	global_log->info() << "Timestep: " << _timestepLength << endl;
 	mardyn_assert(_timestepLength > 0);
+
+	_fusedForceUpdate = false;
+	xmlconfig.getNodeValue("fusedForceUpdate", _fusedForceUpdate);
+	if (_fusedForceUpdate) {
+		global_log->info() << "Leapfrog: summing up forces in the same pass as the second half step" << endl;
+	}
 }
 
 void Leapfrog::eventForcesCalculated(ParticleContainer* molCont, Domain* domain) {
@@ -38,6 +44,14 @@ void Leapfrog::eventForcesCalculated(ParticleContainer* molCont, Domain* domain)
 	}
 }
 
+bool Leapfrog::eventSiteForcesCalculated(ParticleContainer* molCont, Domain* domain) {
+	if (not _fusedForceUpdate or this->_state != STATE_PRE_FORCE_CALCULATION or domain->severalThermostats()) {
+		return false;
+	}
+	transition2to3(molCont, domain, true);
+	return true;
+}
+
 void Leapfrog::eventNewTimestep(ParticleContainer* molCont, Domain* domain) {
 	if (this->_state == STATE_POST_FORCE_CALCULATION) {
 		transition3to1(molCont, domain);
@@ -63,7 +77,7 @@ void Leapfrog::transition1to2(ParticleContainer* molCont, Domain* /*domain*/) {
 	this->_state = STATE_PRE_FORCE_CALCULATION;
 }
 
-void Leapfrog::transition2to3(ParticleContainer* molCont, Domain* domain) {
+void Leapfrog::transition2to3(ParticleContainer* molCont, Domain* domain, bool calcFM) {
 	if (this->_state != STATE_PRE_FORCE_CALCULATION) {
 		global_log->error() << "Leapfrog::transition2to3(...): Wrong state for state transition" << endl;
 	}
@@ -93,6 +107,9 @@ void Leapfrog::transition2to3(ParticleContainer* molCont, Domain* domain) {
 			map<int, double> sumIw2_l;
 
 			for (auto tM = molCont->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tM.isValid(); ++tM) {
+				if (calcFM) {
+					tM->calcFM();
+				}
 				int cid = tM->componentid();
 				int thermostat = domain->getThermostat(cid);
 				tM->upd_postF(dt_half, summv2_l[thermostat], sumIw2_l[thermostat]);
@@ -122,6 +139,10 @@ void Leapfrog::transition2to3(ParticleContainer* molCont, Domain* domain) {
 			double sumIw2gt_l = 0.0;
 
 			for (auto i = molCont->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); i.isValid(); ++i) {
+				// the molecule is still in cache for the update, if its forces are summed up right here
+				if (calcFM) {
+					i->calcFM();
+				}
 				i->upd_postF(dt_half, summv2gt_l, sumIw2gt_l);
 				mardyn_assert(summv2gt_l >= 0.0);
 				Ngt_l++;
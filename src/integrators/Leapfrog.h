@@ -56,8 +56,13 @@ public:
 	 * \code{.xml}
 	   <integrator type="Leapfrog" >
 	     <timestep>DOUBLE</timestep>
+	     <fusedForceUpdate>BOOL</fusedForceUpdate> <!-- optional, default false -->
 	   </integrator>
 	   \endcode
+	 * With fusedForceUpdate, the molecule forces are summed up together with the second velocity half step and the
+	 * accumulation of the kinetic energy in a single pass over the molecules (see eventSiteForcesCalculated()).
+	 * The fused pass is skipped if a plugin or the ensemble changes the forces (e.g. MaxCheck) or inserts
+	 * molecules (e.g. GrandCanonicalEnsemble) in afterForces(), see PluginBase::requiresForcesBeforeIntegration().
 	 */
 	virtual void readXML(XMLfileUnits& xmlconfig);
 
@@ -73,11 +78,20 @@ public:
 	//! checks whether the current state of the integrator allows that this method is called
 	void eventNewTimestep(ParticleContainer* molCont, Domain* domain);
 
+	//! @brief sums up the forces and performs the steps after the force calculation in one pass, if enabled
+	//!
+	//! Falls back to the separate passes for several thermostats, as their directed velocity is sampled
+	//! between the force calculation and the second half step.
+	bool eventSiteForcesCalculated(ParticleContainer* molCont, Domain* domain);
+
 private:
 
 	//! state in which the integrator is
 	int _state;
 
+	//! sum up the forces in the same pass as the second half step
+	bool _fusedForceUpdate = false;
+
 	//! @brief calculate new positions and the first velocity halfstep
 	//!
 	//! This method also checks whether the state is 1. If so, the calculations are done and
@@ -88,7 +102,8 @@ private:
 	//!
 	//! This method also checks whether the state is 2. If so, the calculations are done and
 	//! the state is set to 3, otherwise, an error is printed
-	void transition2to3(ParticleContainer* molCont, Domain* domain);
+	//! @param calcFM sum up the site forces of each molecule right before its update
+	void transition2to3(ParticleContainer* molCont, Domain* domain, bool calcFM = false);
 	//! @brief checks whether the state is 3. If so, the state is set to 3, otherwise, an error is printed.
 	void transition3to1(ParticleContainer* molCont, Domain* domain);
 
@@ -15,6 +15,7 @@
 #include "ensemble/BoxDomain.h"
 #include "ensemble/EnsembleBase.h"
 #include "Simulation.h"
+#include "io/CompressedCheckpoint.h"
 #include "molecules/Molecule.h"
 
 #ifdef ENABLE_MPI
@@ -125,6 +126,18 @@ BinaryReader::readPhaseSpace(ParticleContainer* particleContainer, Domain* domai
 	Timer inputTimer;
 	inputTimer.start();
 
+	// compressed checkpoints are read by all ranks at once
+	if (CompressedCheckpoint::isCompressed(_phaseSpaceFile)) {
+		unsigned long maxid = CompressedCheckpoint::readMolecules(_phaseSpaceFile, particleContainer, domain, domainDecomp);
+		if(domain->getglobalRho() == 0.) {
+			domain->setglobalRho(domain->getglobalNumMolecules() / domain->getGlobalVolume());
+			global_log->info() << "Calculated Rho_global = " << domain->getglobalRho() << endl;
+		}
+		inputTimer.stop();
+		global_log->info() << "Initial IO took:                 " << inputTimer.get_etime() << " sec" << endl;
+		return maxid;
+	}
+
 #ifdef ENABLE_MPI
 	if (domainDecomp->getRank() == 0) { // Rank 0 only
 #endif
@@ -1,19 +1,55 @@
 #include "io/CheckpointWriter.h"
 
 
+#include <fstream>
 #include <sstream>
 #include <string>
 #include <cstring>
 
 #include "Common.h"
 #include "Domain.h"
+#include "io/CompressedCheckpoint.h"
+#include "molecules/Molecule.h"
 #include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "plugins/compression.h"
 #include "utils/Logger.h"
 
 
 using Log::global_log;
 using namespace std;
 
+namespace {
+
+/**
+ * Writes the molecules of a staging buffer. This runs in a background thread, so it must neither log nor touch
+ * anything but the snapshot.
+ * In binary mode the molecules are written at the given byte offset into the already existing file, in ASCII mode they
+ * are appended to the header.
+ */
+bool writeStagedMolecules(const InMemoryCheckpointing::Snapshot& snapshot, const string& filename, bool binary,
+		streamoff offset) {
+	ofstream checkpointfilestream;
+	if (binary) {
+		checkpointfilestream.open(filename.c_str(), ios::binary | ios::in | ios::out);
+		checkpointfilestream.seekp(offset);
+	} else {
+		checkpointfilestream.open(filename.c_str(), ios::app);
+		checkpointfilestream.precision(20);
+	}
+	for (const Molecule& molecule : snapshot.getMolecules()) {
+		if (binary) {
+			molecule.writeBinary(checkpointfilestream);
+		} else {
+			molecule.write(checkpointfilestream);
+		}
+	}
+	checkpointfilestream.close();
+	return not checkpointfilestream.fail();
+}
+
+} /* anonymous namespace */
+
 void CheckpointWriter::readXML(XMLfileUnits& xmlconfig) {
 	_writeFrequency = 1;
 	xmlconfig.getNodeValue("writefrequency", _writeFrequency);
@@ -37,6 +73,28 @@ void CheckpointWriter::readXML(XMLfileUnits& xmlconfig) {
 		Simulation::exit(-1);
 	}
 
+	_compression = "";
+	xmlconfig.getNodeValue("compression", _compression);
+	if (not _compression.empty()) {
+		if (not _useBinaryFormat) {
+			global_log->error() << "CheckpointWriter: compression requires the binary type." << endl;
+			Simulation::exit(-1);
+		}
+		try {
+			Compression::create(_compression);
+		} catch (const std::invalid_argument& e) {
+			global_log->error() << "CheckpointWriter: " << e.what() << endl;
+			Simulation::exit(-1);
+		}
+		global_log->info() << "Compression: " << _compression << endl;
+	}
+	_chunkSize = 16384;
+	xmlconfig.getNodeValue("chunksize", _chunkSize);
+	if (_chunkSize == 0) {
+		global_log->error() << "CheckpointWriter: chunksize must be a positive nonzero integer." << endl;
+		Simulation::exit(-1);
+	}
+
 	_outputPrefix = "mardyn";
 	xmlconfig.getNodeValue("outputprefix", _outputPrefix);
 	global_log->info() << "Output prefix: " << _outputPrefix << endl;
@@ -54,10 +112,25 @@ void CheckpointWriter::readXML(XMLfileUnits& xmlconfig) {
 		_appendTimestamp = false;
 	}
 	global_log->info() << "Append timestamp: " << _appendTimestamp << endl;
+
+	_asynchronous = false;
+	xmlconfig.getNodeValue("asynchronous", _asynchronous);
+	global_log->info() << "Asynchronous: " << _asynchronous << endl;
+	_nextStagingBuffer = 0;
 }
 
-void CheckpointWriter::init(ParticleContainer * /*particleContainer*/, DomainDecompBase * /*domainDecomp*/,
-                            Domain * /*domain*/) {}
+void CheckpointWriter::init(ParticleContainer * /*particleContainer*/, DomainDecompBase *domainDecomp,
+                            Domain * /*domain*/) {
+	if (_asynchronous and not _useBinaryFormat and domainDecomp->getNumProcs() > 1) {
+		global_log->warning() << "CheckpointWriter: ASCII checkpoints of parallel runs are written synchronously. "
+				"Use the binary type for asynchronous checkpoints." << endl;
+		_asynchronous = false;
+	}
+	if (_asynchronous and not _compression.empty()) {
+		global_log->warning() << "CheckpointWriter: compressed checkpoints are written synchronously." << endl;
+		_asynchronous = false;
+	}
+}
 
 void CheckpointWriter::endStep(ParticleContainer *particleContainer, DomainDecompBase *domainDecomp, Domain *domain,
                                unsigned long simstep) {
@@ -82,10 +155,99 @@ void CheckpointWriter::endStep(ParticleContainer *particleContainer, DomainDecom
 		}
 
 		string filename = filenamestream.str();
-		domain->writeCheckpoint(filename, particleContainer, domainDecomp, _simulation.getSimulationTime(), _useBinaryFormat);
+		if (_asynchronous) {
+			writeAsynchronously(filename, particleContainer, domainDecomp, domain);
+		} else if (not _compression.empty()) {
+			domainDecomp->assertDisjunctivity(particleContainer);
+			domain->updateglobalNumMolecules(particleContainer, domainDecomp);
+			domain->writeCheckpointHeaderXML((filename + ".header.xml"), particleContainer, domainDecomp,
+					_simulation.getSimulationTime());
+			CompressedCheckpoint::writeMolecules(filename + ".dat", particleContainer, domainDecomp, _compression,
+					_chunkSize);
+		} else {
+			domain->writeCheckpoint(filename, particleContainer, domainDecomp, _simulation.getSimulationTime(), _useBinaryFormat);
+		}
 	}
 }
 
+void CheckpointWriter::writeAsynchronously(const string& filename, ParticleContainer* particleContainer,
+		DomainDecompBase* domainDecomp, Domain* domain) {
+	const int stagingBuffer = _nextStagingBuffer;
+	_nextStagingBuffer = 1 - _nextStagingBuffer;
+
+	// the staging buffer has to be free and the file must not be written by the other buffer at the same time.
+	waitForWrite(stagingBuffer);
+	if (_pendingFilenames[1 - stagingBuffer] == filename) {
+		waitForWrite(1 - stagingBuffer);
+	}
+
+	domainDecomp->assertDisjunctivity(particleContainer);
+	domain->updateglobalNumMolecules(particleContainer, domainDecomp);
+	const double currentTime = _simulation.getSimulationTime();
+
+	InMemoryCheckpointing::Snapshot& snapshot = _stagingBuffers[stagingBuffer];
+	snapshot.clearMolecules();
+	for (auto tempMolecule = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
+	     tempMolecule.isValid(); ++tempMolecule) {
+		snapshot.addMolecule(*tempMolecule);
+	}
+	snapshot.setCurrentTime(currentTime);
+	snapshot.setRank(domainDecomp->getRank());
+	snapshot.setGlobalNumberOfMolecules(domain->getglobalNumMolecules());
+
+	string moleculeFilename = filename;
+	streamoff offset = 0;
+	if (_useBinaryFormat) {
+		domain->writeCheckpointHeaderXML((filename + ".header.xml"), particleContainer, domainDecomp, currentTime);
+		moleculeFilename = filename + ".dat";
+
+		// every rank writes its molecules into its own part of the file, all records have the same size.
+		const unsigned long localNumMolecules = snapshot.getMolecules().size();
+		domainDecomp->collCommInit(1);
+		domainDecomp->collCommAppendUnsLong(localNumMolecules);
+		domainDecomp->collCommScanSum();
+		const unsigned long numMoleculesBefore = domainDecomp->collCommGetUnsLong() - localNumMolecules;
+		domainDecomp->collCommFinalize();
+		if (localNumMolecules > 0) {
+			ostringstream record;
+			snapshot.getMolecules().front().writeBinary(record);
+			offset = static_cast<streamoff>(numMoleculesBefore * record.str().size());
+		}
+
+		// the other ranks might still write a previous checkpoint to this file, rank 0 may only truncate it once all
+		// of them have finished their pending writes to it.
+		domainDecomp->barrier();
+		if (domainDecomp->getRank() == 0) {
+			ofstream truncate(moleculeFilename.c_str(), ios::binary | ios::out | ios::trunc);
+		}
+		domainDecomp->barrier();
+	} else {
+		domain->writeCheckpointHeader(filename, particleContainer, domainDecomp, currentTime);
+	}
+
+	_pendingFilenames[stagingBuffer] = filename;
+	_pendingWrites[stagingBuffer] = async(launch::async, writeStagedMolecules, cref(snapshot), moleculeFilename,
+			_useBinaryFormat, offset);
+	global_log->info() << "CheckpointWriter: writing " << snapshot.getGlobalNumberOfMolecules()
+			<< " molecules to " << filename << " in the background." << endl;
+}
+
+void CheckpointWriter::waitForWrite(int stagingBuffer) {
+	if (not _pendingWrites[stagingBuffer].valid()) {
+		return;
+	}
+	const bool success = _pendingWrites[stagingBuffer].get();
+	if (not success) {
+		global_log->error() << "CheckpointWriter: writing the checkpoint " << _pendingFilenames[stagingBuffer]
+				<< " failed." << endl;
+		Simulation::exit(1);
+	}
+	_pendingFilenames[stagingBuffer].clear();
+}
+
 void CheckpointWriter::finish(ParticleContainer * /*particleContainer*/, DomainDecompBase * /*domainDecomp*/,
 							  Domain * /*domain*/) {
+	for (int stagingBuffer = 0; stagingBuffer < 2; ++stagingBuffer) {
+		waitForWrite(stagingBuffer);
+	}
 }
@@ -1,12 +1,16 @@
 #ifndef SRC_IO_CHECKPOINTWRITER_H_
 #define SRC_IO_CHECKPOINTWRITER_H_
 
+#include <array>
+#include <future>
 #include <string>
 
 #include "plugins/PluginBase.h"
+#include "plugins/InMemoryCheckpointing.h"
 
 
 class CheckpointWriter : public PluginBase {
+	friend class CheckpointRestartTest;
 public:
 	
     CheckpointWriter() {}
@@ -23,8 +27,19 @@ public:
 	     <outputprefix>STRING</outputprefix>
 	     <incremental>INTEGER</incremental>
 	     <appendTimestamp>INTEGER</appendTimestamp>
+	     <asynchronous>BOOL</asynchronous> <!-- write the molecules in a background thread, default: false -->
+	     <compression>LZ4|None</compression> <!-- binary only: chunked, compressed data file, default: uncompressed -->
+	     <chunksize>INTEGER</chunksize> <!-- molecules per compressed chunk, default: 16384 -->
 	   </outputplugin>
 	   \endcode
+	 *
+	 * In asynchronous mode the molecules are copied into one of two staging buffers and written by a background
+	 * thread, while the simulation continues. A buffer is only reused once its previous write has finished, so at
+	 * most two checkpoints are in flight. This needs memory for up to two copies of the local molecules. ASCII
+	 * checkpoints of parallel runs have to be written rank by rank and are therefore always written synchronously.
+	 *
+	 * With compression the molecules are written in the chunked format of CompressedCheckpoint, which is read by the
+	 * BinaryReader. Compressed checkpoints are always written synchronously.
 	 */
 	void readXML(XMLfileUnits& xmlconfig);
 	
@@ -43,11 +58,25 @@ public:
 	}
 	static PluginBase* createInstance() { return new CheckpointWriter(); }
 private:
+	/** @brief Copies the molecules into a staging buffer and starts writing them in the background. */
+	void writeAsynchronously(const std::string& filename, ParticleContainer* particleContainer,
+			DomainDecompBase* domainDecomp, Domain* domain);
+	/** @brief Blocks until the write from the given staging buffer has finished. */
+	void waitForWrite(int stagingBuffer);
+
 	std::string _outputPrefix;
 	unsigned long _writeFrequency;
     bool    _useBinaryFormat;
 	bool	_incremental;
 	bool	_appendTimestamp;
+	bool	_asynchronous;
+	std::string _compression;
+	unsigned long _chunkSize;
+
+	std::array<InMemoryCheckpointing::Snapshot, 2> _stagingBuffers;
+	std::array<std::future<bool>, 2> _pendingWrites;
+	std::array<std::string, 2> _pendingFilenames;
+	int _nextStagingBuffer;
 };
 
 #endif  // SRC_IO_CHECKPOINTWRITER_H_
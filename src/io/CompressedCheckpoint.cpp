@@ -0,0 +1,452 @@
+#include "io/CompressedCheckpoint.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+#include "Domain.h"
+#include "Simulation.h"
+#include "WrapOpenMP.h"
+#include "ensemble/EnsembleBase.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "plugins/compression.h"
+#include "utils/Logger.h"
+
+using Log::global_log;
+
+namespace {
+
+/** the last character is the version of the format */
+const char magic[8] = {'L', 'S', '1', 'C', 'H', 'N', 'K', '2'};
+constexpr size_t magicVersionPosition = 7;
+constexpr size_t preambleSize = 16;
+constexpr size_t chunkHeaderSize = 2 * sizeof(uint64_t);
+/** offset of the index, number of chunks, magic */
+constexpr size_t footerSize = 2 * sizeof(uint64_t) + sizeof(magic);
+static_assert(sizeof(CompressedCheckpoint::ChunkIndexEntry) == 72, "the index entries are written as they are");
+/** x, y, z, vx, vy, vz, qw, qx, qy, qz, Dx, Dy, Dz */
+constexpr int numDoubleFields = 13;
+constexpr size_t bytesPerMolecule = sizeof(uint64_t) + sizeof(uint32_t) + numDoubleFields * sizeof(double);
+
+void shuffleBytes(const char* values, size_t numValues, size_t valueSize, char* shuffled) {
+	for (size_t byte = 0; byte < valueSize; ++byte) {
+		for (size_t i = 0; i < numValues; ++i) {
+			shuffled[byte * numValues + i] = values[i * valueSize + byte];
+		}
+	}
+}
+
+void unshuffleBytes(const char* shuffled, size_t numValues, size_t valueSize, char* values) {
+	for (size_t byte = 0; byte < valueSize; ++byte) {
+		for (size_t i = 0; i < numValues; ++i) {
+			values[i * valueSize + byte] = shuffled[byte * numValues + i];
+		}
+	}
+}
+
+/** Spreads the lower 21 bits of value, so that two zero bits lie between every two bits. */
+uint64_t spreadBits(uint64_t value) {
+	value &= 0x1fffff;
+	value = (value | value << 32) & 0x1f00000000ffff;
+	value = (value | value << 16) & 0x1f0000ff0000ff;
+	value = (value | value << 8) & 0x100f00f00f00f00f;
+	value = (value | value << 4) & 0x10c30c30c30c30c3;
+	value = (value | value << 2) & 0x1249249249249249;
+	return value;
+}
+
+/** The molecules of this rank, stored field by field. */
+struct MoleculeFields {
+	std::vector<uint64_t> ids;
+	std::vector<uint32_t> componentIds;
+	std::vector<double> values[numDoubleFields];
+};
+
+/**
+ * Packs the molecules order[begin], ..., order[begin + numMolecules - 1] into one chunk and fills its index entry
+ * (except for the offset).
+ */
+std::vector<char> packChunk(const MoleculeFields& fields, const std::vector<size_t>& order, size_t begin,
+		size_t numMolecules, const std::string& encoding, CompressedCheckpoint::ChunkIndexEntry& entry) {
+	// gather the molecules of the chunk in sorted order
+	std::vector<uint64_t> ids(numMolecules);
+	std::vector<uint32_t> componentIds(numMolecules);
+	std::vector<double> values(numDoubleFields * numMolecules);
+	entry.numMolecules = numMolecules;
+	entry.maxId = 0;
+	for (int d = 0; d < 3; ++d) {
+		entry.boxMin[d] = std::numeric_limits<double>::max();
+		entry.boxMax[d] = std::numeric_limits<double>::lowest();
+	}
+	for (size_t i = 0; i < numMolecules; ++i) {
+		const size_t molecule = order[begin + i];
+		ids[i] = fields.ids[molecule];
+		componentIds[i] = fields.componentIds[molecule];
+		for (int field = 0; field < numDoubleFields; ++field) {
+			values[field * numMolecules + i] = fields.values[field][molecule];
+		}
+		entry.maxId = std::max(entry.maxId, ids[i]);
+		for (int d = 0; d < 3; ++d) {
+			entry.boxMin[d] = std::min(entry.boxMin[d], fields.values[d][molecule]);
+			entry.boxMax[d] = std::max(entry.boxMax[d], fields.values[d][molecule]);
+		}
+	}
+
+	std::vector<char> raw(numMolecules * bytesPerMolecule);
+	char* position = raw.data();
+	shuffleBytes(reinterpret_cast<const char*>(ids.data()), numMolecules, sizeof(uint64_t), position);
+	position += numMolecules * sizeof(uint64_t);
+	shuffleBytes(reinterpret_cast<const char*>(componentIds.data()), numMolecules, sizeof(uint32_t), position);
+	position += numMolecules * sizeof(uint32_t);
+	for (int field = 0; field < numDoubleFields; ++field) {
+		shuffleBytes(reinterpret_cast<const char*>(values.data() + field * numMolecules), numMolecules, sizeof(double),
+				position);
+		position += numMolecules * sizeof(double);
+	}
+
+	std::vector<char> compressed;
+	Compression::create(encoding)->compress(raw.begin(), raw.end(), compressed);
+
+	std::vector<char> chunk(chunkHeaderSize + compressed.size());
+	const uint64_t header[2] = {numMolecules, compressed.size()};
+	std::memcpy(chunk.data(), header, chunkHeaderSize);
+	std::copy(compressed.begin(), compressed.end(), chunk.begin() + chunkHeaderSize);
+	return chunk;
+}
+
+/**
+ * Decompresses one chunk. Throws if the chunk is corrupted.
+ */
+std::vector<Molecule> unpackChunk(std::vector<char>& compressed, size_t numMolecules, const std::string& encoding,
+		std::vector<Component>& components) {
+	std::vector<char> raw;
+	Compression::create(encoding)->decompress(compressed.begin(), compressed.end(), raw);
+	if (raw.size() != numMolecules * bytesPerMolecule) {
+		throw std::runtime_error("chunk size does not match its number of molecules");
+	}
+
+	std::vector<uint64_t> ids(numMolecules);
+	std::vector<uint32_t> componentIds(numMolecules);
+	std::vector<double> values(numDoubleFields * numMolecules);
+	const char* position = raw.data();
+	unshuffleBytes(position, numMolecules, sizeof(uint64_t), reinterpret_cast<char*>(ids.data()));
+	position += numMolecules * sizeof(uint64_t);
+	unshuffleBytes(position, numMolecules, sizeof(uint32_t), reinterpret_cast<char*>(componentIds.data()));
+	position += numMolecules * sizeof(uint32_t);
+	for (int field = 0; field < numDoubleFields; ++field) {
+		unshuffleBytes(position, numMolecules, sizeof(double), reinterpret_cast<char*>(values.data() + field * numMolecules));
+		position += numMolecules * sizeof(double);
+	}
+
+	std::vector<Molecule> molecules;
+	molecules.reserve(numMolecules);
+	for (size_t i = 0; i < numMolecules; ++i) {
+		if (componentIds[i] == 0 or componentIds[i] > components.size()) {
+			throw std::runtime_error("molecule " + std::to_string(ids[i]) + " has wrong componentid: "
+					+ std::to_string(componentIds[i]));
+		}
+		double v[numDoubleFields];
+		for (int field = 0; field < numDoubleFields; ++field) {
+			v[field] = values[field * numMolecules + i];
+		}
+		molecules.push_back(Molecule(ids[i], &components[componentIds[i] - 1], v[0], v[1], v[2], v[3], v[4], v[5],
+				v[6], v[7], v[8], v[9], v[10], v[11], v[12]));
+	}
+	return molecules;
+}
+
+} /* anonymous namespace */
+
+bool CompressedCheckpoint::isCompressed(const std::string& filename) {
+	std::ifstream file(filename.c_str(), std::ios::binary | std::ios::in);
+	char start[sizeof(magic)];
+	file.read(start, sizeof(magic));
+	// all versions are recognized
+	return file.good() and std::memcmp(start, magic, magicVersionPosition) == 0;
+}
+
+std::vector<char> CompressedCheckpoint::getPreamble(const std::string& encoding) {
+	std::vector<char> preamble(preambleSize, '\0');
+	std::copy(magic, magic + sizeof(magic), preamble.begin());
+	std::copy_n(encoding.begin(), std::min(encoding.size(), preambleSize - sizeof(magic)),
+			preamble.begin() + sizeof(magic));
+	return preamble;
+}
+
+std::vector<char> CompressedCheckpoint::getFooter(uint64_t indexOffset, uint64_t numChunks) {
+	std::vector<char> footer(footerSize);
+	std::memcpy(footer.data(), &indexOffset, sizeof(uint64_t));
+	std::memcpy(footer.data() + sizeof(uint64_t), &numChunks, sizeof(uint64_t));
+	std::copy(magic, magic + sizeof(magic), footer.begin() + 2 * sizeof(uint64_t));
+	return footer;
+}
+
+CompressedCheckpoint::CompressedMolecules CompressedCheckpoint::compressMolecules(ParticleContainer* particleContainer,
+		const std::string& encoding, unsigned long chunkSize) {
+	MoleculeFields fields;
+	double boxMin[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(),
+			std::numeric_limits<double>::max()};
+	double boxMax[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(),
+			std::numeric_limits<double>::lowest()};
+	for (auto molecule = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); molecule.isValid();
+	     ++molecule) {
+		fields.ids.push_back(molecule->getID());
+		fields.componentIds.push_back(molecule->componentid() + 1);
+		const double values[numDoubleFields] = {molecule->r(0), molecule->r(1), molecule->r(2),
+				molecule->v(0), molecule->v(1), molecule->v(2),
+				molecule->q().qw(), molecule->q().qx(), molecule->q().qy(), molecule->q().qz(),
+				molecule->D(0), molecule->D(1), molecule->D(2)};
+		for (int field = 0; field < numDoubleFields; ++field) {
+			fields.values[field].push_back(values[field]);
+		}
+		for (int d = 0; d < 3; ++d) {
+			boxMin[d] = std::min(boxMin[d], values[d]);
+			boxMax[d] = std::max(boxMax[d], values[d]);
+		}
+	}
+	const size_t numMolecules = fields.ids.size();
+
+	// sort the molecules along a Morton curve over their bounding box, so that the chunks are spatially compact.
+	constexpr double numBins = 1 << 21;
+	std::vector<uint64_t> mortonKeys(numMolecules);
+	for (size_t i = 0; i < numMolecules; ++i) {
+		mortonKeys[i] = 0;
+		for (int d = 0; d < 3; ++d) {
+			const double extent = boxMax[d] - boxMin[d];
+			const double relative = extent > 0. ? (fields.values[d][i] - boxMin[d]) / extent : 0.;
+			const uint64_t bin = std::min(static_cast<uint64_t>(relative * numBins), static_cast<uint64_t>(numBins - 1));
+			mortonKeys[i] |= spreadBits(bin) << d;
+		}
+	}
+	std::vector<size_t> order(numMolecules);
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [&mortonKeys](size_t a, size_t b) { return mortonKeys[a] < mortonKeys[b]; });
+
+	const long numChunks = (numMolecules + chunkSize - 1) / chunkSize;
+	std::vector<std::vector<char>> chunks(numChunks);
+	CompressedMolecules result;
+	result.index.resize(numChunks);
+	std::string errorMessage;
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic)
+	#endif
+	for (long chunk = 0; chunk < numChunks; ++chunk) {
+		const size_t begin = chunk * chunkSize;
+		try {
+			chunks[chunk] = packChunk(fields, order, begin, std::min<size_t>(chunkSize, numMolecules - begin), encoding,
+					result.index[chunk]);
+		} catch (const std::exception& e) {
+			#if defined(_OPENMP)
+			#pragma omp critical(CompressedCheckpointError)
+			#endif
+			errorMessage = e.what();
+		}
+	}
+	if (not errorMessage.empty()) {
+		global_log->error() << "CompressedCheckpoint: compressing the molecules failed: " << errorMessage << std::endl;
+		Simulation::exit(1);
+	}
+
+	for (long chunk = 0; chunk < numChunks; ++chunk) {
+		result.index[chunk].offset = result.chunks.size();
+		result.chunks.insert(result.chunks.end(), chunks[chunk].begin(), chunks[chunk].end());
+	}
+	global_log->info() << "CompressedCheckpoint: compressed " << numMolecules << " local molecules from "
+			<< numMolecules * bytesPerMolecule << " to " << result.chunks.size() << " bytes" << std::endl;
+	return result;
+}
+
+void CompressedCheckpoint::writeMolecules(const std::string& filename, ParticleContainer* particleContainer,
+		DomainDecompBase* domainDecomp, const std::string& encoding, unsigned long chunkSize) {
+	CompressedMolecules compressed = compressMolecules(particleContainer, encoding, chunkSize);
+
+	const unsigned long localBytes = compressed.chunks.size();
+	const unsigned long localChunks = compressed.index.size();
+	domainDecomp->collCommInit(2);
+	domainDecomp->collCommAppendUnsLong(localBytes);
+	domainDecomp->collCommAppendUnsLong(localChunks);
+	domainDecomp->collCommScanSum();
+	const unsigned long bytesBefore = domainDecomp->collCommGetUnsLong() - localBytes;
+	const unsigned long chunksBefore = domainDecomp->collCommGetUnsLong() - localChunks;
+	domainDecomp->collCommFinalize();
+	domainDecomp->collCommInit(2);
+	domainDecomp->collCommAppendUnsLong(localBytes);
+	domainDecomp->collCommAppendUnsLong(localChunks);
+	domainDecomp->collCommAllreduceSum();
+	const unsigned long totalBytes = domainDecomp->collCommGetUnsLong();
+	const unsigned long totalChunks = domainDecomp->collCommGetUnsLong();
+	domainDecomp->collCommFinalize();
+
+	const uint64_t indexOffset = preambleSize + totalBytes;
+	for (ChunkIndexEntry& entry : compressed.index) {
+		entry.offset += preambleSize + bytesBefore;
+	}
+
+	if (domainDecomp->getRank() == 0) {
+		const std::vector<char> preamble = getPreamble(encoding);
+		const std::vector<char> footer = getFooter(indexOffset, totalChunks);
+		std::ofstream file(filename.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+		file.write(preamble.data(), preamble.size());
+		file.seekp(indexOffset + totalChunks * sizeof(ChunkIndexEntry));
+		file.write(footer.data(), footer.size());
+	}
+	domainDecomp->barrier();
+
+	std::ofstream file(filename.c_str(), std::ios::binary | std::ios::in | std::ios::out);
+	file.seekp(preambleSize + bytesBefore);
+	file.write(compressed.chunks.data(), compressed.chunks.size());
+	file.seekp(indexOffset + chunksBefore * sizeof(ChunkIndexEntry));
+	file.write(reinterpret_cast<const char*>(compressed.index.data()), compressed.index.size() * sizeof(ChunkIndexEntry));
+	file.close();
+	if (file.fail()) {
+		global_log->error() << "CompressedCheckpoint: could not write " << filename << std::endl;
+		Simulation::exit(1);
+	}
+	// the file is complete only once all ranks have written their chunks
+	domainDecomp->barrier();
+}
+
+unsigned long CompressedCheckpoint::readMolecules(const std::string& filename, ParticleContainer* particleContainer,
+		Domain* domain, DomainDecompBase* domainDecomp) {
+	std::ifstream file(filename.c_str(), std::ios::binary | std::ios::in);
+	char preamble[preambleSize];
+	file.read(preamble, preambleSize);
+	if (not file.good() or std::memcmp(preamble, magic, magicVersionPosition) != 0) {
+		global_log->error() << "CompressedCheckpoint: " << filename << " is not a compressed checkpoint." << std::endl;
+		Simulation::exit(1);
+	}
+	const char version = preamble[magicVersionPosition];
+	const std::string encoding(preamble + sizeof(magic), strnlen(preamble + sizeof(magic), preambleSize - sizeof(magic)));
+	global_log->info() << "CompressedCheckpoint: reading " << filename << " (version " << version << ", compression: "
+			<< encoding << ")" << std::endl;
+
+	// determine the chunks to read. Version 1 has no index, so all chunks are read.
+	std::vector<ChunkIndexEntry> chunksToRead;
+	unsigned long numMoleculesInFile = 0;
+	unsigned long maxid = 0;
+	if (version == '1') {
+		file.seekg(0, std::ios::end);
+		const uint64_t fileSize = file.tellg();
+		uint64_t offset = preambleSize;
+		while (offset < fileSize) {
+			uint64_t header[2];
+			file.seekg(offset);
+			file.read(reinterpret_cast<char*>(header), chunkHeaderSize);
+			ChunkIndexEntry entry;
+			entry.offset = offset;
+			entry.numMolecules = header[0];
+			chunksToRead.push_back(entry);
+			numMoleculesInFile += header[0];
+			offset += chunkHeaderSize + header[1];
+		}
+	} else {
+		uint64_t footer[2];
+		file.seekg(-static_cast<std::streamoff>(footerSize), std::ios::end);
+		file.read(reinterpret_cast<char*>(footer), sizeof(footer));
+		std::vector<ChunkIndexEntry> index(footer[1]);
+		file.seekg(footer[0]);
+		file.read(reinterpret_cast<char*>(index.data()), index.size() * sizeof(ChunkIndexEntry));
+		if (not file.good()) {
+			global_log->error() << "CompressedCheckpoint: could not read the index of " << filename << std::endl;
+			Simulation::exit(1);
+		}
+		for (const ChunkIndexEntry& entry : index) {
+			numMoleculesInFile += entry.numMolecules;
+			maxid = std::max(maxid, entry.maxId);
+			bool overlaps = true;
+			for (int d = 0; d < 3; ++d) {
+				overlaps = overlaps and entry.boxMax[d] >= particleContainer->getBoundingBoxMin(d)
+						and entry.boxMin[d] <= particleContainer->getBoundingBoxMax(d);
+			}
+			if (overlaps) {
+				chunksToRead.push_back(entry);
+			}
+		}
+		global_log->info() << "CompressedCheckpoint: reading " << chunksToRead.size() << " of " << index.size()
+				<< " chunks" << std::endl;
+	}
+	if (numMoleculesInFile != domain->getglobalNumMolecules()) {
+		global_log->error() << "CompressedCheckpoint: " << filename << " contains " << numMoleculesInFile
+				<< " molecules, but the header specifies " << domain->getglobalNumMolecules() << std::endl;
+		Simulation::exit(1);
+	}
+
+	std::vector<Component>& components = *(global_simulation->getEnsemble()->getComponents());
+	std::vector<unsigned long> localNumMoleculesPerComponent(components.size(), 0);
+
+	// enough chunks to keep all threads busy
+	const size_t chunksPerBatch = 4 * mardyn_get_max_threads();
+	for (size_t batchBegin = 0; batchBegin < chunksToRead.size(); batchBegin += chunksPerBatch) {
+		const long numChunks = std::min(chunksPerBatch, chunksToRead.size() - batchBegin);
+		std::vector<std::vector<char>> compressedChunks(numChunks);
+		for (long chunk = 0; chunk < numChunks; ++chunk) {
+			uint64_t header[2];
+			file.seekg(chunksToRead[batchBegin + chunk].offset);
+			file.read(reinterpret_cast<char*>(header), chunkHeaderSize);
+			compressedChunks[chunk].resize(header[1]);
+			file.read(compressedChunks[chunk].data(), header[1]);
+			if (not file.good() or header[0] != chunksToRead[batchBegin + chunk].numMolecules) {
+				global_log->error() << "CompressedCheckpoint: " << filename << " is corrupted." << std::endl;
+				Simulation::exit(1);
+			}
+		}
+
+		std::vector<std::vector<Molecule>> molecules(numChunks);
+		std::string errorMessage;
+		#if defined(_OPENMP)
+		#pragma omp parallel for schedule(dynamic)
+		#endif
+		for (long chunk = 0; chunk < numChunks; ++chunk) {
+			try {
+				molecules[chunk] = unpackChunk(compressedChunks[chunk], chunksToRead[batchBegin + chunk].numMolecules,
+						encoding, components);
+			} catch (const std::exception& e) {
+				#if defined(_OPENMP)
+				#pragma omp critical(CompressedCheckpointError)
+				#endif
+				errorMessage = e.what();
+			}
+		}
+		if (not errorMessage.empty()) {
+			global_log->error() << "CompressedCheckpoint: reading " << filename << " failed: " << errorMessage << std::endl;
+			Simulation::exit(1);
+		}
+
+		for (std::vector<Molecule>& chunk : molecules) {
+			for (Molecule& m : chunk) {
+				if (version == '1') {
+					maxid = std::max(maxid, m.getID());
+				}
+				// only add particle if it is inside of the own domain!
+				if (not particleContainer->isInBoundingBox(m.r_arr().data())) {
+					continue;
+				}
+				particleContainer->addParticle(m, true, false);
+				localNumMoleculesPerComponent[m.componentid()]++;
+
+				// Only called inside GrandCanonical
+				global_simulation->getEnsemble()->storeSample(&m, m.componentid());
+			}
+		}
+	}
+
+	// every molecule has been added by exactly one rank
+	domainDecomp->collCommInit(components.size());
+	for (unsigned long numMolecules : localNumMoleculesPerComponent) {
+		domainDecomp->collCommAppendUnsLong(numMolecules);
+	}
+	domainDecomp->collCommAllreduceSum();
+	for (Component& component : components) {
+		const unsigned long numMolecules = domainDecomp->collCommGetUnsLong();
+		component.incNumMolecules(numMolecules);
+		domain->setglobalRotDOF(component.getRotationalDegreesOfFreedom() * numMolecules + domain->getglobalRotDOF());
+	}
+	domainDecomp->collCommFinalize();
+	return maxid;
+}
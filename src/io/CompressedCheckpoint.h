@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Domain;
+class DomainDecompBase;
+class ParticleContainer;
+
+/**
+ * Chunked, compressed format for binary checkpoints.
+ *
+ * The data file starts with a preamble (magic string with the format version and name of the compression, 8 bytes
+ * each), followed by the chunks of all ranks. Every chunk holds up to chunkSize molecules in the ICRVQD format and
+ * consists of
+ * - the number of molecules (uint64_t),
+ * - the number of compressed bytes (uint64_t),
+ * - the compressed bytes.
+ * Within a chunk the data is stored field by field (ids, component ids, x, y, z, vx, ..., Dz) and the bytes of every
+ * field are shuffled: first the lowest byte of all values, then the second one and so on. Sign and exponent bytes of
+ * neighbouring molecules are thus stored next to each other, which compresses a lot better than whole records.
+ *
+ * Since version 2 the molecules of every rank are sorted along a Morton curve before they are split into chunks, so
+ * every chunk covers a compact region. The chunks are followed by a spatial index (one ChunkIndexEntry per chunk) and
+ * a footer (offset of the index, number of chunks, magic string). A reader only has to read the chunks, whose
+ * bounding box overlaps its own subdomain.
+ *
+ * The header of the checkpoint is the usual xml header (Domain::writeCheckpointHeaderXML). The BinaryReader and the
+ * MPI_IOReader recognize compressed data files by their preamble.
+ */
+namespace CompressedCheckpoint {
+
+/**
+ * Entry of the spatial index, 72 bytes in the file.
+ */
+struct ChunkIndexEntry {
+	uint64_t offset;  //!< position of the chunk in the file
+	uint64_t numMolecules;
+	uint64_t maxId;  //!< highest molecule id within the chunk
+	double boxMin[3];  //!< bounding box of the molecule positions within the chunk
+	double boxMax[3];
+};
+
+/**
+ * The compressed chunks of one rank together with their index. The offsets of the index are relative to the first
+ * chunk of the rank.
+ */
+struct CompressedMolecules {
+	std::vector<char> chunks;
+	std::vector<ChunkIndexEntry> index;
+};
+
+/**
+ * Checks whether the given file starts with the preamble of a compressed checkpoint.
+ */
+bool isCompressed(const std::string& filename);
+
+/**
+ * Packs the inner and boundary molecules of this rank into compressed chunks. The molecules are sorted along a
+ * Morton curve, the chunks are compressed in parallel.
+ * @param encoding name of the compression (see Compression::create)
+ * @param chunkSize maximal number of molecules per chunk
+ */
+CompressedMolecules compressMolecules(ParticleContainer* particleContainer, const std::string& encoding,
+		unsigned long chunkSize);
+
+/**
+ * Returns the preamble of a data file with the given compression.
+ */
+std::vector<char> getPreamble(const std::string& encoding);
+
+/**
+ * Returns the footer of a data file, whose index of numChunks entries starts at indexOffset.
+ */
+std::vector<char> getFooter(uint64_t indexOffset, uint64_t numChunks);
+
+/**
+ * Writes the inner and boundary molecules of all ranks into one compressed data file.
+ * Every rank writes its chunks and its part of the index at its own offsets, which are determined by exclusive scans
+ * of the chunk sizes and numbers.
+ */
+void writeMolecules(const std::string& filename, ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+		const std::string& encoding, unsigned long chunkSize);
+
+/**
+ * Reads the molecules of a compressed data file, which belong to the subdomain of this rank. With a spatial index
+ * only the overlapping chunks are read, older files are read completely. Several chunks are decompressed in parallel.
+ * The component counts and rotational degrees of freedom are reduced over all ranks.
+ * @return highest molecule id in the file
+ */
+unsigned long readMolecules(const std::string& filename, ParticleContainer* particleContainer, Domain* domain,
+		DomainDecompBase* domainDecomp);
+
+} /* namespace CompressedCheckpoint */
@@ -13,6 +13,8 @@
 
 #include "Common.h"
 #include "Domain.h"
+#include "io/CompressedCheckpoint.h"
+#include "plugins/compression.h"
 #include "utils/Logger.h"
 
 #include "molecules/Molecule.h"
@@ -35,6 +37,7 @@ MPI_IOCheckpointWriter::MPI_IOCheckpointWriter(unsigned long writeFrequency,
 	_outputPrefix = outputPrefix;
 	_writeFrequency = writeFrequency;
 	_incremental = incremental;
+	_chunkSize = 16384;
 
 	if (outputPrefix == "default") {
 		_appendTimestamp = true;
@@ -67,6 +70,24 @@ void MPI_IOCheckpointWriter::readXML(XMLfileUnits& xmlconfig) {
 		_appendTimestamp = true;
 	}
 	global_log->info() << "Append timestamp: " << _appendTimestamp << std::endl;
+
+	_compression = "";
+	xmlconfig.getNodeValue("compression", _compression);
+	if (not _compression.empty()) {
+		try {
+			Compression::create(_compression);
+		} catch (const std::invalid_argument& e) {
+			global_log->error() << "MPI_IOCheckpointWriter: " << e.what() << std::endl;
+			Simulation::exit(-1);
+		}
+		global_log->info() << "Compression: " << _compression << std::endl;
+	}
+	_chunkSize = 16384;
+	xmlconfig.getNodeValue("chunksize", _chunkSize);
+	if (_chunkSize == 0) {
+		global_log->error() << "MPI_IOCheckpointWriter: chunksize must be a positive nonzero integer." << std::endl;
+		Simulation::exit(-1);
+	}
 }
 
 void MPI_IOCheckpointWriter::init(ParticleContainer *particleContainer,
@@ -95,10 +116,18 @@ void MPI_IOCheckpointWriter::endStep(ParticleContainer *particleContainer, Domai
 			filenamestream << "-" << gettimestring();
 		}
 		filenamestream << ".restart";
+		if (not _compression.empty()) {
+			// the reader checks the number of molecules against the header
+			domain->updateglobalNumMolecules(particleContainer, domainDecomp);
+		}
 		domain->writeCheckpointHeader(filenamestream.str(), particleContainer,
 				domainDecomp, _simulation.getSimulationTime());
 		filenamestream << ".mpi";
 		std::string filename = filenamestream.str();
+		if (not _compression.empty()) {
+			writeCompressed(filename, particleContainer);
+			return;
+		}
 
 
 		//some debug stuff to gather cell information from the LinkedCells Class
@@ -426,6 +455,70 @@ void MPI_IOCheckpointWriter::finish(ParticleContainer *particleContainer,
 
 }
 
+void MPI_IOCheckpointWriter::writeCompressed(const std::string& filename, ParticleContainer* particleContainer) {
+#ifdef ENABLE_MPI
+	CompressedCheckpoint::CompressedMolecules compressed
+		= CompressedCheckpoint::compressMolecules(particleContainer, _compression, _chunkSize);
+
+	int rank = 0;
+	MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+	// bytes and number of chunks
+	long long localSizes[2] = {static_cast<long long>(compressed.chunks.size()),
+			static_cast<long long>(compressed.index.size())};
+	long long sizesBefore[2] = {0, 0};
+	long long totalSizes[2] = {0, 0};
+	MPI_Exscan(localSizes, sizesBefore, 2, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+	if (rank == 0) {
+		// the result of MPI_Exscan is undefined on rank 0
+		sizesBefore[0] = sizesBefore[1] = 0;
+	}
+	MPI_Allreduce(localSizes, totalSizes, 2, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+
+	const std::vector<char> preamble = CompressedCheckpoint::getPreamble(_compression);
+	const MPI_Offset dataOffset = preamble.size() + sizesBefore[0];
+	const MPI_Offset indexOffset = preamble.size() + totalSizes[0];
+	for (CompressedCheckpoint::ChunkIndexEntry& entry : compressed.index) {
+		entry.offset += dataOffset;
+	}
+
+	MPI_File fh;
+	int ret = MPI_File_open(MPI_COMM_WORLD, filename.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+	if (ret != MPI_SUCCESS) {
+		handle_error(ret);
+	}
+	// an older, larger file must not leave garbage at the end.
+	ret = MPI_File_set_size(fh, 0);
+	if (ret != MPI_SUCCESS) {
+		handle_error(ret);
+	}
+
+	MPI_Status status;
+	if (rank == 0) {
+		const std::vector<char> footer = CompressedCheckpoint::getFooter(indexOffset, totalSizes[1]);
+		ret = MPI_File_write_at(fh, 0, preamble.data(), preamble.size(), MPI_BYTE, &status);
+		if (ret != MPI_SUCCESS) {
+			handle_error(ret);
+		}
+		ret = MPI_File_write_at(fh, indexOffset + totalSizes[1] * sizeof(CompressedCheckpoint::ChunkIndexEntry),
+				footer.data(), footer.size(), MPI_BYTE, &status);
+		if (ret != MPI_SUCCESS) {
+			handle_error(ret);
+		}
+	}
+	ret = MPI_File_write_at_all(fh, dataOffset, compressed.chunks.data(), compressed.chunks.size(), MPI_BYTE, &status);
+	if (ret != MPI_SUCCESS) {
+		handle_error(ret);
+	}
+	ret = MPI_File_write_at_all(fh, indexOffset + sizesBefore[1] * sizeof(CompressedCheckpoint::ChunkIndexEntry),
+			compressed.index.data(), compressed.index.size() * sizeof(CompressedCheckpoint::ChunkIndexEntry), MPI_BYTE,
+			&status);
+	if (ret != MPI_SUCCESS) {
+		handle_error(ret);
+	}
+	MPI_File_close(&fh);
+#endif
+}
+
 void MPI_IOCheckpointWriter::handle_error(int i) {
 #ifdef ENABLE_MPI
 	char error_string[BUFSIZ];
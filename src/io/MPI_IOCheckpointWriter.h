@@ -29,6 +29,23 @@ public:
 	MPI_IOCheckpointWriter(unsigned long writeFrequency, std::string outputPrefix, bool incremental);
 	~MPI_IOCheckpointWriter();
 
+	/** @brief Read in XML configuration for MPI_IOCheckpointWriter.
+	 *
+	 * The following xml object structure is handled by this method:
+	 * \code{.xml}
+	   <outputplugin name="MPI_IOCheckpointWriter">
+	     <writefrequency>INTEGER</writefrequency>
+	     <outputprefix>STRING</outputprefix>
+	     <incremental>INTEGER</incremental>
+	     <appendTimestamp>INTEGER</appendTimestamp>
+	     <compression>LZ4|None</compression> <!-- chunked, compressed data file, default: uncompressed -->
+	     <chunksize>INTEGER</chunksize> <!-- molecules per compressed chunk, default: 16384 -->
+	   </outputplugin>
+	   \endcode
+	 *
+	 * With compression the .mpi data file is written in the chunked format of CompressedCheckpoint instead of the
+	 * cell based format. The MPI_IOReader recognizes both.
+	 */
 	void readXML(XMLfileUnits& xmlconfig);
 
 	void init(ParticleContainer *particleContainer,
@@ -42,6 +59,9 @@ public:
 
 	void handle_error(int i);
 
+	//! @brief writes the molecules of all ranks in the compressed format with collective MPI-IO
+	void writeCompressed(const std::string& filename, ParticleContainer* particleContainer);
+
 	std::string getPluginName() {
 		return std::string("MPI_IOCheckpointWriter");
 	}
@@ -51,6 +71,8 @@ private:
 	unsigned long _writeFrequency;
 	bool	_incremental;
 	bool	_appendTimestamp;
+	std::string _compression;
+	unsigned long _chunkSize;
 
 };
 
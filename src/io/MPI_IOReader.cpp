@@ -19,6 +19,7 @@
 #include "ensemble/BoxDomain.h"
 #include "ensemble/EnsembleBase.h"
 #include "Simulation.h"
+#include "io/CompressedCheckpoint.h"
 #include "molecules/Molecule.h"
 
 #ifdef ENABLE_MPI
@@ -280,6 +281,20 @@ void MPI_IOReader::readPhaseSpaceHeader(Domain* domain, double timestep) {
 
 unsigned long
 MPI_IOReader::readPhaseSpace(ParticleContainer* particleContainer, Domain* domain, DomainDecompBase* domainDecomp) {
+	// compressed data files (MPI_IOCheckpointWriter with compression) are read by all ranks at once
+	if (CompressedCheckpoint::isCompressed(_phaseSpaceFile)) {
+		Timer inputTimer;
+		inputTimer.start();
+		unsigned long maxid = CompressedCheckpoint::readMolecules(_phaseSpaceFile, particleContainer, domain, domainDecomp);
+		if (!domain->getglobalRho()) {
+			domain->setglobalRho(domain->getglobalNumMolecules() / domain->getGlobalVolume());
+			global_log->info() << "Calculated Rho_global = " << domain->getglobalRho() << endl;
+		}
+		inputTimer.stop();
+		global_log->info() << "Initial IO took:                 " << inputTimer.get_etime() << " sec" << endl;
+		return maxid;
+	}
+
 #ifdef ENABLE_MPI
 	Timer inputTimer;
 	inputTimer.start();
@@ -19,7 +19,10 @@
 #include <vector>
 #include <array>
 #include <iostream>
+#include <algorithm>
+#include <climits>
 #include <cstdint>
+#include <cstring>
 
 #include "Common.h"
 #include "Domain.h"
@@ -39,6 +42,12 @@
 using Log::global_log;
 using namespace std;
 
+//! appends the bytes of data to the buffer
+static void append(std::vector<char>& buffer, const void* data, size_t numBytes) {
+	const char* bytes = static_cast<const char*>(data);
+	buffer.insert(buffer.end(), bytes, bytes + numBytes);
+}
+
 std::string MmpldWriter::getOutputFilename() {
 	std::stringstream filenamestream;
 	filenamestream << _outputPrefix << "_" << fill_width('0', 4) << _fileCount << ".mmpld";
@@ -46,17 +55,18 @@ std::string MmpldWriter::getOutputFilename() {
 }
 
 MmpldWriter::MmpldWriter() :
-		_startTimestep(0), _writeFrequency(1000), _stopTimestep(0), _writeBufferSize(32768), _outputPrefix("unknown"),
+		_startTimestep(0), _writeFrequency(1000), _stopTimestep(0), _outputPrefix("unknown"),
 		_bInitSphereData(ISD_READ_FROM_XML), _bWriteControlPrepared(false),
-		_fileCount(1), _numFramesPerFile(0), _mmpldversion(MMPLD_DEFAULT_VERSION), _vertex_type(MMPLD_VERTEX_FLOAT_XYZ), _color_type(MMPLD_COLOR_NONE)
+		_fileCount(1), _numFramesPerFile(0), _mmpldversion(MMPLD_DEFAULT_VERSION), _vertex_type(MMPLD_VERTEX_FLOAT_XYZ), _color_type(MMPLD_COLOR_NONE),
+		_allSites(false)
 {}
 
 MmpldWriter::MmpldWriter(uint64_t startTimestep, uint64_t writeFrequency, uint64_t stopTimestep, uint64_t numFramesPerFile,
 		std::string outputPrefix)
-		:	_startTimestep(startTimestep), _writeFrequency(writeFrequency), _stopTimestep(stopTimestep), _writeBufferSize(32768),
+		:	_startTimestep(startTimestep), _writeFrequency(writeFrequency), _stopTimestep(stopTimestep),
 		_outputPrefix(outputPrefix), _bInitSphereData(ISD_READ_FROM_XML), _bWriteControlPrepared(false),
-		_fileCount(1),_numFramesPerFile(numFramesPerFile),  _vertex_type(MMPLD_VERTEX_FLOAT_XYZ),
-		_color_type(MMPLD_COLOR_NONE)
+		_fileCount(1),_numFramesPerFile(numFramesPerFile), _mmpldversion(MMPLD_DEFAULT_VERSION), _vertex_type(MMPLD_VERTEX_FLOAT_XYZ),
+		_color_type(MMPLD_COLOR_NONE), _allSites(false)
 {
 	if (0 == _writeFrequency) {
 		Simulation::exit(-1);
@@ -77,12 +87,14 @@ void MmpldWriter::readXML(XMLfileUnits& xmlconfig)
 	xmlconfig.getNodeValue("writecontrol/stop", _stopTimestep);
 	_stopTimestep = std::min(_stopTimestep, global_simulation->getNumTimesteps());
 	xmlconfig.getNodeValue("writecontrol/framesperfile", _numFramesPerFile);
-	xmlconfig.getNodeValue("writecontrol/writeBufferSize", _writeBufferSize);
 	global_log->info() << "[MMPLD Writer] Start sampling from simstep: " << _startTimestep << endl;
 	global_log->info() << "[MMPLD Writer] Write with frequency: " << _writeFrequency << endl;
 	global_log->info() << "[MMPLD Writer] Stop sampling at simstep: " << _stopTimestep << endl;
 	global_log->info() << "[MMPLD Writer] Split files every " << _numFramesPerFile << "th frame."<< endl;
-	global_log->info() << "[MMPLD Writer] Write buffer size: " << _writeBufferSize << " Byte" << endl;
+	long writeBufferSize = 0;
+	if(xmlconfig.getNodeValue("writecontrol/writeBufferSize", writeBufferSize)) {
+		global_log->warning() << "[MMPLD Writer] writeBufferSize is not used anymore, the particle lists are written directly." << endl;
+	}
 
 	int mmpldversion = 100;
 	xmlconfig.getNodeValue("mmpldversion", mmpldversion);
@@ -99,6 +111,18 @@ void MmpldWriter::readXML(XMLfileUnits& xmlconfig)
 	xmlconfig.getNodeValue("outputprefix", _outputPrefix);
 	global_log->info() << "[MMPLD Writer] Output prefix: " << _outputPrefix << endl;
 
+	std::string sites = "lj";
+	xmlconfig.getNodeValue("sites", sites);
+	if("all" == sites) {
+		_allSites = true;
+	} else if("lj" == sites) {
+		_allSites = false;
+	} else {
+		global_log->error() << "[MMPLD Writer] Unknown sites: " << sites << ", possible values: lj, all" << endl;
+		Simulation::exit(1);
+	}
+	global_log->info() << "[MMPLD Writer] Sites taken into account (multi sphere representation): " << sites << endl;
+
 	// sphere params: radius, colors
 	uint32_t numSites = 0;
 	XMLfile::Query query = xmlconfig.query("spheres/site");
@@ -159,8 +183,8 @@ void MmpldWriter::init(ParticleContainer *particleContainer,
 
 	for(int cid = 0; cid < _numComponents; ++cid) {
 		Component &component = components->at(cid);
-		/** @todo MMPLD writer takes into account only LJ sites at the moment, here */
-		int numSites = component.numLJcenters();
+		/* the sites are ordered as by Molecule::site_d_abs(), so the LJ centers come first */
+		int numSites = _allSites ? component.numSites() : component.numLJcenters();
 		_numSitesPerComp.at(cid) = numSites;
 		_nCompSitesOffset.at(cid) = _numSitesTotal; /* offset is total number of sites so far */
 		global_log->debug() << "[MMPLD Writer] Component[" << cid << "] numSites=" << numSites << " offset=" << unsigned(_nCompSitesOffset.at(cid)) << endl;
@@ -181,73 +205,65 @@ void MmpldWriter::init(ParticleContainer *particleContainer,
 	_seekTable.resize(_numSeekEntries);
 	_seekTable.at(0) = MMPLD_HEADER_DATA_SIZE + get_seekTable_size();
 
-#ifdef ENABLE_MPI
-	int rank = domainDecomp->getRank();
-	if (rank == 0){
-#endif
-	ofstream mmpldfstream(filename.c_str(), ios::binary|ios::out);
-	mmpldfstream.write((char*)magicIdentifier, sizeof(magicIdentifier));
-	mmpldfstream.write((char*)&mmpldversion_le, sizeof(mmpldversion_le));
-	mmpldfstream.write((char*)&numframes_le,sizeof(numframes_le));
-	global_log->debug() << "[MMPLD Writer] Writing bounding box data." << endl;
-	float minbox[3] = {0, 0, 0};
-	float maxbox[3];
-	for (unsigned short d = 0; d < 3; ++d) {
-		maxbox[d] = domain->getGlobalLength(d);
-	}
-	mmpldfstream.write((char*)minbox, sizeof(minbox));
-	mmpldfstream.write((char*)maxbox, sizeof(maxbox));
-	global_log->debug() << "[MMPLD Writer] Writing clipping box data." << endl;
-	float inflateRadius = 0;
-	for(auto radius : _global_radius) {
-		if(inflateRadius < radius ) {
-			inflateRadius = radius;
+	std::vector<char> fileHeader;
+	if (domainDecomp->getRank() == 0) {
+		append(fileHeader, magicIdentifier, sizeof(magicIdentifier));
+		append(fileHeader, &mmpldversion_le, sizeof(mmpldversion_le));
+		append(fileHeader, &numframes_le, sizeof(numframes_le));
+		global_log->debug() << "[MMPLD Writer] Writing bounding box data." << endl;
+		float minbox[3] = {0, 0, 0};
+		float maxbox[3];
+		for (unsigned short d = 0; d < 3; ++d) {
+			maxbox[d] = domain->getGlobalLength(d);
+		}
+		append(fileHeader, minbox, sizeof(minbox));
+		append(fileHeader, maxbox, sizeof(maxbox));
+		global_log->debug() << "[MMPLD Writer] Writing clipping box data." << endl;
+		float inflateRadius = 0;
+		for(auto radius : _global_radius) {
+			if(inflateRadius < radius ) {
+				inflateRadius = radius;
+			}
+		}
+		for (unsigned short d = 0; d < 3; ++d){
+			maxbox[d] = maxbox[d] + inflateRadius;
+			minbox[d] = minbox[d] - inflateRadius;
+		}
+		append(fileHeader, minbox, sizeof(minbox));
+		append(fileHeader, maxbox, sizeof(maxbox));
+		global_log->debug() << "[MMPLD Writer] Preallocating " << _numSeekEntries << " seek table entries for frames" << endl;
+		for (uint32_t i = 0; i < _numSeekEntries; ++i) {
+			uint64_t offset_le = htole64(_seekTable.at(i));
+			append(fileHeader, &offset_le, sizeof(offset_le));
 		}
 	}
-	for (unsigned short d = 0; d < 3; ++d){
-		maxbox[d] = maxbox[d] + inflateRadius;
-		minbox[d] = minbox[d] - inflateRadius;
-	}
-	mmpldfstream.write((char*)minbox, sizeof(minbox));
-	mmpldfstream.write((char*)maxbox, sizeof(maxbox));
-	global_log->debug() << "[MMPLD Writer] Preallocating " << _numSeekEntries << " seek table entries for frames" << endl;
-	for (uint32_t i = 0; i < _numSeekEntries; ++i) {
-		uint64_t offset_le = htole64(_seekTable.at(i));
-		mmpldfstream.write((char*) &offset_le, sizeof(offset_le));
-	}
-	mmpldfstream.close();
-#ifdef ENABLE_MPI
-	}
-#endif
+	open_file(true);
+	write_at_all(0, fileHeader.data(), fileHeader.size(), MMPLD_HEADER_DATA_SIZE + get_seekTable_size());
+	close_file();
 }
 
 
 void MmpldWriter::write_frame(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp) {
-	string filename = getOutputFilename();
+	int rank = domainDecomp->getRank();
 
 	// calculate local number of spheres per component|siteType
 	std::vector<uint64_t> numSpheresPerType(_numSphereTypes);
 	this->CalcNumSpheresPerType(particleContainer, numSpheresPerType.data());
 
+	// global number of spheres, offsets of this process inside the particle lists and maximum number of spheres of
+	// a process, which determines the number of collective write calls
+	std::vector<uint64_t> globalNumCompSpheres(numSpheresPerType);
+	std::vector<uint64_t> exscanNumCompSpheres(_numSphereTypes, 0);
+	std::vector<uint64_t> maxNumCompSpheres(numSpheresPerType);
 #ifdef ENABLE_MPI
-	int rank = domainDecomp->getRank();
-
-	MPI_File_open(MPI_COMM_WORLD, const_cast<char*>(filename.c_str()), MPI_MODE_WRONLY|MPI_MODE_CREATE, _mpiinfo, &_mpifh);
-
-	//distribute global component particle count and offset counts for distrubted write
-	std::vector<uint64_t> globalNumCompSpheres(_numSphereTypes);
-	std::vector<uint64_t> exscanNumCompSpheres(_numSphereTypes);
 	MPI_Exscan(numSpheresPerType.data(), exscanNumCompSpheres.data(), _numSphereTypes, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
-	for(int i = 0; i < _numSphereTypes; ++i) {
-		globalNumCompSpheres[i] = exscanNumCompSpheres[i] + numSpheresPerType[i];
-	}
-	int lastrank = domainDecomp->getNumProcs() - 1;
-	MPI_Bcast(globalNumCompSpheres.data(), _numSphereTypes, MPI_UINT64_T, lastrank, MPI_COMM_WORLD);
-
 	if(rank == 0) {
-		MPI_File_seek(_mpifh, _seekTable.at(_frameCount), MPI_SEEK_SET);
-		write_frame_header(_numSphereTypes);
+		// the result of MPI_Exscan is undefined on rank 0
+		std::fill(exscanNumCompSpheres.begin(), exscanNumCompSpheres.end(), 0);
 	}
+	MPI_Allreduce(numSpheresPerType.data(), globalNumCompSpheres.data(), _numSphereTypes, MPI_UINT64_T, MPI_SUM, MPI_COMM_WORLD);
+	MPI_Allreduce(numSpheresPerType.data(), maxNumCompSpheres.data(), _numSphereTypes, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD);
+#endif
 
 	/* positions of data lists relative to frame begin */
 	std::vector<uint64_t> dataListBeginOffsets(_numSphereTypes);
@@ -255,53 +271,45 @@ void MmpldWriter::write_frame(ParticleContainer* particleContainer, DomainDecomp
 	for(int i = 1; i < _numSphereTypes; ++i) {
 		dataListBeginOffsets[i] = dataListBeginOffsets[i-1] + get_data_list_header_size() + get_data_list_size(globalNumCompSpheres[i-1]);
 	}
-	/* calculate write positions inside data lists for this process */
-	std::vector<uint64_t> dataListWriteOffsets(_numSphereTypes);
-	for(int i = 0; i < _numSphereTypes; ++i) {
-		dataListWriteOffsets[i] = get_data_list_header_size() + get_data_list_size(exscanNumCompSpheres[i]);
-	}
 
-	char* writeBuffer = new char[_writeBufferSize];
-	long buffer_pos = 0;
-	/* write particle list for each component|site (sphere type)`*/
+	open_file(false);
+	const uint64_t frameBegin = _seekTable.at(_frameCount);
+	const long particleDataSize = get_particle_data_size();
+	std::vector<char> buffer;
+	/* write particle list for each component|site (sphere type), every process writes its spheres as one block */
 	for (uint8_t sphereTypeId = 0; sphereTypeId < _numSphereTypes; ++sphereTypeId){
-		//write particle list header
+		buffer.clear();
+		uint64_t offset = frameBegin + dataListBeginOffsets[sphereTypeId] + get_data_list_header_size()
+				+ get_data_list_size(exscanNumCompSpheres[sphereTypeId]);
+		// rank 0 writes its spheres directly behind the particle list header, and the frame header in front of the first list
 		if(rank == 0) {
-			long offset = _seekTable.at(_frameCount) + dataListBeginOffsets[sphereTypeId];
-			MPI_File_seek(_mpifh, offset, MPI_SEEK_SET);
-			write_particle_list_header(globalNumCompSpheres[sphereTypeId], sphereTypeId);
+			if(sphereTypeId == 0) {
+				write_frame_header(buffer, _numSphereTypes);
+			}
+			write_particle_list_header(buffer, globalNumCompSpheres[sphereTypeId], sphereTypeId);
+			offset -= buffer.size();
 		}
-		long offset = _seekTable.at(_frameCount) + dataListBeginOffsets[sphereTypeId] + dataListWriteOffsets[sphereTypeId];
-		MPI_File_seek(_mpifh, offset, MPI_SEEK_SET);
-		buffer_pos = 0;
+		const size_t dataBegin = buffer.size();
+		buffer.resize(dataBegin + get_data_list_size(numSpheresPerType[sphereTypeId]));
+		char* spherePosBuffer = buffer.data() + dataBegin;
+		// GetSpherePos may also fill in spheres of other types, therefore they are copied to the buffer only if they match
+		std::array<float, 8> spherePos = {};
 		for (auto moleculeIter = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); moleculeIter.isValid(); ++moleculeIter) {
-			if(true == GetSpherePos(reinterpret_cast<float*>(&writeBuffer[buffer_pos]), &(*moleculeIter), sphereTypeId)) {
-				buffer_pos += get_particle_data_size();
-				if(buffer_pos > _writeBufferSize - get_particle_data_size()) {
-					MPI_Status status;
-					MPI_File_write(_mpifh, writeBuffer, buffer_pos, MPI_BYTE, &status);
-					buffer_pos = 0;
-				}
+			if(true == GetSpherePos(spherePos.data(), &(*moleculeIter), sphereTypeId)) {
+				std::memcpy(spherePosBuffer, spherePos.data(), particleDataSize);
+				spherePosBuffer += particleDataSize;
 			}
 		}
-		MPI_Status status;
-		MPI_File_write(_mpifh, writeBuffer, buffer_pos, MPI_BYTE, &status);
+		uint64_t maxSize = get_data_frame_header_size() + get_data_list_header_size() + get_data_list_size(maxNumCompSpheres[sphereTypeId]);
+		write_at_all(offset, buffer.data(), buffer.size(), maxSize);
 	}
-	delete[] writeBuffer;
 	// data of frame is written
 	_frameCount++;
 	uint64_t frame_offset = dataListBeginOffsets.back() + get_data_list_header_size() + get_data_list_size(globalNumCompSpheres.back());
 	_seekTable.at(_frameCount) = _seekTable.at(_frameCount - 1) + frame_offset;
 	// write seek table entry and update frame count
-	if (rank == 0) {
-		writeSeekTableEntry(_frameCount, _seekTable.at(_frameCount));
-		MPI_Status status;
-		uint32_t frameCount = htole32(_frameCount);
-		// 8: frame count position in file header
-		MPI_File_write_at(_mpifh, 8, &frameCount, sizeof(frameCount), MPI_BYTE, &status);
-	}
-	MPI_File_close(&_mpifh);
-#endif
+	writeSeekTableEntry(rank, _frameCount);
+	close_file();
 }
 
 void MmpldWriter::endStep(ParticleContainer *particleContainer,
@@ -322,30 +330,11 @@ void MmpldWriter::endStep(ParticleContainer *particleContainer,
 
 void MmpldWriter::finish(ParticleContainer * /*particleContainer*/, DomainDecompBase *domainDecomp, Domain * /*domain*/)
 {
-	string filename = getOutputFilename();
-
-#ifdef ENABLE_MPI
-	int rank = domainDecomp->getRank();
-	if (rank == 0){
-		MPI_File_open(MPI_COMM_WORLD, const_cast<char*>(filename.c_str()), MPI_MODE_WRONLY, MPI_INFO_NULL, &_mpifh);
-		MPI_File_seek(_mpifh, 0, MPI_SEEK_END);
-		MPI_Offset endPosition;
-		MPI_File_get_position(_mpifh, &endPosition);
-
-		uint64_t seektablePos = MMPLD_HEADER_DATA_SIZE + (_frameCount * sizeof(uint64_t));
-		uint64_t seekPosition = htole64(endPosition); /** @todo end of frame offset may not be identical to file end! */
-		MPI_Status status;
-		MPI_File_write_at(_mpifh, seektablePos, &seekPosition, sizeof(seekPosition), MPI_BYTE, &status);
-		uint32_t frameCount = htole32(_frameCount);  // set final number of frames
-		// 8: frame count position in file header
-		MPI_File_write_at(_mpifh, 8, &frameCount, sizeof(frameCount), MPI_BYTE, &status);
-		MPI_File_close(&_mpifh);
-	}else{
-		MPI_File_open(MPI_COMM_WORLD, const_cast<char*>(filename.c_str()), MPI_MODE_WRONLY, MPI_INFO_NULL, &_mpifh);
-		MPI_File_close(&_mpifh);
-	}
+	// set final number of frames, the end of the last frame is already in the seek table
+	open_file(false);
+	writeSeekTableEntry(domainDecomp->getRank(), _frameCount);
+	close_file();
 	_seekTable.clear();
-#endif
 }
 
 void MmpldWriter::InitSphereData()
@@ -481,50 +470,84 @@ long MmpldWriter::get_data_list_size(uint64_t particle_count) {
 }
 
 
-void MmpldWriter::write_frame_header(uint32_t num_data_lists) {
-#ifdef ENABLE_MPI
-	MPI_Status status;
+void MmpldWriter::write_frame_header(std::vector<char>& buffer, uint32_t num_data_lists) {
 	if (_mmpldversion == 102){
 		float frameHeader_timestamp = _simulation.getSimulationTime();
-		MPI_File_write(_mpifh, &frameHeader_timestamp, 1, MPI_FLOAT, &status);
+		append(buffer, &frameHeader_timestamp, sizeof(frameHeader_timestamp));
 	}
 	uint32_t num_data_lists_le = htole32(num_data_lists);
-	MPI_File_write(_mpifh, &num_data_lists_le, sizeof(num_data_lists_le), MPI_BYTE, &status);
-#else
-	/** @todo need to implement serial version */
-#endif
+	append(buffer, &num_data_lists_le, sizeof(num_data_lists_le));
 }
 
 long MmpldWriter::get_seekTable_size(){
 	return _numSeekEntries * sizeof(uint64_t);
 }
 
-void MmpldWriter::writeSeekTableEntry(int id, uint64_t offset) {
-#ifdef ENABLE_MPI
-	MPI_Offset seekpos = MMPLD_SEEK_TABLE_OFFSET + id*sizeof(uint64_t);
-	uint64_t offset_le = htole64(offset);
-	MPI_Status status;
-	MPI_File_write_at(_mpifh, seekpos, &offset_le, 8, MPI_BYTE, &status);
-#endif
+void MmpldWriter::writeSeekTableEntry(int rank, uint32_t frameCount) {
+	uint64_t offset_le = htole64(_seekTable.at(frameCount));
+	uint32_t frameCount_le = htole32(frameCount);
+	const uint64_t size = (rank == 0) ? sizeof(offset_le) : 0;
+	write_at_all(MMPLD_SEEK_TABLE_OFFSET + frameCount * sizeof(uint64_t), reinterpret_cast<char*>(&offset_le), size, sizeof(offset_le));
+	// 8: frame count position in file header
+	write_at_all(8, reinterpret_cast<char*>(&frameCount_le), (rank == 0) ? sizeof(frameCount_le) : 0, sizeof(frameCount_le));
 }
 
-void MmpldWriter::write_particle_list_header(uint64_t particle_count, int sphereId) {
-#ifdef ENABLE_MPI
-	MPI_Status status;
-	MPI_File_write(_mpifh, &_vertex_type,  1, MPI_BYTE, &status);
-	MPI_File_write(_mpifh, &_color_type,   1, MPI_BYTE, &status);
+void MmpldWriter::write_particle_list_header(std::vector<char>& buffer, uint64_t particle_count, int sphereId) {
+	append(buffer, &_vertex_type, 1);
+	append(buffer, &_color_type, 1);
 	if(_vertex_type == MMPLD_VERTEX_FLOAT_XYZ || _vertex_type == MMPLD_VERTEX_SHORT_XYZ) {
-		MPI_File_write(_mpifh, &_global_radius[sphereId], 4, MPI_BYTE, &status);
+		append(buffer, &_global_radius[sphereId], 4);
 	}
 	if(_color_type == MMPLD_COLOR_NONE) {
-		MPI_File_write(_mpifh, &_global_rgba[sphereId],   4, MPI_BYTE, &status);
+		append(buffer, &_global_rgba[sphereId], 4);
 	} else if(_color_type == MMPLD_COLOR_FLOAT_I) {
-		MPI_File_write(_mpifh, &_global_intensity_range[sphereId],   8, MPI_BYTE, &status);
+		append(buffer, &_global_intensity_range[sphereId], 8);
 	}
 	uint64_t particle_count_le = htole64(particle_count);
-	MPI_File_write(_mpifh, &particle_count_le, sizeof(particle_count_le), MPI_BYTE, &status);
+	append(buffer, &particle_count_le, sizeof(particle_count_le));
+}
+
+void MmpldWriter::open_file(bool truncate) {
+	string filename = getOutputFilename();
+#ifdef ENABLE_MPI
+	MPI_CHECK(MPI_File_open(MPI_COMM_WORLD, const_cast<char*>(filename.c_str()), MPI_MODE_WRONLY|MPI_MODE_CREATE, _mpiinfo, &_mpifh));
+	if(truncate) {
+		MPI_CHECK(MPI_File_set_size(_mpifh, 0));
+	}
+#else
+	ios::openmode mode = ios::binary|ios::out;
+	if(!truncate) {
+		mode |= ios::in;  // keep the content of the file
+	}
+	_mmpldfstream.open(filename.c_str(), mode);
+	if(!_mmpldfstream) {
+		global_log->error() << "[MMPLD Writer] Could not open file " << filename << endl;
+		Simulation::exit(1);
+	}
+#endif
+}
+
+void MmpldWriter::close_file() {
+#ifdef ENABLE_MPI
+	MPI_CHECK(MPI_File_close(&_mpifh));
+#else
+	_mmpldfstream.close();
+#endif
+}
+
+void MmpldWriter::write_at_all(uint64_t offset, const char* data, uint64_t size, uint64_t maxSize) {
+#ifdef ENABLE_MPI
+	// MPI counts are ints, so large blocks are written in several parts, with the same number of calls on all processes
+	const uint64_t maxPartSize = INT_MAX / 2 + 1;
+	const uint64_t numParts = std::max<uint64_t>(1, (maxSize + maxPartSize - 1) / maxPartSize);
+	for(uint64_t part = 0; part < numParts; ++part) {
+		const uint64_t written = std::min(part * maxPartSize, size);
+		const int partSize = std::min(maxPartSize, size - written);
+		MPI_CHECK(MPI_File_write_at_all(_mpifh, offset + written, const_cast<char*>(data + written), partSize, MPI_BYTE, MPI_STATUS_IGNORE));
+	}
 #else
-	/** @todo need to implement serial version */
+	_mmpldfstream.seekp(offset);
+	_mmpldfstream.write(data, size);
 #endif
 }
 
@@ -568,7 +591,7 @@ bool MmpldWriterMultiSphere::GetSpherePos(float *spherePos, Molecule* mol, uint8
 	{
 		if(offset+si == nSphereTypeIndex)
 		{
-			const std::array<double,3> arrSite = mol->ljcenter_d_abs(si);
+			const std::array<double,3> arrSite = mol->site_d_abs(si);
 			const double* posSite = arrSite.data();
 			for (unsigned short d = 0; d < 3; ++d) spherePos[d] = (float)posSite[d];
 			ret = true;
@@ -4,6 +4,9 @@
 #include <string>
 #include <vector>
 #include <array>
+#ifndef ENABLE_MPI
+#include <fstream>
+#endif
 
 #include "plugins/PluginBase.h"
 #include "molecules/MoleculeForwardDeclaration.h"
@@ -36,6 +39,15 @@ enum MMPLD_Color_type : uint8_t {
 };
 
 /** @brief Output plugin to generate a MegaMol™ Particle List Data file (*.mmpld).
+ *
+ * Each frame contains one particle list per sphere type, i.e. per component (type="simple") or per site of each
+ * component (type="multi"). In the multi representation only the LJ centers are taken into account by default, with
+ * <sites>all</sites> also the charges, dipoles and quadrupoles, in this order, each one sphere type with its own
+ * parameters in the spheres section.
+ *
+ * With MPI, every process computes the position of its spheres within the particle lists by a prefix sum and writes
+ * them directly with collective MPI-IO calls, the headers and the seek table are written by rank 0 as part of the same
+ * collective calls.
  */
 class MmpldWriter : public PluginBase
 {
@@ -91,13 +103,18 @@ protected:
 	void PrepareWriteControl();
 	long get_data_frame_header_size();
 	long get_seekTable_size();
-	void writeSeekTableEntry(int id, uint64_t offset);
+	//! updates the seek table entry of the end of the given frame and the number of frames in the file header
+	void writeSeekTableEntry(int rank, uint32_t frameCount);
 	long get_data_list_header_size();
 	long get_particle_data_size();
 	long get_data_list_size(uint64_t particle_count);
-	void write_frame_header(uint32_t num_data_lists);
-	void write_particle_list_header(uint64_t particle_count, int sphereId);
+	void write_frame_header(std::vector<char>& buffer, uint32_t num_data_lists);
+	void write_particle_list_header(std::vector<char>& buffer, uint64_t particle_count, int sphereId);
 	void write_frame(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp);
+	void open_file(bool truncate);
+	void close_file();
+	//! collective write of size bytes at offset, maxSize has to be at least the size of every process
+	void write_at_all(uint64_t offset, const char* data, uint64_t size, uint64_t maxSize);
 
 protected:
 	/** First time step to be recorded */
@@ -106,7 +123,6 @@ protected:
 	uint64_t _writeFrequency;
 	/** Max time step up to which shall be recorded */
 	uint64_t _stopTimestep;
-	long _writeBufferSize;
 	std::string _outputPrefix;
 	std::string _timestampString;
 	uint32_t _frameCount;
@@ -130,11 +146,15 @@ protected:
 	std::vector<float> _global_radius;
 	std::vector< std::array<uint8_t, 4> > _global_rgba;
 	std::vector< std::array<float, 2> > _global_intensity_range;
+	/** take all sites into account in the multi sphere representation, not only the LJ centers */
+	bool _allSites;
 
 
 #ifdef ENABLE_MPI
 	MPI_File _mpifh;
 	MPI_Info_object _mpiinfo;
+#else
+	std::fstream _mmpldfstream;
 #endif
 };
 
@@ -76,12 +76,34 @@ void ODF::init(ParticleContainer* particleContainer, DomainDecompBase* /*domainD
 	}
 
 	reset();
+
+	// the cell processor of the simulation passes the pairs within its own cutoff only
+	CellProcessor* cellProcessor = global_simulation->getCellProcessor();
+	_observingForces = cellProcessor != nullptr &&
+					   cellProcessor->getCutoffRadiusSquare() == _cellProcessor->getCutoffRadiusSquare() &&
+					   cellProcessor->addPairObserver(_cellProcessor.get());
+	if (_observingForces) {
+		global_log->info() << "[ODF] Calculating the orientations during the force calculation" << endl;
+	}
+}
+
+void ODF::beforeForces(ParticleContainer* /*particleContainer*/, DomainDecompBase* /*domainDecomp*/,
+					   unsigned long simstep) {
+	_cellProcessor->setObserving(_observingForces && simstep > _initStatistics && simstep % _recordingTimesteps == 0);
 }
 
 void ODF::afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep) {
-	if (simstep > _initStatistics && simstep % _recordingTimesteps == 0) {
+	if (simstep > _initStatistics && simstep % _recordingTimesteps == 0 && !_cellProcessor->hasObservedTraversal()) {
 		particleContainer->traverseCells(*_cellProcessor);
 	}
+	_cellProcessor->setObserving(false);
+}
+
+void ODF::finish(ParticleContainer* /*particleContainer*/, DomainDecompBase* /*domainDecomp*/, Domain* /*domain*/) {
+	if (_observingForces) {
+		global_simulation->getCellProcessor()->removePairObserver(_cellProcessor.get());
+		_observingForces = false;
+	}
 }
 
 void ODF::endStep(ParticleContainer* /*particleContainer*/, DomainDecompBase* domainDecomp, Domain* domain,
@@ -28,6 +28,8 @@ class ODF : public PluginBase {
 public:
 	void init(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override;
 	void readXML(XMLfileUnits& xmlconfig) override;
+	void beforeForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+					  unsigned long simstep) override;
 	void afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
 					 unsigned long simstep) override;
 	void endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain,
@@ -39,7 +41,7 @@ public:
                               const Molecule &mol2,
                               const array<double, 3> &orientationVector1);
 	void output(Domain* domain, long unsigned timestep);
-	void finish(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override{};
+	void finish(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override;
 	std::string getPluginName() override { return std::string("ODF"); }
 	static PluginBase* createInstance() { return new ODF(); }
 
@@ -69,4 +71,6 @@ private:
 	std::vector<std::vector<unsigned long>> _threadLocalODF22;
 
 	std::unique_ptr<ODFCellProcessor> _cellProcessor;
+	// the orientations are calculated during the force calculation, see PairObserver
+	bool _observingForces = false;
 };
@@ -29,7 +29,8 @@ RDF::RDF() :
 	_outputPrefix("ls1-mardyn"),
 	_initialized(false),
 	_readConfig(false),
-	_cellProcessor(nullptr)
+	_cellProcessor(nullptr),
+	_observingForces(false)
 {}
 
 void RDF::init() {
@@ -180,9 +181,19 @@ void RDF::readXML(XMLfileUnits& xmlconfig) {
 
 void RDF::init(ParticleContainer * /*particleContainer*/, DomainDecompBase * /*domainDecomp*/, Domain * /*domain*/) {
 	init();
+
+	CellProcessor* cellProcessor = global_simulation->getCellProcessor();
+	_observingForces = cellProcessor != nullptr and cellProcessor->addPairObserver(_cellProcessor);
+	if (_observingForces) {
+		global_log->info() << "RDF: sampling the molecule pairs during the force calculation" << endl;
+	}
 }
 
 void RDF::finish(ParticleContainer * /*particleContainer*/, DomainDecompBase * /*domainDecomp*/, Domain * /*domain*/) {
+	if (_observingForces) {
+		global_simulation->getCellProcessor()->removePairObserver(_cellProcessor);
+		_observingForces = false;
+	}
 }
 
 
@@ -570,12 +581,22 @@ void RDF::writeToFile(const Domain* domain, const std::string& filename, unsigne
 	rdfout.close();
 }
 
+void RDF::beforeForces(ParticleContainer* /*particleContainer*/,
+		DomainDecompBase* /*domainDecomp*/, unsigned long simstep) {
+	const bool samplingStep = simstep % _samplingFrequency == 0 && simstep > global_simulation->getInitStatistics();
+	_cellProcessor->setObserving(_observingForces and samplingStep);
+}
+
 void RDF::afterForces(ParticleContainer* particleContainer,
 		DomainDecompBase* domainDecomp, unsigned long simstep) {
 	if (simstep % _samplingFrequency == 0 && simstep > global_simulation->getInitStatistics()) {
 		global_log->debug() << "Activating the RDF sampling" << endl;
 		tickRDF();
 		accumulateNumberOfMolecules(*(global_simulation->getEnsemble()->getComponents()));
-		particleContainer->traverseCells(*_cellProcessor);
+		// the pairs have not been observed, if e.g. the container does not use the cell processor of the simulation.
+		if (not _cellProcessor->hasObservedTraversal()) {
+			particleContainer->traverseCells(*_cellProcessor);
+		}
 	}
+	_cellProcessor->setObserving(false);
 }
@@ -57,6 +57,11 @@ public:
 	 */
 	void readXML(XMLfileUnits& xmlconfig);
 
+	/** @brief In sampling steps, the pairs are observed during the force calculation, if the cell processor of the
+	 * simulation supports it (see PairObserver). Otherwise, they are traversed once more in afterForces().
+	 */
+	void beforeForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep);
+
 	void afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, unsigned long simstep);
 
 	void init(ParticleContainer *particleContainer, DomainDecompBase *domainDecomp, Domain *domain);
@@ -273,6 +278,8 @@ private:
 	bool _readConfig;
 
 	RDFCellProcessor * _cellProcessor;
+	//! the cell processor is registered as observer at the cell processor of the simulation
+	bool _observingForces;
 };
 
 #endif /* RDF_H */
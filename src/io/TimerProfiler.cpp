@@ -177,6 +177,8 @@ void TimerProfiler::readInitialTimersFromFile(string fileName){
 	**************************************************************/
 	vector<tuple<string, vector<string>, bool>> timerAttrs = {
 		make_tuple("VECTORIZATION_TUNER_TUNER", vector<string>{"TUNERS"}, true),
+		make_tuple("TRAVERSAL_TUNER_SAMPLE", vector<string>{"TUNERS"}, true),
+		make_tuple("CELL_SIZE_TUNER_SAMPLE", vector<string>{"TUNERS"}, true),
 		make_tuple("AQUEOUS_NA_CL_GENERATOR_INPUT", vector<string>{"GENERATORS"}, true),
 		make_tuple("CRYSTAL_LATTICE_GENERATOR_INPUT", vector<string>{"GENERATORS"}, true),
 		make_tuple("CUBIC_GRID_GENERATOR_INPUT", vector<string>{"GENERATORS"}, true),
@@ -204,6 +206,8 @@ void TimerProfiler::readInitialTimersFromFile(string fileName){
 		make_tuple("SIMULATION_MPI_OMP_COMMUNICATION", vector<string>{"SIMULATION_DECOMPOSITION"}, true),
 		make_tuple("SIMULATION_UPDATE_CACHES", vector<string>{"SIMULATION_DECOMPOSITION"}, true),
 		make_tuple("SIMULATION_FORCE_CALCULATION", vector<string>{"SIMULATION_COMPUTATION"}, true),
+		make_tuple("SMOOTH_PARTICLE_MESH_EWALD_REAL_SPACE", vector<string>{"SIMULATION_FORCE_CALCULATION"}, true),
+		make_tuple("SMOOTH_PARTICLE_MESH_EWALD_RECIPROCAL_SPACE", vector<string>{"SIMULATION_FORCE_CALCULATION"}, true),
 		make_tuple("COMMUNICATION_PARTNER_INIT_SEND", vector<string>{"COMMUNICATION_PARTNER", "SIMULATION_MPI_OMP_COMMUNICATION"}, true),
 		make_tuple("COMMUNICATION_PARTNER_TEST_RECV", vector<string>{"COMMUNICATION_PARTNER", "SIMULATION_MPI_OMP_COMMUNICATION"}, true),
 		make_tuple("UNIFORM_PSEUDO_PARTICLE_CONTAINER_PROCESS_CELLS", vector<string>{"UNIFORM_PSEUDO_PARTICLE_CONTAINER"}, true),
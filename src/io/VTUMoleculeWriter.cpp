@@ -0,0 +1,416 @@
+#include "io/VTUMoleculeWriter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <fstream>
+#include <sstream>
+
+#ifdef ENABLE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "Simulation.h"
+#include "WrapOpenMP.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "utils/Logger.h"
+#include "utils/xmlfileUnits.h"
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+
+using Log::global_log;
+
+namespace {
+
+//! center types of the VTKMoleculeWriterImplementation
+enum CenterType : uint8_t { ChargeCenter = 1, LJCenter = 2, DipoleCenter = 3, QuadrupoleCenter = 4 };
+
+template <typename T>
+void append(std::vector<T>& target, const std::vector<T>& source) {
+	target.insert(target.end(), source.begin(), source.end());
+}
+
+template <typename T>
+const char* bytes(const std::vector<T>& values) {
+	return reinterpret_cast<const char*>(values.data());
+}
+
+} /* namespace */
+
+VTUMoleculeWriter::VTUMoleculeWriter() :
+		VTUMoleculeWriter(50, "", "none", false, false) {
+}
+
+VTUMoleculeWriter::VTUMoleculeWriter(unsigned long writeFrequency, const std::string& outputPrefix,
+		const std::string& compression, bool plotCenters, bool singleFile) :
+		_writeFrequency(writeFrequency), _outputPrefix(outputPrefix), _compression(compression),
+		_plotCenters(plotCenters), _singleFile(singleFile), _compressionFailed(false) {
+}
+
+void VTUMoleculeWriter::readXML(XMLfileUnits& xmlconfig) {
+	xmlconfig.getNodeValue("writefrequency", _writeFrequency);
+	global_log->info() << "VTUMoleculeWriter: Write frequency: " << _writeFrequency << std::endl;
+	if (_writeFrequency == 0) {
+		global_log->error() << "VTUMoleculeWriter: writefrequency must be > 0!" << std::endl;
+		Simulation::exit(1);
+	}
+	xmlconfig.getNodeValue("outputprefix", _outputPrefix);
+	global_log->info() << "VTUMoleculeWriter: Output prefix: " << _outputPrefix << std::endl;
+
+	xmlconfig.getNodeValue("compression", _compression);
+	std::transform(_compression.begin(), _compression.end(), _compression.begin(), ::tolower);
+	if (_compression != "none" and _compression != "zlib") {
+		global_log->error() << "VTUMoleculeWriter: unknown compression " << _compression << ", use none or zlib."
+				<< std::endl;
+		Simulation::exit(1);
+	}
+#ifndef ENABLE_ZLIB
+	if (_compression == "zlib") {
+		global_log->error() << "VTUMoleculeWriter: zlib compression requires compiling with ENABLE_ZLIB." << std::endl;
+		Simulation::exit(1);
+	}
+#endif
+	global_log->info() << "VTUMoleculeWriter: Compression: " << _compression << std::endl;
+
+	xmlconfig.getNodeValue("plotCenters", _plotCenters);
+	global_log->info() << "VTUMoleculeWriter: Plot centers: " << _plotCenters << std::endl;
+	xmlconfig.getNodeValue("singleFile", _singleFile);
+	global_log->info() << "VTUMoleculeWriter: Single file: " << _singleFile << std::endl;
+}
+
+//! NOP
+void VTUMoleculeWriter::init(ParticleContainer* /*particleContainer*/, DomainDecompBase* /*domainDecomp*/,
+		Domain* /*domain*/) {}
+
+void VTUMoleculeWriter::endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
+		Domain* /*domain*/, unsigned long simstep) {
+	if (simstep % _writeFrequency != 0) {
+		return;
+	}
+
+	const int rank = domainDecomp->getRank();
+	uint64_t numPoints = 0;
+	_compressionFailed = false;
+	std::vector<DataArray> arrays = collectDataArrays(particleContainer, rank, numPoints);
+#ifdef ENABLE_MPI
+	if (_singleFile) {
+		// all pieces of the shared file have to use the compression of its header
+		int compressionFailed = _compressionFailed;
+		MPI_CHECK(MPI_Allreduce(MPI_IN_PLACE, &compressionFailed, 1, MPI_INT, MPI_LOR,
+				domainDecomp->getCommunicator()));
+		_compressionFailed = compressionFailed;
+	}
+#endif
+	if (_compressionFailed) {
+		global_log->error() << "VTUMoleculeWriter: zlib compression failed, writing uncompressed from step " << simstep
+				<< " on." << std::endl;
+		_compression = "none";
+		arrays = collectDataArrays(particleContainer, rank, numPoints);
+	}
+
+	std::stringstream fileNameStream;
+	fileNameStream << _outputPrefix;
+#ifdef ENABLE_MPI
+	if (_singleFile) {
+		fileNameStream << "_" << simstep << ".vtu";
+		writeSingleFile(fileNameStream.str(), arrays, numPoints, domainDecomp);
+		return;
+	}
+	fileNameStream << "_node" << rank;
+	if (rank == 0) {
+		writeParallelVTKFile(arrays, domainDecomp->getNumProcs(), simstep);
+	}
+#endif
+	fileNameStream << "_" << simstep << ".vtu";
+
+	std::vector<uint64_t> arraySizes;
+	for (const DataArray& array : arrays) {
+		arraySizes.push_back(array.encoded.size());
+	}
+	const std::string header = getHeader(arrays, {numPoints}, arraySizes);
+	const std::vector<char> emptyArray = encode(nullptr, 0);
+	const std::string footer = getFooter();
+
+	std::ofstream file(fileNameStream.str().c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+	file.write(header.data(), header.size());
+	for (const DataArray& array : arrays) {
+		file.write(array.encoded.data(), array.encoded.size());
+	}
+	file.write(emptyArray.data(), emptyArray.size());
+	file.write(footer.data(), footer.size());
+	file.close();
+	if (file.fail()) {
+		global_log->error() << "VTUMoleculeWriter: could not write " << fileNameStream.str() << std::endl;
+		Simulation::exit(1);
+	}
+}
+
+std::vector<VTUMoleculeWriter::DataArray> VTUMoleculeWriter::collectDataArrays(ParticleContainer* particleContainer,
+		int rank, uint64_t& numPoints) {
+	struct PointValues {
+		std::vector<uint64_t> ids;
+		std::vector<int32_t> componentIds;
+		std::vector<float> forces;
+		std::vector<int32_t> centerIds;
+		std::vector<uint8_t> centerTypes;
+		std::vector<float> points;
+	};
+	std::vector<PointValues> threadValues(mardyn_get_max_threads());
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		PointValues& values = threadValues[mardyn_get_thread_num()];
+		auto addPoint = [&values](const Molecule& molecule, const std::array<double, 3>& position,
+				const std::array<double, 3>& force) {
+			values.ids.push_back(molecule.getID());
+			values.componentIds.push_back(molecule.componentid());
+			for (int d = 0; d < 3; ++d) {
+				values.forces.push_back(force[d]);
+				values.points.push_back(position[d]);
+			}
+		};
+		for (auto molecule = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY);
+				molecule.isValid(); ++molecule) {
+			if (not _plotCenters) {
+				addPoint(*molecule, {molecule->r(0), molecule->r(1), molecule->r(2)},
+						{molecule->F(0), molecule->F(1), molecule->F(2)});
+				continue;
+			}
+			// the sites are ordered by type: LJ centers, charges, dipoles, quadrupoles
+			const size_t numCenters[4] = {molecule->numLJcenters(), molecule->numCharges(), molecule->numDipoles(),
+					molecule->numQuadrupoles()};
+			const CenterType centerTypes[4] = {LJCenter, ChargeCenter, DipoleCenter, QuadrupoleCenter};
+			int centerId = 0;
+			for (int type = 0; type < 4; ++type) {
+				for (size_t i = 0; i < numCenters[type]; ++i, ++centerId) {
+					addPoint(*molecule, molecule->site_d_abs(centerId), molecule->site_F(centerId));
+					values.centerIds.push_back(centerId);
+					values.centerTypes.push_back(centerTypes[type]);
+				}
+			}
+		}
+	}
+
+	PointValues all;
+	for (const PointValues& values : threadValues) {
+		append(all.ids, values.ids);
+		append(all.componentIds, values.componentIds);
+		append(all.forces, values.forces);
+		append(all.centerIds, values.centerIds);
+		append(all.centerTypes, values.centerTypes);
+		append(all.points, values.points);
+	}
+	threadValues.clear();
+	numPoints = all.ids.size();
+	const std::vector<int32_t> nodeRanks(numPoints, rank);
+
+	std::vector<DataArray> arrays;
+	arrays.push_back({"id", "UInt64", 1, encode(bytes(all.ids), numPoints * sizeof(uint64_t))});
+	arrays.push_back({"component-id", "Int32", 1, encode(bytes(all.componentIds), numPoints * sizeof(int32_t))});
+	arrays.push_back({"node-rank", "Int32", 1, encode(bytes(nodeRanks), numPoints * sizeof(int32_t))});
+	arrays.push_back({"forces", "Float32", 3, encode(bytes(all.forces), 3 * numPoints * sizeof(float))});
+	if (_plotCenters) {
+		arrays.push_back({"center-id", "Int32", 1, encode(bytes(all.centerIds), numPoints * sizeof(int32_t))});
+		arrays.push_back({"center-type", "UInt8", 1, encode(bytes(all.centerTypes), numPoints * sizeof(uint8_t))});
+	}
+	arrays.push_back({"points", "Float32", 3, encode(bytes(all.points), 3 * numPoints * sizeof(float))});
+	return arrays;
+}
+
+std::vector<char> VTUMoleculeWriter::encode(const char* data, uint64_t numBytes) const {
+	std::vector<char> encoded;
+	if (_compression == "none") {
+		encoded.resize(sizeof(uint64_t) + numBytes);
+		std::copy(reinterpret_cast<const char*>(&numBytes), reinterpret_cast<const char*>(&numBytes + 1),
+				encoded.begin());
+		std::copy(data, data + numBytes, encoded.begin() + sizeof(uint64_t));
+		return encoded;
+	}
+#ifdef ENABLE_ZLIB
+	// header: number of blocks, block size, size of the last block if it is partial, compressed sizes of the blocks
+	const long numBlocks = (numBytes + blockSize - 1) / blockSize;
+	std::vector<uint64_t> header(3 + numBlocks);
+	header[0] = numBlocks;
+	header[1] = blockSize;
+	header[2] = numBytes % blockSize;
+	std::vector<std::vector<char>> blocks(numBlocks);
+	int status = Z_OK;
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(dynamic)
+	#endif
+	for (long block = 0; block < numBlocks; ++block) {
+		const uLong uncompressedSize = std::min(blockSize, numBytes - block * blockSize);
+		uLongf compressedSize = compressBound(uncompressedSize);
+		blocks[block].resize(compressedSize);
+		const int blockStatus = compress2(reinterpret_cast<Bytef*>(blocks[block].data()), &compressedSize,
+				reinterpret_cast<const Bytef*>(data + block * blockSize), uncompressedSize, Z_DEFAULT_COMPRESSION);
+		if (blockStatus != Z_OK) {
+			#if defined(_OPENMP)
+			#pragma omp atomic write
+			#endif
+			status = blockStatus;
+		}
+		blocks[block].resize(compressedSize);
+		header[3 + block] = compressedSize;
+	}
+	if (status != Z_OK) {
+		global_log->error() << "VTUMoleculeWriter: compress2 failed with zlib error " << status << std::endl;
+		_compressionFailed = true;
+		return encoded;
+	}
+	encoded.assign(bytes(header), bytes(header) + header.size() * sizeof(uint64_t));
+	for (const std::vector<char>& block : blocks) {
+		append(encoded, block);
+	}
+#endif
+	return encoded;
+}
+
+std::string VTUMoleculeWriter::getHeader(const std::vector<DataArray>& arrays, const std::vector<uint64_t>& numPoints,
+		const std::vector<uint64_t>& arraySizes) const {
+	const uint16_t one = 1;
+	const bool littleEndian = *reinterpret_cast<const char*>(&one) == 1;
+	const uint64_t emptyArraySize = encode(nullptr, 0).size();
+
+	std::stringstream header;
+	header << "<?xml version=\"1.0\"?>\n";
+	header << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\""
+			<< (littleEndian ? "LittleEndian" : "BigEndian") << "\" header_type=\"UInt64\"";
+	if (_compression == "zlib") {
+		header << " compressor=\"vtkZLibDataCompressor\"";
+	}
+	header << ">\n  <UnstructuredGrid>\n";
+
+	uint64_t offset = 0;
+	auto dataArray = [&header, &offset](const std::string& name, const std::string& type, int numComponents,
+			uint64_t size) {
+		header << "        <DataArray type=\"" << type << "\" Name=\"" << name << "\" NumberOfComponents=\""
+				<< numComponents << "\" format=\"appended\" offset=\"" << offset << "\"/>\n";
+		offset += size;
+	};
+	for (size_t piece = 0; piece < numPoints.size(); ++piece) {
+		const uint64_t* sizes = arraySizes.data() + piece * arrays.size();
+		header << "    <Piece NumberOfPoints=\"" << numPoints[piece] << "\" NumberOfCells=\"0\">\n";
+		header << "      <PointData>\n";
+		for (size_t i = 0; i < arrays.size() - 1; ++i) {
+			dataArray(arrays[i].name, arrays[i].type, arrays[i].numComponents, sizes[i]);
+		}
+		header << "      </PointData>\n      <Points>\n";
+		dataArray(arrays.back().name, arrays.back().type, arrays.back().numComponents, sizes[arrays.size() - 1]);
+		// there are no cells, all cell arrays refer to the same empty array
+		header << "      </Points>\n      <Cells>\n";
+		dataArray("connectivity", "Int64", 1, 0);
+		dataArray("offsets", "Int64", 1, 0);
+		dataArray("types", "UInt8", 1, emptyArraySize);
+		header << "      </Cells>\n    </Piece>\n";
+	}
+	header << "  </UnstructuredGrid>\n  <AppendedData encoding=\"raw\">\n   _";
+	return header.str();
+}
+
+std::string VTUMoleculeWriter::getFooter() {
+	return "\n  </AppendedData>\n</VTKFile>\n";
+}
+
+void VTUMoleculeWriter::writeParallelVTKFile(const std::vector<DataArray>& arrays, int numProcs,
+		unsigned long simstep) const {
+	// the pieces are referenced relative to the .pvtu file
+	std::string baseName = _outputPrefix;
+	const size_t pos = _outputPrefix.find_last_of("/");
+	if (pos != std::string::npos) {
+		baseName = _outputPrefix.substr(pos + 1);
+	}
+
+	std::stringstream fileNameStream;
+	fileNameStream << _outputPrefix << "_" << simstep << ".pvtu";
+	std::ofstream file(fileNameStream.str().c_str());
+	file << "<?xml version=\"1.0\"?>\n";
+	file << "<VTKFile type=\"PUnstructuredGrid\" version=\"1.0\">\n  <PUnstructuredGrid GhostLevel=\"0\">\n";
+	file << "    <PPointData>\n";
+	for (size_t i = 0; i < arrays.size() - 1; ++i) {
+		file << "      <PDataArray type=\"" << arrays[i].type << "\" Name=\"" << arrays[i].name
+				<< "\" NumberOfComponents=\"" << arrays[i].numComponents << "\"/>\n";
+	}
+	file << "    </PPointData>\n    <PPoints>\n";
+	file << "      <PDataArray type=\"" << arrays.back().type << "\" Name=\"" << arrays.back().name
+			<< "\" NumberOfComponents=\"" << arrays.back().numComponents << "\"/>\n";
+	file << "    </PPoints>\n";
+	for (int rank = 0; rank < numProcs; ++rank) {
+		file << "    <Piece Source=\"" << baseName << "_node" << rank << "_" << simstep << ".vtu\"/>\n";
+	}
+	file << "  </PUnstructuredGrid>\n</VTKFile>\n";
+}
+
+void VTUMoleculeWriter::writeSingleFile(const std::string& fileName, const std::vector<DataArray>& arrays,
+		uint64_t numPoints, DomainDecompBase* domainDecomp) const {
+#ifdef ENABLE_MPI
+	const int rank = domainDecomp->getRank();
+	const int numProcs = domainDecomp->getNumProcs();
+	const MPI_Comm comm = domainDecomp->getCommunicator();
+
+	// every rank needs the number of points and sizes of the arrays of all pieces to build the header
+	const size_t numValues = 1 + arrays.size();
+	std::vector<uint64_t> localValues{numPoints};
+	for (const DataArray& array : arrays) {
+		localValues.push_back(array.encoded.size());
+	}
+	std::vector<uint64_t> allValues(numProcs * numValues);
+	MPI_CHECK(MPI_Allgather(localValues.data(), numValues, MPI_UINT64_T, allValues.data(), numValues, MPI_UINT64_T,
+			comm));
+
+	std::vector<uint64_t> pieceNumPoints(numProcs);
+	std::vector<uint64_t> arraySizes;
+	const std::vector<char> emptyArray = encode(nullptr, 0);
+	uint64_t offset = 0;
+	uint64_t totalSize = 0;
+	for (int piece = 0; piece < numProcs; ++piece) {
+		pieceNumPoints[piece] = allValues[piece * numValues];
+		uint64_t pieceSize = emptyArray.size();
+		for (size_t i = 1; i < numValues; ++i) {
+			arraySizes.push_back(allValues[piece * numValues + i]);
+			pieceSize += allValues[piece * numValues + i];
+		}
+		if (piece == rank) {
+			offset = totalSize;
+		}
+		totalSize += pieceSize;
+	}
+	const std::string header = getHeader(arrays, pieceNumPoints, arraySizes);
+	const std::string footer = getFooter();
+	offset += header.size();
+	totalSize += header.size() + footer.size();
+
+	MPI_File fileHandle;
+	MPI_CHECK(MPI_File_open(comm, const_cast<char*>(fileName.c_str()), MPI_MODE_WRONLY | MPI_MODE_CREATE,
+			MPI_INFO_NULL, &fileHandle));
+	MPI_CHECK(MPI_File_set_size(fileHandle, totalSize));
+	// MPI counts are ints, so large arrays are written in several parts
+	auto write = [&fileHandle, &offset](const char* data, uint64_t size) {
+		const uint64_t maxPartSize = INT_MAX / 2 + 1;
+		for (uint64_t written = 0; written < size; written += maxPartSize) {
+			const int partSize = std::min(maxPartSize, size - written);
+			MPI_Status status;
+			MPI_CHECK(MPI_File_write_at(fileHandle, offset + written, const_cast<char*>(data + written), partSize,
+					MPI_BYTE, &status));
+		}
+		offset += size;
+	};
+	if (rank == 0) {
+		MPI_CHECK(MPI_File_write_at(fileHandle, 0, const_cast<char*>(header.data()), header.size(), MPI_BYTE,
+				MPI_STATUS_IGNORE));
+		MPI_CHECK(MPI_File_write_at(fileHandle, totalSize - footer.size(), const_cast<char*>(footer.data()),
+				footer.size(), MPI_BYTE, MPI_STATUS_IGNORE));
+	}
+	for (const DataArray& array : arrays) {
+		write(array.encoded.data(), array.encoded.size());
+	}
+	write(emptyArray.data(), emptyArray.size());
+	MPI_CHECK(MPI_File_close(&fileHandle));
+#endif
+}
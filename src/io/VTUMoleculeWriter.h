@@ -0,0 +1,99 @@
+#ifndef VTUMOLECULEWRITER_H_
+#define VTUMOLECULEWRITER_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "plugins/PluginBase.h"
+
+/**
+ * Writes the molecules as points of a VTK unstructured grid (.vtu) with binary appended data.
+ *
+ * In contrast to the VTKMoleculeWriter, the file is streamed directly from the particle container, without building an
+ * xml tree of all points, and does not depend on xerces and the xsd generated code. The data arrays are the ones of the
+ * VTKMoleculeWriter (id, component-id, node-rank, forces and, if the centers are plotted, center-id and center-type).
+ * They are stored in the appended data section either raw or compressed with zlib in blocks, as the
+ * vtkZLibDataCompressor of VTK does.
+ *
+ * With MPI every rank writes its own file and rank 0 a .pvtu file referencing them. Alternatively all ranks write their
+ * piece into one shared .vtu file via MPI-IO.
+ *
+ * \code{.xml}
+   <plugin name="VTUMoleculeWriter">
+     <writefrequency>INTEGER</writefrequency>
+     <outputprefix>STRING</outputprefix>
+     <compression>STRING</compression>   <!-- none (default) or zlib, which requires ENABLE_ZLIB -->
+     <plotCenters>BOOL</plotCenters>     <!-- one point per center instead of per molecule, default false -->
+     <singleFile>BOOL</singleFile>       <!-- one shared file for all ranks, default false -->
+   </plugin>
+   \endcode
+ */
+class VTUMoleculeWriter : public PluginBase {
+public:
+	VTUMoleculeWriter();
+	VTUMoleculeWriter(unsigned long writeFrequency, const std::string& outputPrefix, const std::string& compression,
+			bool plotCenters, bool singleFile);
+	~VTUMoleculeWriter() override = default;
+
+	void readXML(XMLfileUnits& xmlconfig) override;
+
+	void init(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override;
+
+	void endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain,
+			unsigned long simstep) override;
+
+	void finish(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain) override {}
+
+	std::string getPluginName() override { return std::string("VTUMoleculeWriter"); }
+
+	static PluginBase* createInstance() { return new VTUMoleculeWriter(); }
+
+	//! uncompressed size of the blocks of compressed data arrays, the default of VTK
+	static constexpr uint64_t blockSize = 32768;
+
+private:
+	//! one data array of a piece, encoded for the appended data section
+	struct DataArray {
+		std::string name;
+		std::string type;
+		int numComponents;
+		std::vector<char> encoded;
+	};
+
+	/**
+	 * Collects the data arrays of the local molecules, the points are the last array. Every thread collects the
+	 * molecules of its part of the container, the parts are concatenated in the order of the threads.
+	 */
+	std::vector<DataArray> collectDataArrays(ParticleContainer* particleContainer, int rank, uint64_t& numPoints);
+
+	/**
+	 * Encodes the data for the appended data section: the number of bytes followed by the bytes, or compressed blocks.
+	 * If zlib fails, _compressionFailed is set and the result is incomplete.
+	 */
+	std::vector<char> encode(const char* data, uint64_t numBytes) const;
+
+	/**
+	 * Xml part of a .vtu file in front of the appended data, with one piece per entry of numPoints. The offsets of the
+	 * data arrays are determined from arraySizes, which holds the sizes of the encoded arrays of all pieces.
+	 */
+	std::string getHeader(const std::vector<DataArray>& arrays, const std::vector<uint64_t>& numPoints,
+			const std::vector<uint64_t>& arraySizes) const;
+
+	static std::string getFooter();
+
+	void writeParallelVTKFile(const std::vector<DataArray>& arrays, int numProcs, unsigned long simstep) const;
+
+	void writeSingleFile(const std::string& fileName, const std::vector<DataArray>& arrays, uint64_t numPoints,
+			DomainDecompBase* domainDecomp) const;
+
+	unsigned long _writeFrequency;
+	std::string _outputPrefix;
+	std::string _compression;
+	bool _plotCenters;
+	bool _singleFile;
+	//! set by encode(), the arrays of the step are encoded again without compression
+	mutable bool _compressionFailed;
+};
+
+#endif /* VTUMOLECULEWRITER_H_ */
@@ -8,9 +8,14 @@
  */
 
 #include "Domain.h"
+#include "io/CheckpointWriter.h"
+#include "io/CompressedCheckpoint.h"
+#include "molecules/Molecule.h"
 #include "particleContainer/ParticleContainer.h"
 #include "parallel/DomainDecompBase.h"
+#include <fstream>
 #include <iostream>
+#include <iterator>
 
 #include "io/tests/CheckpointRestartTest.h"
 
@@ -37,6 +42,105 @@ void CheckpointRestartTest::testCheckpointRestartBinary() {
 	testCheckpointRestart(true);
 }
 
+/*
+ * This tests if a chunked, compressed checkpoint can successfully be read again. The small chunk size makes sure, that
+ * several chunks are written and decompressed.
+ */
+void CheckpointRestartTest::testCheckpointRestartCompressed() {
+	constexpr double cutoff = 10.5;
+	ParticleContainer* particleContainer
+		= initializeFromFile(ParticleContainerFactory::LinkedCell, "VectorizationMultiComponentMultiPotentials_50_molecules.inp", cutoff);
+	auto initialParticleCount = getGlobalParticleNumber(particleContainer);
+	double initialSum = 0.;
+	for (auto m = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		initialSum += m->getID() + m->componentid() + m->r(0) + m->v(1) + m->q().qz() + m->D(2);
+	}
+
+#ifdef ENABLE_LZ4
+	const std::string encoding = "LZ4";
+#else
+	const std::string encoding = "None";
+#endif
+	std::string filename = "restart.compressed.test";
+	_domain->updateglobalNumMolecules(particleContainer, _domainDecomposition);
+	_domain->writeCheckpointHeaderXML(getTestDataFilename(filename + ".header.xml", false), particleContainer,
+			_domainDecomposition, 0.);
+	CompressedCheckpoint::writeMolecules(getTestDataFilename(filename + ".dat", false), particleContainer,
+			_domainDecomposition, encoding, 7);
+	ASSERT_TRUE(CompressedCheckpoint::isCompressed(getTestDataFilename(filename + ".dat", false)));
+
+	delete particleContainer;
+
+	ParticleContainer* particleContainer2
+		= initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff, true);
+
+	auto restartedParticleCount = getGlobalParticleNumber(particleContainer2);
+	ASSERT_EQUAL(initialParticleCount, restartedParticleCount);
+	double restartedSum = 0.;
+	for (auto m = particleContainer2->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		restartedSum += m->getID() + m->componentid() + m->r(0) + m->v(1) + m->q().qz() + m->D(2);
+	}
+	// the format is lossless, so the molecules have to be restored exactly (in a single process).
+	if (_domainDecomposition->getNumProcs() == 1) {
+		ASSERT_DOUBLES_EQUAL(initialSum, restartedSum, 1e-12 * std::abs(initialSum));
+	}
+	delete particleContainer2;
+}
+
+/*
+ * This tests the asynchronous, double-buffered CheckpointWriter. Without incremental numbers every step is written to
+ * the same file, alternately from both staging buffers, so each write truncates the file of a pending one. The last
+ * checkpoint has to be identical to the one of the synchronous writer.
+ */
+void CheckpointRestartTest::testCheckpointRestartAsynchronous() {
+	constexpr double cutoff = 10.5;
+	ParticleContainer* particleContainer
+		= initializeFromFile(ParticleContainerFactory::LinkedCell, "VectorizationMultiComponentMultiPotentials_50_molecules.inp", cutoff);
+	auto initialParticleCount = getGlobalParticleNumber(particleContainer);
+
+	CheckpointWriter writer;
+	writer._outputPrefix = getTestDataFilename("restart.async.test", false);
+	writer._writeFrequency = 1;
+	writer._useBinaryFormat = true;
+	writer._incremental = false;
+	writer._appendTimestamp = false;
+	writer._asynchronous = true;
+	writer._chunkSize = 16384;
+	writer._nextStagingBuffer = 0;
+	writer.init(particleContainer, _domainDecomposition, _domain);
+
+	for (unsigned long simstep = 1; simstep <= 5; ++simstep) {
+		// every checkpoint has different velocities, so a write that ends up in the wrong place shows up.
+		for (auto m = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+			m->setv(0, m->getID() * simstep);
+		}
+		writer.endStep(particleContainer, _domainDecomposition, _domain, simstep);
+	}
+	writer.finish(particleContainer, _domainDecomposition, _domain);
+
+	_domain->writeCheckpoint(getTestDataFilename("restart.sync.test", false), particleContainer, _domainDecomposition,
+			0., true);
+	delete particleContainer;
+
+	if (_domainDecomposition->getRank() == 0) {
+		std::ifstream asyncFile(getTestDataFilename("restart.async.test.restart.dat"), std::ios::binary);
+		std::ifstream syncFile(getTestDataFilename("restart.sync.test.dat"), std::ios::binary);
+		const std::string asyncData((std::istreambuf_iterator<char>(asyncFile)), std::istreambuf_iterator<char>());
+		const std::string syncData((std::istreambuf_iterator<char>(syncFile)), std::istreambuf_iterator<char>());
+		ASSERT_EQUAL(syncData.size(), asyncData.size());
+		ASSERT_TRUE_MSG("The asynchronous checkpoint differs from the synchronous one.", syncData == asyncData);
+	}
+
+	ParticleContainer* particleContainer2
+		= initializeFromFile(ParticleContainerFactory::LinkedCell, "restart.async.test.restart", cutoff, true);
+	auto restartedParticleCount = getGlobalParticleNumber(particleContainer2);
+	ASSERT_EQUAL(initialParticleCount, restartedParticleCount);
+	for (auto m = particleContainer2->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		ASSERT_DOUBLES_EQUAL(m->getID() * 5., m->v(0), 1e-12 * m->getID());
+	}
+	delete particleContainer2;
+}
+
 /*
  * Actual test if a written checkpoint can successfully be read again.
  */
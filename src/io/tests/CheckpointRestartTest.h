@@ -21,6 +21,12 @@ class CheckpointRestartTest : public utils::TestWithSimulationSetup {
 	// add a method which perform test
 	TEST_METHOD(testCheckpointRestartBinary);
 
+	// add a method which perform test
+	TEST_METHOD(testCheckpointRestartCompressed);
+
+	// add a method which perform test
+	TEST_METHOD(testCheckpointRestartAsynchronous);
+
 	// end suite declaration
 	TEST_SUITE_END();
 
@@ -31,6 +37,10 @@ public:
 	void testCheckpointRestartASCII();
 
 	void testCheckpointRestartBinary();
+
+	void testCheckpointRestartCompressed();
+
+	void testCheckpointRestartAsynchronous();
 private:
 
 	void testCheckpointRestart(bool binary);
@@ -15,6 +15,7 @@
 #include "particleContainer/LinkedCells.h"
 #include "particleContainer/adapter/ParticlePairs2PotForceAdapter.h"
 #include "particleContainer/adapter/RDFCellProcessor.h"
+#include "particleContainer/adapter/VectorizedCellProcessor.h"
 
 #ifdef ENABLE_MPI
 #include "parallel/DomainDecomposition.h"
@@ -194,7 +195,55 @@ void RDFTest::testRDFCount(ParticleContainer* moleculeContainer) {
 	}
 }
 
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+void RDFTest::testRDFCountObservingForcesLinkedCell() {
+	std::unique_ptr<ParticleContainer> moleculeContainer{initializeFromFile(ParticleContainerFactory::LinkedCell, "1clj-regular-12x12x12.inp", 1.8)};
+	double cutoff = moleculeContainer->getCutoff();
+
+	vector<Component>* components = global_simulation->getEnsemble()->getComponents();
+	ASSERT_EQUAL((size_t) 1, components->size());
+
+	moleculeContainer->deleteOuterParticles();
+	_domainDecomposition->balanceAndExchange(1.0, false, moleculeContainer.get(), _domain);
+	moleculeContainer->updateMoleculeCaches();
+
+	RDF rdf;
+	RDFCellProcessor cellProcessor(cutoff, &rdf);
+	initRDF(rdf, 0.018, 100, components);
+
+	VectorizedCellProcessor forceCellProcessor(*_domain, cutoff, cutoff);
+	ASSERT_TRUE(forceCellProcessor.addPairObserver(&cellProcessor));
+
+	// not observing: the force calculation must not count anything.
+	rdf.tickRDF();
+	moleculeContainer->traverseCells(forceCellProcessor);
+	ASSERT_TRUE(not cellProcessor.hasObservedTraversal());
+
+	cellProcessor.setObserving(true);
+	moleculeContainer->traverseCells(forceCellProcessor);
+	ASSERT_TRUE(cellProcessor.hasObservedTraversal());
+	cellProcessor.setObserving(false);
+	rdf.collectRDF(_domainDecomposition);
+
+	for (int i = 0; i < 100; i++) {
+		stringstream msg;
+		msg << "at index " << i;
+		if (i == 55) {
+			ASSERT_EQUAL(4752ul, rdf._distribution.global[0][0][i]);
+		} else if (i == 78) {
+			ASSERT_EQUAL(8712ul, rdf._distribution.global[0][0][i]);
+		} else if (i == 83) {
+			ASSERT_EQUAL(432ul, rdf._distribution.global[0][0][i]);
+		} else if (i == 96) {
+			ASSERT_EQUAL(5324ul, rdf._distribution.global[0][0][i]);
+		} else {
+			ASSERT_EQUAL_MSG(msg.str(), 0ul, rdf._distribution.global[0][0][i]);
+		}
+	}
 
+	forceCellProcessor.removePairObserver(&cellProcessor);
+}
+#endif
 
 void RDFTest::testSiteSiteRDFLinkedCell() {
 	if (_domainDecomposition->getNumProcs() > 8) {
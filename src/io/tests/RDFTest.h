@@ -19,6 +19,9 @@ class RDFTest : public utils::TestWithSimulationSetup {
 //	TEST_METHOD(testRDFCountSequential12_AdaptiveCell);
 	TEST_METHOD(testRDFCountLinkedCell);
 //	TEST_METHOD(testRDFCountAdaptiveCell);
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	TEST_METHOD(testRDFCountObservingForcesLinkedCell);
+#endif
 	TEST_METHOD(testSiteSiteRDFLinkedCell);
 	TEST_SUITE_END();
 
@@ -72,6 +75,12 @@ public:
 
 	void testRDFCount(ParticleContainer* container);
 
+	/**
+	 * Same setup as testRDFCountLinkedCell(), but the pairs are counted by the RDFCellProcessor as observer of the
+	 * VectorizedCellProcessor, which has to give the same distribution.
+	 */
+	void testRDFCountObservingForcesLinkedCell();
+
 
 	void testSiteSiteRDFLinkedCell();
 
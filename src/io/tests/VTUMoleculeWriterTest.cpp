@@ -0,0 +1,142 @@
+#include "VTUMoleculeWriterTest.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#ifdef ENABLE_ZLIB
+#include <zlib.h>
+#endif
+
+#include "Domain.h"
+#include "parallel/DomainDecompBase.h"
+#ifdef ENABLE_MPI
+#include "parallel/DomainDecomposition.h"
+#endif
+#include "particleContainer/LinkedCells.h"
+#include "utils/FileUtils.h"
+
+#if !defined(MARDYN_AUTOPAS)
+TEST_SUITE_REGISTRATION(VTUMoleculeWriterTest);
+#endif
+
+VTUMoleculeWriterTest::VTUMoleculeWriterTest() {
+}
+
+VTUMoleculeWriterTest::~VTUMoleculeWriterTest() {
+}
+
+void VTUMoleculeWriterTest::testWriteRaw() {
+	testWrite("none");
+}
+
+void VTUMoleculeWriterTest::testWriteZlib() {
+	testWrite("zlib");
+}
+
+void VTUMoleculeWriterTest::testWrite(const std::string& compression) {
+	double boundings_min[] = {0., 0., 0.};
+	double boundings_max[] = {10., 10., 10.};
+	LinkedCells container(boundings_min, boundings_max, 1.);
+
+	std::vector<Component> components;
+	Component dummyComponent(0);
+	dummyComponent.addLJcenter(0, 0, 0, 1, 1, 1, 0, false);
+	components.push_back(dummyComponent);
+
+	// id -> position, the force is the position times the id
+	std::map<uint64_t, std::array<double, 3>> positions;
+	positions[1] = {2.2, 3., 3.4};
+	positions[2] = {1., 0.5, 0.5};
+	positions[3] = {8., 1., 9.5};
+	positions[4] = {1., 1.5, 0.234};
+	for (const auto& entry : positions) {
+		Molecule molecule(entry.first, &components[0], entry.second[0], entry.second[1], entry.second[2], 0, 0, 0, 1,
+				0, 0, 0, 0, 0, 0);
+		molecule.setF(0, entry.first * entry.second[0]);
+		molecule.setF(1, entry.first * entry.second[1]);
+		molecule.setF(2, entry.first * entry.second[2]);
+		container.addParticle(molecule);
+	}
+
+	// with MPI all ranks write the same molecules into one file, the first piece is checked
+	VTUMoleculeWriter writer(2, "VTUMoleculeWriterTest", compression, false, true);
+	Domain domain(0);
+#ifdef ENABLE_MPI
+	DomainDecomposition domainDecomposition;
+#else
+	DomainDecompBase domainDecomposition;
+#endif
+	writer.endStep(&container, &domainDecomposition, &domain, 1);
+	ASSERT_TRUE_MSG("Check that files are written in the right interval.", !fileExists("VTUMoleculeWriterTest_1.vtu"));
+	writer.endStep(&container, &domainDecomposition, &domain, 2);
+	domainDecomposition.barrier();
+	if (domainDecomposition.getRank() != 0) {
+		domainDecomposition.barrier();
+		return;
+	}
+	ASSERT_TRUE_MSG("Check that files are written in the right interval.", fileExists("VTUMoleculeWriterTest_2.vtu"));
+
+	std::ifstream file("VTUMoleculeWriterTest_2.vtu", std::ios::binary);
+	std::stringstream contentStream;
+	contentStream << file.rdbuf();
+	const std::string content = contentStream.str();
+	ASSERT_TRUE(content.find("<Piece NumberOfPoints=\"4\" NumberOfCells=\"0\">") != std::string::npos);
+	const std::string footer = "\n  </AppendedData>\n</VTKFile>\n";
+	ASSERT_EQUAL(footer, content.substr(content.size() - footer.size()));
+
+	const bool compressed = (compression != "none");
+	const std::vector<char> ids = readArray(content, "id", compressed);
+	const std::vector<char> points = readArray(content, "points", compressed);
+	const std::vector<char> forces = readArray(content, "forces", compressed);
+	ASSERT_EQUAL(4 * sizeof(uint64_t), ids.size());
+	ASSERT_EQUAL(12 * sizeof(float), points.size());
+	ASSERT_EQUAL(12 * sizeof(float), forces.size());
+	for (int i = 0; i < 4; ++i) {
+		uint64_t id;
+		std::memcpy(&id, ids.data() + i * sizeof(uint64_t), sizeof(uint64_t));
+		ASSERT_EQUAL(1ul, positions.count(id));
+		for (int d = 0; d < 3; ++d) {
+			float position, force;
+			std::memcpy(&position, points.data() + (3 * i + d) * sizeof(float), sizeof(float));
+			std::memcpy(&force, forces.data() + (3 * i + d) * sizeof(float), sizeof(float));
+			ASSERT_DOUBLES_EQUAL(positions[id][d], position, 1e-6);
+			ASSERT_DOUBLES_EQUAL(id * positions[id][d], force, 1e-5);
+		}
+	}
+	removeFile("VTUMoleculeWriterTest_2.vtu");
+	domainDecomposition.barrier();
+}
+
+std::vector<char> VTUMoleculeWriterTest::readArray(const std::string& content, const std::string& name,
+		bool compressed) {
+	const size_t arrayPos = content.find("Name=\"" + name + "\"");
+	const size_t offsetPos = content.find("offset=\"", arrayPos) + 8;
+	const uint64_t offset = std::stoull(content.substr(offsetPos, content.find("\"", offsetPos) - offsetPos));
+	const char* data = content.data() + content.find("_", content.find("<AppendedData")) + 1 + offset;
+
+	std::vector<char> result;
+	uint64_t header[3];
+	std::memcpy(header, data, compressed ? 3 * sizeof(uint64_t) : sizeof(uint64_t));
+	if (not compressed) {
+		result.assign(data + sizeof(uint64_t), data + sizeof(uint64_t) + header[0]);
+		return result;
+	}
+#ifdef ENABLE_ZLIB
+	const uint64_t numBlocks = header[0];
+	std::vector<uint64_t> compressedSizes(numBlocks);
+	std::memcpy(compressedSizes.data(), data + 3 * sizeof(uint64_t), numBlocks * sizeof(uint64_t));
+	const char* block = data + (3 + numBlocks) * sizeof(uint64_t);
+	for (uint64_t i = 0; i < numBlocks; ++i) {
+		uLongf size = (i == numBlocks - 1 and header[2] != 0) ? header[2] : header[1];
+		std::vector<char> uncompressed(size);
+		ASSERT_EQUAL(Z_OK, uncompress(reinterpret_cast<Bytef*>(uncompressed.data()), &size,
+				reinterpret_cast<const Bytef*>(block), compressedSizes[i]));
+		result.insert(result.end(), uncompressed.begin(), uncompressed.begin() + size);
+		block += compressedSizes[i];
+	}
+#endif
+	return result;
+}
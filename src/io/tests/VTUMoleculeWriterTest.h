@@ -0,0 +1,40 @@
+#ifndef VTUMOLECULEWRITERTEST_H_
+#define VTUMOLECULEWRITERTEST_H_
+
+#include <string>
+#include <vector>
+
+#include "utils/Testing.h"
+#include "utils/TestWithSimulationSetup.h"
+#include "io/VTUMoleculeWriter.h"
+
+class VTUMoleculeWriterTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(VTUMoleculeWriterTest);
+	TEST_METHOD(testWriteRaw);
+#ifdef ENABLE_ZLIB
+	TEST_METHOD(testWriteZlib);
+#endif
+	TEST_SUITE_END;
+
+public:
+	VTUMoleculeWriterTest();
+
+	virtual ~VTUMoleculeWriterTest();
+
+	void testWriteRaw();
+
+	void testWriteZlib();
+
+private:
+	/**
+	 * Writes four molecules with the given compression into one file and checks the number of points and the ids,
+	 * positions and forces read back from the appended data.
+	 */
+	void testWrite(const std::string& compression);
+
+	//! decoded data of the array with the given name of the first piece of a .vtu file
+	std::vector<char> readArray(const std::string& content, const std::string& name, bool compressed);
+};
+
+#endif /* VTUMOLECULEWRITERTEST_H_ */
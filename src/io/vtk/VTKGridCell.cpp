@@ -8,7 +8,7 @@
 #include "VTKGridCell.h"
 
 VTKGridCell::VTKGridCell() :
-		_index(0), _rank(0), _load(0.), _level(0) {
+		_index(0), _rank(0), _load(0.), _level(0), _pairs(0.), _hitRate(0.) {
 }
 
 VTKGridCell::~VTKGridCell() { }
@@ -51,3 +51,19 @@ double VTKGridCell::getLoad() const {
 int VTKGridCell::getLevel() const {
 	return _level;
 }
+
+
+void VTKGridCell::setInstrumentationData(double pairs, double hitRate) {
+	_pairs = pairs;
+	_hitRate = hitRate;
+}
+
+
+double VTKGridCell::getPairs() const {
+	return _pairs;
+}
+
+
+double VTKGridCell::getHitRate() const {
+	return _hitRate;
+}
@@ -37,6 +37,12 @@ private:
 	 */
 	int _level;
 
+	/**
+	 * number of molecule pairs and fraction of them within the cutoff (used when plotting the cell instrumentation)
+	 */
+	double _pairs;
+	double _hitRate;
+
 public:
 
 	VTKGridCell();
@@ -61,6 +67,15 @@ public:
 	double getLoad() const;
 
 	int getLevel() const;
+
+	/**
+	 * set the data of the cell instrumentation (see InstrumentedCellProcessor).
+	 */
+	void setInstrumentationData(double pairs, double hitRate);
+
+	double getPairs() const;
+
+	double getHitRate() const;
 };
 
 #endif /* VTKGRIDCELL_H_ */
@@ -15,6 +15,8 @@
 #include "Domain.h"
 #include "utils/Logger.h"
 #include "parallel/DomainDecompBase.h"
+#include "particleContainer/adapter/InstrumentedCellProcessor.h"
+#include "Simulation.h"
 
 using namespace Log;
 
@@ -59,16 +61,28 @@ void  VTKGridWriter::endStep(
 
 	int rank = domainDecomp->getRank();
 
-	VTKGridWriterImplementation impl(rank);
+	auto* instrumentation = dynamic_cast<InstrumentedCellProcessor*>(global_simulation->getCellProcessor());
+	if (instrumentation != nullptr and not instrumentation->isCountingPairs()) {
+		// only instrumented for a load model
+		instrumentation = nullptr;
+	}
+
+	VTKGridWriterImplementation impl(rank, nullptr, instrumentation != nullptr);
 	impl.initializeVTKFile();
 
 	setupVTKGrid(particleContainer);
 
 	for (int i = 0; i < _numCells; i++) {
-		getCellData(container, _cells[i]);
+		getCellData(container, _cells[i], instrumentation);
 		impl.plotCell(_cells[i]);
 	}
 
+	if (instrumentation != nullptr) {
+		global_log->info() << "VTKGridWriter: thread imbalance of the cell processor (max/mean): "
+				<< instrumentation->getThreadImbalance() << std::endl;
+		instrumentation->reset();
+	}
+
 	std::stringstream fileNameStream;
 	fileNameStream << _fileName;
 
@@ -179,9 +193,19 @@ void VTKGridWriter::releaseVTKGrid() {
 	_numVertices = 0;
 }
 
-void VTKGridWriter::getCellData(LinkedCells* container, VTKGridCell& cell) {
+void VTKGridWriter::getCellData(LinkedCells* container, VTKGridCell& cell,
+		InstrumentedCellProcessor* instrumentation) {
 	int numberOfMolecules = container->_cells[cell.getIndex()].getMoleculeCount();
-	cell.setCellData(numberOfMolecules, 0.0, 0);
+	if (instrumentation == nullptr or instrumentation->getNumTraversals() == 0) {
+		cell.setCellData(numberOfMolecules, 0.0, 0);
+		return;
+	}
+
+	const InstrumentedCellProcessor::CellCounters counters = instrumentation->getCellCounters(cell.getIndex());
+	const double numTraversals = instrumentation->getNumTraversals();
+	cell.setCellData(numberOfMolecules, counters.time / numTraversals, 0);
+	cell.setInstrumentationData(counters.pairs / numTraversals,
+			counters.pairs > 0 ? static_cast<double>(counters.hits) / counters.pairs : 0.);
 }
 
 //! NOP
@@ -15,11 +15,17 @@
 
 class LinkedCells;
 class VTKGridWriterImplementation;
+class InstrumentedCellProcessor;
 
 /**
  * This class acts as adapter to the VTKGridWriterImplementation, which handles
  * the actual xml writing. It is a friend class of LinkedCells, but reads only
  * its internal data to generate the vtk output.
+ *
+ * If the cell processor is instrumented (command line option --cell-instrumentation),
+ * the load of every cell is the time spent in the cell processor per traversal and
+ * the number of molecule pairs per traversal and their hit rate are written as well.
+ * The counters are reset after every output.
  */
 class VTKGridWriter : public PluginBase {
 
@@ -84,7 +90,7 @@ private:
 
 	void releaseVTKGrid();
 
-	void getCellData(LinkedCells* container, VTKGridCell& cell);
+	void getCellData(LinkedCells* container, VTKGridCell& cell, InstrumentedCellProcessor* instrumentation);
 
 	void outputParallelVTKFile(unsigned int numProcs, unsigned long simstep,
 			VTKGridWriterImplementation& impl);
@@ -15,9 +15,10 @@
 
 using namespace Log;
 
-VTKGridWriterImplementation::VTKGridWriterImplementation(int rank, const std::vector<double>* processorSpeeds)
+VTKGridWriterImplementation::VTKGridWriterImplementation(int rank, const std::vector<double>* processorSpeeds,
+		bool plotInstrumentation)
 : _vtkFile(NULL), _parallelVTKFile(NULL), _numCellsPlotted(0),
-  _numVerticesPlotted(0), _rank(rank), _processorSpeeds(processorSpeeds) {
+  _numVerticesPlotted(0), _rank(rank), _processorSpeeds(processorSpeeds), _plotInstrumentation(plotInstrumentation) {
 }
 
 
@@ -48,6 +49,12 @@ void VTKGridWriterImplementation::initializeVTKFile() {
 	cellData.DataArray().push_back(cells_level);
 	DataArray_t index(type::UInt32, "index", 1);
 	cellData.DataArray().push_back(index);
+	if (_plotInstrumentation) {
+		DataArray_t pairs(type::Float64, "pairs", 1);
+		cellData.DataArray().push_back(pairs);
+		DataArray_t hitRate(type::Float32, "hitRate", 1);
+		cellData.DataArray().push_back(hitRate);
+	}
 	if (_processorSpeeds != nullptr && _processorSpeeds->size() != 0) {
 		DataArray_t procSpeeds(type::Float32, "processorSpeeds", 1);
 		cellData.DataArray().push_back(procSpeeds);
@@ -121,6 +128,12 @@ void VTKGridWriterImplementation::plotCell(VTKGridCell& cell) {
 	it3++;
 	it3->push_back(cell.getIndex());
 	it3++;
+	if (_plotInstrumentation) {
+		it3->push_back(cell.getPairs());
+		it3++;
+		it3->push_back(cell.getHitRate());
+		it3++;
+	}
 	if (_processorSpeeds != nullptr && _processorSpeeds->size() != 0) {
 		it3->push_back((*_processorSpeeds)[cell.getRank()]);
 		it3++;
@@ -161,6 +174,12 @@ void VTKGridWriterImplementation::initializeParallelVTKFile(const std::vector<st
 		p_cellData.PDataArray().push_back(p_node_rank);
 		DataArray_t index(type::UInt32, "index", 1);
 		p_cellData.PDataArray().push_back(index);
+		if (_plotInstrumentation) {
+			DataArray_t p_pairs(type::Float64, "pairs", 1);
+			p_cellData.PDataArray().push_back(p_pairs);
+			DataArray_t p_hitRate(type::Float32, "hitRate", 1);
+			p_cellData.PDataArray().push_back(p_hitRate);
+		}
 
 		// 3 coordinates
 		PPoints p_points;
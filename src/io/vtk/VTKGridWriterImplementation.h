@@ -41,12 +41,17 @@ private:
 
 	const std::vector<double>* _processorSpeeds;
 
+	//! plot the pair counts and hit rates of the cell instrumentation
+	bool _plotInstrumentation;
+
 public:
 
 	/**
 	 * @param rank the MPI rank of the process
+	 * @param plotInstrumentation add the cell data of the cell instrumentation
 	 */
-	VTKGridWriterImplementation(int rank, const std::vector<double>* processorSpeeds = nullptr);
+	VTKGridWriterImplementation(int rank, const std::vector<double>* processorSpeeds = nullptr,
+			bool plotInstrumentation = false);
 
 	virtual ~VTKGridWriterImplementation();
 
@@ -0,0 +1,109 @@
+#include "longRange/EwaldRealSpaceCellProcessor.h"
+
+#include <cmath>
+
+#include "Domain.h"
+#include "WrapOpenMP.h"
+#include "molecules/Molecule.h"
+#include "particleContainer/ParticleCell.h"
+
+EwaldRealSpaceCellProcessor::EwaldRealSpaceCellProcessor(Domain& domain, double cutoffRadius,
+		double ewaldCoefficient) :
+		CellProcessor(cutoffRadius, cutoffRadius), _domain(domain), _ewaldCoefficient(ewaldCoefficient),
+		_threadData(mardyn_get_max_threads()), _upot(0.), _virial(0.) {
+}
+
+void EwaldRealSpaceCellProcessor::initTraversal() {
+	for (ThreadData& threadData : _threadData) {
+		threadData.upot = 0.;
+		threadData.virial = 0.;
+	}
+}
+
+void EwaldRealSpaceCellProcessor::processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll /* = false */) {
+	const bool cell1Halo = cell1.isHaloCell();
+	const bool cell2Halo = cell2.isHaloCell();
+	if (cell1Halo and cell2Halo and not sumAll) {
+		return;
+	}
+	// see VectorizedCellProcessor::processCellPair
+	const bool calculateMacroscopic = sumAll or (not cell1Halo and not cell2Halo)
+			or cell1.getCellIndex() < cell2.getCellIndex();
+
+	ThreadData& threadData = _threadData[mardyn_get_thread_num()];
+	for (auto it1 = cell1.iterator(); it1.isValid(); ++it1) {
+		if (it1->numCharges() == 0) {
+			continue;
+		}
+		for (auto it2 = cell2.iterator(); it2.isValid(); ++it2) {
+			processPair(*it1, *it2, calculateMacroscopic, threadData);
+		}
+	}
+}
+
+void EwaldRealSpaceCellProcessor::processCell(ParticleCell& cell) {
+	if (cell.isHaloCell()) {
+		return;
+	}
+	ThreadData& threadData = _threadData[mardyn_get_thread_num()];
+	for (auto it1 = cell.iterator(); it1.isValid(); ++it1) {
+		if (it1->numCharges() == 0) {
+			continue;
+		}
+		auto it2 = it1;
+		++it2;
+		for (; it2.isValid(); ++it2) {
+			processPair(*it1, *it2, true, threadData);
+		}
+	}
+}
+
+void EwaldRealSpaceCellProcessor::processPair(Molecule& molecule1, Molecule& molecule2, bool calculateMacroscopic,
+		ThreadData& threadData) {
+	double centerDistance[3];
+	// dist2 returns the vector from molecule1 to molecule2
+	if (molecule1.dist2(molecule2, centerDistance) >= _cutoffRadiusSquare or molecule2.numCharges() == 0) {
+		return;
+	}
+	const double twoBetaOverSqrtPi = 2. * _ewaldCoefficient / std::sqrt(M_PI);
+	for (unsigned i = 0; i < molecule1.numCharges(); ++i) {
+		const double q1 = molecule1.component()->charge(i).q();
+		const std::array<double, 3> site1 = molecule1.charge_d_abs(i);
+		for (unsigned j = 0; j < molecule2.numCharges(); ++j) {
+			const double q1q2 = q1 * molecule2.component()->charge(j).q();
+			const std::array<double, 3> site2 = molecule2.charge_d_abs(j);
+			double dr[3];
+			double dr2 = 0.;
+			for (int d = 0; d < 3; ++d) {
+				dr[d] = site1[d] - site2[d];
+				dr2 += dr[d] * dr[d];
+			}
+			const double r = std::sqrt(dr2);
+			const double screened = q1q2 * std::erfc(_ewaldCoefficient * r) / r;
+			const double fac = (screened + q1q2 * twoBetaOverSqrtPi * std::exp(-_ewaldCoefficient * _ewaldCoefficient * dr2))
+					/ dr2;
+			double f[3];
+			for (int d = 0; d < 3; ++d) {
+				f[d] = fac * dr[d];
+			}
+			molecule1.Fchargeadd(i, f);
+			molecule2.Fchargesub(j, f);
+			if (calculateMacroscopic) {
+				threadData.upot += screened;
+				// molecular virial with the distance of the centers
+				threadData.virial -= centerDistance[0] * f[0] + centerDistance[1] * f[1] + centerDistance[2] * f[2];
+			}
+		}
+	}
+}
+
+void EwaldRealSpaceCellProcessor::endTraversal() {
+	_upot = 0.;
+	_virial = 0.;
+	for (const ThreadData& threadData : _threadData) {
+		_upot += threadData.upot;
+		_virial += threadData.virial;
+	}
+	_domain.setLocalUpot(_domain.getLocalUpot() + _upot);
+	_domain.setLocalVirial(_domain.getLocalVirial() + _virial);
+}
@@ -0,0 +1,50 @@
+#ifndef EWALDREALSPACECELLPROCESSOR_H_
+#define EWALDREALSPACECELLPROCESSOR_H_
+
+#include <vector>
+
+#include "particleContainer/adapter/CellProcessor.h"
+
+class Domain;
+
+/**
+ * Real space part of the Ewald sum of the charges for the SmoothParticleMeshEwald.
+ *
+ * Computes the screened Coulomb interaction q_i q_j erfc(beta r) / r of the charges of all molecule pairs, whose
+ * centers are closer than the cutoff radius. The potential energy and virial are added to the local values of the
+ * domain by endTraversal(), so the traversal has to follow the one of the regular cell processor, which sets them.
+ * Pairs with a halo molecule are handled like in the VectorizedCellProcessor: the macroscopic values are summed up
+ * for one of the two halo cell pairs only.
+ */
+class EwaldRealSpaceCellProcessor : public CellProcessor {
+public:
+	EwaldRealSpaceCellProcessor(Domain& domain, double cutoffRadius, double ewaldCoefficient);
+
+	void initTraversal() override;
+	void preprocessCell(ParticleCell& /*cell*/) override {}
+	void processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll = false) override;
+	void processCell(ParticleCell& cell) override;
+	double processSingleMolecule(Molecule* /*m1*/, ParticleCell& /*cell2*/) override { return 0.; }
+	void postprocessCell(ParticleCell& /*cell*/) override {}
+	void endTraversal() override;
+
+	double getUpot() const { return _upot; }
+	double getVirial() const { return _virial; }
+
+private:
+	// aligned to avoid false sharing of the thread sums
+	struct alignas(64) ThreadData {
+		double upot = 0.;
+		double virial = 0.;
+	};
+
+	void processPair(Molecule& molecule1, Molecule& molecule2, bool calculateMacroscopic, ThreadData& threadData);
+
+	Domain& _domain;
+	const double _ewaldCoefficient;
+	std::vector<ThreadData> _threadData;
+	double _upot;
+	double _virial;
+};
+
+#endif /* EWALDREALSPACECELLPROCESSOR_H_ */
@@ -5,6 +5,7 @@
 #include "parallel/DomainDecompBase.h"
 #include "particleContainer/ParticleContainer.h"
 #include "Simulation.h"
+#include "WrapOpenMP.h"
 #include "plugins/NEMD/DistControl.h"
 
 #include <vector>
@@ -82,6 +83,10 @@ void Planar::init()
 	resizeExactly(rhoDipole, _slabs*numDipoleSum);
 	resizeExactly(rhoDipoleL, _slabs*numDipoleSum);
 	resizeExactly(eLong, numLJSum);
+	_threadDensityProfiles.resize(mardyn_get_max_threads());
+	for (auto& threadProfile : _threadDensityProfiles) {
+		resizeExactly(threadProfile, _slabs*(numLJSum+numDipoleSum));
+	}
 	
 	unsigned counter=0;
 	for (unsigned i =0; i< numComp; i++){		// Determination of the elongation of the Lennard-Jones sites
@@ -216,41 +221,7 @@ void Planar::readXML(XMLfileUnits& xmlconfig)
 void Planar::calculateLongRange() {
 
 	if (_smooth){
-		const double delta_inv = 1.0 / delta;
-		const double slabsPerV = _slabs / V;
-
-		#if defined(_OPENMP)
-		#pragma omp parallel
-		#endif
-		for(auto tempMol = _particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tempMol.isValid(); ++tempMol){
-			unsigned cid=tempMol->componentid();
-
-			for (unsigned i=0; i<numLJ[cid]; i++){
-				int loc=(tempMol->ljcenter_d_abs(i)[1]) * delta_inv;
-				if (loc < 0){
-					loc=loc+_slabs;
-				}
-				else if (loc > sint-1){
-					loc=loc-_slabs;
-				}
-				const int index = loc + _slabs * (i + numLJSum2[cid]);
-
-				#if defined(_OPENMP)
-				#pragma omp atomic
-				#endif
-				rho_g[index] += slabsPerV;
-			}
-			if (numDipole[cid] != 0){
-				int loc=tempMol->r(1) * delta_inv;
-
-				const int index = loc + _slabs * (numDipoleSum2[cid]);
-
-				#if defined(_OPENMP)
-				#pragma omp atomic
-				#endif
-				rhoDipole[index] += slabsPerV;
-			}
-		}
+		sampleDensityProfile(rho_g, rhoDipole);
 	} 
 	if (simstep % frequency == 0){	// The Density Profile is only calculated once in 10 simulation steps
 
@@ -268,40 +239,7 @@ void Planar::calculateLongRange() {
 
 		// Calculation of the density profile for s slabs
 		if (!_smooth){
-			const double delta_inv = 1.0 / delta;
-			const double slabsPerV = _slabs / V;
-
-			#if defined(_OPENMP)
-			#pragma omp parallel
-			#endif
-			for(auto tempMol = _particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tempMol.isValid(); ++tempMol){
-				unsigned cid=tempMol->componentid();
-
-				for (unsigned i=0; i<numLJ[cid]; i++){
-					int loc=(tempMol->ljcenter_d_abs(i)[1]) * delta_inv;
-					if (loc < 0){
-						loc=loc+_slabs;
-					}
-					else if (loc > sint-1){
-						loc=loc-_slabs;
-					}
-					const int index = loc+_slabs*(i+numLJSum2[cid]);
-
-					#if defined(_OPENMP)
-					#pragma omp atomic
-					#endif
-					rho_l[index] += slabsPerV;
-				}
-				if (numDipole[cid] != 0){
-					int loc=tempMol->r(1) * delta_inv;
-					const int index = loc+_slabs*numDipoleSum2[cid];
-
-					#if defined(_OPENMP)
-					#pragma omp atomic
-					#endif
-					rhoDipoleL[index] += slabsPerV;
-				}
-			}
+			sampleDensityProfile(rho_l, rhoDipoleL);
 		}
 		else{
 			for (unsigned i=0; i<_slabs*numLJSum; i++){
@@ -457,11 +395,12 @@ void Planar::calculateLongRange() {
 		}				
 	}
 
-	// Summation of the correction terms
-	_domainDecomposition->collCommInit(2);
+	// Summation of the correction terms, which may overlap with the next time step like the one of the global values
+	// in Domain::calculateGlobalValues (overlappingCollectives)
+	_domainDecomposition->collCommInit(2, 655);
 	_domainDecomposition->collCommAppendDouble(Upot_c);
 	_domainDecomposition->collCommAppendDouble(Virial_c);
-	_domainDecomposition->collCommAllreduceSum();
+	_domainDecomposition->collCommAllreduceSumAllowPrevious();
 	Upot_c = _domainDecomposition->collCommGetDouble();
 	Virial_c = _domainDecomposition->collCommGetDouble();
 	_domainDecomposition->collCommFinalize();
@@ -474,6 +413,62 @@ void Planar::calculateLongRange() {
 }
 
 
+void Planar::sampleDensityProfile(std::vector<double>& rhoLJ, std::vector<double>& rhoDip) {
+	const double delta_inv = 1.0 / delta;
+	const double slabsPerV = _slabs / V;
+	const unsigned numLJBins = _slabs * numLJSum;
+	const unsigned numBins = numLJBins + _slabs * numDipoleSum;
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		// every thread samples its molecules into its own profile, so no atomics are needed
+		std::vector<double>& threadProfile = _threadDensityProfiles[mardyn_get_thread_num()];
+		std::fill(threadProfile.begin(), threadProfile.end(), 0.0);
+
+		for(auto tempMol = _particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); tempMol.isValid(); ++tempMol){
+			unsigned cid=tempMol->componentid();
+
+			for (unsigned i=0; i<numLJ[cid]; i++){
+				int loc=(tempMol->ljcenter_d_abs(i)[1]) * delta_inv;
+				if (loc < 0){
+					loc=loc+_slabs;
+				}
+				else if (loc > sint-1){
+					loc=loc-_slabs;
+				}
+				threadProfile[loc + _slabs * (i + numLJSum2[cid])] += slabsPerV;
+			}
+			if (numDipole[cid] != 0){
+				int loc=tempMol->r(1) * delta_inv;
+				threadProfile[numLJBins + loc + _slabs * numDipoleSum2[cid]] += slabsPerV;
+			}
+		}
+
+		#if defined(_OPENMP)
+		#pragma omp barrier
+		#endif
+
+		// every thread sums up a range of bins over all thread profiles
+		const int numThreads = mardyn_get_num_threads();
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (unsigned bin = 0; bin < numBins; ++bin) {
+			double sum = 0.0;
+			for (int t = 0; t < numThreads; ++t) {
+				sum += _threadDensityProfiles[t][bin];
+			}
+			if (bin < numLJBins) {
+				rhoLJ[bin] += sum;
+			} else {
+				rhoDip[bin - numLJBins] += sum;
+			}
+		}
+	}
+}
+
 void Planar::centerCenter(double sig, double eps,unsigned ci,unsigned cj,unsigned si, unsigned sj){
 	double rc=sig/cutoff;
 	double rc2=rc*rc;
@@ -72,6 +72,8 @@ private:
 	void centerSite(double sig,double eps,unsigned ci,unsigned cj,unsigned si, unsigned sj);
 	void siteSite(double sig,double eps,unsigned ci,unsigned cj,unsigned si, unsigned sj);
 	void dipoleDipole(unsigned ci,unsigned cj,unsigned si,unsigned sj);
+	// Adds the densities of the LJ centers and dipoles of the local molecules in every slab to the given profiles.
+	void sampleDensityProfile(std::vector<double>& rhoLJ, std::vector<double>& rhoDip);
 
 	unsigned _slabs;
 	unsigned numComp;
@@ -97,6 +99,7 @@ private:
 	std::vector<double> rhoDipoleL;
 	std::vector<double> muSquare;
 	std::vector<double> eLong;
+	std::vector<std::vector<double>> _threadDensityProfiles;  // LJ and dipole densities sampled by every thread
 	double cutoff;
 	double delta;
 	unsigned cutoff_slabs;
@@ -0,0 +1,387 @@
+#include "longRange/SlabFFT.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "parallel/DomainDecompBase.h"
+#include "utils/mardyn_assert.h"
+
+#ifdef ENABLE_MPI
+#include <mpi.h>
+#endif
+
+SlabFFT::SlabFFT(const std::array<int, 3>& gridSize, DomainDecompBase* domainDecomp) :
+		_gridSize(gridSize), _domainDecomp(domainDecomp), _rank(domainDecomp->getRank()),
+		_numProcs(domainDecomp->getNumProcs()) {
+	for (int d = 0; d < 3; ++d) {
+		mardyn_assert(isPowerOfTwo(_gridSize[d]));
+		_plans[d] = createPlan(_gridSize[d]);
+	}
+	// processes with a higher rank than grid planes get an empty slab
+	_zBegin.resize(_numProcs + 1);
+	_yBegin.resize(_numProcs + 1);
+	for (int rank = 0; rank <= _numProcs; ++rank) {
+		_zBegin[rank] = static_cast<int>(static_cast<long>(rank) * _gridSize[2] / _numProcs);
+		_yBegin[rank] = static_cast<int>(static_cast<long>(rank) * _gridSize[1] / _numProcs);
+	}
+}
+
+SlabFFT::Plan1D SlabFFT::createPlan(int n) {
+	Plan1D plan;
+	plan.twiddles.resize(n / 2);
+	for (int k = 0; k < n / 2; ++k) {
+		const double angle = -2. * M_PI * k / n;
+		plan.twiddles[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+	}
+	int numBits = 0;
+	while ((1 << numBits) < n) {
+		++numBits;
+	}
+	plan.bitReversal.resize(n);
+	for (int i = 0; i < n; ++i) {
+		int reversed = 0;
+		for (int bit = 0; bit < numBits; ++bit) {
+			reversed |= ((i >> bit) & 1) << (numBits - 1 - bit);
+		}
+		plan.bitReversal[i] = reversed;
+	}
+	return plan;
+}
+
+void SlabFFT::transform(std::complex<double>* line, const Plan1D& plan, bool inverse) {
+	const int n = plan.bitReversal.size();
+	for (int i = 0; i < n; ++i) {
+		if (i < plan.bitReversal[i]) {
+			std::swap(line[i], line[plan.bitReversal[i]]);
+		}
+	}
+	for (int length = 2; length <= n; length <<= 1) {
+		const int half = length / 2;
+		const int step = n / length;
+		for (int i = 0; i < n; i += length) {
+			for (int j = 0; j < half; ++j) {
+				const std::complex<double> w = inverse ? std::conj(plan.twiddles[j * step]) : plan.twiddles[j * step];
+				const std::complex<double> u = line[i + j];
+				const std::complex<double> v = line[i + j + half] * w;
+				line[i + j] = u + v;
+				line[i + j + half] = u - v;
+			}
+		}
+	}
+}
+
+void SlabFFT::transformLines(std::vector<std::complex<double>>& data, int numPlanes,
+		const std::array<int, 2>& planeSize, int dim, const Plan1D& plan, bool inverse) {
+	const long planeLength = static_cast<long>(planeSize[0]) * planeSize[1];
+	if (dim == 0) {
+		// rows are contiguous
+		const long numLines = static_cast<long>(numPlanes) * planeSize[1];
+		#if defined(_OPENMP)
+		#pragma omp parallel for schedule(static)
+		#endif
+		for (long line = 0; line < numLines; ++line) {
+			transform(data.data() + line * planeSize[0], plan, inverse);
+		}
+		return;
+	}
+
+	const long numLines = static_cast<long>(numPlanes) * planeSize[0];
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		std::vector<std::complex<double>> column(planeSize[1]);
+		#if defined(_OPENMP)
+		#pragma omp for schedule(static)
+		#endif
+		for (long line = 0; line < numLines; ++line) {
+			std::complex<double>* const first = data.data() + (line / planeSize[0]) * planeLength + line % planeSize[0];
+			for (int i = 0; i < planeSize[1]; ++i) {
+				column[i] = first[static_cast<long>(i) * planeSize[0]];
+			}
+			transform(column.data(), plan, inverse);
+			for (int i = 0; i < planeSize[1]; ++i) {
+				first[static_cast<long>(i) * planeSize[0]] = column[i];
+			}
+		}
+	}
+}
+
+int SlabFFT::zOwner(int z) const {
+	// the last process starting at or before z, which skips the empty slabs
+	return static_cast<int>(std::upper_bound(_zBegin.begin(), _zBegin.end(), z) - _zBegin.begin()) - 1;
+}
+
+void SlabFFT::countBrickPoints(std::vector<int>& sendCounts, std::vector<int>& recvCounts) const {
+	sendCounts.assign(_numProcs, 0);
+	recvCounts.assign(_numProcs, 0);
+	for (int rank = 0; rank < _numProcs; ++rank) {
+		const Brick& brick = _bricks[rank];
+		const int planeLength = brick.size[0] * brick.size[1];
+		for (int lz = 0; lz < brick.size[2]; ++lz) {
+			const int z = wrap(brick.begin[2] + lz, _gridSize[2]);
+			if (rank == _rank) {
+				sendCounts[zOwner(z)] += planeLength;
+			}
+			if (z >= zBegin() and z < zEnd()) {
+				recvCounts[rank] += planeLength;
+			}
+		}
+	}
+}
+
+void SlabFFT::exchangeBrickData(const std::vector<int>& sendCounts, const std::vector<int>& recvCounts) {
+	std::vector<int> sendDisplacements(_numProcs, 0);
+	std::vector<int> recvDisplacements(_numProcs, 0);
+	for (int rank = 1; rank < _numProcs; ++rank) {
+		sendDisplacements[rank] = sendDisplacements[rank - 1] + sendCounts[rank - 1];
+		recvDisplacements[rank] = recvDisplacements[rank - 1] + recvCounts[rank - 1];
+	}
+	_recvBuffer.resize(recvDisplacements.back() + recvCounts.back());
+#ifdef ENABLE_MPI
+	if (_numProcs > 1) {
+		MPI_Alltoallv(_sendBuffer.data(), sendCounts.data(), sendDisplacements.data(), MPI_DOUBLE, _recvBuffer.data(),
+				recvCounts.data(), recvDisplacements.data(), MPI_DOUBLE, _domainDecomp->getCommunicator());
+		return;
+	}
+#endif
+	_recvBuffer.swap(_sendBuffer);
+}
+
+void SlabFFT::gatherBricks(const Brick& brick, const std::vector<double>& brickData,
+		std::vector<std::complex<double>>& zSlab) {
+	const int nx = _gridSize[0];
+	const int ny = _gridSize[1];
+	_bricks.assign(_numProcs, brick);
+#ifdef ENABLE_MPI
+	if (_numProcs > 1) {
+		const int localBrick[6] = {brick.begin[0], brick.begin[1], brick.begin[2], brick.size[0], brick.size[1],
+				brick.size[2]};
+		std::vector<int> bricks(6 * _numProcs);
+		MPI_Allgather(localBrick, 6, MPI_INT, bricks.data(), 6, MPI_INT, _domainDecomp->getCommunicator());
+		for (int rank = 0; rank < _numProcs; ++rank) {
+			for (int d = 0; d < 3; ++d) {
+				_bricks[rank].begin[d] = bricks[6 * rank + d];
+				_bricks[rank].size[d] = bricks[6 * rank + 3 + d];
+			}
+		}
+	}
+#endif
+	std::vector<int> sendCounts, recvCounts;
+	countBrickPoints(sendCounts, recvCounts);
+
+	// pack the planes of the brick in the order of the processes owning them
+	const long brickPlaneLength = static_cast<long>(brick.size[0]) * brick.size[1];
+	std::vector<long> offsets(_numProcs, 0);
+	for (int rank = 1; rank < _numProcs; ++rank) {
+		offsets[rank] = offsets[rank - 1] + sendCounts[rank - 1];
+	}
+	_sendBuffer.resize(brickData.size());
+	for (int lz = 0; lz < brick.size[2]; ++lz) {
+		long& offset = offsets[zOwner(wrap(brick.begin[2] + lz, _gridSize[2]))];
+		std::copy(brickData.begin() + lz * brickPlaneLength, brickData.begin() + (lz + 1) * brickPlaneLength,
+				_sendBuffer.begin() + offset);
+		offset += brickPlaneLength;
+	}
+
+	exchangeBrickData(sendCounts, recvCounts);
+
+	// sum up the received planes, periodic images included
+	zSlab.assign(static_cast<long>(zEnd() - zBegin()) * ny * nx, 0.);
+	long index = 0;
+	for (int rank = 0; rank < _numProcs; ++rank) {
+		const Brick& sender = _bricks[rank];
+		for (int lz = 0; lz < sender.size[2]; ++lz) {
+			const int z = wrap(sender.begin[2] + lz, _gridSize[2]);
+			if (z < zBegin() or z >= zEnd()) {
+				continue;
+			}
+			int y = wrap(sender.begin[1], ny);
+			for (int ly = 0; ly < sender.size[1]; ++ly) {
+				const long row = (static_cast<long>(z - zBegin()) * ny + y) * nx;
+				int x = wrap(sender.begin[0], nx);
+				for (int lx = 0; lx < sender.size[0]; ++lx) {
+					zSlab[row + x] += _recvBuffer[index++];
+					x = x + 1 == nx ? 0 : x + 1;
+				}
+				y = y + 1 == ny ? 0 : y + 1;
+			}
+		}
+	}
+}
+
+void SlabFFT::scatterBricks(const std::vector<std::complex<double>>& zSlab, std::vector<double>& brickData) {
+	const int nx = _gridSize[0];
+	const int ny = _gridSize[1];
+	std::vector<int> sendCounts, recvCounts;
+	// the reverse of the communication of gatherBricks()
+	countBrickPoints(recvCounts, sendCounts);
+
+	// pack the parts of the slab in the bricks of all processes
+	_sendBuffer.resize(std::accumulate(sendCounts.begin(), sendCounts.end(), 0L));
+	long index = 0;
+	for (int rank = 0; rank < _numProcs; ++rank) {
+		const Brick& receiver = _bricks[rank];
+		for (int lz = 0; lz < receiver.size[2]; ++lz) {
+			const int z = wrap(receiver.begin[2] + lz, _gridSize[2]);
+			if (z < zBegin() or z >= zEnd()) {
+				continue;
+			}
+			int y = wrap(receiver.begin[1], ny);
+			for (int ly = 0; ly < receiver.size[1]; ++ly) {
+				const long row = (static_cast<long>(z - zBegin()) * ny + y) * nx;
+				int x = wrap(receiver.begin[0], nx);
+				for (int lx = 0; lx < receiver.size[0]; ++lx) {
+					_sendBuffer[index++] = zSlab[row + x].real();
+					x = x + 1 == nx ? 0 : x + 1;
+				}
+				y = y + 1 == ny ? 0 : y + 1;
+			}
+		}
+	}
+
+	exchangeBrickData(sendCounts, recvCounts);
+
+	// unpack the planes in the order of the processes owning them
+	const Brick& brick = _bricks[_rank];
+	const long brickPlaneLength = static_cast<long>(brick.size[0]) * brick.size[1];
+	std::vector<long> offsets(_numProcs, 0);
+	for (int rank = 1; rank < _numProcs; ++rank) {
+		offsets[rank] = offsets[rank - 1] + recvCounts[rank - 1];
+	}
+	brickData.resize(brickPlaneLength * brick.size[2]);
+	for (int lz = 0; lz < brick.size[2]; ++lz) {
+		long& offset = offsets[zOwner(wrap(brick.begin[2] + lz, _gridSize[2]))];
+		std::copy(_recvBuffer.begin() + offset, _recvBuffer.begin() + offset + brickPlaneLength,
+				brickData.begin() + lz * brickPlaneLength);
+		offset += brickPlaneLength;
+	}
+}
+
+void SlabFFT::forward(std::vector<std::complex<double>>& data) {
+	const int numZ = zEnd() - zBegin();
+	transformLines(data, numZ, {_gridSize[0], _gridSize[1]}, 0, _plans[0], false);
+	transformLines(data, numZ, {_gridSize[0], _gridSize[1]}, 1, _plans[1], false);
+	zSlabToYSlab(data);
+	transformLines(data, yEnd() - yBegin(), {_gridSize[0], _gridSize[2]}, 1, _plans[2], false);
+}
+
+void SlabFFT::backward(std::vector<std::complex<double>>& data) {
+	transformLines(data, yEnd() - yBegin(), {_gridSize[0], _gridSize[2]}, 1, _plans[2], true);
+	ySlabToZSlab(data);
+	const int numZ = zEnd() - zBegin();
+	transformLines(data, numZ, {_gridSize[0], _gridSize[1]}, 1, _plans[1], true);
+	transformLines(data, numZ, {_gridSize[0], _gridSize[1]}, 0, _plans[0], true);
+}
+
+void SlabFFT::zSlabToYSlab(std::vector<std::complex<double>>& data) {
+	const int nx = _gridSize[0];
+	const int ny = _gridSize[1];
+	const int nz = _gridSize[2];
+	const int numZ = zEnd() - zBegin();
+	const int numY = yEnd() - yBegin();
+
+	// pack the blocks [z][y of the receiver][x] in the order of the receivers
+	_transposeBuffer.resize(data.size());
+	long index = 0;
+	for (int rank = 0; rank < _numProcs; ++rank) {
+		for (int z = 0; z < numZ; ++z) {
+			for (int y = _yBegin[rank]; y < _yBegin[rank + 1]; ++y) {
+				for (int x = 0; x < nx; ++x) {
+					_transposeBuffer[index++] = data[(static_cast<long>(z) * ny + y) * nx + x];
+				}
+			}
+		}
+	}
+
+	data.resize(static_cast<long>(numY) * nz * nx);
+#ifdef ENABLE_MPI
+	if (_numProcs > 1) {
+		std::vector<int> sendCounts(_numProcs), sendDisplacements(_numProcs);
+		std::vector<int> recvCounts(_numProcs), recvDisplacements(_numProcs);
+		int sendOffset = 0;
+		int recvOffset = 0;
+		for (int rank = 0; rank < _numProcs; ++rank) {
+			// complex values are sent as two doubles
+			sendCounts[rank] = 2 * numZ * (_yBegin[rank + 1] - _yBegin[rank]) * nx;
+			recvCounts[rank] = 2 * (_zBegin[rank + 1] - _zBegin[rank]) * numY * nx;
+			sendDisplacements[rank] = sendOffset;
+			recvDisplacements[rank] = recvOffset;
+			sendOffset += sendCounts[rank];
+			recvOffset += recvCounts[rank];
+		}
+		std::vector<std::complex<double>> received(data.size());
+		MPI_Alltoallv(_transposeBuffer.data(), sendCounts.data(), sendDisplacements.data(), MPI_DOUBLE,
+				received.data(), recvCounts.data(), recvDisplacements.data(), MPI_DOUBLE, _domainDecomp->getCommunicator());
+		_transposeBuffer.swap(received);
+	}
+#endif
+
+	// unpack the blocks [z of the sender][y][x]
+	index = 0;
+	for (int rank = 0; rank < _numProcs; ++rank) {
+		for (int z = _zBegin[rank]; z < _zBegin[rank + 1]; ++z) {
+			for (int y = 0; y < numY; ++y) {
+				for (int x = 0; x < nx; ++x) {
+					data[(static_cast<long>(y) * nz + z) * nx + x] = _transposeBuffer[index++];
+				}
+			}
+		}
+	}
+}
+
+void SlabFFT::ySlabToZSlab(std::vector<std::complex<double>>& data) {
+	const int nx = _gridSize[0];
+	const int ny = _gridSize[1];
+	const int nz = _gridSize[2];
+	const int numZ = zEnd() - zBegin();
+	const int numY = yEnd() - yBegin();
+
+	// pack the blocks [z of the receiver][y][x] in the order of the receivers
+	_transposeBuffer.resize(data.size());
+	long index = 0;
+	for (int rank = 0; rank < _numProcs; ++rank) {
+		for (int z = _zBegin[rank]; z < _zBegin[rank + 1]; ++z) {
+			for (int y = 0; y < numY; ++y) {
+				for (int x = 0; x < nx; ++x) {
+					_transposeBuffer[index++] = data[(static_cast<long>(y) * nz + z) * nx + x];
+				}
+			}
+		}
+	}
+
+	data.resize(static_cast<long>(numZ) * ny * nx);
+#ifdef ENABLE_MPI
+	if (_numProcs > 1) {
+		std::vector<int> sendCounts(_numProcs), sendDisplacements(_numProcs);
+		std::vector<int> recvCounts(_numProcs), recvDisplacements(_numProcs);
+		int sendOffset = 0;
+		int recvOffset = 0;
+		for (int rank = 0; rank < _numProcs; ++rank) {
+			sendCounts[rank] = 2 * (_zBegin[rank + 1] - _zBegin[rank]) * numY * nx;
+			recvCounts[rank] = 2 * numZ * (_yBegin[rank + 1] - _yBegin[rank]) * nx;
+			sendDisplacements[rank] = sendOffset;
+			recvDisplacements[rank] = recvOffset;
+			sendOffset += sendCounts[rank];
+			recvOffset += recvCounts[rank];
+		}
+		std::vector<std::complex<double>> received(data.size());
+		MPI_Alltoallv(_transposeBuffer.data(), sendCounts.data(), sendDisplacements.data(), MPI_DOUBLE,
+				received.data(), recvCounts.data(), recvDisplacements.data(), MPI_DOUBLE, _domainDecomp->getCommunicator());
+		_transposeBuffer.swap(received);
+	}
+#endif
+
+	// unpack the blocks [z][y of the sender][x]
+	index = 0;
+	for (int rank = 0; rank < _numProcs; ++rank) {
+		for (int z = 0; z < numZ; ++z) {
+			for (int y = _yBegin[rank]; y < _yBegin[rank + 1]; ++y) {
+				for (int x = 0; x < nx; ++x) {
+					data[(static_cast<long>(z) * ny + y) * nx + x] = _transposeBuffer[index++];
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,127 @@
+#ifndef SLABFFT_H_
+#define SLABFFT_H_
+
+#include <array>
+#include <complex>
+#include <vector>
+
+class DomainDecompBase;
+
+/**
+ * Distributed 3D FFT of a grid with nx*ny*nz points (powers of two) for the SmoothParticleMeshEwald.
+ *
+ * The grid is distributed over the processes of the domain decomposition in slabs of z planes. The forward transform
+ * leaves its result transposed into slabs of y planes, which is the layout the backward transform expects, so
+ * every pair of transforms needs two global transpositions only. The 1D transforms are radix-2 transforms, which are
+ * parallelized over the grid lines with OpenMP.
+ *
+ * The input of the forward transform is not kept as a global grid: every process provides a brick, the box of grid
+ * points its local charges are spread to, which gatherBricks() sends to the owners of the z planes it overlaps.
+ * scatterBricks() returns the values of the same grid points after the backward transform, so the traffic scales with
+ * the local part of the grid and, for a decomposition along z, consists of the ghost planes at the slab boundaries.
+ *
+ * Layouts of the local data:
+ * - z slab: index ((z - zBegin()) * ny + y) * nx + x
+ * - y slab: index ((y - yBegin()) * nz + z) * nx + x
+ * - brick: index ((z - begin[2]) * size[1] + y - begin[1]) * size[0] + x - begin[0]
+ */
+class SlabFFT {
+public:
+	/**
+	 * Box of size[0] * size[1] * size[2] grid points starting at begin. The coordinates are not wrapped into the grid,
+	 * begin may be negative and a size may exceed the grid size, in which case the periodic images of a grid point
+	 * are contained more than once.
+	 */
+	struct Brick {
+		std::array<int, 3> begin;
+		std::array<int, 3> size;
+	};
+
+	SlabFFT(const std::array<int, 3>& gridSize, DomainDecompBase* domainDecomp);
+
+	static bool isPowerOfTwo(int n) {
+		return n > 0 and (n & (n - 1)) == 0;
+	}
+
+	const std::array<int, 3>& getGridSize() const {
+		return _gridSize;
+	}
+
+	int zBegin() const { return _zBegin[_rank]; }
+	int zEnd() const { return _zBegin[_rank + 1]; }
+	int yBegin() const { return _yBegin[_rank]; }
+	int yEnd() const { return _yBegin[_rank + 1]; }
+
+	/**
+	 * Sums up the bricks of all processes in the z slab of this process. Collective operation.
+	 */
+	void gatherBricks(const Brick& brick, const std::vector<double>& brickData, std::vector<std::complex<double>>& zSlab);
+
+	/**
+	 * Returns the real parts of the z slabs at the grid points of the brick of the last call of gatherBricks().
+	 * Collective operation.
+	 */
+	void scatterBricks(const std::vector<std::complex<double>>& zSlab, std::vector<double>& brickData);
+
+	/**
+	 * In: z slab, out: y slab. Uses exp(-2 pi i k m / n).
+	 */
+	void forward(std::vector<std::complex<double>>& data);
+
+	/**
+	 * In: y slab, out: z slab. Uses exp(+2 pi i k m / n) and is not normalized.
+	 */
+	void backward(std::vector<std::complex<double>>& data);
+
+private:
+	struct Plan1D {
+		std::vector<std::complex<double>> twiddles;
+		std::vector<int> bitReversal;
+	};
+
+	static Plan1D createPlan(int n);
+
+	static void transform(std::complex<double>* line, const Plan1D& plan, bool inverse);
+
+	/**
+	 * Transforms all lines along dimension dim of the local data with numPlanes planes of the size
+	 * planeSize[0] * planeSize[1], the lines being either the rows (dim 0) or columns (dim 1) of a plane.
+	 */
+	void transformLines(std::vector<std::complex<double>>& data, int numPlanes, const std::array<int, 2>& planeSize,
+			int dim, const Plan1D& plan, bool inverse);
+
+	static int wrap(int i, int n) {
+		const int wrapped = i % n;
+		return wrapped < 0 ? wrapped + n : wrapped;
+	}
+
+	//! process whose z slab contains the z plane
+	int zOwner(int z) const;
+
+	//! grid points of the own brick in the z slab of every process resp. of the brick of every process in the own z slab
+	void countBrickPoints(std::vector<int>& sendCounts, std::vector<int>& recvCounts) const;
+
+	//! sends the send buffer, ordered by the receiving processes, to the receive buffer
+	void exchangeBrickData(const std::vector<int>& sendCounts, const std::vector<int>& recvCounts);
+
+	void zSlabToYSlab(std::vector<std::complex<double>>& data);
+	void ySlabToZSlab(std::vector<std::complex<double>>& data);
+
+	std::array<int, 3> _gridSize;
+	std::array<Plan1D, 3> _plans;
+
+	DomainDecompBase* _domainDecomp;
+	int _rank;
+	int _numProcs;
+	//! first z plane resp. y plane of every process, and the grid size as last entry
+	std::vector<int> _zBegin;
+	std::vector<int> _yBegin;
+	//! bricks of all processes of the last call of gatherBricks()
+	std::vector<Brick> _bricks;
+
+	std::vector<std::complex<double>> _transposeBuffer;
+	std::vector<double> _sendBuffer;
+	std::vector<double> _recvBuffer;
+};
+
+#endif /* SLABFFT_H_ */
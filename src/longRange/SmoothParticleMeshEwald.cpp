@@ -0,0 +1,366 @@
+#include "longRange/SmoothParticleMeshEwald.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Domain.h"
+#include "Simulation.h"
+#include "ensemble/EnsembleBase.h"
+#include "longRange/EwaldRealSpaceCellProcessor.h"
+#include "longRange/SlabFFT.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+#include "utils/Logger.h"
+#include "utils/xmlfileUnits.h"
+
+using Log::global_log;
+using std::endl;
+
+SmoothParticleMeshEwald::SmoothParticleMeshEwald() :
+		_ewaldCoefficient(0.), _tolerance(1e-5), _order(4), _gridPoints(0), _gridSize{0, 0, 0}, _domain(nullptr),
+		_domainDecomp(nullptr), _boxLength{0., 0., 0.}, _realSpaceProcessor(nullptr), _fft(nullptr), _localUpot(0.),
+		_localVirial(0.) {
+}
+
+SmoothParticleMeshEwald::~SmoothParticleMeshEwald() {
+	delete _realSpaceProcessor;
+	delete _fft;
+}
+
+void SmoothParticleMeshEwald::readXML(XMLfileUnits& xmlconfig) {
+	xmlconfig.getNodeValue("ewaldCoefficient", _ewaldCoefficient);
+	xmlconfig.getNodeValue("tolerance", _tolerance);
+	xmlconfig.getNodeValue("order", _order);
+	xmlconfig.getNodeValue("gridPoints", _gridPoints);
+	global_log->info() << "SmoothParticleMeshEwald: order: " << _order << endl;
+	if (_gridPoints > 0) {
+		_gridSize = {_gridPoints, _gridPoints, _gridPoints};
+		global_log->info() << "SmoothParticleMeshEwald: gridPoints: " << _gridPoints << endl;
+	}
+}
+
+void SmoothParticleMeshEwald::setParameters(double ewaldCoefficient, int order, std::array<int, 3> gridSize) {
+	_ewaldCoefficient = ewaldCoefficient;
+	_order = order;
+	_gridSize = gridSize;
+}
+
+void SmoothParticleMeshEwald::init(Domain* domain, DomainDecompBase* domainDecomp, double cutoffRadius) {
+	_domain = domain;
+	_domainDecomp = domainDecomp;
+
+	for (const Component& component : *global_simulation->getEnsemble()->getComponents()) {
+		if (component.numDipoles() > 0 or component.numQuadrupoles() > 0) {
+			global_log->error() << "SmoothParticleMeshEwald: only charges are supported, component " << component.ID()
+					<< " has dipoles or quadrupoles" << endl;
+			Simulation::exit(5);
+		}
+	}
+	if (_order < 3 or _order > _maxOrder) {
+		global_log->error() << "SmoothParticleMeshEwald: order has to be between 3 and " << _maxOrder << endl;
+		Simulation::exit(5);
+	}
+
+	if (_ewaldCoefficient <= 0.) {
+		// erfc(beta * rc) = tolerance by bisection
+		double lower = 0.;
+		double upper = 10. / cutoffRadius;
+		for (int i = 0; i < 100; ++i) {
+			const double beta = 0.5 * (lower + upper);
+			if (std::erfc(beta * cutoffRadius) > _tolerance) {
+				lower = beta;
+			} else {
+				upper = beta;
+			}
+		}
+		_ewaldCoefficient = 0.5 * (lower + upper);
+	}
+	global_log->info() << "SmoothParticleMeshEwald: ewaldCoefficient: " << _ewaldCoefficient << endl;
+
+	for (int d = 0; d < 3; ++d) {
+		_boxLength[d] = _domain->getGlobalLength(d);
+		if (_gridSize[d] == 0) {
+			_gridSize[d] = 1;
+			while (_gridSize[d] < 8. * _boxLength[d] / cutoffRadius) {
+				_gridSize[d] *= 2;
+			}
+		}
+		if (not SlabFFT::isPowerOfTwo(_gridSize[d]) or _gridSize[d] < _order) {
+			global_log->error() << "SmoothParticleMeshEwald: the grid points have to be a power of two and at least the "
+					<< "order, got " << _gridSize[d] << endl;
+			Simulation::exit(5);
+		}
+	}
+	global_log->info() << "SmoothParticleMeshEwald: grid: " << _gridSize[0] << " x " << _gridSize[1] << " x "
+			<< _gridSize[2] << endl;
+
+	delete _fft;
+	_fft = new SlabFFT(_gridSize, _domainDecomp);
+	delete _realSpaceProcessor;
+	_realSpaceProcessor = new EwaldRealSpaceCellProcessor(*_domain, cutoffRadius, _ewaldCoefficient);
+
+	// influence function of the local y slab
+	std::array<std::vector<double>, 3> moduli;
+	for (int d = 0; d < 3; ++d) {
+		moduli[d] = computeSplineModuli(_gridSize[d]);
+	}
+	const double volume = _boxLength[0] * _boxLength[1] * _boxLength[2];
+	const double piOverBeta2 = M_PI * M_PI / (_ewaldCoefficient * _ewaldCoefficient);
+	const long slabLength = static_cast<long>(_fft->yEnd() - _fft->yBegin()) * _gridSize[2] * _gridSize[0];
+	_influence.resize(slabLength);
+	_virialFactor.resize(slabLength);
+	for (long i = 0; i < slabLength; ++i) {
+		const int m[3] = {static_cast<int>(i % _gridSize[0]),
+				_fft->yBegin() + static_cast<int>(i / (static_cast<long>(_gridSize[2]) * _gridSize[0])),
+				static_cast<int>((i / _gridSize[0]) % _gridSize[2])};
+		double m2 = 0.;
+		double b = 1.;
+		for (int d = 0; d < 3; ++d) {
+			const int mShifted = m[d] <= _gridSize[d] / 2 ? m[d] : m[d] - _gridSize[d];
+			m2 += (mShifted / _boxLength[d]) * (mShifted / _boxLength[d]);
+			b *= moduli[d][m[d]];
+		}
+		if (m2 == 0.) {
+			_influence[i] = 0.;
+			_virialFactor[i] = 0.;
+			continue;
+		}
+		_influence[i] = b * std::exp(-piOverBeta2 * m2) / (M_PI * volume * m2);
+		_virialFactor[i] = 1. - 2. * piOverBeta2 * m2;
+	}
+}
+
+void SmoothParticleMeshEwald::fillSplines(double w, int order, double* theta, double* dtheta) {
+	// order 2
+	theta[order - 1] = 0.;
+	theta[1] = w;
+	theta[0] = 1. - w;
+	// up to order - 1
+	for (int k = 3; k < order; ++k) {
+		const double div = 1. / (k - 1);
+		theta[k - 1] = div * w * theta[k - 2];
+		for (int j = 1; j < k - 1; ++j) {
+			theta[k - j - 1] = div * ((w + j) * theta[k - j - 2] + (k - j - w) * theta[k - j - 1]);
+		}
+		theta[0] = div * (1. - w) * theta[0];
+	}
+	// the derivatives are differences of the splines of one order less
+	dtheta[0] = -theta[0];
+	for (int j = 1; j < order; ++j) {
+		dtheta[j] = theta[j - 1] - theta[j];
+	}
+	const double div = 1. / (order - 1);
+	theta[order - 1] = div * w * theta[order - 2];
+	for (int j = 1; j < order - 1; ++j) {
+		theta[order - j - 1] = div * ((w + j) * theta[order - j - 2] + (order - j - w) * theta[order - j - 1]);
+	}
+	theta[0] = div * (1. - w) * theta[0];
+}
+
+void SmoothParticleMeshEwald::computeSplines(const std::array<double, 3>& position, Splines& splines) const {
+	for (int d = 0; d < 3; ++d) {
+		const double u = _gridSize[d] * position[d] / _boxLength[d];
+		const double base = std::floor(u);
+		fillSplines(u - base, _order, splines.theta[d].data(), splines.dtheta[d].data());
+		splines.first[d] = static_cast<int>(base) - _order + 1;
+	}
+}
+
+std::vector<double> SmoothParticleMeshEwald::computeSplineModuli(int numGridPoints) const {
+	// M_n(k + 1) for k = 0, ..., n - 2
+	double theta[_maxOrder];
+	double dtheta[_maxOrder];
+	fillSplines(0., _order, theta, dtheta);
+
+	std::vector<double> moduli(numGridPoints);
+	for (int m = 0; m < numGridPoints; ++m) {
+		double sumCos = 0.;
+		double sumSin = 0.;
+		for (int k = 0; k < _order - 1; ++k) {
+			const double arg = 2. * M_PI * m * k / numGridPoints;
+			sumCos += theta[_order - 2 - k] * std::cos(arg);
+			sumSin += theta[_order - 2 - k] * std::sin(arg);
+		}
+		moduli[m] = sumCos * sumCos + sumSin * sumSin;
+	}
+	// interpolate the (for odd orders) vanishing denominators from their neighbours
+	for (int m = 0; m < numGridPoints; ++m) {
+		if (moduli[m] < 1e-7) {
+			moduli[m] = 0.5 * (moduli[(m - 1 + numGridPoints) % numGridPoints] + moduli[(m + 1) % numGridPoints]);
+		}
+	}
+	for (double& modulus : moduli) {
+		modulus = 1. / modulus;
+	}
+	return moduli;
+}
+
+void SmoothParticleMeshEwald::computeElectrostatics(ParticleContainer* moleculeContainer) {
+	global_simulation->timers()->start("SMOOTH_PARTICLE_MESH_EWALD_REAL_SPACE");
+	moleculeContainer->traverseCells(*_realSpaceProcessor);
+	global_simulation->timers()->stop("SMOOTH_PARTICLE_MESH_EWALD_REAL_SPACE");
+
+	global_simulation->timers()->start("SMOOTH_PARTICLE_MESH_EWALD_RECIPROCAL_SPACE");
+	computeReciprocalSpace(moleculeContainer);
+	global_simulation->timers()->stop("SMOOTH_PARTICLE_MESH_EWALD_RECIPROCAL_SPACE");
+
+	_localUpot += _realSpaceProcessor->getUpot();
+	_localVirial += _realSpaceProcessor->getVirial();
+}
+
+void SmoothParticleMeshEwald::computeReciprocalSpace(ParticleContainer* moleculeContainer) {
+	// the local charges are spread to the grid points between the first spline of the lowest and the last spline of
+	// the highest site, which are not wrapped into the grid
+	int lower[3] = {std::numeric_limits<int>::max(), std::numeric_limits<int>::max(), std::numeric_limits<int>::max()};
+	int upper[3] = {std::numeric_limits<int>::min(), std::numeric_limits<int>::min(), std::numeric_limits<int>::min()};
+	#if defined(_OPENMP)
+	#pragma omp parallel reduction(min:lower[:3]) reduction(max:upper[:3])
+	#endif
+	for (auto molecule = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); molecule.isValid(); ++molecule) {
+		for (unsigned i = 0; i < molecule->numCharges(); ++i) {
+			const std::array<double, 3> site = molecule->charge_d_abs(i);
+			for (int d = 0; d < 3; ++d) {
+				const int base = static_cast<int>(std::floor(_gridSize[d] * site[d] / _boxLength[d]));
+				lower[d] = std::min(lower[d], base);
+				upper[d] = std::max(upper[d], base);
+			}
+		}
+	}
+	SlabFFT::Brick brick{{0, 0, 0}, {0, 0, 0}};
+	if (lower[0] <= upper[0]) {
+		for (int d = 0; d < 3; ++d) {
+			brick.begin[d] = lower[d] - _order + 1;
+			brick.size[d] = upper[d] - lower[d] + _order;
+		}
+	}
+	const int sx = brick.size[0];
+	const int sy = brick.size[1];
+	_brickGrid.assign(static_cast<long>(sx) * sy * brick.size[2], 0.);
+
+	// spread the charges of the local molecules on the grid
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		Splines splines;
+		for (auto molecule = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); molecule.isValid(); ++molecule) {
+			for (unsigned i = 0; i < molecule->numCharges(); ++i) {
+				const double q = molecule->component()->charge(i).q();
+				computeSplines(molecule->charge_d_abs(i), splines);
+				const int x0 = splines.first[0] - brick.begin[0];
+				const int y0 = splines.first[1] - brick.begin[1];
+				const int z0 = splines.first[2] - brick.begin[2];
+				for (int c = 0; c < _order; ++c) {
+					const double qz = q * splines.theta[2][c];
+					for (int b = 0; b < _order; ++b) {
+						const double qyz = qz * splines.theta[1][b];
+						const long row = (static_cast<long>(z0 + c) * sy + y0 + b) * sx + x0;
+						for (int a = 0; a < _order; ++a) {
+							#if defined(_OPENMP)
+							#pragma omp atomic
+							#endif
+							_brickGrid[row + a] += qyz * splines.theta[0][a];
+						}
+					}
+				}
+			}
+		}
+	}
+
+	_fft->gatherBricks(brick, _brickGrid, _slab);
+	_fft->forward(_slab);
+
+	double upot = 0.;
+	double virial = 0.;
+	if (_fft->yBegin() == 0 and not _slab.empty()) {
+		// neutralizing background of a charged system; the zero wave vector is the total charge
+		const double totalCharge = _slab[0].real();
+		const double volume = _boxLength[0] * _boxLength[1] * _boxLength[2];
+		upot = -M_PI * totalCharge * totalCharge / (2. * volume * _ewaldCoefficient * _ewaldCoefficient);
+		virial = 3. * upot;
+	}
+	const long slabLength = _slab.size();
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static) reduction(+:upot, virial)
+	#endif
+	for (long i = 0; i < slabLength; ++i) {
+		const double energy = 0.5 * _influence[i] * std::norm(_slab[i]);
+		upot += energy;
+		virial += energy * _virialFactor[i];
+		_slab[i] *= _influence[i];
+	}
+
+	_fft->backward(_slab);
+	_fft->scatterBricks(_slab, _brickGrid);
+
+	// forces from the potential grid, self energy and intramolecular corrections
+	const double beta = _ewaldCoefficient;
+	const double twoBetaOverSqrtPi = 2. * beta / std::sqrt(M_PI);
+	const double scale[3] = {_gridSize[0] / _boxLength[0], _gridSize[1] / _boxLength[1], _gridSize[2] / _boxLength[2]};
+	#if defined(_OPENMP)
+	#pragma omp parallel reduction(+:upot, virial)
+	#endif
+	{
+		Splines splines;
+		for (auto molecule = moleculeContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); molecule.isValid(); ++molecule) {
+			const unsigned numCharges = molecule->numCharges();
+			for (unsigned i = 0; i < numCharges; ++i) {
+				const double q = molecule->component()->charge(i).q();
+				const std::array<double, 3> site = molecule->charge_d_abs(i);
+				computeSplines(site, splines);
+				const int x0 = splines.first[0] - brick.begin[0];
+				const int y0 = splines.first[1] - brick.begin[1];
+				const int z0 = splines.first[2] - brick.begin[2];
+				double f[3] = {0., 0., 0.};
+				for (int c = 0; c < _order; ++c) {
+					for (int b = 0; b < _order; ++b) {
+						const long row = (static_cast<long>(z0 + c) * sy + y0 + b) * sx + x0;
+						for (int a = 0; a < _order; ++a) {
+							const double phi = _brickGrid[row + a];
+							f[0] += splines.dtheta[0][a] * splines.theta[1][b] * splines.theta[2][c] * phi;
+							f[1] += splines.theta[0][a] * splines.dtheta[1][b] * splines.theta[2][c] * phi;
+							f[2] += splines.theta[0][a] * splines.theta[1][b] * splines.dtheta[2][c] * phi;
+						}
+					}
+				}
+				for (int d = 0; d < 3; ++d) {
+					f[d] *= -q * scale[d];
+					// the virial of the wave vectors is the one of the sites, the molecular one uses the centers
+					virial -= (site[d] - molecule->r(d)) * f[d];
+				}
+				molecule->Fchargeadd(i, f);
+
+				upot -= q * q * beta / std::sqrt(M_PI);
+
+				// the reciprocal space part contains the interaction within the molecule
+				for (unsigned j = i + 1; j < numCharges; ++j) {
+					const double qq = q * molecule->component()->charge(j).q();
+					const std::array<double, 3> site2 = molecule->charge_d_abs(j);
+					double dr[3];
+					double dr2 = 0.;
+					for (int d = 0; d < 3; ++d) {
+						dr[d] = site[d] - site2[d];
+						dr2 += dr[d] * dr[d];
+					}
+					const double r = std::sqrt(dr2);
+					const double shielded = qq * std::erf(beta * r) / r;
+					upot -= shielded;
+					const double fac = (qq * twoBetaOverSqrtPi * std::exp(-beta * beta * dr2) - shielded) / dr2;
+					double fIntra[3];
+					for (int d = 0; d < 3; ++d) {
+						fIntra[d] = fac * dr[d];
+					}
+					molecule->Fchargeadd(i, fIntra);
+					molecule->Fchargesub(j, fIntra);
+				}
+			}
+		}
+	}
+
+	_localUpot = upot;
+	_localVirial = virial;
+	_domain->setLocalUpot(_domain->getLocalUpot() + upot);
+	_domain->setLocalVirial(_domain->getLocalVirial() + virial);
+}
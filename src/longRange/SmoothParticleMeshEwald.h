@@ -0,0 +1,117 @@
+#ifndef SMOOTHPARTICLEMESHEWALD_H_
+#define SMOOTHPARTICLEMESHEWALD_H_
+
+#include <array>
+#include <complex>
+#include <vector>
+
+class Domain;
+class DomainDecompBase;
+class EwaldRealSpaceCellProcessor;
+class ParticleContainer;
+class SlabFFT;
+class XMLfileUnits;
+
+/**
+ * Smooth particle mesh Ewald (SPME) summation of the charges (Essmann et al., J. Chem. Phys. 103, 8577 (1995)) as an
+ * alternative to the FastMultipoleMethod for periodic systems.
+ *
+ * The Coulomb interaction is split into
+ * - the real space part, the screened interaction erfc(beta r) / r of the molecule pairs within the cutoff radius,
+ *   computed by an EwaldRealSpaceCellProcessor on the linked cells,
+ * - the reciprocal space part, computed by interpolating the charges with cardinal B-splines on a regular grid, which
+ *   is transformed by a distributed SlabFFT,
+ * - the self energy of the charges, the erf(beta r) / r interaction of the charges within a molecule, which has to be
+ *   removed from the reciprocal space part, and the interaction with the neutralizing background of a charged system.
+ *
+ * The forces are added to the charge sites, so computeElectrostatics() has to be called before the site forces are
+ * summed up to the molecules. The potential energy and virial are added to the local values of the domain.
+ * Dipoles and quadrupoles are not supported.
+ */
+class SmoothParticleMeshEwald {
+public:
+	SmoothParticleMeshEwald();
+	~SmoothParticleMeshEwald();
+
+	/** @brief Read in XML configuration for SmoothParticleMeshEwald.
+	 *
+	 * The following xml object structure is handled by this method:
+	 * \code{.xml}
+	   <electrostatic type="SmoothParticleMeshEwald">
+		 <!-- if no ewaldCoefficient is given, it is chosen such that erfc(ewaldCoefficient * rc) = tolerance -->
+		 <ewaldCoefficient>DOUBLE</ewaldCoefficient>
+		 <tolerance>DOUBLE</tolerance>                <!-- default 1e-5 -->
+		 <order>INTEGER</order>                       <!-- order of the B-splines, 3 to 12, default 4 -->
+		 <!-- grid points per dimension, a power of two; by default the smallest power of two for a spacing of rc/8 -->
+		 <gridPoints>INTEGER</gridPoints>
+	   </electrostatic>
+	   \endcode
+	 */
+	void readXML(XMLfileUnits& xmlconfig);
+
+	void setParameters(double ewaldCoefficient, int order, std::array<int, 3> gridSize);
+
+	/**
+	 * Sets up the grid and the influence function for the current box, which must not change afterwards.
+	 */
+	void init(Domain* domain, DomainDecompBase* domainDecomp, double cutoffRadius);
+
+	void computeElectrostatics(ParticleContainer* moleculeContainer);
+
+	double getEwaldCoefficient() const { return _ewaldCoefficient; }
+	const std::array<int, 3>& getGridSize() const { return _gridSize; }
+
+	//! local potential energy and virial of the last call of computeElectrostatics()
+	double getLocalUpot() const { return _localUpot; }
+	double getLocalVirial() const { return _localVirial; }
+
+private:
+	static constexpr int _maxOrder = 12;
+
+	struct Splines {
+		std::array<std::array<double, _maxOrder>, 3> theta;
+		std::array<std::array<double, _maxOrder>, 3> dtheta;
+		//! grid point of the first spline, not wrapped into the grid
+		std::array<int, 3> first;
+	};
+
+	/**
+	 * Values and derivatives of the B-splines of the given order at w + order - 1 - j for j = 0, ..., order - 1,
+	 * with 0 <= w < 1.
+	 */
+	static void fillSplines(double w, int order, double* theta, double* dtheta);
+
+	void computeSplines(const std::array<double, 3>& position, Splines& splines) const;
+
+	//! |b(m)|^2 of the Euler exponential splines of one dimension
+	std::vector<double> computeSplineModuli(int numGridPoints) const;
+
+	void computeReciprocalSpace(ParticleContainer* moleculeContainer);
+
+	double _ewaldCoefficient;
+	double _tolerance;
+	int _order;
+	int _gridPoints;
+	std::array<int, 3> _gridSize;
+
+	Domain* _domain;
+	DomainDecompBase* _domainDecomp;
+	std::array<double, 3> _boxLength;
+
+	EwaldRealSpaceCellProcessor* _realSpaceProcessor;
+	SlabFFT* _fft;
+
+	//! charges resp. potential at the grid points the local charges are spread to, see SlabFFT::Brick
+	std::vector<double> _brickGrid;
+	//! local slab of the transformed grid
+	std::vector<std::complex<double>> _slab;
+	//! B(m) C(m) of the local y slab
+	std::vector<double> _influence;
+	//! contribution of every wave vector of the local y slab to the virial, relative to its energy
+	std::vector<double> _virialFactor;
+
+	double _localUpot;
+	double _localVirial;
+};
+
+#endif /* SMOOTHPARTICLEMESHEWALD_H_ */
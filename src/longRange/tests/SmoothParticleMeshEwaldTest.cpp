@@ -0,0 +1,148 @@
+/*
+ * SmoothParticleMeshEwaldTest.cpp
+ */
+
+#include "SmoothParticleMeshEwaldTest.h"
+
+#include <cmath>
+#include <complex>
+
+#include "longRange/SlabFFT.h"
+#include "longRange/SmoothParticleMeshEwald.h"
+#include "molecules/Molecule.h"
+#include "parallel/DomainDecompBase.h"
+#include "particleContainer/ParticleContainer.h"
+
+TEST_SUITE_REGISTRATION(SmoothParticleMeshEwaldTest);
+
+SmoothParticleMeshEwaldTest::SmoothParticleMeshEwaldTest() {
+}
+
+SmoothParticleMeshEwaldTest::~SmoothParticleMeshEwaldTest() {
+}
+
+void SmoothParticleMeshEwaldTest::testSlabFFT() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "SmoothParticleMeshEwaldTest::testSlabFFT() not executed (more than 1 proc)" << std::endl;
+		return;
+	}
+	const std::array<int, 3> gridSize = {4, 8, 2};
+	const int numPoints = gridSize[0] * gridSize[1] * gridSize[2];
+	std::vector<std::complex<double>> input(numPoints);
+	for (int i = 0; i < numPoints; ++i) {
+		input[i] = std::complex<double>(std::sin(1.3 * i), std::cos(0.7 * i * i));
+	}
+
+	SlabFFT fft(gridSize, _domainDecomposition);
+	std::vector<std::complex<double>> data(input);
+	fft.forward(data);
+	for (int y = 0; y < gridSize[1]; ++y) {
+		for (int z = 0; z < gridSize[2]; ++z) {
+			for (int x = 0; x < gridSize[0]; ++x) {
+				std::complex<double> expected(0., 0.);
+				for (int i = 0; i < numPoints; ++i) {
+					const int ix = i % gridSize[0];
+					const int iy = (i / gridSize[0]) % gridSize[1];
+					const int iz = i / (gridSize[0] * gridSize[1]);
+					const double phase = -2. * M_PI * (static_cast<double>(ix * x) / gridSize[0]
+							+ static_cast<double>(iy * y) / gridSize[1] + static_cast<double>(iz * z) / gridSize[2]);
+					expected += input[i] * std::complex<double>(std::cos(phase), std::sin(phase));
+				}
+				const std::complex<double> actual = data[(y * gridSize[2] + z) * gridSize[0] + x];
+				ASSERT_DOUBLES_EQUAL(expected.real(), actual.real(), 1e-10);
+				ASSERT_DOUBLES_EQUAL(expected.imag(), actual.imag(), 1e-10);
+			}
+		}
+	}
+
+	fft.backward(data);
+	for (int i = 0; i < numPoints; ++i) {
+		ASSERT_DOUBLES_EQUAL(numPoints * input[i].real(), data[i].real(), 1e-10);
+		ASSERT_DOUBLES_EQUAL(numPoints * input[i].imag(), data[i].imag(), 1e-10);
+	}
+}
+
+void SmoothParticleMeshEwaldTest::compute(double cutoff, double ewaldCoefficient, DomainDecompBase* domainDecomp,
+		double& upot, std::map<unsigned long, std::array<double, 3>>& forces) {
+	ParticleContainer* container = ParticleContainerFactory::createInitializedParticleContainer(
+			ParticleContainerFactory::LinkedCell, _domain, domainDecomp, cutoff, getTestDataFilename("FMMCharge.inp"),
+			false);
+	domainDecomp->exchangeMolecules(container, _domain);
+	container->updateMoleculeCaches();
+
+	SmoothParticleMeshEwald spme;
+	spme.setParameters(ewaldCoefficient, 8, {32, 32, 32});
+	spme.init(_domain, domainDecomp, cutoff);
+	spme.computeElectrostatics(container);
+	upot = spme.getLocalUpot();
+
+	forces.clear();
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		m->calcFM();
+		forces[m->getID()] = {m->F(0), m->F(1), m->F(2)};
+	}
+	delete container;
+}
+
+void SmoothParticleMeshEwaldTest::testIndependentOfEwaldCoefficient() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "SmoothParticleMeshEwaldTest::testIndependentOfEwaldCoefficient() not executed (more than 1 proc)"
+				<< std::endl;
+		return;
+	}
+	double upot1, upot2;
+	std::map<unsigned long, std::array<double, 3>> forces1, forces2;
+	compute(4., 1.0, _domainDecomposition, upot1, forces1);
+
+	// reset variables, which are not visible here
+	tearDown();
+	setUp();
+
+	compute(4., 1.4, _domainDecomposition, upot2, forces2);
+
+	ASSERT_DOUBLES_EQUAL(upot1, upot2, 1e-6 * std::fabs(upot1));
+	ASSERT_EQUAL(forces1.size(), forces2.size());
+	for (const auto& force : forces1) {
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_DOUBLES_EQUAL(force.second[d], forces2[force.first][d], 1e-5);
+		}
+	}
+}
+
+void SmoothParticleMeshEwaldTest::testParallelMatchesSerial() {
+	if (_domainDecomposition->getNumProcs() == 1) {
+		test_log->info() << "SmoothParticleMeshEwaldTest::testParallelMatchesSerial() only compares the distributed grid "
+				<< "with more than one process" << std::endl;
+	}
+	// small enough for the subdomains of eight processes
+	const double cutoff = 2.;
+	double parallelUpot;
+	std::map<unsigned long, std::array<double, 3>> parallelForces;
+	compute(cutoff, 1.4, _domainDecomposition, parallelUpot, parallelForces);
+	_domainDecomposition->collCommInit(2);
+	_domainDecomposition->collCommAppendDouble(parallelUpot);
+	_domainDecomposition->collCommAppendUnsLong(parallelForces.size());
+	_domainDecomposition->collCommAllreduceSum();
+	parallelUpot = _domainDecomposition->collCommGetDouble();
+	const unsigned long numMolecules = _domainDecomposition->collCommGetUnsLong();
+	_domainDecomposition->collCommFinalize();
+
+	// reset variables, which are not visible here
+	tearDown();
+	setUp();
+
+	// every process computes the complete system
+	DomainDecompBase serialDecomposition;
+	double serialUpot;
+	std::map<unsigned long, std::array<double, 3>> serialForces;
+	compute(cutoff, 1.4, &serialDecomposition, serialUpot, serialForces);
+
+	ASSERT_DOUBLES_EQUAL(serialUpot, parallelUpot, 1e-10 * std::fabs(serialUpot));
+	ASSERT_EQUAL(serialForces.size(), numMolecules);
+	for (const auto& force : parallelForces) {
+		ASSERT_EQUAL(1ul, serialForces.count(force.first));
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_DOUBLES_EQUAL(serialForces[force.first][d], force.second[d], 1e-10);
+		}
+	}
+}
@@ -0,0 +1,49 @@
+/*
+ * SmoothParticleMeshEwaldTest.h
+ */
+
+#ifndef SRC_LONGRANGE_TESTS_SMOOTHPARTICLEMESHEWALDTEST_H_
+#define SRC_LONGRANGE_TESTS_SMOOTHPARTICLEMESHEWALDTEST_H_
+
+#include <array>
+#include <map>
+
+#include "utils/TestWithSimulationSetup.h"
+
+class SmoothParticleMeshEwaldTest : public utils::TestWithSimulationSetup {
+	TEST_SUITE(SmoothParticleMeshEwaldTest);
+	TEST_METHOD(testSlabFFT);
+	TEST_METHOD(testIndependentOfEwaldCoefficient);
+	TEST_METHOD(testParallelMatchesSerial);
+	TEST_SUITE_END();
+
+public:
+	SmoothParticleMeshEwaldTest();
+	virtual ~SmoothParticleMeshEwaldTest();
+
+	/**
+	 * Compares the distributed FFT with a direct discrete Fourier transform.
+	 */
+	void testSlabFFT();
+
+	/**
+	 * The splitting into real and reciprocal space must not change the energy and forces of the charged system of
+	 * FMMCharge.inp (with its neutralizing background).
+	 */
+	void testIndependentOfEwaldCoefficient();
+
+	/**
+	 * The energy and forces of the distributed grid have to match the ones of a single process computing the
+	 * complete system. Only meaningful with more than one process.
+	 */
+	void testParallelMatchesSerial();
+
+private:
+	/**
+	 * Computes the local energy and the forces of the local molecules, by molecule id, of FMMCharge.inp.
+	 */
+	void compute(double cutoff, double ewaldCoefficient, DomainDecompBase* domainDecomp, double& upot,
+			std::map<unsigned long, std::array<double, 3>>& forces);
+};
+
+#endif /* SRC_LONGRANGE_TESTS_SMOOTHPARTICLEMESHEWALDTEST_H_ */
@@ -71,6 +71,12 @@ public:
 
 	void setupSoACache(CellDataSoABase* const s, unsigned iLJ, unsigned iC, unsigned iD, unsigned iQ) override {}
 
+	bool isSoACacheValid(const CellDataSoABase* const s, unsigned iLJ, unsigned iC, unsigned iD, unsigned iQ) const override {
+		return false;
+	}
+
+	void updateSoACache() override {}
+
 	void setSoA(CellDataSoABase* const s) override{};
 
 	void setStartIndexSoA_LJ(unsigned i) override{};
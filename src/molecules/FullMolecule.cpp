@@ -719,6 +719,23 @@ void FullMolecule::setupSoACache(CellDataSoABase* const s, unsigned iLJ, unsigne
 	setStartIndexSoA_D(iD);
 	setStartIndexSoA_Q(iQ);
 
+	fillSoACache(true);
+}
+
+bool FullMolecule::isSoACacheValid(const CellDataSoABase* const s, unsigned iLJ, unsigned iC,
+		unsigned iD, unsigned iQ) const {
+	if (_soa != s or _soa_index_lj != iLJ or _soa_index_c != iC or _soa_index_d != iD or _soa_index_q != iQ) {
+		return false;
+	}
+	// the component might have been changed since
+	return numLJcenters() == 0 or _soa->_ljc_id[_soa_index_lj] == getComponentLookUpID();
+}
+
+void FullMolecule::updateSoACache() {
+	fillSoACache(false);
+}
+
+void FullMolecule::fillSoACache(bool centerProperties) {
 	normalizeQuaternion();
 
 	unsigned ns = numLJcenters();
@@ -730,7 +747,11 @@ void FullMolecule::setupSoACache(CellDataSoABase* const s, unsigned iLJ, unsigne
 
 		const unsigned ind = _soa_index_lj + j;
 
-		_soa->pushBackLJC(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), getComponentLookUpID() + j);
+		if (centerProperties) {
+			_soa->pushBackLJC(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), getComponentLookUpID() + j);
+		} else {
+			_soa->updateLJC(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos));
+		}
 	}
 	ns = numCharges();
 	for (unsigned j = 0; j < ns; ++j) {
@@ -741,7 +762,11 @@ void FullMolecule::setupSoACache(CellDataSoABase* const s, unsigned iLJ, unsigne
 
 		const unsigned ind = _soa_index_c + j;
 
-		_soa->pushBackCharge(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), component()->charge(j).q());
+		if (centerProperties) {
+			_soa->pushBackCharge(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), component()->charge(j).q());
+		} else {
+			_soa->updateCharge(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos));
+		}
 	}
 	ns = numDipoles();
 	for (unsigned j = 0; j < ns; ++j) {
@@ -753,7 +778,11 @@ void FullMolecule::setupSoACache(CellDataSoABase* const s, unsigned iLJ, unsigne
 		std::array<double,3> orientation = computeDipole_e(j);
 		const unsigned ind = _soa_index_d + j;
 
-		_soa->pushBackDipole(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), component()->dipole(j).absMy(), convert_double_to_vcp_real_calc(orientation));
+		if (centerProperties) {
+			_soa->pushBackDipole(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), component()->dipole(j).absMy(), convert_double_to_vcp_real_calc(orientation));
+		} else {
+			_soa->updateDipole(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), convert_double_to_vcp_real_calc(orientation));
+		}
 	}
 	ns = numQuadrupoles();
 	for (unsigned j = 0; j < ns; ++j) {
@@ -765,6 +794,10 @@ void FullMolecule::setupSoACache(CellDataSoABase* const s, unsigned iLJ, unsigne
 		std::array<double,3> orientation = computeQuadrupole_e(j);
 		const unsigned ind = _soa_index_q + j;
 
-		_soa->pushBackQuadrupole(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), component()->quadrupole(j).absQ(), convert_double_to_vcp_real_calc(orientation));
+		if (centerProperties) {
+			_soa->pushBackQuadrupole(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), component()->quadrupole(j).absQ(), convert_double_to_vcp_real_calc(orientation));
+		} else {
+			_soa->updateQuadrupole(ind, convert_double_to_vcp_real_calc(r_arr()), convert_double_to_vcp_real_calc(centerPos), convert_double_to_vcp_real_calc(orientation));
+		}
 	}
 }
@@ -122,6 +122,8 @@ public:
 	double U_kin() override { return U_trans() + U_rot(); }
 	
 	void setupSoACache(CellDataSoABase * s, unsigned iLJ, unsigned iC, unsigned iD, unsigned iQ) override;
+	bool isSoACacheValid(const CellDataSoABase * s, unsigned iLJ, unsigned iC, unsigned iD, unsigned iQ) const override;
+	void updateSoACache() override;
 
 	void setSoA(CellDataSoABase * s) override;
 	void setStartIndexSoA_LJ(unsigned i) override {_soa_index_lj = i;}
@@ -337,6 +339,9 @@ protected:
 	/** calculate forces and moments for already given site forces, for this precise site */
 	void calcFM_site(const std::array<double, 3>& d, const std::array<double, 3>& F);
 
+	/** write the positions and orientations of the centers to the SoA, their component data only if centerProperties */
+	void fillSoACache(bool centerProperties);
+
     Component *_component;  /**< IDentification number of its component type */
 	double _r[3];  /**< position coordinates */
 	double _F[3];  /**< forces */
@@ -106,6 +106,10 @@ public:
 	virtual void updateMassInertia() = 0;
 
 	virtual void setupSoACache(CellDataSoABase * const s, unsigned iLJ, unsigned iC, unsigned iD, unsigned iQ) = 0;
+	/** true, if the molecule is still stored at the given start indices of s by its last setupSoACache() */
+	virtual bool isSoACacheValid(const CellDataSoABase * const s, unsigned iLJ, unsigned iC, unsigned iD, unsigned iQ) const = 0;
+	/** write the current positions and orientations of the centers to the SoA of the last setupSoACache() */
+	virtual void updateSoACache() = 0;
 
 	virtual void setSoA(CellDataSoABase * const s) = 0;
 	virtual void setStartIndexSoA_LJ(unsigned i) = 0;
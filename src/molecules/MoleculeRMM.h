@@ -143,6 +143,14 @@ public:
 		_soa_index = iLJ;
 	}
 
+	bool isSoACacheValid(const CellDataSoABase * const /*s*/, unsigned /*iLJ*/, unsigned /*iC*/, unsigned /*iD*/, unsigned /*iQ*/) const override {
+		return false;
+	}
+
+	void updateSoACache() override {
+		mardyn_assert(false);
+	}
+
 	void setSoA(CellDataSoABase * s) override;
 
 	void setStartIndexSoA_LJ(unsigned i) override {
@@ -10,7 +10,9 @@
 #include "Simulation.h"
 #include "ensemble/EnsembleBase.h"
 
+#include <algorithm>
 #include <climits> /* UINT64_MAX */
+#include <cmath>
 
 #ifdef ENABLE_REDUCED_MEMORY_MODE
 // position, velocity, id
@@ -33,6 +35,15 @@ size_t CommunicationBuffer::_numBytesHalo = 7 * sizeof(double) + sizeof(int)
 		;
 size_t CommunicationBuffer::_numBytesForces = sizeof(unsigned long) + 12 * sizeof(double);
 #endif
+// compact halo encoding: cid, fixed-point position, packed orientation (without the optional id)
+size_t CommunicationBuffer::_numBytesHaloCompact = sizeof(uint16_t) + 3 * sizeof(uint32_t) + sizeof(uint64_t);
+
+namespace {
+// bits per component of the compressed quaternions, the remaining two store the index of the omitted component
+constexpr int quaternionBits = 20;
+constexpr uint64_t quaternionMax = (uint64_t(1) << quaternionBits) - 1;
+constexpr double fixedPointMax = 4294967295.;
+}
 
 
 unsigned char* CommunicationBuffer::getDataForSending() {
@@ -47,21 +58,121 @@ void CommunicationBuffer::clear() {
 	_numHalo = 0;
 	_numLeaving = 0;
 	_numForces = 0;
+	_haloEncoding = HaloEncoding::FULL;
 	_buffer.clear();
 }
 
+void CommunicationBuffer::setCompactHalo(const double low[3], const double high[3], bool withIds) {
+	mardyn_assert(_numLeaving == 0ul and _numHalo == 0ul);
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	mardyn_assert(false);
+#endif
+	_haloEncoding = withIds ? HaloEncoding::COMPACT : HaloEncoding::COMPACT_WITHOUT_IDS;
+	for (int d = 0; d < 3; ++d) {
+		_haloOrigin[d] = low[d];
+		_haloResolution[d] = (high[d] - low[d]) / fixedPointMax;
+	}
+}
+
+size_t CommunicationBuffer::getHeaderSize() const {
+	size_t ret = sizeof(_numLeaving) + sizeof(_numHalo) + sizeof(_haloEncoding);
+	if (isCompactHalo()) {
+		ret += sizeof(_haloOrigin) + sizeof(_haloResolution);
+	}
+	return ret;
+}
+
+size_t CommunicationBuffer::getNumBytesHalo() const {
+	switch (_haloEncoding) {
+	case HaloEncoding::COMPACT:
+		return _numBytesHaloCompact + sizeof(unsigned long);
+	case HaloEncoding::COMPACT_WITHOUT_IDS:
+		return _numBytesHaloCompact;
+	default:
+		return _numBytesHalo;
+	}
+}
+
+void CommunicationBuffer::emplaceHeader() {
+	size_t i_runningByte = 0;
+	i_runningByte = emplaceValue(i_runningByte, _numLeaving);
+	i_runningByte = emplaceValue(i_runningByte, _numHalo);
+	i_runningByte = emplaceValue(i_runningByte, _haloEncoding);
+	if (isCompactHalo()) {
+		for (int d = 0; d < 3; ++d) {
+			i_runningByte = emplaceValue(i_runningByte, _haloOrigin[d]);
+		}
+		for (int d = 0; d < 3; ++d) {
+			i_runningByte = emplaceValue(i_runningByte, _haloResolution[d]);
+		}
+	}
+}
+
+uint64_t CommunicationBuffer::packQuaternion(double qw, double qx, double qy, double qz) {
+	// the largest component is omitted and restored from the norm, the others lie within [-1/sqrt(2), 1/sqrt(2)]
+	const double q[4] = {qw, qx, qy, qz};
+	int largest = 0;
+	for (int i = 1; i < 4; ++i) {
+		if (std::abs(q[i]) > std::abs(q[largest])) {
+			largest = i;
+		}
+	}
+	// q and -q describe the same rotation, so the omitted component can be made positive
+	const double sign = q[largest] < 0. ? -1. : 1.;
+	uint64_t packed = largest;
+	int shift = 2;
+	for (int i = 0; i < 4; ++i) {
+		if (i == largest) {
+			continue;
+		}
+		const double scaled = std::min(std::max(sign * q[i] * M_SQRT2, -1.), 1.);
+		const uint64_t value = std::llround((scaled + 1.) * 0.5 * quaternionMax);
+		packed |= value << shift;
+		shift += quaternionBits;
+	}
+	return packed;
+}
+
+void CommunicationBuffer::unpackQuaternion(uint64_t packed, double q[4]) {
+	const int largest = packed & 3;
+	int shift = 2;
+	double sumSquares = 0.;
+	for (int i = 0; i < 4; ++i) {
+		if (i == largest) {
+			continue;
+		}
+		const uint64_t value = (packed >> shift) & quaternionMax;
+		q[i] = (2. * value / quaternionMax - 1.) * M_SQRT1_2;
+		sumSquares += q[i] * q[i];
+		shift += quaternionBits;
+	}
+	q[largest] = std::sqrt(std::max(0., 1. - sumSquares));
+}
+
 void CommunicationBuffer::resizeForRawBytes(unsigned long numBytes) {
-	_buffer.reserve(numBytes);
+	// grow geometrically, the leaving and halo molecules are appended one after the other in every exchange
+	if (numBytes > _buffer.capacity()) {
+		_buffer.reserve(std::max<size_t>(numBytes, 2 * _buffer.capacity()));
+	}
 	_buffer.resize(numBytes);
 }
 
 void CommunicationBuffer::resizeForReceivingMolecules(unsigned long& numLeaving, unsigned long& numHalo) { // adjust for force exchange?
 	// message has been received
 
-	// read _numHalo and _numLeaving
+	// read _numHalo, _numLeaving and the halo encoding
 	size_t i_runningByte = 0;
 	i_runningByte = readValue(i_runningByte, _numLeaving);
 	i_runningByte = readValue(i_runningByte, _numHalo);
+	i_runningByte = readValue(i_runningByte, _haloEncoding);
+	if (isCompactHalo()) {
+		for (int d = 0; d < 3; ++d) {
+			i_runningByte = readValue(i_runningByte, _haloOrigin[d]);
+		}
+		for (int d = 0; d < 3; ++d) {
+			i_runningByte = readValue(i_runningByte, _haloResolution[d]);
+		}
+	}
 	numLeaving = _numLeaving;
 	numHalo = _numHalo;
 }
@@ -79,27 +190,25 @@ void CommunicationBuffer::resizeForReceivingMolecules(unsigned long& numForces)
 void CommunicationBuffer::resizeForAppendingLeavingMolecules(unsigned long numLeaving) { 
 	_numLeaving += numLeaving;
 	mardyn_assert(_numHalo == 0ul); // assumption: add leaving, add leaving, then add halo, halo, halo, ... but not intertwined.
-	size_t numBytes = sizeof(_numHalo) + sizeof(_numLeaving) +
+	size_t numBytes = getHeaderSize() +
 				_numLeaving * _numBytesLeaving +
-				_numHalo * _numBytesHalo;
+				_numHalo * getNumBytesHalo();
 	resizeForRawBytes(numBytes);
 
-	// store _numLeaving
-	size_t i_runningByte = 0;
-	i_runningByte = emplaceValue(i_runningByte, _numLeaving);
+	// store _numLeaving, _numHalo and the halo encoding
+	emplaceHeader();
 }
 
 void CommunicationBuffer::resizeForAppendingHaloMolecules(unsigned long numHalo) { 
 	// _numLeaving stays
 	_numHalo += numHalo;
-	size_t numBytes = sizeof(_numHalo) + sizeof(_numLeaving) +
+	size_t numBytes = getHeaderSize() +
 				_numLeaving * _numBytesLeaving +
-				_numHalo * _numBytesHalo;
+				_numHalo * getNumBytesHalo();
 	resizeForRawBytes(numBytes);
 
-	// store _numHalo
-	size_t i_runningByte = sizeof(_numLeaving);
-	i_runningByte = emplaceValue(i_runningByte, _numHalo);
+	// store _numLeaving, _numHalo and the halo encoding
+	emplaceHeader();
 }
 
 void CommunicationBuffer::resizeForAppendingForceMolecules(unsigned long numForces) {
@@ -148,13 +257,44 @@ void CommunicationBuffer::addLeavingMolecule(size_t indexOfMolecule, const Molec
 	mardyn_assert(i_runningByte - i_firstByte == _numBytesLeaving);
 }
 
-void CommunicationBuffer::addHaloMolecule(size_t indexOfMolecule, const Molecule& m) {
+void CommunicationBuffer::addHaloMolecule(size_t indexOfMolecule, const Molecule& m, const double regionLow[3],
+										  const double regionHigh[3]) {
 	mardyn_assert(indexOfMolecule < _numHalo);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::HALO, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesHalo <= _buffer.capacity());
+	mardyn_assert(i_firstByte + getNumBytesHalo() <= _buffer.capacity());
 
 	size_t i_runningByte = i_firstByte;
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	if (isCompactHalo()) {
+		if (_haloEncoding == HaloEncoding::COMPACT) {
+			i_runningByte = emplaceValue(i_runningByte, m.getID());
+		}
+		mardyn_assert(m.componentid() <= UINT16_MAX);
+		i_runningByte = emplaceValue(i_runningByte, static_cast<uint16_t>(m.componentid()));
+		for (int d = 0; d < 3; ++d) {
+			// positions slightly outside the box, e.g. due to the halo position check, are clamped
+			const double scaled = _haloResolution[d] > 0. ? (m.r(d) - _haloOrigin[d]) / _haloResolution[d] : 0.;
+			const double clamped = std::min(std::max(scaled, 0.), fixedPointMax);
+			long long fixedPoint = std::llround(clamped);
+			if (regionLow != nullptr and regionHigh != nullptr) {
+				for (const double bound : {regionLow[d], regionHigh[d]}) {
+					const double decoded = _haloOrigin[d] + static_cast<double>(fixedPoint) * _haloResolution[d];
+					if (m.r(d) < bound and decoded >= bound and fixedPoint > 0) {
+						--fixedPoint;
+					} else if (m.r(d) >= bound and decoded < bound and fixedPoint < fixedPointMax) {
+						++fixedPoint;
+					}
+				}
+			}
+			i_runningByte = emplaceValue(i_runningByte, static_cast<uint32_t>(fixedPoint));
+		}
+		i_runningByte = emplaceValue(i_runningByte, packQuaternion(m.q().qw(), m.q().qx(), m.q().qy(), m.q().qz()));
+		mardyn_assert(i_runningByte - i_firstByte == getNumBytesHalo());
+		return;
+	}
+#endif
+
 #ifdef ENABLE_REDUCED_MEMORY_MODE
 	#ifdef LS1_SEND_UNIQUE_ID_FOR_HALO_COPIES
 		i_runningByte = emplaceValue(i_runningByte, m.getID());
@@ -271,10 +411,40 @@ void CommunicationBuffer::readHaloMolecule(size_t indexOfMolecule, Molecule& m)
 	mardyn_assert(indexOfMolecule < _numHalo);
 
 	size_t i_firstByte = getStartPosition(ParticleType_t::HALO, indexOfMolecule);
-	mardyn_assert(i_firstByte + _numBytesHalo <= _buffer.capacity());
+	mardyn_assert(i_firstByte + getNumBytesHalo() <= _buffer.capacity());
 
 	// add id, r, v
 	size_t i_runningByte = i_firstByte;
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+	if (isCompactHalo()) {
+		unsigned long idbuf = UINT64_MAX;
+		uint16_t cidbuf;
+		uint32_t rbuf[3];
+		uint64_t qbuf;
+		if (_haloEncoding == HaloEncoding::COMPACT) {
+			i_runningByte = readValue(i_runningByte, idbuf);
+		}
+		i_runningByte = readValue(i_runningByte, cidbuf);
+		i_runningByte = readValue(i_runningByte, rbuf[0]);
+		i_runningByte = readValue(i_runningByte, rbuf[1]);
+		i_runningByte = readValue(i_runningByte, rbuf[2]);
+		i_runningByte = readValue(i_runningByte, qbuf);
+		double q[4];
+		unpackQuaternion(qbuf, q);
+		Component* component = _simulation.getEnsemble()->getComponent(cidbuf);
+		m = Molecule(idbuf, component,
+			_haloOrigin[0] + rbuf[0] * _haloResolution[0],
+			_haloOrigin[1] + rbuf[1] * _haloResolution[1],
+			_haloOrigin[2] + rbuf[2] * _haloResolution[2],
+			0., 0., 0.,
+			q[0], q[1], q[2], q[3],
+			0., 0., 0.
+		);
+		mardyn_assert(i_runningByte - i_firstByte == getNumBytesHalo());
+		return;
+	}
+#endif
+
 #ifdef ENABLE_REDUCED_MEMORY_MODE
 	unsigned long idbuf;
 	vcp_real_calc rbuf[3];
@@ -377,13 +547,13 @@ void CommunicationBuffer::readForceMolecule(size_t indexOfMolecule, Molecule& m)
 size_t CommunicationBuffer::getStartPosition(ParticleType_t type, size_t indexOfMolecule) const {
 	size_t ret = 0;
 
-	// two unsigned longs
-	ret += sizeof(_numLeaving) + sizeof(_numHalo);
+	// three unsigned longs and the box of the compact halo encoding
+	ret += getHeaderSize();
 
 	if(type == ParticleType_t::LEAVING) {
 		ret += indexOfMolecule * _numBytesLeaving;
 	} else if(type == ParticleType_t::HALO) {
-		ret += _numLeaving * _numBytesLeaving + indexOfMolecule * _numBytesHalo;
+		ret += _numLeaving * _numBytesLeaving + indexOfMolecule * getNumBytesHalo();
 	} else if(type == ParticleType_t::FORCE) {
 		// the number of forces is NOT stored in the buffer, as they are sent on their own!
 		ret = indexOfMolecule * _numBytesForces;
@@ -11,6 +11,7 @@
 #include "molecules/MoleculeForwardDeclaration.h" 
 #include "utils/mardyn_assert.h" 
 
+#include <cstdint>
 #include <vector>
 #include <stddef.h>
 #include <mpi.h>
@@ -33,6 +34,9 @@
  * due to CHAR conversion.
  *
  * Stores two unsigned long integers, then leaving molecules, then halo molecules.
+ *
+ * The halo molecules can optionally be stored in a compact encoding, see setCompactHalo(). The encoding is stored as a
+ * third unsigned long in the header, followed by the box of the fixed-point positions in the compact case.
  */
 class CommunicationBuffer {
 
@@ -56,7 +60,13 @@ public:
 
 	// write
 	void addLeavingMolecule(size_t indexOfMolecule, const Molecule& m);
-	void addHaloMolecule(size_t indexOfMolecule, const Molecule& m);
+	/**
+	 * With the compact encoding, the rounded position is kept on the same side of the bounds of the (shifted) region
+	 * the molecule was copied from, if given. The receiver assigns the molecule to its halo regions by its position
+	 * and sends the forces of zonal methods back with the shift of that region.
+	 */
+	void addHaloMolecule(size_t indexOfMolecule, const Molecule& m, const double regionLow[3] = nullptr,
+						 const double regionHigh[3] = nullptr);
         void addForceMolecule(size_t indexOfMolecule, const Molecule& m);
 
 	// read
@@ -67,6 +77,25 @@ public:
 	void resizeForReceivingMolecules(unsigned long& numLeaving, unsigned long& numHalo); 
 	void resizeForReceivingMolecules(unsigned long& numForces);
 
+	/**
+	 * Use the compact encoding for the halo molecules: the positions as 32 bit fixed-point numbers within the box
+	 * [low, high], which has to contain all halo molecules, the orientations as compressed unit quaternions of 64 bit,
+	 * the component ids as 16 bit integers and the ids only if withIds is set. The resolution of the positions is
+	 * (high - low) / 2^32, the one of the quaternion components about 1e-6.
+	 * Has to be called before the molecules are appended, clear() resets the encoding to the full one.
+	 * Not available with ENABLE_REDUCED_MEMORY_MODE.
+	 */
+	void setCompactHalo(const double low[3], const double high[3], bool withIds);
+
+	bool isCompactHalo() const {
+		return _haloEncoding != HaloEncoding::FULL;
+	}
+
+	//! whether the halo molecules carry their ids, otherwise they are set to UINT64_MAX
+	bool hasHaloIds() const {
+		return _haloEncoding != HaloEncoding::COMPACT_WITHOUT_IDS;
+	}
+
 	size_t getNumHalo() const {
 		return _numHalo;
 	}
@@ -91,6 +120,18 @@ private:
 	enum class ParticleType_t {HALO=0, LEAVING=1, FORCE=3};
 	size_t getStartPosition(ParticleType_t type, size_t indexOfMolecule) const;
 
+	enum HaloEncoding : unsigned long {FULL = 0, COMPACT = 1, COMPACT_WITHOUT_IDS = 2};
+	static size_t _numBytesHaloCompact;
+
+	//! size of the header in bytes, depends on the halo encoding
+	size_t getHeaderSize() const;
+	//! size of a halo molecule in bytes, depends on the halo encoding
+	size_t getNumBytesHalo() const;
+	void emplaceHeader();
+
+	static uint64_t packQuaternion(double qw, double qx, double qy, double qz);
+	static void unpackQuaternion(uint64_t packed, double q[4]);
+
 	/**
 	 * @return the next index for writing
 	 */
@@ -103,6 +144,10 @@ private:
 	typedef unsigned char byte_t;
 	std::vector<byte_t> _buffer;
 	size_t _numLeaving, _numHalo, _numForces;
+
+	unsigned long _haloEncoding;
+	//! origin and resolution of the fixed-point positions of the compact halo encoding
+	double _haloOrigin[3], _haloResolution[3];
 };
 
 template<typename T>
@@ -6,7 +6,10 @@
  */
 
 #include "CommunicationPartner.h"
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <limits>
 #include <sstream>
 #include "Domain.h"
 #include "ForceHelper.h"
@@ -17,6 +20,44 @@
 #include "parallel/DomainDecompBase.h"
 #include "particleContainer/ParticleContainer.h"
 
+namespace {
+// molecules which do not fit into a persistent channel are sent separately with the overflow tag
+constexpr int messageTag = 99;
+constexpr int overflowTag = 98;
+
+/**
+ * The fixed-point positions of the compact halo encoding can move a halo copy, which is closer to the own box than
+ * their resolution, onto the boundary of the box. Such a copy is moved back across the nearest face.
+ */
+void moveOutOfOwnBox(Molecule& m, ParticleContainer* moleculeContainer) {
+	double low[3], high[3];
+	for (int d = 0; d < 3; ++d) {
+		low[d] = moleculeContainer->getBoundingBoxMin(d);
+		high[d] = moleculeContainer->getBoundingBoxMax(d);
+	}
+	if (not m.inBox(low, high)) {
+		return;
+	}
+	int nearestDim = 0;
+	bool lowerFace = true;
+	double nearestDistance = std::numeric_limits<double>::max();
+	for (int d = 0; d < 3; ++d) {
+		if (m.r(d) - low[d] < nearestDistance) {
+			nearestDistance = m.r(d) - low[d];
+			nearestDim = d;
+			lowerFace = true;
+		}
+		if (high[d] - m.r(d) < nearestDistance) {
+			nearestDistance = high[d] - m.r(d);
+			nearestDim = d;
+			lowerFace = false;
+		}
+	}
+	const double face = lowerFace ? low[nearestDim] : high[nearestDim];
+	m.setr(nearestDim, lowerFace ? std::nexttoward(face, face - 1.) : face);
+}
+}
+
 CommunicationPartner::CommunicationPartner(const int r, const double hLo[3], const double hHi[3], const double bLo[3],
 		const double bHi[3], const double sh[3], const int offset[3], const bool enlarged[3][2]) {
 	_rank = r;
@@ -43,6 +84,10 @@ CommunicationPartner::CommunicationPartner(const int r, const double hLo[3], con
 	_recvStatus = new MPI_Status;
 	_isSending = _msgSent = _isReceiving = _countReceived = _msgReceived = false;
 	_countTested = 0;
+	_probeTag = messageTag;
+	_sendChannel = _recvChannel = nullptr;
+	_compactHaloCopies = false;
+	_haloCopiesWithIds = true;
 }
 
 CommunicationPartner::CommunicationPartner(const int r) {
@@ -69,6 +114,10 @@ CommunicationPartner::CommunicationPartner(const int r) {
 	_recvStatus = new MPI_Status;
 	_isSending = _msgSent = _isReceiving = _countReceived = _msgReceived = false;
 	_countTested = 0;
+	_probeTag = messageTag;
+	_sendChannel = _recvChannel = nullptr;
+	_compactHaloCopies = false;
+	_haloCopiesWithIds = true;
 }
 
 CommunicationPartner::CommunicationPartner(const int r, const double leavingLo[3], const double leavingHigh[3]) {
@@ -94,6 +143,10 @@ CommunicationPartner::CommunicationPartner(const int r, const double leavingLo[3
 	_recvStatus = new MPI_Status;
 	_isSending = _msgSent = _isReceiving = _countReceived = _msgReceived = false;
 	_countTested = 0;
+	_probeTag = messageTag;
+	_sendChannel = _recvChannel = nullptr;
+	_compactHaloCopies = false;
+	_haloCopiesWithIds = true;
 }
 
 CommunicationPartner::CommunicationPartner(const CommunicationPartner& o) {
@@ -108,6 +161,10 @@ CommunicationPartner::CommunicationPartner(const CommunicationPartner& o) {
 	_recvStatus = new MPI_Status;
 	_isSending = _msgSent = _isReceiving = _countReceived = _msgReceived = false;
 	_countTested = 0;
+	_probeTag = messageTag;
+	_sendChannel = _recvChannel = nullptr;
+	_compactHaloCopies = false;
+	_haloCopiesWithIds = true;
 }
 
 CommunicationPartner& CommunicationPartner::operator =(const CommunicationPartner& o) {
@@ -125,11 +182,19 @@ CommunicationPartner& CommunicationPartner::operator =(const CommunicationPartne
 		_recvStatus = new MPI_Status;
 		_isSending = _msgSent = _isReceiving = _countReceived = _msgReceived = false;
 		_countTested = 0;
+		_probeTag = messageTag;
+		// the channels belong to the old partner, they have to be agreed on anew
+		freePersistentChannels();
+		_sendChannels = _recvChannels = {};
+		_sendChannel = _recvChannel = nullptr;
+		_compactHaloCopies = false;
+		_haloCopiesWithIds = true;
 	}
 	return *this;
 }
 
 CommunicationPartner::~CommunicationPartner() {
+	freePersistentChannels();
 	delete _sendRequest;
 	delete _recvRequest;
 	delete _sendStatus;
@@ -140,9 +205,97 @@ void CommunicationPartner::initSend(ParticleContainer* moleculeContainer, const
 									const MPI_Datatype& type, MessageType msgType,
 									std::vector<Molecule>& invalidParticles, bool mightUseInvalidParticles,
 									bool doHaloPositionCheck, bool removeFromContainer) {
+	collectMolecules(moleculeContainer, msgType, invalidParticles, mightUseInvalidParticles, doHaloPositionCheck,
+					 removeFromContainer);
+
+	MPI_CHECK(MPI_Isend(_sendBuf.getDataForSending(), (int ) _sendBuf.getNumElementsForSending(), _sendBuf.getMPIDataType(), _rank, messageTag, comm, _sendRequest));
+	_msgSent = false;
+	_isSending = true;
+}
+
+void CommunicationPartner::initSendPersistent(ParticleContainer* moleculeContainer, const MPI_Comm& comm,
+											  MessageType msgType, std::vector<Molecule>& invalidParticles,
+											  bool mightUseInvalidParticles, bool doHaloPositionCheck) {
+	collectMolecules(moleculeContainer, msgType, invalidParticles, mightUseInvalidParticles, doHaloPositionCheck,
+					 false);
+
+	PersistentChannel& channel = _sendChannels[msgType];
+	preparePersistentChannel(channel, comm, true);
+
+	const unsigned long numBytes = _sendBuf.getNumElementsForSending();
+	std::memcpy(channel.buffer.data(), &numBytes, sizeof(numBytes));
+	if (numBytes <= channel.capacity) {
+		std::memcpy(channel.buffer.data() + sizeof(numBytes), _sendBuf.getDataForSending(), numBytes);
+		*_sendRequest = MPI_REQUEST_NULL;
+	} else {
+		// the channel only tells the partner how many bytes follow in the overflow message
+		MPI_CHECK(MPI_Isend(_sendBuf.getDataForSending(), (int ) numBytes, _sendBuf.getMPIDataType(), _rank, overflowTag, comm, _sendRequest));
+		channel.capacity = grownCapacity(numBytes, channel.capacity);
+	}
+	MPI_CHECK(MPI_Start(&channel.request));
+	_sendChannel = &channel;
+	_msgSent = false;
+	_isSending = true;
+}
+
+unsigned long CommunicationPartner::initSendCollective(ParticleContainer* moleculeContainer, MessageType msgType,
+													   std::vector<Molecule>& invalidParticles,
+													   bool mightUseInvalidParticles, bool doHaloPositionCheck) {
+	collectMolecules(moleculeContainer, msgType, invalidParticles, mightUseInvalidParticles, doHaloPositionCheck,
+					 false);
+	// nothing is pending, the caller sends the message
+	*_sendRequest = MPI_REQUEST_NULL;
+	_msgSent = true;
+	_isSending = false;
+	return _sendBuf.getNumElementsForSending();
+}
+
+void CommunicationPartner::moveCollectedBytes(unsigned char* destination) {
+	std::memcpy(destination, _sendBuf.getDataForSending(), _sendBuf.getNumElementsForSending());
+	_sendBuf.clear();
+}
+
+void CommunicationPartner::initRecvCollective(const unsigned char* data, unsigned long numBytes) {
+	resetReceive();
+	_recvBuf.resizeForRawBytes(numBytes);
+	std::memcpy(_recvBuf.getDataForSending(), data, numBytes);
+	// testRecv() finds the message completed
+	*_recvRequest = MPI_REQUEST_NULL;
+	_countReceived = true;
+	_countTested = 0;
+}
+
+void CommunicationPartner::collectMolecules(ParticleContainer* moleculeContainer, MessageType msgType,
+											std::vector<Molecule>& invalidParticles, bool mightUseInvalidParticles,
+											bool doHaloPositionCheck, bool removeFromContainer) {
 	global_log->debug() << _rank << std::endl;
 	_sendBuf.clear();
 
+	if (_compactHaloCopies and (msgType == LEAVING_AND_HALO_COPIES or msgType == HALO_COPIES)) {
+		// the shifted copy regions contain all halo copies
+		double low[3], high[3];
+		for (int d = 0; d < 3; ++d) {
+			low[d] = std::numeric_limits<double>::max();
+			high[d] = std::numeric_limits<double>::lowest();
+			for (const PositionInfo& info : _haloInfo) {
+				low[d] = std::min(low[d], info._copiesLow[d] + info._shift[d]);
+				high[d] = std::max(high[d], info._copiesHigh[d] + info._shift[d]);
+			}
+		}
+		// With a force exchange, the forces of the halo molecules are sent back and added to the original molecules,
+		// which are found by their position and checked by their id (see ForceHelper). The fixed-point positions have
+		// to be within the tolerance of getMoleculeAtPosition() then, otherwise the full encoding is used.
+		const bool forceExchange = moleculeContainer->requiresForceExchange();
+		bool resolutionSufficient = true;
+		for (int d = 0; d < 3; ++d) {
+			resolutionSufficient &= (high[d] - low[d]) / 4294967295. <= moleculeContainer->getCutoff() * 1e-6;
+		}
+		if (not forceExchange or resolutionSufficient) {
+			// molecules of overlapping regions are sent twice, the receiver removes the duplicates by their ids
+			_sendBuf.setCompactHalo(low, high, _haloCopiesWithIds or forceExchange or _haloInfo.size() > 1);
+		}
+	}
+
 	const unsigned int numHaloInfo = _haloInfo.size();
 	switch (msgType){
 		case MessageType::LEAVING_AND_HALO_COPIES: {
@@ -220,19 +373,23 @@ void CommunicationPartner::initSend(ParticleContainer* moleculeContainer, const
 
 
 	#endif
-
-	MPI_CHECK(MPI_Isend(_sendBuf.getDataForSending(), (int ) _sendBuf.getNumElementsForSending(), _sendBuf.getMPIDataType(), _rank, 99, comm, _sendRequest));
-	_msgSent = false;
-	_isSending = true;
 }
 
 bool CommunicationPartner::testSend() {
 	if (not _msgSent) {
 		int flag = 0;
+		if (_sendChannel != nullptr) {
+			// the persistent request becomes inactive when it completes, testing it again returns immediately
+			MPI_CHECK(MPI_Test(&_sendChannel->request, &flag, _sendStatus));
+			if (flag == 0) {
+				return false;
+			}
+		}
 		MPI_CHECK(MPI_Test(_sendRequest, &flag, _sendStatus)); // THIS CAUSES A SEG FAULT IN PUSH_PULL_NEIGHBOURS
 		if (flag == 1) {
 			_msgSent = true;
 			_isSending = false;
+			_sendChannel = nullptr;
 			_sendBuf.clear();
 		}
 	}
@@ -241,13 +398,89 @@ bool CommunicationPartner::testSend() {
 
 void CommunicationPartner::resetReceive() {
 	_countReceived = _msgReceived = _isReceiving = false;
+	_probeTag = messageTag;
+	_recvChannel = nullptr;
+}
+
+void CommunicationPartner::initRecvPersistent(const MPI_Comm& comm, MessageType msgType) {
+	resetReceive();
+	PersistentChannel& channel = _recvChannels[msgType];
+	preparePersistentChannel(channel, comm, false);
+	MPI_CHECK(MPI_Start(&channel.request));
+	_recvChannel = &channel;
+	_isReceiving = true;
+}
+
+void CommunicationPartner::testRecvPersistent() {
+	int flag = 0;
+	MPI_CHECK(MPI_Test(&_recvChannel->request, &flag, _recvStatus));
+	if (flag == 0) {
+		return;
+	}
+	PersistentChannel& channel = *_recvChannel;
+	_recvChannel = nullptr;
+	unsigned long numBytes;
+	std::memcpy(&numBytes, channel.buffer.data(), sizeof(numBytes));
+	if (numBytes <= channel.capacity) {
+		_recvBuf.resizeForRawBytes(numBytes);
+		std::memcpy(_recvBuf.getDataForSending(), channel.buffer.data() + sizeof(numBytes), numBytes);
+		// testRecv() finds the message completed
+		*_recvRequest = MPI_REQUEST_NULL;
+		_countReceived = true;
+		_countTested = 0;
+	} else {
+		// same growth as on the sending side
+		channel.capacity = grownCapacity(numBytes, channel.capacity);
+		_probeTag = overflowTag;
+	}
+}
+
+void CommunicationPartner::preparePersistentChannel(PersistentChannel& channel, const MPI_Comm& comm, bool send) {
+	const size_t size = sizeof(unsigned long) + channel.capacity;
+	if (channel.request != MPI_REQUEST_NULL and channel.buffer.size() == size) {
+		return;
+	}
+	if (channel.request != MPI_REQUEST_NULL) {
+		MPI_CHECK(MPI_Request_free(&channel.request));
+	}
+	channel.buffer.resize(size);
+	if (send) {
+		MPI_CHECK(MPI_Send_init(channel.buffer.data(), (int ) size, _sendBuf.getMPIDataType(), _rank, messageTag, comm, &channel.request));
+	} else {
+		MPI_CHECK(MPI_Recv_init(channel.buffer.data(), (int ) size, _sendBuf.getMPIDataType(), _rank, messageTag, comm, &channel.request));
+	}
+}
+
+void CommunicationPartner::freePersistentChannels() {
+	int finalized = 0;
+	MPI_Finalized(&finalized);
+	if (finalized) {
+		return;
+	}
+	for (auto channels : {&_sendChannels, &_recvChannels}) {
+		for (PersistentChannel& channel : *channels) {
+			if (channel.request != MPI_REQUEST_NULL) {
+				MPI_CHECK(MPI_Request_free(&channel.request));
+			}
+		}
+	}
+}
+
+unsigned long CommunicationPartner::grownCapacity(unsigned long numBytes, unsigned long capacity) {
+	return std::max(numBytes + numBytes / 2, 2 * capacity);
 }
 
 bool CommunicationPartner::iprobeCount(const MPI_Comm& comm, const MPI_Datatype& /*type*/) {
 	if (not _countReceived) {
 		_isReceiving = true;
+		if (_recvChannel != nullptr) {
+			testRecvPersistent();
+			if (_recvChannel != nullptr or _countReceived) {
+				return _countReceived;
+			}
+		}
 		int flag = 0;
-		MPI_CHECK(MPI_Iprobe(_rank, 99, comm, &flag, _recvStatus));
+		MPI_CHECK(MPI_Iprobe(_rank, _probeTag, comm, &flag, _recvStatus));
 		if (flag != 0) {
 			_countReceived = true;
 			_countTested = 0;
@@ -258,7 +491,7 @@ bool CommunicationPartner::iprobeCount(const MPI_Comm& comm, const MPI_Datatype&
                                 global_log->debug() << "Preparing to receive " << numrecv << " bytes." << std::endl;
                         #endif
 			_recvBuf.resizeForRawBytes(numrecv);
-			MPI_CHECK(MPI_Irecv(_recvBuf.getDataForSending(), numrecv, _sendBuf.getMPIDataType(), _rank, 99, comm, _recvRequest));
+			MPI_CHECK(MPI_Irecv(_recvBuf.getDataForSending(), numrecv, _sendBuf.getMPIDataType(), _rank, _probeTag, comm, _recvRequest));
 		}
 	}
 	return _countReceived;
@@ -322,7 +555,11 @@ bool CommunicationPartner::testRecv(ParticleContainer* moleculeContainer, bool r
 					} else {
 						// halo
 						_recvBuf.readHaloMolecule(i - numLeaving, m);
-						moleculeContainer->addHaloParticle(m, false, removeRecvDuplicates);
+						if (_recvBuf.isCompactHalo()) {
+							moveOutOfOwnBox(m, moleculeContainer);
+						}
+						// without ids, the sender ensured that there are no duplicates
+						moleculeContainer->addHaloParticle(m, false, removeRecvDuplicates and _recvBuf.hasHaloIds());
 					}
 				}
 			} else { // Buffer is force data
@@ -397,7 +634,7 @@ void CommunicationPartner::initRecv(int numParticles, const MPI_Comm& comm, cons
 	// hackaround - resizeForAppendingLeavingMolecules is intended for the send-buffer, not the recv one.
 	_recvBuf.resizeForAppendingLeavingMolecules(numParticles);
 
-	MPI_CHECK(MPI_Irecv(_recvBuf.getDataForSending(), _recvBuf.getNumElementsForSending(), _sendBuf.getMPIDataType(), _rank, 99, comm, _recvRequest));
+	MPI_CHECK(MPI_Irecv(_recvBuf.getDataForSending(), _recvBuf.getNumElementsForSending(), _sendBuf.getMPIDataType(), _rank, messageTag, comm, _recvRequest));
 }
 
 void CommunicationPartner::deadlockDiagnosticSendRecv() {
@@ -437,7 +674,6 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 													bool doHaloPositionCheck) {
 	using std::vector;
 	global_simulation->timers()->start("COMMUNICATION_PARTNER_INIT_SEND");
-	vector<vector<Molecule>> threadData;
 	vector<int> prefixArray;
 
 	// compute how many molecules are already in of this type: - adjust for Forces
@@ -451,7 +687,7 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 	}
 
 	#if defined (_OPENMP)
-	#pragma omp parallel shared(threadData, numMolsAlreadyIn)
+	#pragma omp parallel shared(numMolsAlreadyIn)
 	#endif
 	{
 		// in the case of an autopas container, we only want to iterate over inner particle cells if we are sending
@@ -468,7 +704,7 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 		#pragma omp master
 		#endif
 		{
-			threadData.resize(numThreads);
+			_threadData.resize(numThreads);
 			prefixArray.resize(numThreads + 1);
 		}
 
@@ -476,17 +712,20 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 		#pragma omp barrier
 		#endif
 
+		std::vector<Molecule>& threadData = _threadData[threadNum];
+		threadData.clear();
+
 		for (auto i = begin; i.isValid(); ++i) {
 			//traverse and gather all molecules in the cells containing part of the box specified as parameter
 			//i is a pointer to a Molecule; (*i) is the Molecule
-			threadData[threadNum].push_back(*i);
+			threadData.push_back(*i);
 			mardyn_assert(i->inBox(lowCorner, highCorner));
 			if (removeFromContainer) {
 				moleculeContainer->deleteMolecule(i, false);
 			}
 		}
 
-		prefixArray[threadNum + 1] = threadData[threadNum].size();
+		prefixArray[threadNum + 1] = threadData.size();
 
 		#if defined (_OPENMP)
 		#pragma omp barrier
@@ -502,7 +741,7 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 			prefixArray[0] = 0;
 			for(int i = 1; i <= numThreads; i++){
 				prefixArray[i] += prefixArray[i - 1];
-				totalNumMolsAppended += threadData[i - 1].size();
+				totalNumMolsAppended += _threadData[i - 1].size();
 			}
 
 			//resize the send buffer
@@ -522,10 +761,16 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 
 		Domain* domain = global_simulation->getDomain();
 
+		double shiftedLow[3], shiftedHigh[3];
+		for (int dim = 0; dim < 3; dim++) {
+			shiftedLow[dim] = lowCorner[dim] + shift[dim];
+			shiftedHigh[dim] = highCorner[dim] + shift[dim];
+		}
+
 		//reduce the molecules in the send buffer and also apply the shift
 		int myThreadMolecules = prefixArray[threadNum + 1] - prefixArray[threadNum];
 		for(int i = 0; i < myThreadMolecules; i++){
-			Molecule mCopy = threadData[threadNum][i];
+			Molecule mCopy = threadData[i];
 			mCopy.move(0, shift[0]);
 			mCopy.move(1, shift[1]);
 			mCopy.move(2, shift[2]);
@@ -569,7 +814,7 @@ void CommunicationPartner::collectMoleculesInRegion(ParticleContainer* moleculeC
 			if (haloLeaveCorr == HaloOrLeavingCorrection::LEAVING) {
 				_sendBuf.addLeavingMolecule(numMolsAlreadyIn + prefixArray[threadNum] + i, mCopy);
 			} else if (haloLeaveCorr == HaloOrLeavingCorrection::HALO) {
-				_sendBuf.addHaloMolecule(numMolsAlreadyIn + prefixArray[threadNum] + i, mCopy);
+				_sendBuf.addHaloMolecule(numMolsAlreadyIn + prefixArray[threadNum] + i, mCopy, shiftedLow, shiftedHigh);
 			} else if (haloLeaveCorr == HaloOrLeavingCorrection::FORCES) {
 				_sendBuf.addForceMolecule(numMolsAlreadyIn + prefixArray[threadNum] + i, mCopy);
 			}
@@ -637,7 +882,16 @@ void CommunicationPartner::collectLeavingMoleculesFromInvalidParticles(std::vect
 }
 
 size_t CommunicationPartner::getDynamicSize() {
-	return _sendBuf.getDynamicSize() + _recvBuf.getDynamicSize() + _haloInfo.capacity() * sizeof(PositionInfo);
+	size_t totSize = _sendBuf.getDynamicSize() + _recvBuf.getDynamicSize() + _haloInfo.capacity() * sizeof(PositionInfo);
+	for (auto channels : {&_sendChannels, &_recvChannels}) {
+		for (const PersistentChannel& channel : *channels) {
+			totSize += channel.buffer.capacity();
+		}
+	}
+	for (const std::vector<Molecule>& threadData : _threadData) {
+		totSize += threadData.capacity() * sizeof(Molecule);
+	}
+	return totSize;
 }
 
 void CommunicationPartner::print(std::ostream& stream) const {
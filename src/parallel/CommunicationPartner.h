@@ -9,6 +9,7 @@
 #define COMMUNICATIONPARTNER_H_
 
 #include <mpi.h>
+#include <array>
 #include <vector>
 #include <stddef.h>
 #include "CommunicationBuffer.h"
@@ -54,10 +55,57 @@ public:
 				  MessageType msgType, std::vector<Molecule>& invalidParticles, bool mightUseInvalidParticles,
 				  bool doHaloPositionCheck, bool removeFromContainer = false);
 
+	/**
+	 * Like initSend(), but the message is sent with a persistent request into a channel of a fixed capacity, that is
+	 * kept between the exchanges. The receiving partner has to call initRecvPersistent() with the same message type.
+	 * If the molecules do not fit into the channel, only their number of bytes is sent through it and the molecules
+	 * follow in a separate message, which the receiver probes for. Both partners then grow the channel
+	 * geometrically, so that this happens only a few times after the CommunicationPartners were created.
+	 */
+	void initSendPersistent(ParticleContainer* moleculeContainer, const MPI_Comm& comm, MessageType msgType,
+							std::vector<Molecule>& invalidParticles, bool mightUseInvalidParticles,
+							bool doHaloPositionCheck);
+
+	/**
+	 * Collects the molecules like initSend(), but does not send them. The caller exchanges the message itself, e.g.
+	 * with a neighbourhood collective, after copying it with moveCollectedBytes(). The receiving partner gets it via
+	 * initRecvCollective().
+	 * @return the number of bytes of the message
+	 */
+	unsigned long initSendCollective(ParticleContainer* moleculeContainer, MessageType msgType,
+									 std::vector<Molecule>& invalidParticles, bool mightUseInvalidParticles,
+									 bool doHaloPositionCheck);
+
+	//! Copies the message collected by initSendCollective() to destination and clears the send buffer.
+	void moveCollectedBytes(unsigned char* destination);
+
+	/**
+	 * Hands over a message, which was received by the caller, see initSendCollective(). It is unpacked by testRecv()
+	 * as usual.
+	 */
+	void initRecvCollective(const unsigned char* data, unsigned long numBytes);
+
+	/**
+	 * Selects the encoding of the halo copies sent by the next calls of initSend(), initSendPersistent() and
+	 * initSendCollective(), see CommunicationBuffer::setCompactHalo(). The positions are encoded within the halo regions
+	 * of this partner. The ids are omitted if withIds is false and the halo regions do not overlap, as they are only
+	 * needed by the receiver to remove duplicates. The receiver reads the encoding from the message.
+	 */
+	void setCompactHaloCopies(bool compact, bool withIds) {
+		_compactHaloCopies = compact;
+		_haloCopiesWithIds = withIds;
+	}
+
 	bool testSend();
 
 	void resetReceive();
 
+	/**
+	 * Resets the receive status and starts the persistent receive of the channel of the given message type, see
+	 * initSendPersistent(). The message is then completed by iprobeCount() and testRecv() as usual.
+	 */
+	void initRecvPersistent(const MPI_Comm& comm, MessageType msgType);
+
 	bool iprobeCount(const MPI_Comm& comm, const MPI_Datatype& type);
 
 	bool testRecv(ParticleContainer* moleculeContainer, bool removeRecvDuplicates, bool force = false);
@@ -123,6 +171,29 @@ private:
 		NONE,
 		FORCES // necessary?
 	};
+	//! persistent point-to-point channel of one message type and direction, see initSendPersistent()
+	struct PersistentChannel {
+		MPI_Request request{MPI_REQUEST_NULL};
+		//! number of bytes of the molecules, followed by the molecules; the request was created for its size
+		std::vector<unsigned char> buffer;
+		//! capacity agreed with the partner, changes when the molecules do not fit into the channel
+		unsigned long capacity{0};
+	};
+
+	//! ensures that the persistent request of the channel matches its current capacity
+	void preparePersistentChannel(PersistentChannel& channel, const MPI_Comm& comm, bool send);
+
+	//! tests the pending persistent receive and either moves the molecules to _recvBuf or prepares to probe for them
+	void testRecvPersistent();
+
+	void freePersistentChannels();
+
+	static unsigned long grownCapacity(unsigned long numBytes, unsigned long capacity);
+
+	void collectMolecules(ParticleContainer* moleculeContainer, MessageType msgType,
+			std::vector<Molecule>& invalidParticles, bool mightUseInvalidParticles, bool doHaloPositionCheck,
+			bool removeFromContainer);
+
 	void collectMoleculesInRegion(ParticleContainer* moleculeContainer, const double lowCorner[3],
 			const double highCorner[3], const double shift[3], bool removeFromContainer,
 			HaloOrLeavingCorrection haloLeaveCorr, bool doHaloPositionCheck = true);
@@ -136,6 +207,17 @@ private:
 	MPI_Status *_sendStatus, *_recvStatus;
 	CommunicationBuffer _sendBuf, _recvBuf; // used to be ParticleData and 
 	bool _msgSent, _countReceived, _msgReceived, _isSending, _isReceiving;
+	//! tag of the message iprobeCount() probes for
+	int _probeTag;
+
+	// persistent channels per message type, the pointers refer to the ones of a pending exchange
+	std::array<PersistentChannel, 4> _sendChannels, _recvChannels;
+	PersistentChannel *_sendChannel, *_recvChannel;
+
+	bool _compactHaloCopies, _haloCopiesWithIds;
+
+	//! molecules collected by every thread, kept to reuse their memory
+	std::vector<std::vector<Molecule>> _threadData;
 
 	void collectLeavingMoleculesFromInvalidParticles(std::vector<Molecule>& invalidParticles, double lowCorner [3], double highCorner [3], double shift [3]);
 
@@ -94,6 +94,11 @@ void DomainDecompBase::exchangeForces(ParticleContainer* moleculeContainer, Doma
 	}
 }
 
+void DomainDecompBase::exchangeHaloAfterRebuild(ParticleContainer* moleculeContainer, Domain* domain) {
+	// without leaving particles this only creates the halo copies.
+	exchangeMolecules(moleculeContainer, domain);
+}
+
 void DomainDecompBase::handleForceExchange(unsigned dim, ParticleContainer* moleculeContainer) const {
 	const double shiftMagnitude = moleculeContainer->getBoundingBoxMax(dim) - moleculeContainer->getBoundingBoxMin(dim);
 
@@ -78,6 +78,16 @@ public:
 	 */
 	virtual void exchangeForces(ParticleContainer* moleculeContainer, Domain* domain);
 
+	/**
+	 * @brief Creates the halo copies again after the particle container rebuilt its cells for the same bounding box,
+	 * e.g. with a different cell size (see ParticleContainer::adaptCellSize()).
+	 * The container holds no halo particles at this point. Decompositions, whose communication partners depend on
+	 * the cell geometry, update them first.
+	 * @param moleculeContainer The particle container
+	 * @param domain
+	 */
+	virtual void exchangeHaloAfterRebuild(ParticleContainer* moleculeContainer, Domain* domain);
+
 	/**
 	 * Specifies the amount of non-blocking stages, when performing overlapping balanceAndExchange and computation.
 	 * For a communication scheme, where only direct neighbours communicate, 3 stages of communication are necessary,
@@ -195,6 +205,7 @@ public:
 
 	void updateSendLeavingWithCopies(bool sendTogether){
 		using Log::global_log;
+		_localSendLeavingWithCopies = sendTogether;
 		// Count all processes that need to send separately
 		collCommInit(1);
 		collCommAppendInt(!sendTogether);
@@ -337,6 +348,9 @@ protected:
 	//! total number of processes in the simulation
 	int _numProcs;
 
+	//! argument of the last call of updateSendLeavingWithCopies() on this process
+	bool _localSendLeavingWithCopies = true;
+
 private:
 	CollectiveCommBase _collCommBase;
 	int _sendLeavingAndCopiesSeparately = 0;
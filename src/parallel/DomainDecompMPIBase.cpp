@@ -68,10 +68,15 @@ void DomainDecompMPIBase::readXML(XMLfileUnits& xmlconfig) {
 	std::string neighbourCommunicationScheme = "direct-pp";
 #endif
 	if(_forceDirectPP){
+		// the neighbourhood collectives use the same partners as the direct scheme
+		if (neighbourCommunicationScheme.find("neighbourhood-collective") == 0) {
+			neighbourCommunicationScheme = "neighbourhood-collective-pp";
+		} else {
+			neighbourCommunicationScheme = "direct-pp";
+		}
 		global_log->info()
-			<< "Forcing direct-pp communication scheme, as _forceDirectPP is set (probably by a child class)."
-			<< std::endl;
-		neighbourCommunicationScheme = "direct-pp";
+			<< "Forcing " << neighbourCommunicationScheme
+			<< " communication scheme, as _forceDirectPP is set (probably by a child class)." << std::endl;
 	}
 
 	std::string zonalMethod = "fs";
@@ -113,6 +118,34 @@ void DomainDecompMPIBase::readXML(XMLfileUnits& xmlconfig) {
 	setCommunicationScheme(neighbourCommunicationScheme, zonalMethod);
 	_neighbourCommunicationScheme->setSequentialFallback(useSequentialFallback);
 
+	bool persistentCommunication = false;
+	xmlconfig.getNodeValue("persistentCommunication", persistentCommunication);
+	if (persistentCommunication and neighbourCommunicationScheme.find("neighbourhood-collective") == 0) {
+		global_log->warning() << "DomainDecompMPIBase: persistentCommunication has no effect on the neighbourhood "
+								 "collectives" << endl;
+	} else if (persistentCommunication) {
+		global_log->info() << "DomainDecompMPIBase: Using persistent communication channels" << endl;
+	}
+	_neighbourCommunicationScheme->setPersistentCommunication(persistentCommunication);
+
+	std::string haloCopyEncoding = "full";
+	xmlconfig.getNodeValue("haloCopyEncoding", haloCopyEncoding);
+	if (haloCopyEncoding != "full" and haloCopyEncoding != "compact" and haloCopyEncoding != "compactWithoutIds") {
+		global_log->error() << "DomainDecompMPIBase: invalid haloCopyEncoding specified. Valid values are 'full', "
+							   "'compact' and 'compactWithoutIds'" << std::endl;
+		Simulation::exit(1);
+	}
+#ifdef ENABLE_REDUCED_MEMORY_MODE
+	if (haloCopyEncoding != "full") {
+		global_log->warning() << "DomainDecompMPIBase: The compact halo copy encoding is not available in the reduced "
+								 "memory mode, using the full one." << std::endl;
+		haloCopyEncoding = "full";
+	}
+#endif
+	global_log->info() << "DomainDecompMPIBase: Using the " << haloCopyEncoding << " halo copy encoding" << std::endl;
+	_neighbourCommunicationScheme->setCompactHaloCopies(haloCopyEncoding != "full",
+														haloCopyEncoding != "compactWithoutIds");
+
 	bool overlappingCollectives = false;
 	xmlconfig.getNodeValue("overlappingCollectives", overlappingCollectives);
 	if(overlappingCollectives) {
@@ -132,8 +165,8 @@ int DomainDecompMPIBase::getNonBlockingStageCount() {
 }
 
 void DomainDecompMPIBase::setCommunicationScheme(const std::string& scheme, const std::string& zonalMethod) {
-	// delete if it exists already
-	delete _neighbourCommunicationScheme;
+	// an existing scheme is deleted after its options are taken over
+	NeighbourCommunicationScheme* oldScheme = _neighbourCommunicationScheme;
 	_neighbourCommunicationScheme = nullptr;
 
 	ZonalMethod* zonalMethodP = nullptr;
@@ -165,11 +198,28 @@ void DomainDecompMPIBase::setCommunicationScheme(const std::string& scheme, cons
 	} else if(scheme=="indirect") {
 		global_log->info() << "DomainDecompMPIBase: Using IndirectCommunicationScheme" << std::endl;
 		_neighbourCommunicationScheme = new IndirectNeighbourCommunicationScheme(zonalMethodP);
+	} else if(scheme=="neighbourhood-collective" or scheme=="neighbourhood-collective-pp") {
+		const bool pushPull = scheme=="neighbourhood-collective-pp";
+#if MPI_VERSION >= 3
+		global_log->info() << "DomainDecompMPIBase: Using NeighbourhoodCollectiveCommunicationScheme "
+						   << (pushPull ? "with" : "without") << " push-pull neighbors" << std::endl;
+		_neighbourCommunicationScheme = new NeighbourhoodCollectiveCommunicationScheme(zonalMethodP, pushPull);
+#else
+		global_log->warning() << "DomainDecompMPIBase: Can not use neighbourhood collectives, as the MPI version is "
+								 "less than MPI 3. Using DirectCommunicationScheme instead." << std::endl;
+		_neighbourCommunicationScheme = new DirectNeighbourCommunicationScheme(zonalMethodP, pushPull);
+#endif
 	} else {
-		global_log->error() << "DomainDecompMPIBase: invalid NeighbourCommunicationScheme specified. Valid values are 'direct' and 'indirect'"
-				<< std::endl;
+		global_log->error() << "DomainDecompMPIBase: invalid NeighbourCommunicationScheme specified. Valid values are "
+							   "'direct', 'direct-pp', 'indirect', 'neighbourhood-collective' and "
+							   "'neighbourhood-collective-pp'" << std::endl;
 		Simulation::exit(1);
 	}
+
+	if (oldScheme != nullptr) {
+		_neighbourCommunicationScheme->copyOptions(*oldScheme);
+		delete oldScheme;
+	}
 }
 
 unsigned DomainDecompMPIBase::Ndistribution(unsigned localN, float* minrnd, float* maxrnd) {
@@ -301,6 +351,13 @@ void DomainDecompMPIBase::exchangeForces(ParticleContainer* moleculeContainer, D
 	global_log->set_mpi_output_root(0);
 }
 
+void DomainDecompMPIBase::exchangeHaloAfterRebuild(ParticleContainer* moleculeContainer, Domain* domain) {
+	// the halo regions of some zonal methods depend on the cell length.
+	_neighbourCommunicationScheme->initCommunicationPartners(moleculeContainer->getCutoff(), domain, this,
+															 moleculeContainer);
+	exchangeMoleculesMPI(moleculeContainer, domain, HALO_COPIES);
+}
+
 size_t DomainDecompMPIBase::getTotalSize() { 
 	return DomainDecompBase::getTotalSize() + _neighbourCommunicationScheme->getDynamicSize()
 			+ _collCommunication->getTotalSize();
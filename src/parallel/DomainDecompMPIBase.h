@@ -28,6 +28,8 @@ class NeighbourCommunicationScheme;
 struct HaloRegion;
 
 class DomainDecompMPIBase: public DomainDecompBase {
+	friend class DomainDecompositionTest;
+
 public:
 	DomainDecompMPIBase();
 	virtual ~DomainDecompMPIBase();
@@ -171,6 +173,8 @@ public:
 
 	void exchangeForces(ParticleContainer* moleculeContainer, Domain* domain) override;
 
+	void exchangeHaloAfterRebuild(ParticleContainer* moleculeContainer, Domain* domain) override;
+
 	std::vector<int> getNeighbourRanks() override = 0;
 	std::vector<int> getNeighbourRanksFullShell() override = 0;
 
@@ -195,11 +199,18 @@ public:
 	 * \code{.xml}
 	   <parallelisation type="DomainDecomposition" OR "KDDecomposition">
 	   <!--default: indirect, unless in autopas mode-->
-	   	 <CommunicationScheme>indirect OR direct OR direct-pp</CommunicationScheme>
+	   	 <!--neighbourhood-collective(-pp) exchanges the messages of direct(-pp) with MPI-3 neighbourhood collectives-->
+	   	 <CommunicationScheme>indirect OR direct OR direct-pp OR neighbourhood-collective OR neighbourhood-collective-pp</CommunicationScheme>
 	   	 <!--default: no-->
 	   	 <overlappingCollectives>yes OR no</overlappingCollectives>
 	   	 <!--default: yes-->
 	   	 <useSequentialFallback>yes OR no</useSequentialFallback>
+	   	 <!--default: no; exchange the molecules through persistent requests, which are kept until the neighbours change-->
+	   	 <persistentCommunication>yes OR no</persistentCommunication>
+	   	 <!--default: full; compact sends the halo copies with fixed-point positions and compressed orientations,
+	   	     compactWithoutIds additionally omits their ids unless they are needed to remove duplicates or to send
+	   	     back the forces of zonal methods-->
+	   	 <haloCopyEncoding>full OR compact OR compactWithoutIds</haloCopyEncoding>
 	     <!-- structure handled by DomainDecomposition or KDDecomposition -->
 	   </parallelisation>
 	   \endcode
@@ -209,6 +220,7 @@ public:
 	/**
 	 * Sets the communicationScheme.
 	 * @note If this function is called dynamically, make sure to reinitialise the CommunicationPartners before exchanging molecules!
+	 * The options of the previous scheme (sequential fallback, persistent communication, halo copy encoding) are kept.
 	 * @param scheme
 	 * @param comScheme
 	 */
@@ -9,6 +9,7 @@
 #include "ALLLoadBalancer.h"
 #endif
 #include "Domain.h"
+#include "LoadCalc.h"
 #include "NeighborAcquirer.h"
 #include "NeighbourCommunicationScheme.h"
 
@@ -91,10 +92,14 @@ void GeneralDomainDecomposition::balanceAndExchange(double lastTraversalTime, bo
 			// rebalance
 			global_log->info() << "rebalancing..." << std::endl;
 
+			double work = lastTraversalTime;
+			if (_cellTimingLoad != nullptr and _cellTimingLoad->fit(getCommunicator())) {
+				work = _cellTimingLoad->getContainerLoad(moleculeContainer);
+			}
 			global_log->set_mpi_output_all();
-			global_log->debug() << "work:" << lastTraversalTime << std::endl;
+			global_log->debug() << "work:" << work << std::endl;
 			global_log->set_mpi_output_root(0);
-			auto [newBoxMin, newBoxMax] = _loadBalancer->rebalance(lastTraversalTime);
+			auto [newBoxMin, newBoxMax] = _loadBalancer->rebalance(work);
 			if (_gridSize.has_value()) {
 				std::tie(newBoxMin, newBoxMax) = latchToGridSize(newBoxMin, newBoxMax);
 			}
@@ -132,6 +137,24 @@ void GeneralDomainDecomposition::balanceAndExchange(double lastTraversalTime, bo
 		}
 	}
 	++_steps;
+	if (_instrumentedCellProcessor != nullptr) {
+		// the times of the following traversal are sampled for the cell timing load
+		const bool sample = _steps % _cellTimingLoadSampleFrequency == 0;
+		_instrumentedCellProcessor->setTimeObserver(sample ? _cellTimingLoad.get() : nullptr);
+	}
+}
+
+void GeneralDomainDecomposition::instrumentCellProcessor(CellProcessor** cellProc) {
+	if (_cellTimingLoad == nullptr) {
+		return;
+	}
+	_cellTimingLoad->setComponents(*_simulation.getEnsemble()->getComponents());
+	// a cell processor instrumented on request of the user is reused
+	_instrumentedCellProcessor = dynamic_cast<InstrumentedCellProcessor*>(*cellProc);
+	if (_instrumentedCellProcessor == nullptr) {
+		_instrumentedCellProcessor = new InstrumentedCellProcessor(*cellProc, false);
+		*cellProc = _instrumentedCellProcessor;
+	}
 }
 
 void GeneralDomainDecomposition::migrateParticles(Domain* domain, ParticleContainer* particleContainer,
@@ -265,6 +288,22 @@ void GeneralDomainDecomposition::readXML(XMLfileUnits& xmlconfig) {
 	global_log->info() << "GeneralDomainDecomposition frequency for initial rebalancing phase: " << _initFrequency
 					   << endl;
 
+	bool useCellTimingLoad = false;
+	xmlconfig.getNodeValue("useCellTimingLoad", useCellTimingLoad);
+	global_log->info() << "GeneralDomainDecomposition using cell timing load: " << (useCellTimingLoad ? "yes" : "no")
+					   << endl;
+	if (useCellTimingLoad) {
+		double historyWeight = 0.5;
+		xmlconfig.getNodeValue("cellTimingLoadHistoryWeight", historyWeight);
+		xmlconfig.getNodeValue("cellTimingLoadSampleFrequency", _cellTimingLoadSampleFrequency);
+		if (historyWeight < 0. or historyWeight > 1. or _cellTimingLoadSampleFrequency < 1) {
+			global_log->error() << "GeneralDomainDecomposition: cellTimingLoadHistoryWeight has to be in [0, 1] and "
+								   "cellTimingLoadSampleFrequency at least 1!" << endl;
+			Simulation::exit(8137);
+		}
+		_cellTimingLoad = std::make_unique<CellTimingLoad>(historyWeight);
+	}
+
 	std::string gridSizeString;
 	if (xmlconfig.getNodeValue("gridSize", gridSizeString)) {
 		global_log->info() << "GeneralDomainDecomposition grid size: " << gridSizeString << endl;
@@ -9,6 +9,10 @@
 #include "DomainDecompMPIBase.h"
 #include "LoadBalancer.h"
 
+class CellProcessor;
+class CellTimingLoad;
+class InstrumentedCellProcessor;
+
 /**
  * This decomposition is meant to be able to call arbitrary load balancers.
  */
@@ -36,6 +40,13 @@ public:
 		  <gridSize>STRING</gridSize><!--default: 0; if non-zero, the process boundaries are fixed to multiples of
 				gridSize. Comma separated string to define three different grid sizes for the different dimensions is
 				possible.-->
+		  <useCellTimingLoad>BOOL</useCellTimingLoad><!--default: false; if true, the work passed to the load balancer
+				is estimated by the CellTimingLoad instead of the last traversal time. The model is fit to the times of
+				the force calculation measured per cell on all processes.-->
+		  <cellTimingLoadHistoryWeight>DOUBLE</cellTimingLoadHistoryWeight><!--default: 0.5; weight of the previous
+				samples at every fit, in [0, 1]-->
+		  <cellTimingLoadSampleFrequency>INTEGER</cellTimingLoadSampleFrequency><!--default: 10; the force calculation
+				is timed every cellTimingLoadSampleFrequency steps-->
 		  <loadBalancer type="STRING"><!--STRING...type of the load balancer, currently supported: ALL-->
 			<!--options for the load balancer-->
 			<!--for detailed information see the readXML functions from ALLLoadBalancer.-->
@@ -54,6 +65,12 @@ public:
 	void balanceAndExchange(double lastTraversalTime, bool forceRebalancing, ParticleContainer* moleculeContainer,
 							Domain* domain) override;
 
+	/**
+	 * Wraps the cell processor into an InstrumentedCellProcessor, which samples the times for the CellTimingLoad, if
+	 * it is used.
+	 */
+	void instrumentCellProcessor(CellProcessor** cellProc);
+
 	//! @param filename name of the file into which the data will be written
 	//! @param domain e.g. needed to get the bounding boxes
 	void printDecomp(const std::string& filename, Domain* domain) override;
@@ -208,6 +225,13 @@ private:
 
 	std::unique_ptr<LoadBalancer> _loadBalancer{nullptr};
 
+	/**
+	 * Optional load model, which estimates the work of this process instead of the last traversal time.
+	 */
+	std::unique_ptr<CellTimingLoad> _cellTimingLoad{nullptr};
+	InstrumentedCellProcessor* _instrumentedCellProcessor{nullptr};
+	size_t _cellTimingLoadSampleFrequency{10};
+
 	friend class GeneralDomainDecompositionTest;
 
 };
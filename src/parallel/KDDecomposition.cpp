@@ -5,6 +5,7 @@
 #include <fstream>
 #include <climits>
 #include <cmath>
+#include <numeric>
 
 #ifdef ENABLE_MPI
 #include <mpi.h>
@@ -164,6 +165,21 @@ void KDDecomposition::readXML(XMLfileUnits& xmlconfig) {
 	if(!_splitBiggest){
 		global_log->info() << "KDDecomposition threshold for splitting not only the biggest Domain: " << _splitThreshold << endl;
 	}
+	xmlconfig.getNodeValue("incrementalRebalancing", _incrementalRebalancing);
+	if (_incrementalRebalancing and (_heterogeneousSystems or _clusteredHeterogeneouseSystems)) {
+		global_log->warning() << "KDDecomposition incremental rebalancing is not supported for heterogeneous systems, "
+								 "disabling it." << endl;
+		_incrementalRebalancing = false;
+	}
+	global_log->info() << "KDDecomposition incremental rebalancing?: " << (_incrementalRebalancing?"yes":"no") << endl;
+	xmlconfig.getNodeValue("maxSplitPlaneShift", _maxSplitPlaneShift);
+	if (_maxSplitPlaneShift < 1) {
+		global_log->error() << "KDDecomposition maxSplitPlaneShift has to be at least 1!" << std::endl;
+		Simulation::exit(43);
+	}
+	if (_incrementalRebalancing) {
+		global_log->info() << "KDDecomposition maximal split plane shift: " << _maxSplitPlaneShift << endl;
+	}
 
 	/*
 	 * Reads the Vectorization tuner parameters
@@ -190,6 +206,29 @@ void KDDecomposition::readXML(XMLfileUnits& xmlconfig) {
 	global_log->info() << "measureLoad: Ensure that cells with more particles take longer ? "
 					   << (_measureLoadIncreasingTimeValues ? "yes" : "no") << endl;
 
+	bool useCellTimingLoad = false;
+	xmlconfig.getNodeValue("useCellTimingLoad", useCellTimingLoad);
+	global_log->info() << "KDDecomposition using cell timing load: " << (useCellTimingLoad?"yes":"no") << endl;
+	if (useCellTimingLoad) {
+		if (useVecTuner or _doMeasureLoadCalc) {
+			global_log->error() << "KDDecomposition: useCellTimingLoad can not be combined with useVectorizationTuner "
+								   "or doMeasureLoadCalc!" << std::endl;
+			Simulation::exit(44);
+		}
+		double historyWeight = 0.5;
+		xmlconfig.getNodeValue("cellTimingLoadHistoryWeight", historyWeight);
+		xmlconfig.getNodeValue("cellTimingLoadSampleFrequency", _cellTimingLoadSampleFrequency);
+		if (historyWeight < 0. or historyWeight > 1. or _cellTimingLoadSampleFrequency < 1) {
+			global_log->error() << "KDDecomposition: cellTimingLoadHistoryWeight has to be in [0, 1] and "
+								   "cellTimingLoadSampleFrequency at least 1!" << std::endl;
+			Simulation::exit(44);
+		}
+		global_log->info() << "Cell timing load: history weight " << historyWeight << ", sampling every "
+						   << _cellTimingLoadSampleFrequency << " steps" << endl;
+		delete _loadCalc;
+		_loadCalc = _cellTimingLoad = new CellTimingLoad(historyWeight);
+	}
+
 	DomainDecompMPIBase::readXML(xmlconfig);
 
 	string oldPath(xmlconfig.getcurrentnodepath());
@@ -263,6 +302,12 @@ void KDDecomposition::balanceAndExchange(double lastTraversalTime, bool forceReb
 	_steps++;
 	const bool removeRecvDuplicates = true;
 
+	if (_instrumentedCellProcessor != nullptr) {
+		// the times of the following traversal are sampled for the cell timing load
+		const bool sample = _steps % _cellTimingLoadSampleFrequency == 0;
+		_instrumentedCellProcessor->setTimeObserver(sample ? _cellTimingLoad : nullptr);
+	}
+
 	size_t measureLoadInitTimers = 2;
 	if (_steps == measureLoadInitTimers and _doMeasureLoadCalc) {
 		if(global_simulation->getEnsemble()->getComponents()->size() > 1){
@@ -272,6 +317,8 @@ void KDDecomposition::balanceAndExchange(double lastTraversalTime, bool forceReb
 		}
 		_measureLoadCalc = new MeasureLoad(_measureLoadIncreasingTimeValues, _measureLoadInterpolationStartsAt);
 	}
+	// the first rebalancing replaces the initial tree, which is not balanced at all
+	bool incremental = _incrementalRebalancing and _steps != 1;
 	size_t measureLoadStart = 50;
 	if (_steps == measureLoadStart and _doMeasureLoadCalc) {
 		bool faulty = _measureLoadCalc->prepareLoads(this, _comm);
@@ -283,6 +330,7 @@ void KDDecomposition::balanceAndExchange(double lastTraversalTime, bool forceReb
 			_loadCalc = _measureLoadCalc;
 			_measureLoadCalc = nullptr;
 			rebalance = true;
+			incremental = false;
 		}
 	}
 
@@ -307,7 +355,7 @@ void KDDecomposition::balanceAndExchange(double lastTraversalTime, bool forceReb
 			DomainDecompMPIBase::exchangeMoleculesMPI(moleculeContainer, domain, HALO_COPIES, false /*dohaloPositionCheck*/);
 		}
 	} else {
-		global_log->info() << "KDDecomposition: rebalancing..." << endl;
+		global_log->info() << "KDDecomposition: " << (incremental ? "incrementally " : "") << "rebalancing..." << endl;
 		if(moleculeContainer->isInvalidParticleReturner() and not moleculeContainer->hasInvalidParticles()){
 			moleculeContainer->forcedUpdate();
 		}
@@ -320,8 +368,15 @@ void KDDecomposition::balanceAndExchange(double lastTraversalTime, bool forceReb
 		KDNode * newDecompRoot = nullptr;
 		KDNode * newOwnLeaf = nullptr;
 
+		if (_cellTimingLoad != nullptr) {
+			_cellTimingLoad->fit(_comm);
+		}
 		calcNumParticlesPerCell(moleculeContainer);
-		constructNewTree(newDecompRoot, newOwnLeaf, moleculeContainer);
+		if (incremental) {
+			constructShiftedTree(newDecompRoot, newOwnLeaf);
+		} else {
+			constructNewTree(newDecompRoot, newOwnLeaf, moleculeContainer);
+		}
 		bool migrationSuccessful = migrateParticles(*newDecompRoot, *newOwnLeaf, moleculeContainer, domain);
 		if (not migrationSuccessful) {
 			global_log->error() << "A problem occurred during particle migration between old decomposition and new decomposition of the KDDecomposition." << endl;
@@ -363,6 +418,18 @@ bool KDDecomposition::migrateParticles(const KDNode& newRoot, const KDNode& newO
 	// 4. issue Isend calls
 	// 5. get all
 
+	bool ownAreaChanged = false;
+	for (int dim = 0; dim < KDDIM; dim++) {
+		ownAreaChanged |= newOwnLeaf._lowCorner[dim] != _ownArea->_lowCorner[dim];
+		ownAreaChanged |= newOwnLeaf._highCorner[dim] != _ownArea->_highCorner[dim];
+	}
+	if (not ownAreaChanged) {
+		// no other process gets or gives cells of this process, so the molecules and the container are kept. The
+		// collective of the processes rebuilding their container is matched with the unchanged local value.
+		updateSendLeavingWithCopies(_localSendLeavingWithCopies);
+		return checkMigration(true, moleculeContainer);
+	}
+
 	vector<CommunicationPartner> recvPartners;
 	recvPartners.clear();
 	int numProcsRecv;
@@ -393,9 +460,8 @@ bool KDDecomposition::migrateParticles(const KDNode& newRoot, const KDNode& newO
 			for (int iz = low[2]; iz <= high[2]; ++iz) {
 				for (int iy = low[1]; iy <= high[1]; ++iy) {
 					for (int ix = low[0]; ix <= high[0]; ++ ix) {
-						numMols += _numParticlesPerCell[(iz * _globalCellsPerDim[1] + iy) * _globalCellsPerDim[0] + ix];
-						if(_numParticleTypes >= 2){
-							numMols += _numParticlesPerCell[_globalNumCells + (iz * _globalCellsPerDim[1] + iy) * _globalCellsPerDim[0] + ix];
+						for (int type = 0; type < _numParticleTypes; ++type) {
+							numMols += _numParticlesPerCell[type * _globalNumCells + (iz * _globalCellsPerDim[1] + iy) * _globalCellsPerDim[0] + ix];
 						}
 					}
 				}
@@ -547,6 +613,10 @@ bool KDDecomposition::migrateParticles(const KDNode& newRoot, const KDNode& newO
 
 	moleculeContainer->update();
 
+	return checkMigration(allDone, moleculeContainer);
+}
+
+bool KDDecomposition::checkMigration(bool allDone, ParticleContainer* moleculeContainer) {
 	int isOK = allDone;
 
 	MPI_Allreduce(MPI_IN_PLACE, &isOK, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
@@ -576,6 +646,19 @@ void KDDecomposition::fillTimeVecs(CellProcessor **cellProc){
 
 }
 
+void KDDecomposition::instrumentCellProcessor(CellProcessor** cellProc) {
+	if (_cellTimingLoad == nullptr) {
+		return;
+	}
+	_cellTimingLoad->setComponents(*_simulation.getEnsemble()->getComponents());
+	// a cell processor instrumented on request of the user is reused
+	_instrumentedCellProcessor = dynamic_cast<InstrumentedCellProcessor*>(*cellProc);
+	if (_instrumentedCellProcessor == nullptr) {
+		_instrumentedCellProcessor = new InstrumentedCellProcessor(*cellProc, false);
+		*cellProc = _instrumentedCellProcessor;
+	}
+}
+
 void KDDecomposition::constructNewTree(KDNode *& newRoot, KDNode *& newOwnLeaf, ParticleContainer* moleculeContainer) {
 
 	newRoot = new KDNode(_numProcs, &(_decompTree->_lowCorner[0]), &(_decompTree->_highCorner[0]), 0, 0, _decompTree->_coversWholeDomain, 0);
@@ -615,6 +698,105 @@ void KDDecomposition::constructNewTree(KDNode *& newRoot, KDNode *& newOwnLeaf,
 #endif
 }
 
+void KDDecomposition::constructShiftedTree(KDNode *& newRoot, KDNode *& newOwnLeaf) {
+	newRoot = _decompTree->copyTree();
+
+	// one split index per inner node
+	std::vector<int> splitIndices;
+	splitIndices.reserve(_numProcs - 1);
+	if (_rank == 0) {
+		std::vector<double> cellCosts(_globalNumCells);
+		std::vector<int> numParticlesPerComponent;
+		for (int i = 0; i < _globalNumCells; i++) {
+			cellCosts[i] = getCellCosts(i, numParticlesPerComponent);
+		}
+		const int numShifted = shiftSplitPlanes(newRoot, cellCosts, splitIndices);
+		global_log->info() << "KDDecomposition: shifted " << numShifted << " of " << _numProcs - 1 << " split planes"
+				<< endl;
+	} else {
+		splitIndices.resize(_numProcs - 1);
+	}
+	MPI_CHECK( MPI_Bcast(splitIndices.data(), _numProcs - 1, MPI_INT, 0, _comm) );
+	if (_rank != 0) {
+		size_t nextIndex = 0;
+		applySplitPlanes(newRoot, splitIndices, nextIndex);
+	}
+
+	newOwnLeaf = newRoot->findAreaForProcess(_rank);
+	global_log->info() << "KDDecomposition: rebalancing finished" << endl;
+
+#ifdef DEBUG_DECOMP
+	if (_rank == 0) {
+		newRoot->printTree("", std::cout);
+	}
+#endif
+}
+
+int KDDecomposition::shiftSplitPlanes(KDNode* node, const std::vector<double>& cellCosts, std::vector<int>& splitIndices) const {
+	const int divDim = node->getSplitDimension();
+	if (divDim == -1) {
+		return 0;
+	}
+
+	// costs of the cell layers of the node along the split dimension
+	std::vector<double> layerCosts(node->_highCorner[divDim] - node->_lowCorner[divDim] + 1, 0.);
+	for (int iz = node->_lowCorner[2]; iz <= node->_highCorner[2]; ++iz) {
+		for (int iy = node->_lowCorner[1]; iy <= node->_highCorner[1]; ++iy) {
+			for (int ix = node->_lowCorner[0]; ix <= node->_highCorner[0]; ++ix) {
+				const int index[3] = {ix, iy, iz};
+				layerCosts[index[divDim] - node->_lowCorner[divDim]] +=
+						cellCosts[(iz * _globalCellsPerDim[1] + iy) * _globalCellsPerDim[0] + ix];
+			}
+		}
+	}
+	const double totalCosts = std::accumulate(layerCosts.begin(), layerCosts.end(), 0.);
+	node->_load = totalCosts;
+
+	// the children have to keep enough cells for the split planes of their subtrees
+	const int oldSplitIndex = node->_child1->_highCorner[divDim];
+	const int minSplitIndex = node->_lowCorner[divDim] + node->_child1->getMinNumCells(divDim) - 1;
+	const int maxSplitIndex = node->_highCorner[divDim] - node->_child2->getMinNumCells(divDim);
+	const int lowSplitIndex = std::max(oldSplitIndex - _maxSplitPlaneShift, minSplitIndex);
+	const int highSplitIndex = std::min(oldSplitIndex + _maxSplitPlaneShift, maxSplitIndex);
+
+	// keep the old split plane, unless another one reduces the deviation from the optimal load
+	const double numProcs1 = node->_child1->_numProcs;
+	const double numProcs2 = node->_child2->_numProcs;
+	const double optimalLoad = totalCosts / node->_numProcs;
+	int splitIndex = std::max(minSplitIndex, std::min(oldSplitIndex, maxSplitIndex));
+	double minDeviation = std::numeric_limits<double>::max();
+	double costs1 = 0.;
+	for (int i = node->_lowCorner[divDim]; i <= highSplitIndex; i++) {
+		costs1 += layerCosts[i - node->_lowCorner[divDim]];
+		if (i < lowSplitIndex) {
+			continue;
+		}
+		const double costs2 = totalCosts - costs1;
+		const double deviation1 = costs1 / numProcs1 - optimalLoad;
+		const double deviation2 = costs2 / numProcs2 - optimalLoad;
+		const double deviation = numProcs1 * deviation1 * deviation1 + numProcs2 * deviation2 * deviation2;
+		if (deviation < minDeviation or (deviation == minDeviation and i == oldSplitIndex)) {
+			minDeviation = deviation;
+			splitIndex = i;
+		}
+	}
+
+	node->moveSplitPlane(splitIndex);
+	splitIndices.push_back(splitIndex);
+	const int numShifted = splitIndex != oldSplitIndex ? 1 : 0;
+	return numShifted + shiftSplitPlanes(node->_child1, cellCosts, splitIndices)
+			+ shiftSplitPlanes(node->_child2, cellCosts, splitIndices);
+}
+
+void KDDecomposition::applySplitPlanes(KDNode* node, const std::vector<int>& splitIndices, size_t& nextIndex) const {
+	if (node->_numProcs == 1) {
+		return;
+	}
+	node->moveSplitPlane(splitIndices[nextIndex++]);
+	applySplitPlanes(node->_child1, splitIndices, nextIndex);
+	applySplitPlanes(node->_child2, splitIndices, nextIndex);
+}
+
 void KDDecomposition::updateMeanProcessorSpeeds(std::vector<double>& processorSpeeds,
 		std::vector<double>& accumulatedProcessorSpeeds, ParticleContainer* moleculeContainer) {
 	// update the processor speed exactly twice (first update at preprocessor stage (no speeds known yet)
@@ -1166,6 +1348,7 @@ bool KDDecomposition::calculateAllPossibleSubdivisions(KDNode* node, std::list<K
 void KDDecomposition::calculateCostsPar(KDNode* area, vector<vector<double> >& costsLeft, vector<vector<double> >& costsRight, MPI_Comm commGroup) {
 	vector<vector<double> > cellCosts;
 	cellCosts.resize(3);
+	std::vector<int> numParticlesPerComponent;
 
 	int newRank;
 	MPI_Group group;
@@ -1226,9 +1409,11 @@ void KDDecomposition::calculateCostsPar(KDNode* area, vector<vector<double> >& c
 			for (int i_dim1 = 0; i_dim1 <= area->_highCorner[dim1] - area->_lowCorner[dim1]; i_dim1++) {
 				for (int i_dim2 = 0; i_dim2 <= area->_highCorner[dim2] - area->_lowCorner[dim2]; i_dim2++) {
 
-					int numParts1 = (int) _numParticlesPerCell[getGlobalIndex(dim, dim1, dim2, i_dim, i_dim1, i_dim2, area)];
-					int numParts2 = _numParticleTypes == 1 ? 0 :
-							_numParticlesPerCell[_globalNumCells + getGlobalIndex(dim, dim1, dim2, i_dim, i_dim1, i_dim2, area)];
+					const double costs = getCellCosts(getGlobalIndex(dim, dim1, dim2, i_dim, i_dim1, i_dim2, area),
+							numParticlesPerComponent);
+					const int numParts1 = numParticlesPerComponent[0];
+					const int numParts2 = std::accumulate(numParticlesPerComponent.begin() + 1,
+							numParticlesPerComponent.end(), 0);
 
 					//_maxPars = max(_maxPars, numParts);
 					_maxPars = max(_maxPars, numParts1);
@@ -1236,65 +1421,7 @@ void KDDecomposition::calculateCostsPar(KDNode* area, vector<vector<double> >& c
 					// #######################
 					// ## Cell Costs        ##
 					// #######################
-					cellCosts[dim][i_dim] += _loadCalc->getOwn(numParts1, numParts2);
-
-					// all Neighbours
-					for (int neighInd_divDim = i_dim - 1; neighInd_divDim <= i_dim + 1; neighInd_divDim++) {
-						int nI_dim = neighInd_divDim;
-						if (nI_dim + area->_lowCorner[dim] < 0)
-							nI_dim = _globalCellsPerDim[dim] - 1;
-						else if (nI_dim + area->_lowCorner[dim] >= _globalCellsPerDim[dim])
-							nI_dim = 0;
-						//counts if the the offset in this dimension is zero
-						//if the offset in zero dimensions is zero the neighbor shares a corner
-						//1 => edge
-						//2 => face
-						//3 => the cell itself
-						const int zeroCount1 = (neighInd_divDim == i_dim) ? 1 : 0;
-
-						for (int neighInd_dim1 = i_dim1 - 1; neighInd_dim1 <= i_dim1 + 1; neighInd_dim1++) {
-							// adjust index in case of periodic boundary
-							int nI_dim1 = neighInd_dim1;
-							if (nI_dim1 + area->_lowCorner[dim1] < 0)
-								nI_dim1 = _globalCellsPerDim[dim1] - 1;
-							else if (nI_dim1 + area->_lowCorner[dim1] >= _globalCellsPerDim[dim1])
-								nI_dim1 = 0;
-							const int zeroCount2 = (neighInd_dim1 == i_dim1) ? 1 : 0;
-
-							for (int neighInd_dim2 = i_dim2 - 1; neighInd_dim2 <= i_dim2 + 1; neighInd_dim2++) {
-								// adjust index in case of periodic boundary
-								int nI_dim2 = neighInd_dim2;
-								if (nI_dim2 + area->_lowCorner[dim2] < 0)
-									nI_dim2 = _globalCellsPerDim[dim2] - 1;
-								else if (nI_dim2 + area->_lowCorner[dim2] >= _globalCellsPerDim[dim2])
-									nI_dim2 = 0;
-								const int zeroCount3 = (neighInd_dim2 == i_dim2) ? 1 : 0;
-								// count only forward neighbours
-								/*
-								if (getGlobalIndex(dim, dim1, dim2, nI_dim, nI_dim1, nI_dim2, area) > getGlobalIndex(dim, dim1, dim2, i_dim, i_dim1, i_dim2, area)) {
-									int numPartsNeigh = (int) _numParticlesPerCell[getGlobalIndex(dim, dim1, dim2, nI_dim, nI_dim1, nI_dim2, area)];
-									cellCosts[dim][i_dim] += 0.5 * (double) (numParts * numPartsNeigh);
-								}
-								*/
-								const int numPartsNeigh1 = (int) _numParticlesPerCell[getGlobalIndex(dim, dim1, dim2, nI_dim, nI_dim1, nI_dim2, area)];
-								int numPartsNeigh2= _numParticleTypes == 1 ? 0 :
-															_numParticlesPerCell[_globalNumCells + getGlobalIndex(dim, dim1, dim2, nI_dim, nI_dim1, nI_dim2, area)];
-
-								switch(zeroCount1+zeroCount2+zeroCount3){
-								case 0: //the current neighbour shares a corner
-									cellCosts[dim][i_dim] += _loadCalc->getCorner(numParts1, numParts2);
-									break;
-								case 1: //edge
-									cellCosts[dim][i_dim] += _loadCalc->getEdge(numParts1, numParts2);
-									break;
-								case 2: //face
-									cellCosts[dim][i_dim] += _loadCalc->getFace(numParts1, numParts2);
-									break;
-									//3 zeroes is the cell itself which was already counted
-								}
-							}
-						}
-					}
+					cellCosts[dim][i_dim] += costs;
 				}
 			}
 		}
@@ -1456,23 +1583,26 @@ void KDDecomposition::calcNumParticlesPerCell(ParticleContainer* moleculeContain
 				if (globalCellIdx[dim] >= _globalCellsPerDim[dim])
 					globalCellIdx[dim] -= _globalCellsPerDim[dim];
 			}
-			if(molPtr->componentid() == 0){
-				mardyn_assert(static_cast<int>(molPtr->componentid()) <= _numParticleTypes);
-				#if defined(_OPENMP)
-				#pragma omp atomic
-				#endif
-				_numParticlesPerCell[_globalCellsPerDim[0] * (globalCellIdx[2] * _globalCellsPerDim[1] + globalCellIdx[1]) + globalCellIdx[0]]++;
-			} else {
-				#if defined(_OPENMP)
-				#pragma omp atomic
-				#endif
-				_numParticlesPerCell[_globalNumCells + _globalCellsPerDim[0] * (globalCellIdx[2] * _globalCellsPerDim[1] + globalCellIdx[1]) + globalCellIdx[0]]++;
-			}
+			mardyn_assert(static_cast<int>(molPtr->componentid()) < _numParticleTypes);
+			const int type = std::min(static_cast<int>(molPtr->componentid()), _numParticleTypes - 1);
+			#if defined(_OPENMP)
+			#pragma omp atomic
+			#endif
+			_numParticlesPerCell[type * _globalNumCells + _globalCellsPerDim[0] * (globalCellIdx[2] * _globalCellsPerDim[1] + globalCellIdx[1]) + globalCellIdx[0]]++;
 		}
 	}
 	MPI_CHECK( MPI_Allreduce(MPI_IN_PLACE, _numParticlesPerCell.data(), _globalNumCells * _numParticleTypes, MPI_UNSIGNED, MPI_SUM, MPI_COMM_WORLD) );
 }
 
+double KDDecomposition::getCellCosts(int globalCellIndex, std::vector<int>& numParticlesPerComponent) const {
+	numParticlesPerComponent.resize(_numParticleTypes);
+	for (int type = 0; type < _numParticleTypes; ++type) {
+		numParticlesPerComponent[type] = _numParticlesPerCell[type * _globalNumCells + globalCellIndex];
+	}
+	// the neighbours are assumed to be occupied like the cell itself
+	return _loadCalc->getCellLoad(numParticlesPerComponent);
+}
+
 std::vector<int> KDDecomposition::getNeighbourRanks() {
 	//global_log->error() << "not implemented \n";
 	Simulation::exit(-1);
@@ -131,6 +131,18 @@ class KDDecomposition: public DomainDecompMPIBase {
 		 <!-- Option for MeasureLoad: Forces increasing values for the load estimation (more particles = more load).
 		      Default: True-->
 		 <measureLoadIncreasingTimeValues>BOOL</measureLoadIncreasingTimeValues>
+		 <!-- Indicates whether the CellTimingLoad load estimator should be used. Its model is fit to the times of the
+		      force calculation measured per cell during the simulation and accounts for the sites of all components.
+		      Until it is fitted for the first time, the quadratic model is used.
+		      Can not be combined with useVectorizationTuner or doMeasureLoadCalc.
+		      Default: False-->
+		 <useCellTimingLoad>BOOL</useCellTimingLoad>
+		 <!-- For CellTimingLoad: Weight of the previous samples at every fit, in [0, 1].
+		      Default: 0.5-->
+		 <cellTimingLoadHistoryWeight>DOUBLE</cellTimingLoadHistoryWeight>
+		 <!-- For CellTimingLoad: The force calculation is timed every cellTimingLoadSampleFrequency steps.
+		      Default: 10-->
+		 <cellTimingLoadSampleFrequency>UINT</cellTimingLoadSampleFrequency>
 		 <!-- The reduction operation for the deviation calculation.
 		      Default: sum-->
 		 <deviationReductionOperation>max OR sum</deviationReductionOperation>
@@ -139,6 +151,15 @@ class KDDecomposition: public DomainDecompMPIBase {
 		      might lead to worse load balance or can make a domain splitting impossible.
 		      Default: 1-->
 		 <minNumCellsPerDimension>UINT</minNumCellsPerDimension>
+		 <!-- Rebalance incrementally: Instead of constructing a new tree, the split planes of the current tree are
+		      shifted by at most maxSplitPlaneShift cells each, so that molecules only migrate between neighbouring
+		      processes. The first rebalancing and switching to MeasureLoad still construct a new tree.
+		      Not supported for heterogeneous systems.
+		      Default: False-->
+		 <incrementalRebalancing>BOOL</incrementalRebalancing>
+		 <!-- For incremental rebalancing: The maximal number of cells a split plane is shifted per rebalancing.
+		      Default: 2-->
+		 <maxSplitPlaneShift>UINT</maxSplitPlaneShift>
 	   </parallelisation>
 	   \endcode
 	 */
@@ -198,6 +219,12 @@ class KDDecomposition: public DomainDecompMPIBase {
 	 */
 	void fillTimeVecs(CellProcessor **cellProc);
 
+	/**
+	 * Wraps the cell processor into an InstrumentedCellProcessor, which samples the times for the CellTimingLoad, if
+	 * it is used. Has to be called after the cell processor is created, like fillTimeVecs().
+	 */
+	void instrumentCellProcessor(CellProcessor **cellProc);
+
 	/**
 	 * Prints the tree to the desired ostream.
 	 * @param ostream
@@ -206,6 +233,25 @@ class KDDecomposition: public DomainDecompMPIBase {
 
 private:
 	void constructNewTree(KDNode *& newRoot, KDNode *& newOwnLeaf, ParticleContainer* moleculeContainer);
+
+	/**
+	 * Constructs the new tree for incremental rebalancing: A copy of the current tree, whose split planes are shifted
+	 * by at most _maxSplitPlaneShift cells. The split planes are chosen by the root process and broadcast.
+	 */
+	void constructShiftedTree(KDNode *& newRoot, KDNode *& newOwnLeaf);
+
+	/**
+	 * Shifts the split plane of node and recursively the ones of its children towards a balanced load.
+	 * @param node node, whose corners are already updated
+	 * @param cellCosts costs of every global cell
+	 * @param splitIndices the chosen split index of every inner node is appended (depth first)
+	 * @return the number of shifted split planes
+	 */
+	int shiftSplitPlanes(KDNode* node, const std::vector<double>& cellCosts, std::vector<int>& splitIndices) const;
+
+	//! moves the split planes of node and its children to the splitIndices chosen by shiftSplitPlanes()
+	void applySplitPlanes(KDNode* node, const std::vector<int>& splitIndices, size_t& nextIndex) const;
+
 	/**
 	 *
 	 * @param newRoot
@@ -214,6 +260,9 @@ private:
 	 * @return true if OK, false if deadlock
 	 */
 	bool migrateParticles(const KDNode& newRoot, const KDNode& newOwnLeaf, ParticleContainer* moleculeContainer, Domain* domain);
+
+	//! @return true if the migration was successful on all processes, otherwise a checkpoint is written
+	bool checkMigration(bool allDone, ParticleContainer* moleculeContainer);
 	void initCommunicationPartners(double cutoffRadius, Domain * domain, ParticleContainer* moleculeContainer);
 
 
@@ -287,6 +336,12 @@ private:
 	//! @todo _numParticles should perhaps not be a member variable (think about that)
 	void calcNumParticlesPerCell(ParticleContainer* moleculeContainer);
 
+	/**
+	 * @return the costs of the given global cell including its neighbours, see LoadCalc::getCellLoad()
+	 * @param numParticlesPerComponent set to the number of particles of every type in the cell
+	 */
+	double getCellCosts(int globalCellIndex, std::vector<int>& numParticlesPerComponent) const;
+
 	bool decompose(KDNode* fatherNode, KDNode*& ownArea, MPI_Comm commGroup);
 
 	bool decompose(KDNode* fatherNode, KDNode*& ownArea, MPI_Comm commGroup, double globalMinimalDeviation);
@@ -417,6 +472,9 @@ private:
 	const int _partitionRank;
 	LoadCalc* _loadCalc;  // stores the times (and constants) measured by the vectorization tuner
 	MeasureLoad* _measureLoadCalc;  // stores the measured times of the real-world simulations
+	CellTimingLoad* _cellTimingLoad{nullptr};  // same as _loadCalc, if the load model is fit to the measured cell times
+	InstrumentedCellProcessor* _instrumentedCellProcessor{nullptr};  // samples the cell times for _cellTimingLoad
+	int _cellTimingLoadSampleFrequency{10};
 
 	/*
 	 * The following Variables are only used for as parameters for the Vectorization tuner constructor.
@@ -437,6 +495,9 @@ private:
 
 	double _rebalanceLimit{0.}; ///< limit for the fraction max/min time used in traversal before automatic rebalacing
 
+	bool _incrementalRebalancing{false};  ///< shift the split planes of the current tree instead of constructing a new one
+	int _maxSplitPlaneShift{2};  ///< maximal number of cells a split plane is shifted by one incremental rebalancing
+
 	/**
 	 * MPI reduction operation to reduce the deviation within the decompose step.
 	 * MPI_SUM will result in overestimated values for the deviation, but will result in more balanced trees.
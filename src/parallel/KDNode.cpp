@@ -201,6 +201,58 @@ void KDNode::split(int divDimension, int splitIndex, int numProcsLeft) {
 	_child2->_optimalLoadPerProcess = _optimalLoadPerProcess;
 }
 
+int KDNode::getSplitDimension() const {
+	if (_numProcs == 1) {
+		return -1;
+	}
+	// the children share all corners except for the split plane, which separates them
+	for (int dim = 0; dim < KDDIM; dim++) {
+		if (_child2->_lowCorner[dim] == _child1->_highCorner[dim] + 1) {
+			return dim;
+		}
+	}
+	mardyn_assert(false);
+	return -1;
+}
+
+int KDNode::getMinNumCells(int dimension) const {
+	const int divDimension = getSplitDimension();
+	if (divDimension == -1) {
+		return KDDStaticValues::minNumCellsPerDimension;
+	}
+	const int minNumCells1 = _child1->getMinNumCells(dimension);
+	const int minNumCells2 = _child2->getMinNumCells(dimension);
+	if (divDimension == dimension) {
+		return minNumCells1 + minNumCells2;
+	}
+	return std::max(minNumCells1, minNumCells2);
+}
+
+void KDNode::moveSplitPlane(int splitIndex) {
+	const int divDimension = getSplitDimension();
+	mardyn_assert(divDimension != -1);
+	mardyn_assert(splitIndex >= _lowCorner[divDimension] + (KDDStaticValues::minNumCellsPerDimension - 1));
+	mardyn_assert(splitIndex < _highCorner[divDimension]);
+
+	for (int dim = 0; dim < KDDIM; dim++) {
+		_child1->_lowCorner[dim] = _lowCorner[dim];
+		_child1->_highCorner[dim] = _highCorner[dim];
+		_child2->_lowCorner[dim] = _lowCorner[dim];
+		_child2->_highCorner[dim] = _highCorner[dim];
+	}
+	_child1->_highCorner[divDimension] = splitIndex;
+	_child2->_lowCorner[divDimension] = splitIndex + 1;
+}
+
+KDNode* KDNode::copyTree() const {
+	auto copy = new KDNode(*this);
+	if (_numProcs > 1) {
+		copy->_child1 = _child1->copyTree();
+		copy->_child2 = _child2->copyTree();
+	}
+	return copy;
+}
+
 //#define BINARY
 
 void KDNode::serialize(const std::string& fileName) {
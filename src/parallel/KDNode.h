@@ -172,6 +172,28 @@ public:
 	 */
 	void split(int divDimension, int splitIndex, int numProcsLeft);
 
+	/**
+	 * @return the dimension along which this node is split, or -1 if this node is a leaf.
+	 */
+	int getSplitDimension() const;
+
+	/**
+	 * @return the minimal number of cells this node needs in the given dimension, so that the split planes of its
+	 *         subtree can be kept and each leaf has at least KDDStaticValues::minNumCellsPerDimension cells.
+	 */
+	int getMinNumCells(int dimension) const;
+
+	/**
+	 * Moves the split plane of this inner node, i.e. the children are resized to the corners of this node, split
+	 * along getSplitDimension() at splitIndex (see split()). The subtrees of the children are not adapted.
+	 */
+	void moveSplitPlane(int splitIndex);
+
+	/**
+	 * @return a copy of the (sub-)tree represented by this node, including all children.
+	 */
+	KDNode* copyTree() const;
+
 	//! @brief prints this (sub-) tree to stdout
 	//!
 	//! For each node, it is printed whether it is a "LEAF" or a "INNER" node,
@@ -11,6 +11,21 @@
 #include "utils/nnls.h"
 #include "LoadCalc.h"
 #include "DomainDecompBase.h"
+#include "molecules/Component.h"
+#include "particleContainer/ParticleCell.h"
+#include "particleContainer/ParticleContainer.h"
+#include "WrapOpenMP.h"
+
+#include <cmath>
+#include <numeric>
+
+double LoadCalc::getCellLoad(const std::vector<int>& numParticlesPerComponent) const {
+	const int index1 = numParticlesPerComponent.empty() ? 0 : numParticlesPerComponent[0];
+	const int index2 = numParticlesPerComponent.empty() ?
+			0 : std::accumulate(numParticlesPerComponent.begin() + 1, numParticlesPerComponent.end(), 0);
+	return getOwn(index1, index2) + 6 * getFace(index1, index2) + 12 * getEdge(index1, index2)
+			+ 8 * getCorner(index1, index2);
+}
 
 std::vector<double> TunerLoad::readVec(std::istream& in, int& count1, int& count2) {
 	std::vector<double> vec;
@@ -555,3 +570,300 @@ double MeasureLoad::getValue(int numParticles) const {
 			   _interpolationConstants[2];
 	}
 }
+
+// CELLTIMINGLOAD
+CellTimingLoad::CellTimingLoad(double historyWeight)
+	: _threadSamples(mardyn_get_max_threads()), _historyWeight{historyWeight} {
+}
+
+void CellTimingLoad::setComponents(const std::vector<Component>& components) {
+	_componentSites.clear();
+	for (const Component& component : components) {
+		const double numElectrostaticSites = component.numCharges() + component.numDipoles() + component.numQuadrupoles();
+		_componentSites.push_back({static_cast<double>(component.numLJcenters()), numElectrostaticSites});
+	}
+}
+
+double CellTimingLoad::getOwn(int index1, int index2) const {
+	if (not _fitted) {
+		return _tradLoad.getOwn(index1, index2);
+	}
+	return predict(OWN, getFeatures(getSiteCounts({index1, index2})));
+}
+
+double CellTimingLoad::getFace(int index1, int index2) const {
+	if (not _fitted) {
+		return _tradLoad.getFace(index1, index2);
+	}
+	const SiteCounts sites = getSiteCounts({index1, index2});
+	return _callsPerCell[FACE] * predict(FACE, getFeatures(sites, sites)) / 6.;
+}
+
+double CellTimingLoad::getEdge(int index1, int index2) const {
+	if (not _fitted) {
+		return _tradLoad.getEdge(index1, index2);
+	}
+	const SiteCounts sites = getSiteCounts({index1, index2});
+	return _callsPerCell[EDGE] * predict(EDGE, getFeatures(sites, sites)) / 12.;
+}
+
+double CellTimingLoad::getCorner(int index1, int index2) const {
+	if (not _fitted) {
+		return _tradLoad.getCorner(index1, index2);
+	}
+	const SiteCounts sites = getSiteCounts({index1, index2});
+	return _callsPerCell[CORNER] * predict(CORNER, getFeatures(sites, sites)) / 8.;
+}
+
+double CellTimingLoad::getCellLoad(const std::vector<int>& numParticlesPerComponent) const {
+	if (not _fitted) {
+		return _tradLoad.getCellLoad(numParticlesPerComponent);
+	}
+	return getSiteLoad(getSiteCounts(numParticlesPerComponent));
+}
+
+double CellTimingLoad::getSiteLoad(const SiteCounts& cell) const {
+	double load = predict(OWN, getFeatures(cell));
+	const Features neighbourFeatures = getFeatures(cell, cell);
+	for (CallKind kind : {FACE, EDGE, CORNER}) {
+		load += _callsPerCell[kind] * predict(kind, neighbourFeatures);
+	}
+	return load;
+}
+
+double CellTimingLoad::getContainerLoad(ParticleContainer* container) const {
+	if (not _fitted) {
+		return 0.;
+	}
+	// the molecules are binned into cells of the size of the cells of the container
+	const double* cellLength = container->getCellLength();
+	std::array<int, 3> numCells{};
+	for (int d = 0; d < 3; ++d) {
+		const double length = container->getBoundingBoxMax(d) - container->getBoundingBoxMin(d);
+		numCells[d] = std::max(1, static_cast<int>(std::lround(length / cellLength[d])));
+	}
+	std::vector<SiteCounts> cells(numCells[0] * numCells[1] * numCells[2]);
+	for (auto it = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		int cellIndex = 0;
+		for (int d = 2; d >= 0; --d) {
+			const int index = static_cast<int>((it->r(d) - container->getBoundingBoxMin(d)) / cellLength[d]);
+			cellIndex = cellIndex * numCells[d] + std::min(std::max(index, 0), numCells[d] - 1);
+		}
+		cells[cellIndex].add(1., it->numLJcenters(), it->numCharges() + it->numDipoles() + it->numQuadrupoles());
+	}
+	double load = 0.;
+	for (const SiteCounts& cell : cells) {
+		load += getSiteLoad(cell);
+	}
+	return load;
+}
+
+void CellTimingLoad::observeCell(ParticleCell& cell, double time) {
+	// the halo cells are not traversed on their own, as they belong to other processes
+	if (cell.isHaloCell()) {
+		return;
+	}
+	addSample(OWN, getFeatures(countSites(cell)), time);
+}
+
+void CellTimingLoad::observeCellPair(ParticleCell& cell1, ParticleCell& cell2, double time) {
+	if (cell1.isHaloCell() and cell2.isHaloCell()) {
+		return;
+	}
+	// the neighbours share a face, an edge or a corner, if their positions differ in one, two or three dimensions
+	int kind = OWN;
+	for (int d = 0; d < 3; ++d) {
+		kind += (cell1.getBoxMin(d) != cell2.getBoxMin(d)) ? 1 : 0;
+	}
+	if (kind == OWN) {
+		return;
+	}
+	addSample(static_cast<CallKind>(kind), getFeatures(countSites(cell1), countSites(cell2)), time);
+}
+
+#ifdef ENABLE_MPI
+bool CellTimingLoad::fit(MPI_Comm comm) {
+	Sums newSums{};
+	collectSamples(newSums);
+	MPI_Allreduce(MPI_IN_PLACE, newSums[0].data(), NUM_CALL_KINDS * NUM_SUMS, MPI_DOUBLE, MPI_SUM, comm);
+	return fit(newSums);
+}
+#endif
+
+bool CellTimingLoad::fit(const Sums& newSums) {
+	for (int kind = 0; kind < NUM_CALL_KINDS; ++kind) {
+		for (int i = 0; i < NUM_SUMS; ++i) {
+			_sums[kind][i] = _historyWeight * _sums[kind][i] + newSums[kind][i];
+		}
+	}
+	const double numCells = _sums[OWN][NUM_SUMS - 1];
+	if (numCells < NUM_FEATURES) {
+		Log::global_log->info() << "CellTimingLoad: not enough samples to fit the load model." << std::endl;
+		return _fitted;
+	}
+	for (CallKind kind : {OWN, FACE, EDGE, CORNER}) {
+		_callsPerCell[kind] = _sums[kind][NUM_SUMS - 1] / numCells;
+		if (_sums[kind][NUM_SUMS - 1] > 0.) {
+			solve(kind);
+		}
+		Log::global_log->debug() << "CellTimingLoad: calls of kind " << kind << " per cell: " << _callsPerCell[kind]
+				<< ", seconds per molecule pair, LJ pair, electrostatic pair, molecule and call: "
+				<< _coefficients[kind][0] << " " << _coefficients[kind][1] << " " << _coefficients[kind][2] << " "
+				<< _coefficients[kind][3] << " " << _coefficients[kind][4] << std::endl;
+	}
+	_fitted = true;
+	return _fitted;
+}
+
+void CellTimingLoad::solve(CallKind kind) {
+	const std::array<double, NUM_SUMS>& sums = _sums[kind];
+	// the features are scaled to the unit diagonal of the normal equations, as their magnitudes differ widely
+	Features scale{};
+	for (int i = 0; i < NUM_FEATURES; ++i) {
+		const double diagonal = sums[i * NUM_FEATURES + i];
+		scale[i] = diagonal > 0. ? std::sqrt(diagonal) : 0.;
+	}
+	auto matrix = [&](int i, int j) {
+		return sums[i * NUM_FEATURES + j] / (scale[i] * scale[j]);
+	};
+	auto rhs = [&](int i) {
+		return sums[NUM_FEATURES * NUM_FEATURES + i] / scale[i];
+	};
+
+	// As there are only a few features, the non-negative least squares problem is solved exactly: the normal equations
+	// are solved for every subset of the features and the best non-negative solution is kept. Subsets with linearly
+	// dependent features, e.g. the molecule and site pairs of single-centered molecules, are skipped.
+	Features best{};
+	double bestObjective = 0.;  // of the solution 0
+	for (int subset = 1; subset < (1 << NUM_FEATURES); ++subset) {
+		std::vector<int> features;
+		bool unused = false;
+		for (int i = 0; i < NUM_FEATURES; ++i) {
+			if (subset & (1 << i)) {
+				features.push_back(i);
+				unused |= scale[i] == 0.;
+			}
+		}
+		if (unused) {
+			continue;
+		}
+		const size_t n = features.size();
+		// gaussian elimination with partial pivoting, the last column is the right hand side
+		std::vector<std::vector<double>> system(n, std::vector<double>(n + 1));
+		for (size_t row = 0; row < n; ++row) {
+			for (size_t col = 0; col < n; ++col) {
+				system[row][col] = matrix(features[row], features[col]);
+			}
+			system[row][n] = rhs(features[row]);
+		}
+		bool singular = false;
+		for (size_t col = 0; col < n and not singular; ++col) {
+			size_t pivot = col;
+			for (size_t row = col + 1; row < n; ++row) {
+				if (std::abs(system[row][col]) > std::abs(system[pivot][col])) {
+					pivot = row;
+				}
+			}
+			std::swap(system[col], system[pivot]);
+			singular = std::abs(system[col][col]) < 1e-10;
+			for (size_t row = col + 1; row < n and not singular; ++row) {
+				const double factor = system[row][col] / system[col][col];
+				for (size_t k = col; k <= n; ++k) {
+					system[row][k] -= factor * system[col][k];
+				}
+			}
+		}
+		if (singular) {
+			continue;
+		}
+		Features x{};
+		bool negative = false;
+		for (size_t row = n; row-- > 0;) {
+			double value = system[row][n];
+			for (size_t col = row + 1; col < n; ++col) {
+				value -= system[row][col] * x[features[col]];
+			}
+			x[features[row]] = value / system[row][row];
+			negative |= x[features[row]] < 0.;
+		}
+		if (negative) {
+			continue;
+		}
+		// the squared residual up to a constant
+		double objective = 0.;
+		for (int i : features) {
+			for (int j : features) {
+				objective += x[i] * x[j] * matrix(i, j);
+			}
+			objective -= 2. * x[i] * rhs(i);
+		}
+		if (objective < bestObjective) {
+			bestObjective = objective;
+			best = x;
+		}
+	}
+	for (int i = 0; i < NUM_FEATURES; ++i) {
+		_coefficients[kind][i] = scale[i] > 0. ? best[i] / scale[i] : 0.;
+	}
+}
+
+void CellTimingLoad::addSample(CallKind kind, const Features& features, double time) {
+	std::array<double, NUM_SUMS>& sums = _threadSamples[mardyn_get_thread_num()].sums[kind];
+	for (int i = 0; i < NUM_FEATURES; ++i) {
+		for (int j = 0; j < NUM_FEATURES; ++j) {
+			sums[i * NUM_FEATURES + j] += features[i] * features[j];
+		}
+		sums[NUM_FEATURES * NUM_FEATURES + i] += features[i] * time;
+	}
+	sums[NUM_SUMS - 1] += 1.;
+}
+
+void CellTimingLoad::collectSamples(Sums& sums) {
+	for (ThreadSamples& threadSamples : _threadSamples) {
+		for (int kind = 0; kind < NUM_CALL_KINDS; ++kind) {
+			for (int i = 0; i < NUM_SUMS; ++i) {
+				sums[kind][i] += threadSamples.sums[kind][i];
+			}
+		}
+		threadSamples.sums = Sums{};
+	}
+}
+
+CellTimingLoad::SiteCounts CellTimingLoad::countSites(ParticleCell& cell) {
+	SiteCounts sites;
+	for (auto it = cell.iterator(); it.isValid(); ++it) {
+		sites.add(1., it->numLJcenters(), it->numCharges() + it->numDipoles() + it->numQuadrupoles());
+	}
+	return sites;
+}
+
+CellTimingLoad::Features CellTimingLoad::getFeatures(const SiteCounts& cell) {
+	return {0.5 * cell.molecules * (cell.molecules - 1.),
+			0.5 * (cell.ljCenters * cell.ljCenters - cell.ljCentersSquared),
+			0.5 * (cell.electrostaticSites * cell.electrostaticSites - cell.electrostaticSitesSquared),
+			cell.molecules, 1.};
+}
+
+CellTimingLoad::Features CellTimingLoad::getFeatures(const SiteCounts& cell1, const SiteCounts& cell2) {
+	return {cell1.molecules * cell2.molecules, cell1.ljCenters * cell2.ljCenters,
+			cell1.electrostaticSites * cell2.electrostaticSites, cell1.molecules + cell2.molecules, 1.};
+}
+
+double CellTimingLoad::predict(CallKind kind, const Features& features) const {
+	double time = 0.;
+	for (int i = 0; i < NUM_FEATURES; ++i) {
+		time += _coefficients[kind][i] * features[i];
+	}
+	return time;
+}
+
+CellTimingLoad::SiteCounts CellTimingLoad::getSiteCounts(const std::vector<int>& numParticlesPerComponent) const {
+	SiteCounts sites;
+	for (size_t component = 0; component < numParticlesPerComponent.size(); ++component) {
+		// without the components, a molecule is counted as a single Lennard-Jones center
+		const std::array<double, 2> componentSites =
+				component < _componentSites.size() ? _componentSites[component] : std::array<double, 2>{1., 0.};
+		sites.add(numParticlesPerComponent[component], componentSites[0], componentSites[1]);
+	}
+	return sites;
+}
@@ -16,9 +16,12 @@
 
 #include <utils/Logger.h>
 
+class Component;
 class DomainDecompBase;
+class ParticleContainer;
 
 #include "Simulation.h"
+#include "particleContainer/adapter/InstrumentedCellProcessor.h"
 
 
 class LoadCalc {
@@ -34,6 +37,13 @@ public:
 	virtual double getEdge(int index1, int index2) const = 0;
 
 	virtual double getCorner(int index1, int index2) const = 0;
+
+	/**
+	 * Get the load of a cell including the interactions with its 26 neighbours, which are assumed to be occupied
+	 * alike. By default, the molecules of all but the first component are counted as the second particle type.
+	 * @param numParticlesPerComponent number of molecules of every component in the cell
+	 */
+	virtual double getCellLoad(const std::vector<int>& numParticlesPerComponent) const;
 };
 
 /**
@@ -267,3 +277,136 @@ private:
 	int _interpolationStartsAt{1};
 	bool _timeValuesShouldBeIncreasing{true};
 };
+
+
+/**
+ * Load model, which is fit continuously to the times of the force calculation measured per cell during the
+ * simulation, see InstrumentedCellProcessor.
+ *
+ * The time of one call of the cell processor, i.e., for one cell or for a pair of cells sharing a face, an edge or a
+ * corner, is modelled as
+ * \f[ t = c_0 P_{mol} + c_1 P_{LJ} + c_2 P_{el} + c_3 N_{mol} + c_4, \f]
+ * where \f$P\f$ are the numbers of pairs of molecules, of Lennard-Jones centers and of electrostatic sites (charges,
+ * dipoles and quadrupoles), and \f$N_{mol}\f$ is the number of molecules in the cell(s). The coefficients are fit for
+ * the four kinds of calls by a non-negative least squares fit to the samples of all processes, so mixtures of
+ * components with different site types are weighted by their measured costs.
+ *
+ * The samples are accumulated between the fits. At every fit, the previous samples are weighted by historyWeight, so
+ * that the model follows the simulation. Until the first fit, the loads of TradLoad are returned.
+ */
+class CellTimingLoad: public LoadCalc, public CellTimeObserver {
+public:
+	explicit CellTimingLoad(double historyWeight);
+
+	/**
+	 * Sets the components, whose sites are used to get the load from the number of molecules per component.
+	 */
+	void setComponents(const std::vector<Component>& components);
+
+	/**
+	 * The loads for index1 molecules of the first and index2 molecules of the second component. The loads of the
+	 * neighbours are scaled, such that getOwn() + 6 getFace() + 12 getEdge() + 8 getCorner() equals getCellLoad().
+	 */
+	double getOwn(int index1, int index2) const override;
+
+	double getFace(int index1, int index2) const override;
+
+	double getEdge(int index1, int index2) const override;
+
+	double getCorner(int index1, int index2) const override;
+
+	double getCellLoad(const std::vector<int>& numParticlesPerComponent) const override;
+
+	/**
+	 * @return the load of all inner cells of the container, 0 if the model is not fitted yet
+	 */
+	double getContainerLoad(ParticleContainer* container) const;
+
+	void observeCell(ParticleCell& cell, double time) override;
+
+	void observeCellPair(ParticleCell& cell1, ParticleCell& cell2, double time) override;
+
+#ifdef ENABLE_MPI
+	/**
+	 * Fits the model to the samples of all processes, which were observed since the last fit. Collective on comm.
+	 * @return true if the model is fitted, i.e. if there were enough samples so far
+	 */
+	bool fit(MPI_Comm comm);
+#endif
+
+	bool isFitted() const {
+		return _fitted;
+	}
+
+private:
+	enum CallKind {
+		OWN = 0, FACE = 1, EDGE = 2, CORNER = 3
+	};
+	static constexpr int NUM_CALL_KINDS = 4;
+	static constexpr int NUM_FEATURES = 5;
+	//! normal equations of the least squares fit (matrix, right hand side) followed by the number of samples
+	static constexpr int NUM_SUMS = NUM_FEATURES * NUM_FEATURES + NUM_FEATURES + 1;
+	typedef std::array<double, NUM_FEATURES> Features;
+	typedef std::array<std::array<double, NUM_SUMS>, NUM_CALL_KINDS> Sums;
+
+	//! sites of the molecules of a cell, the squares are summed per molecule to exclude the intramolecular pairs
+	struct SiteCounts {
+		double molecules{0.};
+		double ljCenters{0.};
+		double electrostaticSites{0.};
+		double ljCentersSquared{0.};
+		double electrostaticSitesSquared{0.};
+
+		void add(double numMolecules, double numLJCenters, double numElectrostaticSites) {
+			molecules += numMolecules;
+			ljCenters += numMolecules * numLJCenters;
+			electrostaticSites += numMolecules * numElectrostaticSites;
+			ljCentersSquared += numMolecules * numLJCenters * numLJCenters;
+			electrostaticSitesSquared += numMolecules * numElectrostaticSites * numElectrostaticSites;
+		}
+	};
+
+	// aligned to avoid false sharing of the samples of the threads
+	struct alignas(64) ThreadSamples {
+		Sums sums{};
+	};
+
+	void addSample(CallKind kind, const Features& features, double time);
+
+	//! fits the model to the given samples, which are summed over all processes
+	bool fit(const Sums& newSums);
+
+	//! sums the samples of all threads into sums and resets them
+	void collectSamples(Sums& sums);
+
+	static SiteCounts countSites(ParticleCell& cell);
+
+	//! features of a call for one cell
+	static Features getFeatures(const SiteCounts& cell);
+
+	//! features of a call for a pair of cells
+	static Features getFeatures(const SiteCounts& cell1, const SiteCounts& cell2);
+
+	double predict(CallKind kind, const Features& features) const;
+
+	SiteCounts getSiteCounts(const std::vector<int>& numParticlesPerComponent) const;
+
+	double getSiteLoad(const SiteCounts& cell) const;
+
+	//! solves the normal equations of the given kind of calls, the coefficients are non-negative
+	void solve(CallKind kind);
+
+	std::vector<ThreadSamples> _threadSamples;
+	//! weighted samples of all processes as of the last fit
+	Sums _sums{};
+	std::array<Features, NUM_CALL_KINDS> _coefficients{};
+	//! mean number of calls of each kind per cell, e.g. 1 for OWN
+	std::array<double, NUM_CALL_KINDS> _callsPerCell{};
+	//! number of Lennard-Jones centers and electrostatic sites of a molecule of every component
+	std::vector<std::array<double, 2>> _componentSites;
+	double _historyWeight;
+	bool _fitted{false};
+	TradLoad _tradLoad;
+
+	friend class CellTimingLoadTest;
+};
@@ -8,6 +8,7 @@ class NeighbourCommunicationScheme;
 class DirectNeighbourCommunicationScheme;
 class IndirectNeighbourCommunicationScheme;
 
+#include <limits>
 #include <mpi.h>
 #include "NeighbourCommunicationScheme.h"
 #include "Domain.h"
@@ -172,7 +173,7 @@ void DirectNeighbourCommunicationScheme::doDirectFallBackExchange(
 }
 
 void DirectNeighbourCommunicationScheme::initExchangeMoleculesMPI(ParticleContainer* moleculeContainer, Domain* domain,
-																  MessageType msgType, bool /*removeRecvDuplicates*/,
+																  MessageType msgType, bool removeRecvDuplicates,
 																  DomainDecompMPIBase* domainDecomp,
 																  bool doHaloPositionCheck) {
 	// We mimic the direct neighbour communication also for the sequential case, otherwise things are copied multiple
@@ -186,65 +187,83 @@ void DirectNeighbourCommunicationScheme::initExchangeMoleculesMPI(ParticleContai
 	// halo position check needs to be done, unless it is a invalidParticle returner and it had no invalid particles.
 	auto invalidParticles = moleculeContainer->getInvalidParticles();
 
-	if(_useSequentialFallback) {
-		std::array<double, DIMgeom> rmin;  // lower corner
-		std::array<double, DIMgeom> rmax;  // higher corner
-
-		for (int d = 0; d < DIMgeom; d++) {
-			rmin[d] = domainDecomp->getBoundingBoxMin(d, domain);
-			rmax[d] = domainDecomp->getBoundingBoxMax(d, domain);
-		}
-		HaloRegion ownRegion = {rmin[0], rmin[1], rmin[2], rmax[0], rmax[1],
-								rmax[2], 0,       0,       0,       global_simulation->getcutoffRadius()};
-		std::vector<HaloRegion> haloRegions;
-		double* cellLength = moleculeContainer->getHaloSize();
-		std::vector<Molecule> dummy{};
-		switch (msgType) {
-			case LEAVING_AND_HALO_COPIES:
-				haloRegions = _zonalMethod->getLeavingExportRegions(ownRegion, moleculeContainer->getCutoff(),
-																	_coversWholeDomain);
-				doDirectFallBackExchange(haloRegions, LEAVING_ONLY, domainDecomp, moleculeContainer, invalidParticles,
-										 doHaloPositionCheck);
-				haloRegions = _zonalMethod->getHaloExportForceImportRegions(ownRegion, moleculeContainer->getCutoff(),
-																			moleculeContainer->getSkin(),
-																			_coversWholeDomain, cellLength);
-				doDirectFallBackExchange(haloRegions, HALO_COPIES, domainDecomp, moleculeContainer, dummy,
-										 doHaloPositionCheck);
-				break;
-			case LEAVING_ONLY:
-				haloRegions = _zonalMethod->getLeavingExportRegions(ownRegion, moleculeContainer->getCutoff(),
-																	_coversWholeDomain);
-				doDirectFallBackExchange(haloRegions, msgType, domainDecomp, moleculeContainer, invalidParticles,
-										 doHaloPositionCheck);
-				break;
-			case HALO_COPIES:
-				haloRegions = _zonalMethod->getHaloExportForceImportRegions(ownRegion, moleculeContainer->getCutoff(),
-																			moleculeContainer->getSkin(),
-																			_coversWholeDomain, cellLength);
-				doDirectFallBackExchange(haloRegions, msgType, domainDecomp, moleculeContainer, dummy,
-										 doHaloPositionCheck);
-				break;
-			case FORCES:
-				haloRegions = _zonalMethod->getHaloImportForceExportRegions(
-					ownRegion, moleculeContainer->getCutoff(), moleculeContainer->getSkin(), _coversWholeDomain, cellLength);
-				doDirectFallBackExchange(haloRegions, msgType, domainDecomp, moleculeContainer, dummy,
-										 doHaloPositionCheck);
-				break;
-		}
+	if (_useSequentialFallback) {
+		doSequentialFallBackExchange(moleculeContainer, domain, msgType, domainDecomp, invalidParticles,
+									 doHaloPositionCheck);
 	}
 
-
 	// 1Stage=> only _neighbours[0] exists!
 	const int numNeighbours = (*_neighbours)[0].size();
 	// send only if neighbour is actually a neighbour.
 	for (int i = 0; i < numNeighbours; ++i) {
 		if (not _useSequentialFallback or (*_neighbours)[0][i].getRank() != domainDecomp->getRank()) {
 			global_log->debug() << "Rank " << domainDecomp->getRank() << " is initiating communication to" << std::endl;
-			(*_neighbours)[0][i].initSend(moleculeContainer, domainDecomp->getCommunicator(),
-					domainDecomp->getMPIParticleType(), msgType, invalidParticles, true, doHaloPositionCheck);
+			// messages to the own rank are received with the removal of duplicates
+			(*_neighbours)[0][i].setCompactHaloCopies(_compactHaloCopies, _haloCopiesWithIds or removeRecvDuplicates
+					or (*_neighbours)[0][i].getRank() == domainDecomp->getRank());
+			if (_usePersistentCommunication) {
+				(*_neighbours)[0][i].initSendPersistent(moleculeContainer, domainDecomp->getCommunicator(), msgType,
+						invalidParticles, true, doHaloPositionCheck);
+			} else {
+				(*_neighbours)[0][i].initSend(moleculeContainer, domainDecomp->getCommunicator(),
+						domainDecomp->getMPIParticleType(), msgType, invalidParticles, true, doHaloPositionCheck);
+			}
 		}
 
 	}
+	checkInvalidParticlesSent(invalidParticles);
+}
+
+void DirectNeighbourCommunicationScheme::doSequentialFallBackExchange(ParticleContainer* moleculeContainer,
+		Domain* domain, MessageType msgType, DomainDecompMPIBase* domainDecomp, std::vector<Molecule>& invalidParticles,
+		bool doHaloPositionCheck) {
+	std::array<double, DIMgeom> rmin;  // lower corner
+	std::array<double, DIMgeom> rmax;  // higher corner
+
+	for (int d = 0; d < DIMgeom; d++) {
+		rmin[d] = domainDecomp->getBoundingBoxMin(d, domain);
+		rmax[d] = domainDecomp->getBoundingBoxMax(d, domain);
+	}
+	HaloRegion ownRegion = {rmin[0], rmin[1], rmin[2], rmax[0], rmax[1],
+							rmax[2], 0,       0,       0,       global_simulation->getcutoffRadius()};
+	std::vector<HaloRegion> haloRegions;
+	double* cellLength = moleculeContainer->getHaloSize();
+	std::vector<Molecule> dummy{};
+	switch (msgType) {
+		case LEAVING_AND_HALO_COPIES:
+			haloRegions = _zonalMethod->getLeavingExportRegions(ownRegion, moleculeContainer->getCutoff(),
+																_coversWholeDomain);
+			doDirectFallBackExchange(haloRegions, LEAVING_ONLY, domainDecomp, moleculeContainer, invalidParticles,
+									 doHaloPositionCheck);
+			haloRegions = _zonalMethod->getHaloExportForceImportRegions(ownRegion, moleculeContainer->getCutoff(),
+																		moleculeContainer->getSkin(),
+																		_coversWholeDomain, cellLength);
+			doDirectFallBackExchange(haloRegions, HALO_COPIES, domainDecomp, moleculeContainer, dummy,
+									 doHaloPositionCheck);
+			break;
+		case LEAVING_ONLY:
+			haloRegions = _zonalMethod->getLeavingExportRegions(ownRegion, moleculeContainer->getCutoff(),
+																_coversWholeDomain);
+			doDirectFallBackExchange(haloRegions, msgType, domainDecomp, moleculeContainer, invalidParticles,
+									 doHaloPositionCheck);
+			break;
+		case HALO_COPIES:
+			haloRegions = _zonalMethod->getHaloExportForceImportRegions(ownRegion, moleculeContainer->getCutoff(),
+																		moleculeContainer->getSkin(),
+																		_coversWholeDomain, cellLength);
+			doDirectFallBackExchange(haloRegions, msgType, domainDecomp, moleculeContainer, dummy,
+									 doHaloPositionCheck);
+			break;
+		case FORCES:
+			haloRegions = _zonalMethod->getHaloImportForceExportRegions(
+				ownRegion, moleculeContainer->getCutoff(), moleculeContainer->getSkin(), _coversWholeDomain, cellLength);
+			doDirectFallBackExchange(haloRegions, msgType, domainDecomp, moleculeContainer, dummy,
+									 doHaloPositionCheck);
+			break;
+	}
+}
+
+void DirectNeighbourCommunicationScheme::checkInvalidParticlesSent(std::vector<Molecule>& invalidParticles) {
 	if(not invalidParticles.empty()){
 		global_log->error_always_output() << "NeighbourCommunicationScheme: Invalid particles that should have been "
 											 "removed, are still existent. They would be lost. Aborting..."
@@ -263,7 +282,6 @@ void DirectNeighbourCommunicationScheme::initExchangeMoleculesMPI(ParticleContai
 		}
 		Simulation::exit(544);
 	}
-
 }
 
 void DirectNeighbourCommunicationScheme::finalizeExchangeMoleculesMPI(ParticleContainer* moleculeContainer,
@@ -304,9 +322,13 @@ void DirectNeighbourCommunicationScheme::finalizeExchangeMoleculesMPI(ParticleCo
 		}
 	};
 
-	forAllRealNeighbors([](auto& neighbor) {
+	forAllRealNeighbors([&](auto& neighbor) {
 		// reset receive status
-		neighbor.resetReceive();
+		if (_usePersistentCommunication) {
+			neighbor.initRecvPersistent(domainDecomp->getCommunicator(), msgType);
+		} else {
+			neighbor.resetReceive();
+		}
 	});
 
 	if (_pushPull) {
@@ -498,7 +520,7 @@ void DirectNeighbourCommunicationScheme::initCommunicationPartners(double cutoff
 }
 
 void IndirectNeighbourCommunicationScheme::initExchangeMoleculesMPI1D(ParticleContainer* moleculeContainer,
-		Domain* /*domain*/, MessageType msgType, bool /*removeRecvDuplicates*/, unsigned short d,
+		Domain* /*domain*/, MessageType msgType, bool removeRecvDuplicates, unsigned short d,
 		DomainDecompMPIBase* domainDecomp) {
 	
 	
@@ -527,8 +549,14 @@ void IndirectNeighbourCommunicationScheme::initExchangeMoleculesMPI1D(ParticleCo
 		std::vector<Molecule> dummy;
 		for (int i = 0; i < numNeighbours; ++i) {
 			global_log->debug() << "Rank " << domainDecomp->getRank() << " is initiating communication to" << std::endl;
-			(*_neighbours)[d][i].initSend(moleculeContainer, domainDecomp->getCommunicator(),
-					domainDecomp->getMPIParticleType(), msgType, dummy, false, true/*do halo position change*/);
+			(*_neighbours)[d][i].setCompactHaloCopies(_compactHaloCopies, _haloCopiesWithIds or removeRecvDuplicates);
+			if (_usePersistentCommunication) {
+				(*_neighbours)[d][i].initSendPersistent(moleculeContainer, domainDecomp->getCommunicator(), msgType,
+						dummy, false, true/*do halo position change*/);
+			} else {
+				(*_neighbours)[d][i].initSend(moleculeContainer, domainDecomp->getCommunicator(),
+						domainDecomp->getMPIParticleType(), msgType, dummy, false, true/*do halo position change*/);
+			}
 		}
 
 	}
@@ -555,7 +583,11 @@ void IndirectNeighbourCommunicationScheme::finalizeExchangeMoleculesMPI1D(Partic
 	global_log->set_mpi_output_all();
 	for (int i = 0; i < numNeighbours; ++i) { // reset receive status
 		if (domainDecomp->getRank() != (*_neighbours)[d][i].getRank()) {
-			(*_neighbours)[d][i].resetReceive();
+			if (_usePersistentCommunication) {
+				(*_neighbours)[d][i].initRecvPersistent(domainDecomp->getCommunicator(), msgType);
+			} else {
+				(*_neighbours)[d][i].resetReceive();
+			}
 		}
 	}
 
@@ -688,3 +720,208 @@ void IndirectNeighbourCommunicationScheme::initCommunicationPartners(double cuto
 		(*_neighbours)[d]= NeighborAcquirer::squeezePartners((*_neighbours)[d]);
 	}
 }
+
+#if MPI_VERSION >= 3
+NeighbourhoodCollectiveCommunicationScheme::~NeighbourhoodCollectiveCommunicationScheme() {
+	freeGraphs();
+}
+
+void NeighbourhoodCollectiveCommunicationScheme::initCommunicationPartners(double cutoffRadius, Domain* domain,
+		DomainDecompMPIBase* domainDecomp, ParticleContainer* moleculeContainer) {
+	DirectNeighbourCommunicationScheme::initCommunicationPartners(cutoffRadius, domain, domainDecomp,
+			moleculeContainer);
+
+	// the partners have changed, so the graphs have to be created anew
+	freeGraphs();
+	if (_pushPull) {
+		createGraph(_graphs[0], (*_leavingImportNeighbours)[0], (*_leavingExportNeighbours)[0], domainDecomp);
+		createGraph(_graphs[1], (*_haloImportForceExportNeighbours)[0], (*_haloExportForceImportNeighbours)[0],
+				domainDecomp);
+		createGraph(_graphs[2], (*_haloExportForceImportNeighbours)[0], (*_haloImportForceExportNeighbours)[0],
+				domainDecomp);
+	} else {
+		createGraph(_graphs[0], (*_neighbours)[0], (*_neighbours)[0], domainDecomp);
+	}
+}
+
+void NeighbourhoodCollectiveCommunicationScheme::createGraph(NeighbourhoodGraph& graph,
+		std::vector<CommunicationPartner>& sources, std::vector<CommunicationPartner>& destinations,
+		DomainDecompMPIBase* domainDecomp) {
+	// the own process is handled by the sequential fallback, see DirectNeighbourCommunicationScheme
+	auto addEdges = [&](std::vector<CommunicationPartner>& partners, std::vector<CommunicationPartner*>& edges,
+			std::vector<int>& ranks) {
+		edges.clear();
+		for (CommunicationPartner& partner : partners) {
+			if (not _useSequentialFallback or partner.getRank() != domainDecomp->getRank()) {
+				edges.push_back(&partner);
+				ranks.push_back(partner.getRank());
+			}
+		}
+	};
+	std::vector<int> sourceRanks, destinationRanks;
+	addEdges(sources, graph.sources, sourceRanks);
+	addEdges(destinations, graph.destinations, destinationRanks);
+
+	// no reordering, the partners refer to the ranks of the communicator of the decomposition
+	MPI_CHECK(MPI_Dist_graph_create_adjacent(domainDecomp->getCommunicator(), (int) sourceRanks.size(),
+			sourceRanks.data(), MPI_UNWEIGHTED, (int) destinationRanks.size(), destinationRanks.data(), MPI_UNWEIGHTED,
+			MPI_INFO_NULL, 0, &graph.comm));
+}
+
+void NeighbourhoodCollectiveCommunicationScheme::freeGraphs() {
+	// the scheme might be destroyed after MPI_Finalize
+	int finalized = 0;
+	MPI_Finalized(&finalized);
+	for (NeighbourhoodGraph& graph : _graphs) {
+		if (graph.comm != MPI_COMM_NULL and not finalized) {
+			MPI_CHECK(MPI_Comm_free(&graph.comm));
+		}
+		graph = NeighbourhoodGraph();
+	}
+}
+
+NeighbourhoodCollectiveCommunicationScheme::NeighbourhoodGraph& NeighbourhoodCollectiveCommunicationScheme::getGraph(
+		MessageType msgType) {
+	if (not _pushPull) {
+		return _graphs[0];
+	}
+	switch (msgType) {
+		case LEAVING_ONLY:
+			return _graphs[0];
+		case HALO_COPIES:
+			return _graphs[1];
+		case FORCES:
+			return _graphs[2];
+		default:
+			global_log->error() << "NeighbourhoodCollectiveCommunicationScheme: push-pull partners can not exchange "
+								   "leaving molecules and halo copies in one message" << std::endl;
+			Simulation::exit(1);
+			return _graphs[0];
+	}
+}
+
+void NeighbourhoodCollectiveCommunicationScheme::prepareNonBlockingStageImpl(ParticleContainer* moleculeContainer,
+		Domain* domain, unsigned int stageNumber, MessageType msgType, bool removeRecvDuplicates,
+		DomainDecompMPIBase* domainDecomp) {
+	mardyn_assert(stageNumber < getCommDims());
+	initExchangeMoleculesCollective(moleculeContainer, domain, msgType, removeRecvDuplicates, domainDecomp, true);
+}
+
+void NeighbourhoodCollectiveCommunicationScheme::finishNonBlockingStageImpl(ParticleContainer* moleculeContainer,
+		Domain* /*domain*/, unsigned int stageNumber, MessageType msgType, bool removeRecvDuplicates,
+		DomainDecompMPIBase* domainDecomp) {
+	mardyn_assert(stageNumber < getCommDims());
+	finalizeExchangeMoleculesCollective(moleculeContainer, msgType, removeRecvDuplicates, domainDecomp);
+}
+
+void NeighbourhoodCollectiveCommunicationScheme::exchangeMoleculesMPI(ParticleContainer* moleculeContainer,
+		Domain* domain, MessageType msgType, bool removeRecvDuplicates, DomainDecompMPIBase* domainDecomp,
+		bool doHaloPositionCheck) {
+	if (msgType == LEAVING_AND_HALO_COPIES) {
+		msgType = LEAVING_ONLY;
+
+		initExchangeMoleculesCollective(moleculeContainer, domain, msgType, removeRecvDuplicates, domainDecomp,
+				doHaloPositionCheck);
+		finalizeExchangeMoleculesCollective(moleculeContainer, msgType, removeRecvDuplicates, domainDecomp);
+		moleculeContainer->deleteOuterParticles();
+		msgType = HALO_COPIES;
+	}
+	initExchangeMoleculesCollective(moleculeContainer, domain, msgType, removeRecvDuplicates, domainDecomp,
+			doHaloPositionCheck);
+	finalizeExchangeMoleculesCollective(moleculeContainer, msgType, removeRecvDuplicates, domainDecomp);
+}
+
+void NeighbourhoodCollectiveCommunicationScheme::initExchangeMoleculesCollective(ParticleContainer* moleculeContainer,
+		Domain* domain, MessageType msgType, bool removeRecvDuplicates, DomainDecompMPIBase* domainDecomp,
+		bool doHaloPositionCheck) {
+	mardyn_assert(_request == MPI_REQUEST_NULL);
+	if (_pushPull) {
+		selectNeighbours(msgType, false /* export */);
+	}
+
+	auto invalidParticles = moleculeContainer->getInvalidParticles();
+	if (_useSequentialFallback) {
+		doSequentialFallBackExchange(moleculeContainer, domain, msgType, domainDecomp, invalidParticles,
+									 doHaloPositionCheck);
+	}
+
+	NeighbourhoodGraph& graph = getGraph(msgType);
+	mardyn_assert(graph.comm != MPI_COMM_NULL);
+
+	const size_t numDestinations = graph.destinations.size();
+	_sendCounts.resize(numDestinations);
+	_sendDisplacements.resize(numDestinations);
+	unsigned long numBytes = 0;
+	for (size_t i = 0; i < numDestinations; ++i) {
+		CommunicationPartner& partner = *graph.destinations[i];
+		// messages to the own rank are received with the removal of duplicates
+		partner.setCompactHaloCopies(_compactHaloCopies, _haloCopiesWithIds or removeRecvDuplicates
+				or partner.getRank() == domainDecomp->getRank());
+		const unsigned long partnerBytes = partner.initSendCollective(moleculeContainer, msgType, invalidParticles,
+				true, doHaloPositionCheck);
+		mardyn_assert(numBytes + partnerBytes <= static_cast<unsigned long>(std::numeric_limits<int>::max()));
+		_sendCounts[i] = static_cast<int>(partnerBytes);
+		_sendDisplacements[i] = static_cast<int>(numBytes);
+		numBytes += partnerBytes;
+	}
+	checkInvalidParticlesSent(invalidParticles);
+
+	_sendBuffer.resize(numBytes);
+	for (size_t i = 0; i < numDestinations; ++i) {
+		graph.destinations[i]->moveCollectedBytes(_sendBuffer.data() + _sendDisplacements[i]);
+	}
+
+	// the receivers need the sizes of the messages to place them in their buffer
+	const size_t numSources = graph.sources.size();
+	_recvCounts.resize(numSources);
+	_recvDisplacements.resize(numSources);
+	MPI_CHECK(MPI_Neighbor_alltoall(_sendCounts.data(), 1, MPI_INT, _recvCounts.data(), 1, MPI_INT, graph.comm));
+	numBytes = 0;
+	for (size_t i = 0; i < numSources; ++i) {
+		_recvDisplacements[i] = static_cast<int>(numBytes);
+		numBytes += _recvCounts[i];
+	}
+	_recvBuffer.resize(numBytes);
+
+	MPI_CHECK(MPI_Ineighbor_alltoallv(_sendBuffer.data(), _sendCounts.data(), _sendDisplacements.data(),
+			CommunicationBuffer::getMPIDataType(), _recvBuffer.data(), _recvCounts.data(), _recvDisplacements.data(),
+			CommunicationBuffer::getMPIDataType(), graph.comm, &_request));
+}
+
+void NeighbourhoodCollectiveCommunicationScheme::finalizeExchangeMoleculesCollective(
+		ParticleContainer* moleculeContainer, MessageType msgType, bool removeRecvDuplicates,
+		DomainDecompMPIBase* domainDecomp) {
+	// see DirectNeighbourCommunicationScheme::finalizeExchangeMoleculesMPI
+	auto checkOwnRank = [&](const std::vector<CommunicationPartner>& partners) {
+		for (const CommunicationPartner& partner : partners) {
+			removeRecvDuplicates |= (domainDecomp->getRank() == partner.getRank());
+		}
+	};
+	if (_pushPull) {
+		selectNeighbours(msgType, true /* import */);
+		checkOwnRank((*_neighbours)[0]);
+		selectNeighbours(msgType, false /* export */);
+	}
+	checkOwnRank((*_neighbours)[0]);
+
+	MPI_CHECK(MPI_Wait(&_request, MPI_STATUS_IGNORE));
+
+	NeighbourhoodGraph& graph = getGraph(msgType);
+	for (size_t i = 0; i < graph.sources.size(); ++i) {
+		CommunicationPartner& partner = *graph.sources[i];
+		partner.initRecvCollective(_recvBuffer.data() + _recvDisplacements[i], _recvCounts[i]);
+		partner.testRecv(moleculeContainer, removeRecvDuplicates, msgType == FORCES);
+	}
+}
+
+size_t NeighbourhoodCollectiveCommunicationScheme::getDynamicSize() {
+	size_t totSize = DirectNeighbourCommunicationScheme::getDynamicSize();
+	for (const NeighbourhoodGraph& graph : _graphs) {
+		totSize += (graph.sources.capacity() + graph.destinations.capacity()) * sizeof(CommunicationPartner*);
+	}
+	totSize += (_sendCounts.capacity() + _sendDisplacements.capacity() + _recvCounts.capacity()
+			+ _recvDisplacements.capacity()) * sizeof(int);
+	totSize += _sendBuffer.capacity() + _recvBuffer.capacity();
+	return totSize;
+}
+#endif
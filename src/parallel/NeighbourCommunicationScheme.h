@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 
 #include "parallel/CommunicationPartner.h"
@@ -93,6 +94,31 @@ public:
 		_useSequentialFallback = useSequentialFallback;
 	}
 
+	/**
+	 * Exchange the molecules through persistent channels between the CommunicationPartners, which are kept until the
+	 * partners are initialised anew, instead of probing for every message (see CommunicationPartner::initSendPersistent).
+	 */
+	void setPersistentCommunication(bool usePersistentCommunication) {
+		_usePersistentCommunication = usePersistentCommunication;
+	}
+
+	/**
+	 * Send the halo copies in the compact encoding (see CommunicationBuffer::setCompactHalo()). Their ids are only
+	 * omitted if withIds is false and the receiver does not need them to remove duplicates.
+	 */
+	void setCompactHaloCopies(bool compact, bool withIds) {
+		_compactHaloCopies = compact;
+		_haloCopiesWithIds = withIds;
+	}
+
+	//! takes over the sequential fallback, persistent communication and halo copy encoding of another scheme
+	void copyOptions(const NeighbourCommunicationScheme& other) {
+		_useSequentialFallback = other._useSequentialFallback;
+		_usePersistentCommunication = other._usePersistentCommunication;
+		_compactHaloCopies = other._compactHaloCopies;
+		_haloCopiesWithIds = other._haloCopiesWithIds;
+	}
+
 protected:
 
 	//! vector of neighbours. The first dimension should be of size getCommDims().
@@ -123,6 +149,11 @@ protected:
 	bool _pushPull;
 
 	bool _useSequentialFallback{true};
+
+	bool _usePersistentCommunication{false};
+
+	bool _compactHaloCopies{false};
+	bool _haloCopiesWithIds{true};
 };
 
 class DirectNeighbourCommunicationScheme: public NeighbourCommunicationScheme {
@@ -163,6 +194,13 @@ protected:
 	void initExchangeMoleculesMPI(ParticleContainer* moleculeContainer, Domain* /*domain*/, MessageType msgType,
 			bool /*removeRecvDuplicates*/, DomainDecompMPIBase* domainDecomp, bool doHaloPositionCheck);
 
+	//! exchanges the molecules with the own process along the dimensions it covers completely
+	void doSequentialFallBackExchange(ParticleContainer* moleculeContainer, Domain* domain, MessageType msgType,
+			DomainDecompMPIBase* domainDecomp, std::vector<Molecule>& invalidParticles, bool doHaloPositionCheck);
+
+	//! aborts if invalid particles are left, which were sent to no neighbour
+	void checkInvalidParticlesSent(std::vector<Molecule>& invalidParticles);
+
 private:
 	void doDirectFallBackExchange(const std::vector<HaloRegion>& haloRegions, MessageType msgType,
 								  DomainDecompMPIBase* domainDecomp, ParticleContainer*& moleculeContainer,
@@ -213,3 +251,69 @@ protected:
 			std::vector<std::vector<CommunicationPartner>>& neighbours, HaloRegion& ownRegion, double cutoffRadius);
 
 };
+
+#if MPI_VERSION >= 3
+/**
+ * Exchanges the messages of the DirectNeighbourCommunicationScheme with MPI-3 neighbourhood collectives on a
+ * distributed graph communicator of the neighbours, instead of one point-to-point message per neighbour: the numbers
+ * of bytes are exchanged with MPI_Neighbor_alltoall, the molecules with MPI_Ineighbor_alltoallv. This leaves the
+ * scheduling and aggregation of the messages to the MPI library.
+ *
+ * The graph communicators are created anew by initCommunicationPartners(), i.e. whenever the decomposition changes the
+ * neighbours. With push-pull partners, senders and receivers differ, so there is one graph for the leaving molecules,
+ * one for the halo copies and one for the forces.
+ */
+class NeighbourhoodCollectiveCommunicationScheme : public DirectNeighbourCommunicationScheme {
+public:
+	NeighbourhoodCollectiveCommunicationScheme(ZonalMethod* zonalMethod, bool pushPull) :
+			DirectNeighbourCommunicationScheme(zonalMethod, pushPull) {
+	}
+	~NeighbourhoodCollectiveCommunicationScheme() override;
+
+	void initCommunicationPartners(double cutoffRadius, Domain * domain,
+			DomainDecompMPIBase* domainDecomp,
+			ParticleContainer* moleculeContainer) override;
+
+	void prepareNonBlockingStageImpl(ParticleContainer* moleculeContainer, Domain* domain,
+			unsigned int stageNumber, MessageType msgType, bool removeRecvDuplicates,
+			DomainDecompMPIBase* domainDecomp) override;
+
+	void finishNonBlockingStageImpl(ParticleContainer* moleculeContainer, Domain* domain,
+			unsigned int stageNumber, MessageType msgType, bool removeRecvDuplicates,
+			DomainDecompMPIBase* domainDecomp) override;
+
+	void exchangeMoleculesMPI(ParticleContainer* moleculeContainer, Domain* domain, MessageType msgType,
+			bool removeRecvDuplicates, DomainDecompMPIBase* domainDecomp, bool doHaloPositionCheck=true) override;
+
+	size_t getDynamicSize() override;
+
+private:
+	//! distributed graph communicator and the partners of its edges, in the order of the edges
+	struct NeighbourhoodGraph {
+		MPI_Comm comm{MPI_COMM_NULL};
+		std::vector<CommunicationPartner*> sources;
+		std::vector<CommunicationPartner*> destinations;
+	};
+
+	void createGraph(NeighbourhoodGraph& graph, std::vector<CommunicationPartner>& sources,
+			std::vector<CommunicationPartner>& destinations, DomainDecompMPIBase* domainDecomp);
+
+	void freeGraphs();
+
+	NeighbourhoodGraph& getGraph(MessageType msgType);
+
+	void initExchangeMoleculesCollective(ParticleContainer* moleculeContainer, Domain* domain, MessageType msgType,
+			bool removeRecvDuplicates, DomainDecompMPIBase* domainDecomp, bool doHaloPositionCheck);
+
+	void finalizeExchangeMoleculesCollective(ParticleContainer* moleculeContainer, MessageType msgType,
+			bool removeRecvDuplicates, DomainDecompMPIBase* domainDecomp);
+
+	//! without push-pull partners only the first graph is used, otherwise the ones of leaving, halo copies and forces
+	std::array<NeighbourhoodGraph, 3> _graphs;
+
+	// state of the pending exchange
+	std::vector<int> _sendCounts, _sendDisplacements, _recvCounts, _recvDisplacements;
+	std::vector<unsigned char> _sendBuffer, _recvBuffer;
+	MPI_Request _request{MPI_REQUEST_NULL};
+};
+#endif
@@ -0,0 +1,124 @@
+/*
+ * CellTimingLoadTest.cpp
+ */
+
+#include "CellTimingLoadTest.h"
+#include "parallel/LoadCalc.h"
+
+TEST_SUITE_REGISTRATION(CellTimingLoadTest);
+
+CellTimingLoadTest::CellTimingLoadTest() {
+}
+
+CellTimingLoadTest::~CellTimingLoadTest() {
+}
+
+namespace {
+// seconds per molecule pair, LJ pair, electrostatic pair, molecule and call
+const std::array<double, 5> ownCoefficients{1e-8, 2e-8, 5e-8, 1e-7, 1e-6};
+const std::array<double, 5> faceCoefficients{1.5e-8, 2e-8, 4e-8, 0., 2e-6};
+
+double dot(const std::array<double, 5>& coefficients, const std::array<double, 5>& features) {
+	double time = 0.;
+	for (int i = 0; i < 5; ++i) {
+		time += coefficients[i] * features[i];
+	}
+	return time;
+}
+} /* anonymous namespace */
+
+void CellTimingLoadTest::testFallbackBeforeFit() {
+	CellTimingLoad load(0.5);
+	TradLoad tradLoad;
+	ASSERT_TRUE(not load.isFitted());
+	ASSERT_DOUBLES_EQUAL(tradLoad.getOwn(3, 2), load.getOwn(3, 2), 1e-12);
+	ASSERT_DOUBLES_EQUAL(tradLoad.getCellLoad({3, 2}), load.getCellLoad({3, 2}), 1e-12);
+	ASSERT_DOUBLES_EQUAL(25. + 26. * 12.5, load.getCellLoad({3, 2}), 1e-12);
+
+	// too few samples to fit
+	load.addSample(CellTimingLoad::OWN, CellTimingLoad::getFeatures(CellTimingLoad::SiteCounts()), 1.);
+	CellTimingLoad::Sums sums{};
+	load.collectSamples(sums);
+	ASSERT_TRUE(not load.fit(sums));
+	ASSERT_DOUBLES_EQUAL(tradLoad.getOwn(3, 2), load.getOwn(3, 2), 1e-12);
+}
+
+void CellTimingLoadTest::testFit() {
+	CellTimingLoad load(0.);
+	// single center LJ molecules and molecules with three LJ centers and two charges
+	load._componentSites = {{1., 0.}, {3., 2.}};
+
+	for (int n1 = 0; n1 < 8; ++n1) {
+		for (int n2 = 0; n2 < 5; ++n2) {
+			CellTimingLoad::SiteCounts cell;
+			cell.add(n1, 1., 0.);
+			cell.add(n2, 3., 2.);
+			CellTimingLoad::SiteCounts neighbour;
+			neighbour.add(n2, 1., 0.);
+			neighbour.add(n1 / 2, 3., 2.);
+			const auto ownFeatures = CellTimingLoad::getFeatures(cell);
+			const auto faceFeatures = CellTimingLoad::getFeatures(cell, neighbour);
+			load.addSample(CellTimingLoad::OWN, ownFeatures, dot(ownCoefficients, ownFeatures));
+			// three face neighbours per cell, as traversed with newton 3
+			for (int i = 0; i < 3; ++i) {
+				load.addSample(CellTimingLoad::FACE, faceFeatures, dot(faceCoefficients, faceFeatures));
+			}
+		}
+	}
+	CellTimingLoad::Sums sums{};
+	load.collectSamples(sums);
+	ASSERT_TRUE(load.fit(sums));
+	ASSERT_TRUE(load.isFitted());
+
+	for (int i = 0; i < 5; ++i) {
+		ASSERT_DOUBLES_EQUAL(ownCoefficients[i], load._coefficients[CellTimingLoad::OWN][i], 1e-3 * ownCoefficients[i] + 1e-12);
+		ASSERT_DOUBLES_EQUAL(faceCoefficients[i], load._coefficients[CellTimingLoad::FACE][i], 1e-3 * faceCoefficients[i] + 1e-12);
+	}
+	ASSERT_DOUBLES_EQUAL(1., load._callsPerCell[CellTimingLoad::OWN], 1e-12);
+	ASSERT_DOUBLES_EQUAL(3., load._callsPerCell[CellTimingLoad::FACE], 1e-12);
+	ASSERT_DOUBLES_EQUAL(0., load._callsPerCell[CellTimingLoad::EDGE], 1e-12);
+
+	// a cell with 4 + 2 molecules: 39 LJ pairs (without the 3 intramolecular pairs of each of the 2 molecules)
+	CellTimingLoad::SiteCounts cell;
+	cell.add(4., 1., 0.);
+	cell.add(2., 3., 2.);
+	const double own = 1e-8 * 15. + 2e-8 * 39. + 5e-8 * 4. + 1e-7 * 6. + 1e-6;
+	const double face = 1.5e-8 * 36. + 2e-8 * 100. + 4e-8 * 16. + 2e-6;
+	ASSERT_DOUBLES_EQUAL(own, load.getOwn(4, 2), 1e-3 * own);
+	ASSERT_DOUBLES_EQUAL(own + 3. * face, load.getCellLoad({4, 2}), 1e-3 * (own + 3. * face));
+	// the loads of the neighbours add up to the cell load
+	const double sum = load.getOwn(4, 2) + 6 * load.getFace(4, 2) + 12 * load.getEdge(4, 2) + 8 * load.getCorner(4, 2);
+	ASSERT_DOUBLES_EQUAL(load.getCellLoad({4, 2}), sum, 1e-12 * sum);
+}
+
+void CellTimingLoadTest::testMixture() {
+	CellTimingLoad load(0.5);
+	load._componentSites = {{1., 0.}, {4., 0.}, {1., 3.}};
+
+	// only the LJ centers take time
+	for (int n = 0; n < 10; ++n) {
+		for (int component = 0; component < 3; ++component) {
+			CellTimingLoad::SiteCounts cell;
+			cell.add(n, load._componentSites[component][0], load._componentSites[component][1]);
+			const auto features = CellTimingLoad::getFeatures(cell);
+			load.addSample(CellTimingLoad::OWN, features, 1e-8 * features[1]);
+		}
+	}
+	CellTimingLoad::Sums sums{};
+	load.collectSamples(sums);
+	ASSERT_TRUE(load.fit(sums));
+
+	// 10 molecules of component 1 have 16 times the LJ pairs of 10 molecules of the others
+	ASSERT_DOUBLES_EQUAL(1e-8 * 45., load.getCellLoad({10, 0, 0}), 1e-10);
+	ASSERT_DOUBLES_EQUAL(16e-8 * 45., load.getCellLoad({0, 10, 0}), 1e-10);
+	ASSERT_DOUBLES_EQUAL(1e-8 * 45., load.getCellLoad({0, 0, 10}), 1e-10);
+	// 1 + 4 LJ centers
+	ASSERT_DOUBLES_EQUAL(4e-8, load.getCellLoad({1, 1, 0}), 1e-10);
+
+	// the previous samples are kept with the history weight
+	ASSERT_DOUBLES_EQUAL(30., load._sums[CellTimingLoad::OWN][CellTimingLoad::NUM_SUMS - 1], 1e-12);
+	CellTimingLoad::Sums noSamples{};
+	ASSERT_TRUE(load.fit(noSamples));
+	ASSERT_DOUBLES_EQUAL(15., load._sums[CellTimingLoad::OWN][CellTimingLoad::NUM_SUMS - 1], 1e-12);
+	ASSERT_DOUBLES_EQUAL(16e-8 * 45., load.getCellLoad({0, 10, 0}), 1e-10);
+}
@@ -0,0 +1,31 @@
+/*
+ * CellTimingLoadTest.h
+ */
+
+#ifndef CELLTIMINGLOADTEST_H_
+#define CELLTIMINGLOADTEST_H_
+
+#include "utils/TestWithSimulationSetup.h"
+
+class CellTimingLoadTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(CellTimingLoadTest);
+	TEST_METHOD(testFallbackBeforeFit);
+	TEST_METHOD(testFit);
+	TEST_METHOD(testMixture);
+	TEST_SUITE_END();
+
+public:
+
+	CellTimingLoadTest();
+
+	virtual ~CellTimingLoadTest();
+
+	void testFallbackBeforeFit();
+
+	void testFit();
+
+	void testMixture();
+};
+
+#endif /* CELLTIMINGLOADTEST_H_ */
@@ -15,6 +15,7 @@
 #include "ensemble/EnsembleBase.h"
 #include "ensemble/CanonicalEnsemble.h"
 
+#include <algorithm>
 #include <iostream>
 using namespace std;
 
@@ -205,6 +206,73 @@ void CommunicationBufferTest::testLeavingAndHalo() {
 	}
 }
 
+void CommunicationBufferTest::testCompactHalo() {
+	Component dummyComponent(0);
+	dummyComponent.addLJcenter(0, 0, 0, 1, 1, 1, 0, false);
+	global_simulation->getEnsemble()->addComponent(dummyComponent);
+
+	Molecule m[4];
+	m[0] = Molecule(0, global_simulation->getEnsemble()->getComponent(0), 1.,
+			2., 3., -1., -2., -3.);
+	m[1] = Molecule(1, global_simulation->getEnsemble()->getComponent(0), -2.5,
+			12., 13., -11., -12., -13., 0.5, -0.5, 0.5, -0.5, 0., 0., 0.);
+	m[2] = Molecule(2, global_simulation->getEnsemble()->getComponent(0), 7.25,
+			-0.125, 19.75, -21., -22., -23., 0.1, 0.7, -0.1, 0.7, 0., 0., 0.);
+	m[3] = Molecule(3, global_simulation->getEnsemble()->getComponent(0), 0.3,
+			0.4, 0.5, -31., -32., -33., -0.8, 0.2, 0.4, 0.4, 0., 0., 0.);
+	const double low[3] = {-3., -1., 0.};
+	const double high[3] = {8., 13., 20.};
+
+	for (bool withIds : {true, false}) {
+		CommunicationBuffer buf;
+		buf.setCompactHalo(low, high, withIds);
+		buf.resizeForAppendingLeavingMolecules(1);
+		buf.addLeavingMolecule(0, m[0]);
+		buf.resizeForAppendingHaloMolecules(3);
+		for (int i = 1; i < 4; ++i) {
+			buf.addHaloMolecule(i - 1, m[i]);
+		}
+		ASSERT_EQUAL(withIds, buf.hasHaloIds());
+
+		// the receiver reads the encoding from the header
+		CommunicationBuffer recvBuf;
+		recvBuf.resizeForRawBytes(buf.getNumElementsForSending());
+		std::copy(buf.getDataForSending(), buf.getDataForSending() + buf.getNumElementsForSending(),
+				recvBuf.getDataForSending());
+		unsigned long numLeaving, numHalo;
+		recvBuf.resizeForReceivingMolecules(numLeaving, numHalo);
+		ASSERT_EQUAL(1ul, numLeaving);
+		ASSERT_EQUAL(3ul, numHalo);
+		ASSERT_EQUAL(true, recvBuf.isCompactHalo());
+
+		Molecule mread[4];
+		recvBuf.readLeavingMolecule(0, mread[0]);
+		for (int i = 1; i < 4; ++i) {
+			recvBuf.readHaloMolecule(i - 1, mread[i]);
+		}
+
+		ASSERT_EQUAL(m[0].getID(), mread[0].getID());
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_DOUBLES_EQUAL(m[0].r(d), mread[0].r(d), 1e-16);
+			ASSERT_DOUBLES_EQUAL(m[0].v(d), mread[0].v(d), 1e-16);
+		}
+		for (int i = 1; i < 4; ++i) {
+			ASSERT_EQUAL(withIds ? m[i].getID() : UINT64_MAX, mread[i].getID());
+			for (int d = 0; d < 3; ++d) {
+				ASSERT_DOUBLES_EQUAL(m[i].r(d), mread[i].r(d), 1e-8);
+				ASSERT_DOUBLES_EQUAL(0.0, mread[i].v(d), 1e-16);
+			}
+			// q and -q describe the same orientation
+			const double sign = m[i].q().qw() * mread[i].q().qw() + m[i].q().qx() * mread[i].q().qx()
+					+ m[i].q().qy() * mread[i].q().qy() + m[i].q().qz() * mread[i].q().qz() < 0. ? -1. : 1.;
+			ASSERT_DOUBLES_EQUAL(m[i].q().qw(), sign * mread[i].q().qw(), 1e-5);
+			ASSERT_DOUBLES_EQUAL(m[i].q().qx(), sign * mread[i].q().qx(), 1e-5);
+			ASSERT_DOUBLES_EQUAL(m[i].q().qy(), sign * mread[i].q().qy(), 1e-5);
+			ASSERT_DOUBLES_EQUAL(m[i].q().qz(), sign * mread[i].q().qz(), 1e-5);
+		}
+	}
+}
+
 void CommunicationBufferTest::testPackSendRecvUnpack() {
 	if (_domainDecomposition->getNumProcs() < 2) {
 		test_log->info() << "CommunicationBufferTest::testPackSendRecvUnpack"
@@ -16,6 +16,7 @@ class CommunicationBufferTest : public utils::TestWithSimulationSetup {
 	TEST_METHOD(testHalo);
 	TEST_METHOD(testLeaving);
 	TEST_METHOD(testLeavingAndHalo);
+	TEST_METHOD(testCompactHalo);
 	TEST_METHOD(testPackSendRecvUnpack);
 	TEST_SUITE_END();
 
@@ -32,6 +33,8 @@ public:
 
 	void testLeavingAndHalo();
 
+	void testCompactHalo();
+
 	void testPackSendRecvUnpack();
 };
 
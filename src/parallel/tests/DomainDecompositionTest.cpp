@@ -8,11 +8,17 @@
 #include "DomainDecompositionTest.h"
 #include "parallel/DomainDecompBase.h"
 #include "parallel/DomainDecomposition.h"
+#include "parallel/NeighbourCommunicationScheme.h"
+#include "particleContainer/LinkedCells.h"
 #include "particleContainer/ParticleContainer.h"
+#include "particleContainer/TraversalTuner.h"
 #include "molecules/Component.h"
 #include "molecules/Molecule.h"
 #include "Domain.h"
 
+#include <array>
+#include <map>
+
 TEST_SUITE_REGISTRATION(DomainDecompositionTest);
 
 DomainDecompositionTest::DomainDecompositionTest() = default;
@@ -53,8 +59,14 @@ void DomainDecompositionTest::testNoDuplicatedParticles() {
 	testNoDuplicatedParticlesFilename("H20_NaBr_0.01_T_293.15_DD.inp", 5.0);
 }
 
-void DomainDecompositionTest::testNoLostParticlesFilename(const char * filename, double cutoff) {
-	_domainDecomposition = new DomainDecomposition();
+void DomainDecompositionTest::testNoLostParticlesFilename(const char * filename, double cutoff,
+		const std::string& scheme, bool persistentCommunication) {
+	auto domainDecomposition = new DomainDecomposition();
+	if (not scheme.empty()) {
+		domainDecomposition->setCommunicationScheme(scheme, "fs");
+	}
+	domainDecomposition->_neighbourCommunicationScheme->setPersistentCommunication(persistentCommunication);
+	_domainDecomposition = domainDecomposition;
 
 	std::unique_ptr<ParticleContainer> container{
 		initializeFromFile(ParticleContainerFactory::LinkedCell, filename, cutoff)};
@@ -125,6 +137,27 @@ void DomainDecompositionTest::testNoLostParticlesFilename(const char * filename,
 		}
 	}
 
+	if (persistentCommunication) {
+		// The channels are created by the first exchange. Moving all molecules by a growing distance increases the
+		// number of leaving molecules, so that they no longer fit into the channels and are sent in overflow messages.
+		for (int exchange = 1; exchange <= 3; ++exchange) {
+			for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+				m->setr(0, m->r(0) + 0.2 * exchange * cutoff);
+			}
+			container->update();
+			_domainDecomposition->balanceAndExchange(0., false, container.get(), _domain);
+			container->deleteOuterParticles();
+
+			newNumMols = container->getNumberOfParticles();
+			_domainDecomposition->collCommInit(1);
+			_domainDecomposition->collCommAppendUnsLong(newNumMols);
+			_domainDecomposition->collCommAllreduceSum();
+			newNumMols = _domainDecomposition->collCommGetUnsLong();
+			_domainDecomposition->collCommFinalize();
+			ASSERT_EQUAL(numMols, newNumMols);
+		}
+	}
+
 	delete _domainDecomposition;
 }
 
@@ -132,6 +165,70 @@ void DomainDecompositionTest::testNoLostParticles() {
 	testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0);
 }
 
+void DomainDecompositionTest::testNoLostParticlesNeighbourhoodCollective() {
+#if MPI_VERSION >= 3
+	testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0, "neighbourhood-collective");
+	testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0, "neighbourhood-collective-pp");
+#endif
+}
+
+void DomainDecompositionTest::testNoLostParticlesPersistentCommunication() {
+	testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0, "", true);
+	testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0, "indirect", true);
+}
+
+void DomainDecompositionTest::testExchangeForcesCompactHalo() {
+	const double cutoff = 3.0;
+	std::map<unsigned long, std::array<double, 3>> referenceForces;
+	for (const std::string encoding : {"full", "compactWithoutIds"}) {
+		auto domainDecomposition = new DomainDecomposition();
+		domainDecomposition->setCommunicationScheme("direct", "hs");
+		domainDecomposition->_neighbourCommunicationScheme->setCompactHaloCopies(encoding != "full", false);
+		_domainDecomposition = domainDecomposition;
+
+		std::unique_ptr<LinkedCells> container{dynamic_cast<LinkedCells*>(
+			initializeFromFile(ParticleContainerFactory::LinkedCell, "H20_NaBr_0.01_T_293.15_DD_2.inp", cutoff))};
+		container->_traversalTuner->selectedTraversal = TraversalTuner<ParticleCell>::HS;
+		container->initializeTraversal();
+		ASSERT_TRUE(container->requiresForceExchange());
+		domainDecomposition->initCommunicationPartners(cutoff, _domain, container.get());
+
+		container->update();
+		_domainDecomposition->balanceAndExchange(0., false, container.get(), _domain);
+
+		// the force of every halo copy is derived from its id and has to be added to the original molecule
+		double bBoxMin[3];
+		double bBoxMax[3];
+		for (int d = 0; d < 3; ++d) {
+			bBoxMin[d] = container->getBoundingBoxMin(d);
+			bBoxMax[d] = container->getBoundingBoxMax(d);
+		}
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			// the received halo copies have no SoA yet, so the forces are set instead of cleared
+			double zero[3] = {0.0, 0.0, 0.0};
+			double force[3] = {1.0 * m->getID(), 1.0, 0.0};
+			m->setF(m->inBox(bBoxMin, bBoxMax) ? zero : force);
+			m->setM(zero);
+			m->setVi(zero);
+		}
+		_domainDecomposition->exchangeForces(container.get(), _domain);
+		container->deleteOuterParticles();
+
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			if (encoding == "full") {
+				referenceForces[m->getID()] = {m->F(0), m->F(1), m->F(2)};
+			} else {
+				ASSERT_EQUAL(1ul, referenceForces.count(m->getID()));
+				for (int d = 0; d < 3; ++d) {
+					ASSERT_DOUBLES_EQUAL(referenceForces[m->getID()][d], m->F(d), 1e-12);
+				}
+			}
+		}
+
+		delete _domainDecomposition;
+	}
+}
+
 void DomainDecompositionTest::testExchangeMolecules1Proc() {
 	if (_domainDecomposition->getNumProcs() != 1) {
 		test_log->info() << "DomainDecompositionTest::testExchangeMolecules1Proc()"
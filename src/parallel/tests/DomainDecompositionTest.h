@@ -10,11 +10,16 @@
 
 #include "utils/TestWithSimulationSetup.h"
 
+#include <string>
+
 class DomainDecompositionTest: public utils::TestWithSimulationSetup {
 
 	TEST_SUITE(DomainDecompositionTest);
 	TEST_METHOD(testNoDuplicatedParticles);
 	TEST_METHOD(testNoLostParticles);
+	TEST_METHOD(testNoLostParticlesNeighbourhoodCollective);
+	TEST_METHOD(testNoLostParticlesPersistentCommunication);
+	TEST_METHOD(testExchangeForcesCompactHalo);
 	TEST_METHOD(testExchangeMolecules1Proc);
 	TEST_SUITE_END();
 
@@ -26,13 +31,27 @@ public:
 
 	void testNoDuplicatedParticles();
 	void testNoLostParticles();
+	/**
+	 * Test the particle exchange with the neighbourhood collectives, with and without push-pull partners.
+	 */
+	void testNoLostParticlesNeighbourhoodCollective();
+	/**
+	 * Test that the forces of a zonal method are sent back to the original molecules with the compact halo
+	 * encoding, even if the ids of the halo copies are not requested.
+	 */
+	void testExchangeForcesCompactHalo();
+	/**
+	 * Test the particle exchange with persistent communication channels over several exchanges, with growing channels.
+	 */
+	void testNoLostParticlesPersistentCommunication();
 	/**
 	 * Test the particle exchange if running with 1 process.
 	 */
 	void testExchangeMolecules1Proc();
 private:
 	void testNoDuplicatedParticlesFilename(const char * filename, double cutoff);
-	void testNoLostParticlesFilename(const char * filename, double cutoff);
+	void testNoLostParticlesFilename(const char * filename, double cutoff, const std::string& scheme = "",
+			bool persistentCommunication = false);
 };
 
 #endif /* DOMAINDECOMPOSITIONTEST_H_ */
@@ -148,7 +148,7 @@ void KDDecompositionTest::testNoDuplicatedParticles2() {
 }
 
 void KDDecompositionTest::testNoLostParticlesFilename(const char * filename,
-		double cutoff, double domainLength) {
+		double cutoff, double domainLength, bool incrementalRebalancing) {
 	// original pointer will be deleted by tearDown()
 	KDDecomposition * kdd;
 	// original pointer will be deleted by tearDown()
@@ -157,6 +157,7 @@ void KDDecompositionTest::testNoLostParticlesFilename(const char * filename,
 	_domain->setGlobalLength(2, domainLength);
 	kdd = new KDDecomposition(cutoff, 3, 1, 4);
 	kdd->init(_domain);
+	kdd->_incrementalRebalancing = incrementalRebalancing;
 	_domainDecomposition = kdd;
 	_rank = kdd->_rank;
 
@@ -290,6 +291,91 @@ void KDDecompositionTest::testNoLostParticles2() {
 	testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0, 58.5);
 }
 
+void KDDecompositionTest::testNoLostParticlesIncremental() {
+	testNoLostParticlesFilename("H20_NaBr_0.01_T_293.15_DD_2.inp", 3.0, 58.5, true);
+}
+
+void KDDecompositionTest::testMigrationWithUnchangedLeaves() {
+	if (_domainDecomposition->getNumProcs() < 3) {
+		Log::global_log->warning() << "KDDecompositionTest::testMigrationWithUnchangedLeaves():"
+				"only executed with 3 or more procs!" << std::endl;
+		return;
+	}
+
+	const double cutoff = 3.0;
+	const double domainLength = 58.5;
+	for (int d = 0; d < 3; ++d) {
+		_domain->setGlobalLength(d, domainLength);
+	}
+	KDDecomposition* kdd = new KDDecomposition(cutoff, 3, 1, 4);
+	kdd->init(_domain);
+	_domainDecomposition = kdd;
+	_rank = kdd->_rank;
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell,
+			"H20_NaBr_0.01_T_293.15_DD_2.inp", cutoff);
+	kdd->updateSendLeavingWithCopies(true);
+	// the receivers allocate their buffers from the global particle counts
+	kdd->calcNumParticlesPerCell(container);
+
+	unsigned long numMols = container->getNumberOfParticles();
+	kdd->collCommInit(1);
+	kdd->collCommAppendUnsLong(numMols);
+	kdd->collCommAllreduceSum();
+	numMols = kdd->collCommGetUnsLong();
+	kdd->collCommFinalize();
+
+	// shift the split plane of an inner node with two leaves only
+	KDNode* newRoot = kdd->_decompTree->copyTree();
+	KDNode* node = newRoot;
+	while (node->_numProcs > 2) {
+		node = node->_child2->_numProcs > 1 ? node->_child2 : node->_child1;
+	}
+	const int dim = node->getSplitDimension();
+	const int oldSplitIndex = node->_child1->_highCorner[dim];
+	const int minSplitIndex = node->_lowCorner[dim] + node->_child1->getMinNumCells(dim) - 1;
+	node->moveSplitPlane(oldSplitIndex > minSplitIndex ? oldSplitIndex - 1 : oldSplitIndex + 1);
+	KDNode* newOwnLeaf = newRoot->findAreaForProcess(_rank);
+
+	const bool ownLeafChanged = node->_child1->_owningProc == _rank or node->_child2->_owningProc == _rank;
+	kdd->collCommInit(1);
+	kdd->collCommAppendInt(ownLeafChanged ? 1 : 0);
+	kdd->collCommAllreduceSum();
+	ASSERT_EQUAL(2, kdd->collCommGetInt());
+	kdd->collCommFinalize();
+
+	ASSERT_TRUE(kdd->migrateParticles(*newRoot, *newOwnLeaf, container, _domain));
+	delete kdd->_decompTree;
+	kdd->_decompTree = newRoot;
+	kdd->_ownArea = newOwnLeaf;
+
+	unsigned long newNumMols = container->getNumberOfParticles();
+	kdd->collCommInit(1);
+	kdd->collCommAppendUnsLong(newNumMols);
+	kdd->collCommAllreduceSum();
+	newNumMols = kdd->collCommGetUnsLong();
+	kdd->collCommFinalize();
+	ASSERT_EQUAL(numMols, newNumMols);
+
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		for (int d = 0; d < 3; ++d) {
+			ASSERT_TRUE(m->r(d) >= kdd->getBoundingBoxMin(d, _domain));
+			ASSERT_TRUE(m->r(d) < kdd->getBoundingBoxMax(d, _domain));
+		}
+	}
+
+	// all processes have to agree on sending the leaving molecules and the halo copies together
+	kdd->collCommInit(1);
+	kdd->collCommAppendInt(kdd->sendLeavingWithCopies() ? 1 : 0);
+	kdd->collCommAllreduceSum();
+	const int numSendTogether = kdd->collCommGetInt();
+	kdd->collCommFinalize();
+	ASSERT_TRUE(numSendTogether == 0 or numSendTogether == kdd->getNumProcs());
+
+	delete _domainDecomposition;
+	delete container;
+}
+
 void KDDecompositionTest::testCompleteTreeInfo() {
 
 	if (_domainDecomposition->getNumProcs() < 9) {
@@ -21,6 +21,8 @@ class KDDecompositionTest : public utils::TestWithSimulationSetup {
 	TEST_METHOD(testNoDuplicatedParticles2);
 	TEST_METHOD(testNoLostParticles);
 	TEST_METHOD(testNoLostParticles2);
+	TEST_METHOD(testNoLostParticlesIncremental);
+	TEST_METHOD(testMigrationWithUnchangedLeaves);
 	TEST_METHOD(testCompleteTreeInfo);
 	TEST_METHOD(testRebalancingDeadlocks);
 	TEST_METHOD(testbalanceAndExchange);
@@ -40,6 +42,18 @@ public:
 	void testNoLostParticles();
 	void testNoLostParticles2();
 
+	/**
+	 * Like testNoLostParticles2(), but the split planes of the initial tree are shifted, see incrementalRebalancing.
+	 */
+	void testNoLostParticlesIncremental();
+
+	/**
+	 * Migrates the molecules to a tree, in which only the leaves of the last two processes change. The other processes
+	 * keep their molecules and container, but have to take part in the collectives of the migration nonetheless.
+	 * Only executed with at least 3 procs.
+	 */
+	void testMigrationWithUnchangedLeaves();
+
 	void testCompleteTreeInfo();
 
 	/**
@@ -56,7 +70,8 @@ private:
 
 	void testNoDuplicatedParticlesFilename(const char * filename, double cutoff, double domainLength);
 
-	void testNoLostParticlesFilename(const char * filename, double cutoff, double domainLength);
+	void testNoLostParticlesFilename(const char * filename, double cutoff, double domainLength,
+			bool incrementalRebalancing = false);
 
 	/**
 	 * init some random distribution
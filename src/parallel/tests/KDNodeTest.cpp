@@ -7,6 +7,7 @@
 
 #include "KDNodeTest.h"
 #include "parallel/KDNode.h"
+#include "parallel/KDDStaticValues.h"
 #include <string>
 
 TEST_SUITE_REGISTRATION(KDNodeTest);
@@ -91,6 +92,45 @@ void KDNodeTest::testBuildKDTree() {
 	ASSERT_TRUE(root.equals(resultRoot));
 }
 
+void KDNodeTest::testMoveSplitPlane() {
+	int lowerEnd[] = {0, 0, 0};
+	int upperEnd[] = {7, 7, 3};
+	bool coversAll[] = {true, true, true};
+
+	// split along x at 3, both children along y at 3
+	KDNode root(4, lowerEnd, upperEnd, 0, 0, coversAll, 0);
+	root.buildKDTree();
+	KDNode* copy = root.copyTree();
+	ASSERT_TRUE(root.equals(*copy));
+
+	const int minNumCells = KDDStaticValues::minNumCellsPerDimension;
+	ASSERT_EQUAL(root.getSplitDimension(), 0);
+	ASSERT_EQUAL(root._child1->getSplitDimension(), 1);
+	ASSERT_EQUAL(root._child1->_child1->getSplitDimension(), -1);
+	ASSERT_EQUAL(root.getMinNumCells(0), 2 * minNumCells);
+	ASSERT_EQUAL(root.getMinNumCells(1), 2 * minNumCells);
+	ASSERT_EQUAL(root.getMinNumCells(2), minNumCells);
+
+	copy->moveSplitPlane(4);
+	ASSERT_EQUAL(copy->_child1->_highCorner[0], 4);
+	ASSERT_EQUAL(copy->_child2->_lowCorner[0], 5);
+	ASSERT_EQUAL(copy->_child2->_highCorner[0], 7);
+	// the split dimension of the children is still found, although their own children were not adapted yet
+	ASSERT_EQUAL(copy->_child1->getSplitDimension(), 1);
+	ASSERT_EQUAL(copy->_child2->getSplitDimension(), 1);
+
+	copy->_child1->moveSplitPlane(2);
+	ASSERT_EQUAL(copy->_child1->_child1->_highCorner[0], 4);
+	ASSERT_EQUAL(copy->_child1->_child1->_highCorner[1], 2);
+	ASSERT_EQUAL(copy->_child1->_child2->_lowCorner[1], 3);
+	ASSERT_TRUE(not root.equals(*copy));
+
+	copy->moveSplitPlane(3);
+	copy->_child1->moveSplitPlane(3);
+	ASSERT_TRUE(root.equals(*copy));
+	delete copy;
+}
+
 void KDNodeTest::testFindAreaForProcess() {
 	int lowerEnd[] = {0, 0, 0};
 	int upperEnd[] = {7, 3, 3};
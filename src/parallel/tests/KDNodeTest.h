@@ -16,6 +16,7 @@ class KDNodeTest : public utils::TestWithSimulationSetup {
 	TEST_METHOD(testEqual);
 	TEST_METHOD(testSplit);
 	TEST_METHOD(testBuildKDTree);
+	TEST_METHOD(testMoveSplitPlane);
 	TEST_METHOD(testFindAreaForProcess);
 	TEST_METHOD(testGetMPIKDNode);
 	TEST_METHOD(testserializeDeserialize);
@@ -33,6 +34,8 @@ public:
 
 	void testBuildKDTree();
 
+	void testMoveSplitPlane();
+
 	void testFindAreaForProcess();
 
 	void testGetMPIKDNode();
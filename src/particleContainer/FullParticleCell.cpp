@@ -94,14 +94,17 @@ void FullParticleCell::preUpdateLeavingMolecules() {
 	const size_t size_total = _molecules.size(); // for debugging, see below
 	#endif
 
+	// molecules staying in an inner cell keep their SoA, so that buildSoACaches() can reuse its layout
+	const bool isHalo = isHaloCell();
 	for (auto it = iterator(); it.isValid(); ++it) {
-		it->setSoA(nullptr);
-
 		const bool isStaying = testInBox(*it);
 
 		if (isStaying) {
-			// don't do anything, just advance iterator
+			if (isHalo) {
+				it->setSoA(nullptr);
+			}
 		} else {
+			it->setSoA(nullptr);
 			_leavingMolecules.push_back(*it);
 			it.deleteCurrentParticle();
 		}
@@ -141,7 +144,44 @@ void FullParticleCell::getRegion(double lowCorner[3], double highCorner[3], std:
 }
 
 void FullParticleCell::buildSoACaches() {
+	if (isSoALayoutValid()) {
+		updateSoACaches();
+	} else {
+		rebuildSoACaches();
+	}
+	_cellDataSoA.computeMoleculeBoundingBox();
+}
+
+bool FullParticleCell::isSoALayoutValid() const {
+	const size_t numMolecules = _molecules.size();
+	if (_cellDataSoA.getMolNum() != numMolecules) {
+		return false;
+	}
 
+	size_t iLJCenters = 0;
+	size_t iCharges = 0;
+	size_t iDipoles = 0;
+	size_t iQuadrupoles = 0;
+
+	// molecules may have been exchanged, reordered or may have changed their component
+	for (size_t i = 0; i < numMolecules; ++i) {
+		const Molecule& M = _molecules[i];
+		if (static_cast<unsigned>(_cellDataSoA._mol_ljc_num[i]) != M.numLJcenters()
+				or static_cast<unsigned>(_cellDataSoA._mol_charges_num[i]) != M.numCharges()
+				or static_cast<unsigned>(_cellDataSoA._mol_dipoles_num[i]) != M.numDipoles()
+				or static_cast<unsigned>(_cellDataSoA._mol_quadrupoles_num[i]) != M.numQuadrupoles()
+				or not M.isSoACacheValid(&_cellDataSoA, iLJCenters, iCharges, iDipoles, iQuadrupoles)) {
+			return false;
+		}
+		iLJCenters += _cellDataSoA._mol_ljc_num[i];
+		iCharges += _cellDataSoA._mol_charges_num[i];
+		iDipoles += _cellDataSoA._mol_dipoles_num[i];
+		iQuadrupoles += _cellDataSoA._mol_quadrupoles_num[i];
+	}
+	return true;
+}
+
+void FullParticleCell::rebuildSoACaches() {
 	// Determine the total number of centers.
 	size_t numMolecules = _molecules.size();
 	size_t nLJCenters = 0;
@@ -192,6 +232,28 @@ void FullParticleCell::buildSoACaches() {
 	}
 }
 
+void FullParticleCell::updateSoACaches() {
+	_cellDataSoA.clearAccumulators();
+
+	double zero[3] = {0., 0., 0.};
+
+	for (size_t i = 0; i < _molecules.size(); ++i) {
+		Molecule & M = _molecules[i];
+
+		_cellDataSoA._mol_pos.x(i) = M.r(0);
+		_cellDataSoA._mol_pos.y(i) = M.r(1);
+		_cellDataSoA._mol_pos.z(i) = M.r(2);
+
+		// the molecule still refers to its centers in the SoA, only the positions have changed
+		M.updateSoACache();
+
+		// the centers have already been cleared above
+		M.setF(zero);
+		M.setM(zero);
+		M.setVi(zero);
+	}
+}
+
 void FullParticleCell::increaseMoleculeStorage(size_t numExtraMols) {
 	_molecules.reserve(_molecules.size() + numExtraMols);
 }
@@ -47,6 +47,8 @@
  */
 
 class FullParticleCell: public ParticleCellBase {
+	friend class LinkedCellsTest;
+
 	/*private:
 	 FullParticleCell(const ParticleCell& that);*/
 public:
@@ -95,6 +97,12 @@ public:
 	void getRegion(double lowCorner[3], double highCorner[3],
 			std::vector<Molecule*> &particlePtrs, bool removeFromContainer = false) override;
 
+	/**
+	 * \brief Fill the structure of arrays with the current positions and clear the forces.
+	 * \details The SoA is kept between the steps. Its layout (number and order of the centers of every molecule)
+	 * is only set up again, if the molecules of the cell have changed since the last call. Otherwise only the
+	 * positions and orientations are updated and the forces, virials and torques are cleared for the whole cell.
+	 */
 	void buildSoACaches() override;
 
 	void increaseMoleculeStorage(size_t numExtraMols) override;
@@ -118,6 +126,15 @@ private:
 
 	void updateLeavingMolecules(FullParticleCell& otherCell);
 
+	//! checks, whether the cell still holds the molecules the SoA was set up for, in the same order
+	bool isSoALayoutValid() const;
+
+	//! set up the layout of the SoA and fill it
+	void rebuildSoACaches();
+
+	//! write the current positions to the SoA, whose layout is still valid
+	void updateSoACaches();
+
 	/**
 	 * \brief A vector of pointers to the Molecules in this cell.
 	 */
@@ -17,6 +17,12 @@
 #include "quicksched.h"
 #endif
 
+#ifdef PRINT_SCHEDULING_TIMINGS
+#include "particleContainer/adapter/InstrumentedCellProcessor.h"
+#include "particleContainer/adapter/VectorizedCellProcessor.h"
+#include "particleContainer/adapter/VectorizedCellProcessorDispatch.h"
+#endif
+
 using Log::global_log;
 
 struct QuickschedTraversalData : CellPairTraversalData {
@@ -235,7 +241,20 @@ void QuickschedTraversal<CellTemplate>::runner(int type, void *data) {
 #ifdef PRINT_SCHEDULING_TIMINGS
     if(_simulation.getSimStep() > 10){
         timing.end = _rdtsc();
-        (dynamic_cast<VectorizedCellProcessor*>(_contextCellProcessor))->getThreadData()[omp_get_thread_num()]->_timings.push_back(timing);
+        CellProcessor *timedCellProcessor = context->_contextCellProcessor;
+        // the timings are stored in the VectorizedCellProcessor, so look through the instrumentation wrapper
+        if (auto instrumented = dynamic_cast<InstrumentedCellProcessor *>(timedCellProcessor)) {
+            timedCellProcessor = instrumented->getInstrumentedCellProcessor();
+        }
+        // only the VectorizedCellProcessor of the baseline instruction set is visible here
+        auto vectorizedCellProcessor = dynamic_cast<VectorizedCellProcessor *>(timedCellProcessor);
+        if (vectorizedCellProcessor == nullptr) {
+            global_log->error() << "PRINT_SCHEDULING_TIMINGS requires the VectorizedCellProcessor of the baseline "
+                                << "instruction set (" << vcp::getCompiledInstructionSets().front()
+                                << "), select it with --vcp-isa." << std::endl;
+            Simulation::exit(1);
+        }
+        vectorizedCellProcessor->getThreadData()[omp_get_thread_num()]->_timings.push_back(timing);
     }
 #endif
 #endif /* QUICKSCHED */
@@ -16,6 +16,7 @@
 #include "utils/Random.h"
 #include "utils/mardyn_assert.h"
 #include "utils/GetChunkSize.h"
+#include "utils/String_utils.h"
 
 #include "particleContainer/TraversalTuner.h"
 
@@ -129,6 +130,32 @@ void LinkedCells::readXML(XMLfileUnits& xmlconfig) {
 	_cellsInCutoff = xmlconfig.getNodeValue_int("cellsInCutoffRadius", 1); // new
 	mardyn_assert(_cellsInCutoff>=1); // new
 
+	if (xmlconfig.changecurrentnode("cellsInCutoffTuning")) {
+		_cellSizeTuningEnabled = xmlconfig.getNodeValue_bool("enabled", true);
+		_cellSizeStepsPerCandidate = xmlconfig.getNodeValue_int("stepsPerCandidate", _cellSizeStepsPerCandidate);
+		_cellSizeRetuneInterval = xmlconfig.getNodeValue_int("retuneInterval", _cellSizeRetuneInterval);
+		std::string candidates;
+		if (xmlconfig.getNodeValue("candidates", candidates)) {
+			_cellSizeCandidates.clear();
+			for (const auto& candidate : string_utils::split(candidates, ',')) {
+				const int cellsInCutoff = std::atoi(candidate.c_str());
+				if (cellsInCutoff >= 1) {
+					_cellSizeCandidates.push_back(cellsInCutoff);
+				} else {
+					global_log->warning() << "LinkedCells: ignoring invalid cellsInCutoff candidate " << candidate << endl;
+				}
+			}
+		}
+		if (_cellSizeStepsPerCandidate < 1) {
+			global_log->error() << "LinkedCells: stepsPerCandidate has to be at least 1." << endl;
+			Simulation::exit(1);
+		}
+		global_log->info() << "LinkedCells: cellsInCutoff tuning " << (_cellSizeTuningEnabled ? "enabled" : "disabled")
+				<< ", " << _cellSizeStepsPerCandidate << " steps per candidate, retune interval "
+				<< _cellSizeRetuneInterval << endl;
+		xmlconfig.changecurrentnode("..");
+	}
+
 	_traversalTuner = std::unique_ptr<TraversalTuner<ParticleCell>>(new TraversalTuner<ParticleCell>()); // new way to assign _traversalTuner
 	_traversalTuner->readXML(xmlconfig);
 }
@@ -203,6 +230,126 @@ bool LinkedCells::rebuild(double bBoxMin[3], double bBoxMax[3]) {
 
 }
 
+bool LinkedCells::setCellsInCutoff(unsigned cellsInCutoff) {
+	if (cellsInCutoff == _cellsInCutoff) {
+		return false;
+	}
+
+	// the halo is not kept, it has to be exchanged again for the new halo width.
+	std::vector<Molecule> molecules;
+	molecules.reserve(getNumberOfParticles());
+	for (auto it = iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); it.isValid(); ++it) {
+		molecules.push_back(*it);
+	}
+	clear();
+
+	_cellsInCutoff = cellsInCutoff;
+	_traversalTuner->setCellsInCutoff(cellsInCutoff);
+	double bBoxMin[3];
+	double bBoxMax[3];
+	for (int d = 0; d < 3; ++d) {
+		bBoxMin[d] = _boundingBoxMin[d];
+		bBoxMax[d] = _boundingBoxMax[d];
+	}
+	rebuild(bBoxMin, bBoxMax);
+
+	addParticles(molecules);
+	_cellsValid = true;
+	return true;
+}
+
+void LinkedCells::startCellSizeTuning() {
+	_activeCellSizeCandidates.clear();
+	_cellSizeTuned = true;
+	_stepsSinceCellSizeTuning = 0;
+
+	// every rank has to sample the same candidates, so a candidate has to fit into all subdomains. Like in rebuild,
+	// at least two halo widths of cells are needed per dimension to send leaving and halo particles together.
+	DomainDecompBase& domainDecomp = global_simulation->domainDecomposition();
+	const unsigned maxCellsInCutoff = _traversalTuner->getMaxCellsInCutoff();
+	domainDecomp.collCommInit(_cellSizeCandidates.size());
+	for (unsigned candidate : _cellSizeCandidates) {
+		int applicable = candidate <= maxCellsInCutoff;
+		for (int d = 0; d < 3; ++d) {
+			const int boxWidthInNumCells = floor((_boundingBoxMax[d] - _boundingBoxMin[d]) / (_cutoffRadius / candidate));
+			applicable = applicable and boxWidthInNumCells >= static_cast<int>(2 * candidate);
+		}
+		domainDecomp.collCommAppendInt(applicable);
+	}
+	domainDecomp.collCommAllreduceCustom(ReduceType::MIN);
+	for (unsigned candidate : _cellSizeCandidates) {
+		if (domainDecomp.collCommGetInt() and std::find(_activeCellSizeCandidates.begin(),
+				_activeCellSizeCandidates.end(), candidate) == _activeCellSizeCandidates.end()) {
+			_activeCellSizeCandidates.push_back(candidate);
+		}
+	}
+	domainDecomp.collCommFinalize();
+
+	if (_activeCellSizeCandidates.size() < 2) {
+		global_log->info() << "LinkedCells: less than two applicable cellsInCutoff candidates, tuning skipped." << endl;
+		return;
+	}
+
+	global_log->info() << "LinkedCells: sampling " << _activeCellSizeCandidates.size() << " cellsInCutoff values for "
+			<< _cellSizeStepsPerCandidate << " steps each." << endl;
+	_cellSizeCandidateTimes.assign(_activeCellSizeCandidates.size(), 0.);
+	_currentCellSizeCandidate = 0;
+	_cellSizeSamples = 0;
+	_cellSizeSampleTime = 0.;
+	_cellSizeTuningActive = true;
+	// the samples must only contain force calculations with the same traversal, so keep it for all candidates.
+	_traversalTuner->setTuningFrozen(true);
+}
+
+bool LinkedCells::adaptCellSize() {
+	if (not _cellSizeTuningEnabled) {
+		return false;
+	}
+
+	if (not _cellSizeTuningActive) {
+		if (_cellSizeTuned and (_cellSizeRetuneInterval == 0 or ++_stepsSinceCellSizeTuning < _cellSizeRetuneInterval)) {
+			return false;
+		}
+		startCellSizeTuning();
+		return _cellSizeTuningActive and setCellsInCutoff(_activeCellSizeCandidates.front());
+	}
+
+	// one force calculation with the current candidate happened since the last call.
+	if (++_cellSizeSamples < _cellSizeStepsPerCandidate) {
+		return false;
+	}
+
+	// the slowest rank determines the time of a step.
+	DomainDecompBase& domainDecomp = global_simulation->domainDecomposition();
+	domainDecomp.collCommInit(1);
+	domainDecomp.collCommAppendDouble(_cellSizeSampleTime);
+	domainDecomp.collCommAllreduceCustom(ReduceType::MAX);
+	_cellSizeCandidateTimes[_currentCellSizeCandidate] = domainDecomp.collCommGetDouble();
+	domainDecomp.collCommFinalize();
+	_cellSizeSamples = 0;
+	_cellSizeSampleTime = 0.;
+
+	if (++_currentCellSizeCandidate < _activeCellSizeCandidates.size()) {
+		return setCellsInCutoff(_activeCellSizeCandidates[_currentCellSizeCandidate]);
+	}
+
+	// all candidates sampled, lock in the fastest one
+	size_t best = 0;
+	for (size_t i = 0; i < _activeCellSizeCandidates.size(); ++i) {
+		global_log->info() << "LinkedCells: " << _activeCellSizeCandidates[i] << " cells in cutoff took "
+				<< _cellSizeCandidateTimes[i] / _cellSizeStepsPerCandidate << " s per force calculation." << endl;
+		if (_cellSizeCandidateTimes[i] < _cellSizeCandidateTimes[best]) {
+			best = i;
+		}
+	}
+	global_log->info() << "LinkedCells: using " << _activeCellSizeCandidates[best] << " cells in cutoff." << endl;
+	_cellSizeTuningActive = false;
+	_stepsSinceCellSizeTuning = 0;
+	// tunes the traversal for the chosen cell size.
+	_traversalTuner->setTuningFrozen(false);
+	return setCellsInCutoff(_activeCellSizeCandidates[best]);
+}
+
 void LinkedCells::check_molecules_in_box() {
 	std::vector<Molecule> badMolecules;
 	unsigned numBadMolecules = 0;
@@ -570,7 +717,17 @@ void LinkedCells::traverseCells(CellProcessor& cellProcessor) {
 	}
 
 	cellProcessor.initTraversal();
-	_traversalTuner->traverseCellPairs(cellProcessor);
+	if (_cellSizeTuningActive and global_simulation != nullptr and &cellProcessor == global_simulation->getCellProcessor()) {
+		// sample the force calculation for the cellsInCutoff tuning
+		TimerProfiler* timers = global_simulation->timers();
+		const double timeBefore = timers->getTime("CELL_SIZE_TUNER_SAMPLE");
+		timers->start("CELL_SIZE_TUNER_SAMPLE");
+		_traversalTuner->traverseCellPairs(cellProcessor);
+		timers->stop("CELL_SIZE_TUNER_SAMPLE");
+		_cellSizeSampleTime += timers->getTime("CELL_SIZE_TUNER_SAMPLE") - timeBefore;
+	} else {
+		_traversalTuner->traverseCellPairs(cellProcessor);
+	}
 	cellProcessor.endTraversal();
 }
 
@@ -1051,6 +1208,58 @@ double LinkedCells::getEnergy(ParticlePairsHandler* particlePairsHandler, Molecu
 	return u;
 }
 
+void LinkedCells::getEnergies(ParticlePairsHandler* particlePairsHandler, const std::vector<Molecule>& testMolecules,
+		CellProcessor& cellProcessor, std::vector<double>& energies) {
+	energies.resize(testMolecules.size());
+	if (testMolecules.empty()) {
+		return;
+	}
+
+	vector<long> forwardNeighbourOffsets;
+	vector<long> backwardNeighbourOffsets;
+	calculateNeighbourIndices(forwardNeighbourOffsets, backwardNeighbourOffsets);
+
+	// the cell of the test molecule and its neighbours, as in getEnergy()
+	auto collectCells = [&](Molecule& testMolecule, std::vector<ParticleCell*>& cells) {
+		const unsigned long cellIndex = getCellIndexOfMolecule(&testMolecule);
+		mardyn_assert(not _cells[cellIndex].isHaloCell());
+		cells.clear();
+		cells.push_back(&_cells[cellIndex]);
+		for (long offset : forwardNeighbourOffsets) {
+			cells.push_back(&_cells[cellIndex + offset]);
+		}
+		for (long offset : backwardNeighbourOffsets) {
+			cells.push_back(&_cells[cellIndex - offset]);
+		}
+	};
+
+	// the first test molecule tells, whether the cell processor supports test molecules at all.
+	std::vector<ParticleCell*> cells;
+	Molecule firstMolecule = testMolecules[0];
+	collectCells(firstMolecule, cells);
+	if (not cellProcessor.processTestMolecule(firstMolecule, cells, energies[0])) {
+		ParticleContainer::getEnergies(particlePairsHandler, testMolecules, cellProcessor, energies);
+		return;
+	}
+
+	#if defined(_OPENMP)
+	#pragma omp parallel
+	#endif
+	{
+		std::vector<ParticleCell*> threadCells;
+
+		#if defined(_OPENMP)
+		#pragma omp for schedule(dynamic)
+		#endif
+		for (size_t i = 1; i < testMolecules.size(); ++i) {
+			Molecule testMolecule = testMolecules[i];
+			collectCells(testMolecule, threadCells);
+			cellProcessor.processTestMolecule(testMolecule, threadCells, energies[i]);
+			mardyn_assert(not std::isnan(energies[i])); // catches NaN
+		}
+	}
+}
+
 void LinkedCells::updateInnerMoleculeCaches() {
 	#if defined(_OPENMP)
 	#pragma omp parallel for schedule(static)
@@ -1137,11 +1346,29 @@ std::variant<ParticleIterator, SingleCellIterator<ParticleCell>> LinkedCells::ge
 			return cellIterator;
 		}
 	}
+
+	// A position within the tolerance (e.g. rounded by the compact halo encoding) might lie in a neighbouring cell.
+	std::vector<unsigned long> checkedIndices{index};
+	for (int corner = 0; corner < 8; ++corner) {
+		const double cornerPos[3] = {pos[0] + (corner & 1 ? epsi : -epsi), pos[1] + (corner & 2 ? epsi : -epsi),
+									 pos[2] + (corner & 4 ? epsi : -epsi)};
+		const auto cornerIndex = getCellIndexOfPoint(cornerPos);
+		if (std::find(checkedIndices.begin(), checkedIndices.end(), cornerIndex) != checkedIndices.end()) {
+			continue;
+		}
+		checkedIndices.push_back(cornerIndex);
+		for (auto cellIterator = _cells.at(cornerIndex).iterator(); cellIterator.isValid(); ++cellIterator) {
+			if (fabs(cellIterator->r(0) - pos[0]) <= epsi && fabs(cellIterator->r(1) - pos[1]) <= epsi &&
+				fabs(cellIterator->r(2) - pos[2]) <= epsi) {
+				return cellIterator;
+			}
+		}
+	}
 	// not found -> return default initialized iter.
 	return {};
 }
 
-bool LinkedCells::requiresForceExchange() const {return _traversalTuner->getCurrentOptimalTraversal()->requiresForceExchange();}
+bool LinkedCells::requiresForceExchange() const {return _traversalTuner->requiresForceExchange();}
 
 std::vector<unsigned long> LinkedCells::getParticleCellStatistics() {
 	int maxParticles = 0;
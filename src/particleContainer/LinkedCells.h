@@ -51,6 +51,7 @@ class ResortCellProcessorSliced;
 class LinkedCells : public ParticleContainer {
 
 	friend class LinkedCellsTest;
+	friend class DomainDecompositionTest;
 #ifdef VTK
 	friend class VTKGridWriter;
 #endif
@@ -104,6 +105,18 @@ public:
 	 * \code{.xml}
 		<datastructure type="LinkedCells">
 			<cellsInCutoffRadius>INTEGER</cellsInCutoffRadius>
+			<!-- optional runtime tuning of cellsInCutoffRadius: the cells are rebuilt for every candidate, which is
+			     timed on the force calculation for stepsPerCandidate steps, and the fastest one is used (the slowest
+			     rank counts). Candidates the traversalSelector does not support (e.g. more than 1 for c08) or which
+			     do not fit into a subdomain are skipped. The tuning is repeated every retuneInterval steps
+			     (0: only once at the start). The traversal is not tuned while the candidates are sampled, it is
+			     tuned for the chosen cell size afterwards. -->
+			<cellsInCutoffTuning>
+				<enabled>true</enabled>
+				<candidates>1,2,3</candidates>
+				<stepsPerCandidate>5</stepsPerCandidate>
+				<retuneInterval>0</retuneInterval>
+			</cellsInCutoffTuning>
 			<!-- from TraversalTuner: -->
 			<!-- select traversal algorithm
 				possible values are:
@@ -118,6 +131,19 @@ public:
 				- nt         (neutral territory method)
 			-->
 			<traversalSelector>c08</traversalSelector>
+			<!-- optional runtime tuning: every candidate is timed on the force calculation for
+			     stepsPerTraversal steps and the fastest is used. Retuning is triggered if the particle count
+			     or the pair work (sum of squared cell occupancies) changes by more than retuneThreshold.
+			     Only candidates with the same zonal method (i.e. halo regions, see DomainDecompMPIBase) and force
+			     exchange requirement as traversalSelector are sampled, e.g. c08, c04 and sliced for the full shell.
+			     A rebuild only triggers retuning if the cell length changed. -->
+			<traversalTuning>
+				<enabled>true</enabled>
+				<candidates>c08,c04,sliced,hs,mp,nt,c08es</candidates>
+				<stepsPerTraversal>5</stepsPerTraversal>
+				<checkInterval>100</checkInterval>
+				<retuneThreshold>0.1</retuneThreshold>
+			</traversalTuning>
 			<!-- override default block size (2x2x2) for quicksched tasks -->
 			<traversalData type="quicksched">
 				<taskBlockSize>
@@ -138,6 +164,18 @@ public:
 	// documentation see father class (ParticleContainer.h)
 	bool rebuild(double bBoxMin[3], double bBoxMax[3]) override;
 
+	// documentation see father class (ParticleContainer.h)
+	bool adaptCellSize() override;
+
+	unsigned getCellsInCutoff() const { return _cellsInCutoff; }
+
+	/**
+	 * Rebuild the cells of the current bounding box with the given number of cells per cutoff radius.
+	 * The inner and boundary particles are kept, the halo particles are deleted.
+	 * @return false, if the number of cells in cutoff did not change
+	 */
+	bool setCellsInCutoff(unsigned cellsInCutoff);
+
 	//! Pointers to the particles are put into cells depending on the spacial position
 	//! of the particles.
 	//! Before the call of this method, this distribution might have become invalid.
@@ -197,6 +235,14 @@ public:
 	/* TODO: The particle container should not contain any physics, search a new place for this. */
 	double getEnergy(ParticlePairsHandler* particlePairsHandler, Molecule* m1, CellProcessor& cellProcessor) override;
 
+	/**
+	 * Uses the vectorized kernels of the cell processor (see CellProcessor::processTestMolecule()) and distributes the
+	 * test molecules over the threads. The SoAs of the cells have to be up to date, e.g. after the force calculation.
+	 * Falls back to getEnergy(), if the cell processor does not support test molecules.
+	 */
+	void getEnergies(ParticlePairsHandler* particlePairsHandler, const std::vector<Molecule>& testMolecules,
+			CellProcessor& cellProcessor, std::vector<double>& energies) override;
+
 	int* getBoxWidthInNumCells() {
 		return _boxWidthInNumCells;
 	}
@@ -278,6 +324,9 @@ private:
 
 	void initializeTraversal();
 
+	//! @brief Start a tuning phase of the number of cells in cutoff over all candidates applicable on all ranks.
+	void startCellSizeTuning();
+
 	//! @brief Calculate neighbour indices.
 	//!
 	//! This method is executed once for the molecule container and not for
@@ -351,6 +400,23 @@ private:
 	double _cutoffRadius; //!< RDF/electrostatics cutoff radius
 	unsigned _cellsInCutoff = 1; //!< Cells in cutoff radius -> cells with size cutoff / cellsInCutoff
 
+	//! runtime tuning of _cellsInCutoff, see readXML
+	bool _cellSizeTuningEnabled = false;
+	std::vector<unsigned> _cellSizeCandidates {1, 2, 3};
+	unsigned _cellSizeStepsPerCandidate = 5;
+	unsigned long _cellSizeRetuneInterval = 0;
+
+	bool _cellSizeTuningActive = false;
+	bool _cellSizeTuned = false;
+	//! candidates applicable in the current tuning phase
+	std::vector<unsigned> _activeCellSizeCandidates;
+	std::vector<double> _cellSizeCandidateTimes;
+	size_t _currentCellSizeCandidate = 0;
+	unsigned _cellSizeSamples = 0;
+	//! force traversal time of the current candidate
+	double _cellSizeSampleTime = 0.;
+	unsigned long _stepsSinceCellSizeTuning = 0;
+
 	//! @brief True if all Particles are in the right cell
 	//!
 	//! The particles themselves are not stored in cells, but in one large
@@ -51,3 +51,12 @@ bool ParticleContainer::addHaloParticle(Molecule& particle, bool inBoxCheckedAlr
 	mardyn_assert(not particle.inBox(_boundingBoxMin,_boundingBoxMax));
 	return addParticle(particle, inBoxCheckedAlready, checkWhetherDuplicate, rebuildCaches);
 }
+
+void ParticleContainer::getEnergies(ParticlePairsHandler* particlePairsHandler, const std::vector<Molecule>& testMolecules,
+		CellProcessor& cellProcessor, std::vector<double>& energies) {
+	energies.resize(testMolecules.size());
+	for (size_t i = 0; i < testMolecules.size(); ++i) {
+		Molecule testMolecule = testMolecules[i];
+		energies[i] = getEnergy(particlePairsHandler, &testMolecule, cellProcessor);
+	}
+}
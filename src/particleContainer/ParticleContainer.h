@@ -212,6 +212,15 @@ public:
     /* TODO goes into grand canonical ensemble */
 	virtual double getEnergy(ParticlePairsHandler* particlePairsHandler, Molecule* m1, CellProcessor& cellProcessor) = 0;
 
+	/**
+	 * @brief Potential energies of many test molecules (insertions, deletions, Widom probes) with the molecules of the
+	 * container, computed as by getEnergy() for every test molecule. The test molecules do not interact with each
+	 * other. The default implementation calls getEnergy() for every test molecule.
+	 * @param energies is resized to the number of test molecules
+	 */
+	virtual void getEnergies(ParticlePairsHandler* particlePairsHandler, const std::vector<Molecule>& testMolecules,
+			CellProcessor& cellProcessor, std::vector<double>& energies);
+
 	//! @brief Update the caches of the molecules, that lie in inner cells.
 	//! The caches of boundary and halo cells is not updated.
 	//! This method is used for a multi-step scheme of overlapping mpi communication
@@ -260,6 +269,13 @@ public:
 	 */
 	virtual void setCutoff(double rc){};
 
+	/**
+	 * Applies a change of the cell size, e.g. chosen by a runtime tuning. It is called once per time step on all
+	 * ranks, after the particles have been exchanged.
+	 * @return true, if the cells were rebuilt. The halo particles are deleted then and have to be exchanged again.
+	 */
+	virtual bool adaptCellSize() { return false; }
+
 	virtual std::vector<Molecule> getInvalidParticles() { return {}; }
 
 	virtual bool isInvalidParticleReturner() { return false; }
@@ -2,10 +2,13 @@
 #define TRAVERSALTUNER_H_
 
 #include <algorithm>
+#include <cmath>
 #include <utility>
 #include <vector>
 
 #include <utils/Logger.h>
+#include <utils/String_utils.h>
+#include <io/TimerProfiler.h>
 #include <Simulation.h>
 #include "LinkedCellTraversals/CellPairTraversals.h"
 #include "LinkedCellTraversals/QuickschedTraversal.h"
@@ -22,6 +25,7 @@ using Log::global_log;
 template<class CellTemplate>
 class TraversalTuner {
 	friend class LinkedCellsTest;
+	friend class DomainDecompositionTest;
 
 public:
 	// Probably remove this once autotuning is implemented
@@ -74,12 +78,94 @@ public:
 
 	CellPairTraversals<ParticleCell> *getCurrentOptimalTraversal() { return _optimalTraversal; }
 
+	//! @brief true while the tuner is still sampling candidate traversals
+	bool isTuning() const { return _tuningActive; }
+
+	//! @brief set the number of cells per cutoff radius, the cells have to be rebuilt afterwards.
+	void setCellsInCutoff(unsigned cellsInCutoff) { _cellsInCutoff = cellsInCutoff; }
+
+	//! @brief maximal number of cells per cutoff radius the configured traversal supports.
+	unsigned getMaxCellsInCutoff() const;
+
+	/**
+	 * Whether the forces of the halo molecules have to be sent back. All tuning candidates agree in this, so it is
+	 * also known between a rebuild and the (re)selection of the traversal at the next traversal.
+	 */
+	bool requiresForceExchange() const;
+
+	/**
+	 * Freeze the traversal, e.g. while another tuner times the force calculation. A running tuning phase is aborted
+	 * and the traversal selected before it is kept. After unfreezing, the traversals are tuned anew.
+	 */
+	void setTuningFrozen(bool frozen);
+
 private:
+	/**
+	 * Translate a traversal name as given in the xml (e.g. "c08", "sliced", ...) into its enum value.
+	 * @return false, if the name does not denote a known traversal.
+	 */
+	static bool parseTraversalName(const std::string &name, traversalNames &result);
+
+	//! @brief print which traversal is in use.
+	void logOptimalTraversal() const;
+
+	//! @brief Start a new tuning phase over all candidates applicable to the current cell geometry.
+	void startTuning();
+
+	/**
+	 * The zonal method, which DomainDecompMPIBase derives from the traversal selected in the xml. It determines the
+	 * halo regions, so a candidate is only correct if it maps to the same zonal method as the configured traversal.
+	 */
+	static const char *getZonalMethod(traversalNames name);
+
+	//! @brief Traverse the force cell processor with the candidate under test and record its runtime.
+	void traverseCellPairsTuning(CellProcessor &cellProcessor);
+
+	/**
+	 * Determine the particle count and the sum of squared cell occupancies (a measure of the pair work and thus of
+	 * the density distribution) over all cells.
+	 */
+	std::pair<double, double> measureParticleDistribution() const;
+
+	//! @brief Check whether the particle distribution drifted so far since the last tuning phase that we retune.
+	bool particleDistributionChanged();
+
 	std::vector<CellTemplate>* _cells;
 	std::array<unsigned long, 3> _dims;
 
 	traversalNames selectedTraversal;
 
+	//! traversal chosen in the xml, determines whether the candidates need force exchange
+	traversalNames _configuredTraversal;
+
+	//! tuning is enabled via <traversalTuning><enabled>
+	bool _tuningEnabled = false;
+	//! no tuning while frozen, see setTuningFrozen()
+	bool _tuningFrozen = false;
+	//! traversal in use before the current tuning phase
+	traversalNames _traversalBeforeTuning = C08;
+	//! the traversals are only tuned anew if the cell length changes, not for every rebuild
+	bool _cellGeometryChanged = true;
+	std::array<double, 3> _tunedCellLength {0., 0., 0.};
+	//! candidates sampled during tuning
+	std::vector<traversalNames> _tuningCandidates {C08, C04, SLICED, HS, MP, NT, C08ES};
+	//! number of force traversals each candidate is timed for
+	unsigned _tuningStepsPerTraversal = 5;
+	//! number of force traversals between two checks of the particle distribution
+	unsigned _tuningCheckInterval = 100;
+	//! relative change in particle count or pair work that triggers retuning
+	double _tuningRetuneThreshold = 0.1;
+
+	bool _tuningActive = false;
+	//! candidates applicable in the current tuning phase
+	std::vector<traversalNames> _activeCandidates;
+	std::vector<double> _candidateTimes;
+	size_t _currentCandidate = 0;
+	unsigned _currentCandidateSamples = 0;
+	unsigned _stepsSinceCheck = 0;
+	//! particle count and pair work at the end of the last tuning phase
+	std::pair<double, double> _tunedParticleDistribution {0., 0.};
+
 	std::vector<std::pair<CellPairTraversals<CellTemplate> *, CellPairTraversalData *> > _traversals;
 
 	CellPairTraversals<CellTemplate> *_optimalTraversal;
@@ -93,6 +179,7 @@ TraversalTuner<CellTemplate>::TraversalTuner() : _cells(nullptr), _dims(), _opti
 	selectedTraversal = {
 			mardyn_get_max_threads() > 1 ? C08 : SLICED
 	};
+	_configuredTraversal = selectedTraversal;
 	auto *c08Data = new C08CellPairTraversalData;
 	auto *c04Data = new C04CellPairTraversalData;
 	auto *origData = new OriginalCellPairTraversalData;
@@ -133,11 +220,48 @@ TraversalTuner<CellTemplate>::~TraversalTuner() {
 
 template<class CellTemplate>
 void TraversalTuner<CellTemplate>::findOptimalTraversal() {
-	// TODO implement autotuning here! At the moment the traversal is chosen via readXML!
+	// a rebuild of the same cells (e.g. after a rebalancing) continues or keeps the current choice,
+	// unless the selected traversal is no longer applicable to the new dimensions.
+	const bool selectionInapplicable = selectedTraversal == SLICED
+			and not SlicedCellPairTraversal<CellTemplate>::isApplicable(_dims);
+	if (_tuningEnabled and (_cellGeometryChanged or selectionInapplicable)) {
+		// samples the candidates during the next force traversals, starting with the first one.
+		startTuning();
+	}
+	_cellGeometryChanged = false;
 
 	_optimalTraversal = _traversals[selectedTraversal].first;
 
-	// log traversal
+	if (not _tuningActive) {
+		logOptimalTraversal();
+	}
+
+	if (_cellsInCutoff > _optimalTraversal->maxCellsInCutoff()) {
+		global_log->error() << "Traversal supports up to " << _optimalTraversal->maxCellsInCutoff()
+							<< " cells in cutoff, but value is chosen as " << _cellsInCutoff << std::endl;
+		Simulation::exit(45);
+	}
+}
+
+template<class CellTemplate>
+unsigned TraversalTuner<CellTemplate>::getMaxCellsInCutoff() const {
+	if (static_cast<size_t>(_configuredTraversal) >= _traversals.size()
+		or _traversals[_configuredTraversal].first == nullptr) {
+		return 1;
+	}
+	return _traversals[_configuredTraversal].first->maxCellsInCutoff();
+}
+
+template<class CellTemplate>
+bool TraversalTuner<CellTemplate>::requiresForceExchange() const {
+	if (_optimalTraversal != nullptr) {
+		return _optimalTraversal->requiresForceExchange();
+	}
+	return _traversals[selectedTraversal].first->requiresForceExchange();
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::logOptimalTraversal() const {
 	if (dynamic_cast<HalfShellTraversal<CellTemplate> *>(_optimalTraversal))
 		global_log->info() << "Using HalfShellTraversal." << endl;
 	else if (dynamic_cast<OriginalCellPairTraversal<CellTemplate> *>(_optimalTraversal))
@@ -162,42 +286,45 @@ void TraversalTuner<CellTemplate>::findOptimalTraversal() {
 		global_log->info() << "Using SlicedCellPairTraversal." << endl;
 	else
 		global_log->warning() << "Using unknown traversal." << endl;
-
-	if (_cellsInCutoff > _optimalTraversal->maxCellsInCutoff()) {
-		global_log->error() << "Traversal supports up to " << _optimalTraversal->maxCellsInCutoff()
-							<< " cells in cutoff, but value is chosen as " << _cellsInCutoff << std::endl;
-		Simulation::exit(45);
-	}
 }
 
 template<class CellTemplate>
-void TraversalTuner<CellTemplate>::readXML(XMLfileUnits &xmlconfig) {
-	string oldPath(xmlconfig.getcurrentnodepath());
-	// read traversal type default values
-	string traversalType;
-
-	xmlconfig.getNodeValue("traversalSelector", traversalType);
+bool TraversalTuner<CellTemplate>::parseTraversalName(const std::string &name, traversalNames &result) {
+	std::string traversalType(name);
 	transform(traversalType.begin(), traversalType.end(), traversalType.begin(), ::tolower);
 
 	if (traversalType.find("c08es") != string::npos)
-		selectedTraversal = C08ES;
+		result = C08ES;
 	else if (traversalType.find("c08") != string::npos)
-		selectedTraversal = C08;
+		result = C08;
 	else if (traversalType.find("c04") != string::npos)
-		selectedTraversal = C04;
+		result = C04;
 	else if (traversalType.find("qui") != string::npos)
-		selectedTraversal = QSCHED;
+		result = QSCHED;
 	else if (traversalType.find("slice") != string::npos)
-		selectedTraversal = SLICED;
+		result = SLICED;
 	else if (traversalType.find("ori") != string::npos)
-		selectedTraversal = ORIGINAL;
+		result = ORIGINAL;
 	else if (traversalType.find("hs") != string::npos)
-		selectedTraversal = HS;
+		result = HS;
 	else if (traversalType.find("mp") != string::npos)
-		selectedTraversal = MP;
-	else if (traversalType.find("nt") != string::npos) {
-		selectedTraversal = NT;
-	} else {
+		result = MP;
+	else if (traversalType.find("nt") != string::npos)
+		result = NT;
+	else
+		return false;
+	return true;
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::readXML(XMLfileUnits &xmlconfig) {
+	string oldPath(xmlconfig.getcurrentnodepath());
+	// read traversal type default values
+	string traversalType;
+
+	xmlconfig.getNodeValue("traversalSelector", traversalType);
+
+	if (not parseTraversalName(traversalType, selectedTraversal)) {
 		// selector already set in constructor, just print a warning here
 		if (mardyn_get_max_threads() > 1) {
 			global_log->warning() << "No traversal type selected. Defaulting to c08 traversal." << endl;
@@ -205,9 +332,38 @@ void TraversalTuner<CellTemplate>::readXML(XMLfileUnits &xmlconfig) {
 			global_log->warning() << "No traversal type selected. Defaulting to sliced traversal." << endl;
 		}
 	}
+	_configuredTraversal = selectedTraversal;
 
 	_cellsInCutoff = xmlconfig.getNodeValue_int("cellsInCutoffRadius", 1); // This is currently only used for an assert
 
+	if (xmlconfig.changecurrentnode("traversalTuning")) {
+		_tuningEnabled = xmlconfig.getNodeValue_bool("enabled", true);
+		_tuningStepsPerTraversal = xmlconfig.getNodeValue_int("stepsPerTraversal", _tuningStepsPerTraversal);
+		_tuningCheckInterval = xmlconfig.getNodeValue_int("checkInterval", _tuningCheckInterval);
+		_tuningRetuneThreshold = xmlconfig.getNodeValue_double("retuneThreshold", _tuningRetuneThreshold);
+		std::string candidates;
+		if (xmlconfig.getNodeValue("candidates", candidates)) {
+			_tuningCandidates.clear();
+			for (const auto &candidateName : string_utils::split(candidates, ',')) {
+				traversalNames candidate;
+				if (parseTraversalName(candidateName, candidate) and candidate != QSCHED) {
+					_tuningCandidates.push_back(candidate);
+				} else {
+					global_log->warning() << "TraversalTuner: ignoring unknown tuning candidate " << candidateName << endl;
+				}
+			}
+		}
+		if (_tuningStepsPerTraversal < 1) {
+			global_log->error() << "TraversalTuner: stepsPerTraversal has to be at least 1." << endl;
+			Simulation::exit(1);
+		}
+		global_log->info() << "TraversalTuner: tuning " << (_tuningEnabled ? "enabled" : "disabled")
+						   << ", " << _tuningStepsPerTraversal << " steps per candidate, checking the particle"
+						   << " distribution every " << _tuningCheckInterval << " steps (retune threshold "
+						   << _tuningRetuneThreshold << ")" << endl;
+		xmlconfig.changecurrentnode(oldPath);
+	}
+
 	// workaround for stupid iterator:
 	// since
 	// xmlconfig.changecurrentnode(traversalIterator);
@@ -270,6 +426,11 @@ void TraversalTuner<CellTemplate>::rebuild(std::vector<CellTemplate> &cells, con
 										   double cellLength[3], double cutoff) {
 	_cells = &cells; // new - what for?
 	_dims = dims; // new - what for?
+	const std::array<double, 3> newCellLength {cellLength[0], cellLength[1], cellLength[2]};
+	if (newCellLength != _tunedCellLength) {
+		_tunedCellLength = newCellLength;
+		_cellGeometryChanged = true;
+	}
 
 	for (size_t i = 0ul; i < _traversals.size(); ++i) {
 		auto& [traversalPointerReference, traversalData] = _traversals[i];
@@ -321,7 +482,173 @@ void TraversalTuner<CellTemplate>::traverseCellPairs(CellProcessor &cellProcesso
 	if (not _optimalTraversal) {
 		findOptimalTraversal();
 	}
+	// only the force calculation is representative for the choice of the traversal,
+	// all other cell processors (resorting, RDF, ...) just use the current one.
+	if (_tuningEnabled and not _tuningFrozen and global_simulation != nullptr
+		and &cellProcessor == global_simulation->getCellProcessor()) {
+		if (not _tuningActive and particleDistributionChanged()) {
+			startTuning();
+			_optimalTraversal = _traversals[selectedTraversal].first;
+		}
+		if (_tuningActive) {
+			traverseCellPairsTuning(cellProcessor);
+			return;
+		}
+	}
+	_optimalTraversal->traverseCellPairs(cellProcessor);
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::setTuningFrozen(bool frozen) {
+	if (frozen and _tuningActive) {
+		global_log->info() << "TraversalTuner: tuning aborted." << endl;
+		_tuningActive = false;
+		selectedTraversal = _traversalBeforeTuning;
+		if (_optimalTraversal != nullptr) {
+			_optimalTraversal = _traversals[selectedTraversal].first;
+		}
+	}
+	if (not frozen and _tuningFrozen) {
+		_cellGeometryChanged = true;
+		_optimalTraversal = nullptr;
+	}
+	_tuningFrozen = frozen;
+}
+
+template<class CellTemplate>
+const char *TraversalTuner<CellTemplate>::getZonalMethod(traversalNames name) {
+	switch (name) {
+		case HS:
+			return "hs";
+		case MP:
+			return "mp";
+		case NT:
+			return "nt";
+		case C08ES:
+			return "es";
+		default:
+			return "fs";
+	}
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::startTuning() {
+	if (not _tuningActive) {
+		_traversalBeforeTuning = selectedTraversal;
+	}
+	_tuningActive = false;
+	_activeCandidates.clear();
+	_stepsSinceCheck = 0;
+	_tunedParticleDistribution = measureParticleDistribution();
+
+	if (_tuningFrozen or static_cast<size_t>(_configuredTraversal) >= _traversals.size()) {
+		return;
+	}
+	// the halo regions and the communication pattern (force exchange or not) are fixed by the zonal method of the
+	// configured traversal, so only candidates with the same zonal method and requirement may be chosen.
+	const bool requiresForceExchange = _traversals[_configuredTraversal].first->requiresForceExchange();
+	const std::string zonalMethod = getZonalMethod(_configuredTraversal);
+	for (auto candidate : _tuningCandidates) {
+		if (static_cast<size_t>(candidate) >= _traversals.size()
+			or std::find(_activeCandidates.begin(), _activeCandidates.end(), candidate) != _activeCandidates.end()) {
+			continue;
+		}
+		auto *traversal = _traversals[candidate].first;
+		if (zonalMethod != getZonalMethod(candidate)
+			or traversal->requiresForceExchange() != requiresForceExchange
+			or _cellsInCutoff > traversal->maxCellsInCutoff()
+			or (candidate == SLICED and not SlicedCellPairTraversal<CellTemplate>::isApplicable(_dims))) {
+			continue;
+		}
+		_activeCandidates.push_back(candidate);
+	}
+
+	if (_activeCandidates.size() < 2) {
+		selectedTraversal = _activeCandidates.empty() ? _configuredTraversal : _activeCandidates.front();
+		global_log->info() << "TraversalTuner: less than two applicable candidates, tuning skipped." << endl;
+		return;
+	}
+
+	global_log->info() << "TraversalTuner: sampling " << _activeCandidates.size() << " traversals for "
+					   << _tuningStepsPerTraversal << " steps each." << endl;
+	_candidateTimes.assign(_activeCandidates.size(), 0.);
+	_currentCandidate = 0;
+	_currentCandidateSamples = 0;
+	_tuningActive = true;
+	selectedTraversal = _activeCandidates[_currentCandidate];
+}
+
+template<class CellTemplate>
+void TraversalTuner<CellTemplate>::traverseCellPairsTuning(CellProcessor &cellProcessor) {
+	TimerProfiler *timers = global_simulation->timers();
+	const double timeBefore = timers->getTime("TRAVERSAL_TUNER_SAMPLE");
+	timers->start("TRAVERSAL_TUNER_SAMPLE");
 	_optimalTraversal->traverseCellPairs(cellProcessor);
+	timers->stop("TRAVERSAL_TUNER_SAMPLE");
+	_candidateTimes[_currentCandidate] += timers->getTime("TRAVERSAL_TUNER_SAMPLE") - timeBefore;
+
+	if (++_currentCandidateSamples < _tuningStepsPerTraversal) {
+		return;
+	}
+	_currentCandidateSamples = 0;
+	++_currentCandidate;
+
+	if (_currentCandidate < _activeCandidates.size()) {
+		selectedTraversal = _activeCandidates[_currentCandidate];
+	} else {
+		// all candidates sampled, lock in the fastest one
+		static const char *const names[] = {"original", "c08", "c04", "sliced", "hs", "mp", "c08es", "nt", "quicksched"};
+		size_t best = 0;
+		for (size_t i = 0; i < _activeCandidates.size(); ++i) {
+			global_log->info() << "TraversalTuner: candidate " << names[_activeCandidates[i]] << " took "
+							   << _candidateTimes[i] / _tuningStepsPerTraversal << " s per step." << endl;
+			if (_candidateTimes[i] < _candidateTimes[best]) {
+				best = i;
+			}
+		}
+		selectedTraversal = _activeCandidates[best];
+		_tuningActive = false;
+		_stepsSinceCheck = 0;
+		_tunedParticleDistribution = measureParticleDistribution();
+	}
+	_optimalTraversal = _traversals[selectedTraversal].first;
+	if (not _tuningActive) {
+		logOptimalTraversal();
+	}
+}
+
+template<class CellTemplate>
+std::pair<double, double> TraversalTuner<CellTemplate>::measureParticleDistribution() const {
+	double numParticles = 0., pairWork = 0.;
+	if (_cells != nullptr) {
+		for (const auto &cell : *_cells) {
+			const double n = cell.getMoleculeCount();
+			numParticles += n;
+			pairWork += n * n;
+		}
+	}
+	return std::make_pair(numParticles, pairWork);
+}
+
+template<class CellTemplate>
+bool TraversalTuner<CellTemplate>::particleDistributionChanged() {
+	if (_tuningCheckInterval == 0 or ++_stepsSinceCheck < _tuningCheckInterval) {
+		return false;
+	}
+	_stepsSinceCheck = 0;
+
+	const auto current = measureParticleDistribution();
+	auto relativeDrift = [](double now, double reference) {
+		return reference > 0. ? std::abs(now - reference) / reference : (now > 0. ? 1. : 0.);
+	};
+	const double particleDrift = relativeDrift(current.first, _tunedParticleDistribution.first);
+	const double pairWorkDrift = relativeDrift(current.second, _tunedParticleDistribution.second);
+	if (particleDrift > _tuningRetuneThreshold or pairWorkDrift > _tuningRetuneThreshold) {
+		global_log->info() << "TraversalTuner: particle count changed by " << particleDrift
+						   << ", pair work by " << pairWorkDrift << ". Retuning." << endl;
+		return true;
+	}
+	return false;
 }
 
 template<class CellTemplate>
@@ -13,6 +13,7 @@
 #include "utils/ConcatenatedSites.h"
 #include "vectorization/SIMD_TYPES.h"
 #include <cstdint>
+#include <algorithm>
 #include <array>
 
 /**
@@ -51,6 +52,11 @@ public:
 	AlignedArray<int> _mol_dipoles_num;
 	AlignedArray<int> _mol_quadrupoles_num;
 
+	// bounding box of the molecule positions, only valid after computeMoleculeBoundingBox()
+	std::array<vcp_real_calc, 3> _mol_bbox_min;
+	std::array<vcp_real_calc, 3> _mol_bbox_max;
+	bool _mol_bbox_valid;
+
 	// entries per center
 	ConcatenatedSites<vcp_real_calc> _centers_m_r;
 	ConcatenatedSites<vcp_real_calc> _centers_r;
@@ -176,12 +182,129 @@ public:
 		_quadrupoles_e.z(index) = orientation[2];
 	}
 
+	/**
+	 * \brief	Update the positions of the LJ center at position index, its lookup index is kept
+	 */
+	void updateLJC(const size_t index, std::array<vcp_real_calc,3> moleculePos, std::array<vcp_real_calc,3> centerPos) {
+		setTripletCalc(moleculePos, QuantityType::MOL_POSITION, SiteType::LJC, index);
+		setTripletCalc(centerPos, QuantityType::CENTER_POSITION, SiteType::LJC, index);
+	}
+
+	/**
+	 * \brief	Update the positions of the charge at position index, its charge is kept
+	 */
+	void updateCharge(const size_t index, std::array<vcp_real_calc,3> moleculePos, std::array<vcp_real_calc,3> centerPos) {
+		setTripletCalc(moleculePos, QuantityType::MOL_POSITION, SiteType::CHARGE, index);
+		setTripletCalc(centerPos, QuantityType::CENTER_POSITION, SiteType::CHARGE, index);
+	}
+
+	/**
+	 * \brief	Update the positions and the orientation of the dipole at position index, its moment is kept
+	 */
+	void updateDipole(const size_t index, std::array<vcp_real_calc,3> moleculePos, std::array<vcp_real_calc,3> centerPos,
+			std::array<vcp_real_calc,3> orientation) {
+		setTripletCalc(moleculePos, QuantityType::MOL_POSITION, SiteType::DIPOLE, index);
+		setTripletCalc(centerPos, QuantityType::CENTER_POSITION, SiteType::DIPOLE, index);
+		_dipoles_e.x(index) = orientation[0];
+		_dipoles_e.y(index) = orientation[1];
+		_dipoles_e.z(index) = orientation[2];
+	}
+
+	/**
+	 * \brief	Update the positions and the orientation of the quadrupole at position index, its moment is kept
+	 */
+	void updateQuadrupole(const size_t index, std::array<vcp_real_calc,3> moleculePos, std::array<vcp_real_calc,3> centerPos,
+			std::array<vcp_real_calc,3> orientation) {
+		setTripletCalc(moleculePos, QuantityType::MOL_POSITION, SiteType::QUADRUPOLE, index);
+		setTripletCalc(centerPos, QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, index);
+		_quadrupoles_e.x(index) = orientation[0];
+		_quadrupoles_e.y(index) = orientation[1];
+		_quadrupoles_e.z(index) = orientation[2];
+	}
+
+	/**
+	 * \brief	Set the forces, virials and torques of all centers to zero.
+	 * \details	Clears the whole arrays at once, which is cheaper than clearing the centers molecule by molecule.
+	 */
+	void clearAccumulators() {
+		_centers_f.zero();
+		_centers_V.zero();
+		_dipoles_M.zeroAll();
+		_quadrupoles_M.zeroAll();
+	}
+
+	/**
+	 * \brief	Compute the bounding box of the molecule positions.
+	 * \details	Has to be called after all molecule positions are set. The vectorized cell processor uses the box to
+	 * skip cell pairs and molecules which are further apart than the cutoff radius.
+	 */
+	void computeMoleculeBoundingBox() {
+		const size_t molNum = getMolNum();
+		if (molNum == 0) {
+			_mol_bbox_valid = false;
+			return;
+		}
+		const vcp_real_calc * const pos[3] = {_mol_pos.xBegin(), _mol_pos.yBegin(), _mol_pos.zBegin()};
+		for (int d = 0; d < 3; ++d) {
+			vcp_real_calc lo = pos[d][0];
+			vcp_real_calc hi = pos[d][0];
+			for (size_t i = 1; i < molNum; ++i) {
+				lo = std::min(lo, pos[d][i]);
+				hi = std::max(hi, pos[d][i]);
+			}
+			_mol_bbox_min[d] = lo;
+			_mol_bbox_max[d] = hi;
+		}
+		_mol_bbox_valid = true;
+	}
+
+	/**
+	 * \brief	Squared distance of a point to the bounding box of the molecule positions.
+	 * \return	0 if the point lies inside the box or if the box is not valid.
+	 */
+	vcp_inline vcp_real_calc moleculeBoundingBoxDistanceSquare(vcp_real_calc x, vcp_real_calc y, vcp_real_calc z) const {
+		if (not _mol_bbox_valid) {
+			return 0;
+		}
+		const vcp_real_calc p[3] = {x, y, z};
+		vcp_real_calc dist2 = 0;
+		for (int d = 0; d < 3; ++d) {
+			const vcp_real_calc gap = std::max(std::max(_mol_bbox_min[d] - p[d], p[d] - _mol_bbox_max[d]), vcp_real_calc(0));
+			dist2 += gap * gap;
+		}
+		return dist2;
+	}
+
+	/**
+	 * \brief	Squared distance between the bounding boxes of the molecule positions of two SoAs.
+	 * \return	0 if the boxes overlap or if one of them is not valid.
+	 */
+	vcp_inline vcp_real_calc moleculeBoundingBoxDistanceSquare(const CellDataSoA& other) const {
+		if (not _mol_bbox_valid or not other._mol_bbox_valid) {
+			return 0;
+		}
+		vcp_real_calc dist2 = 0;
+		for (int d = 0; d < 3; ++d) {
+			const vcp_real_calc gap = std::max(std::max(_mol_bbox_min[d] - other._mol_bbox_max[d],
+					other._mol_bbox_min[d] - _mol_bbox_max[d]), vcp_real_calc(0));
+			dist2 += gap * gap;
+		}
+		return dist2;
+	}
+
+	/**
+	 * \brief Sets up the distance lookup arrays of all center types.
+	 * \details The lookup type and the number of indices per lookup entry depend on the vector type, so they are
+	 * passed by the caller. This keeps the class independent of VCP_ISA_NAMESPACE.
+	 */
+	template<typename LookupOrMask>
 	void vcp_inline initDistLookupPointers(
-			AlignedArray<vcp_lookupOrMask_single>& centers_dist_lookup,
-			vcp_lookupOrMask_single*& ljc_dist_lookup,
-			vcp_lookupOrMask_single*& charges_dist_lookup,
-			vcp_lookupOrMask_single*& dipoles_dist_lookup,
-			vcp_lookupOrMask_single*& quadrupoles_dist_lookup) const {
+			AlignedArray<LookupOrMask>& centers_dist_lookup,
+			LookupOrMask*& ljc_dist_lookup,
+			LookupOrMask*& charges_dist_lookup,
+			LookupOrMask*& dipoles_dist_lookup,
+			LookupOrMask*& quadrupoles_dist_lookup,
+			const size_t indicesPerLookup) const {
 
 		size_t ljc_size 	= AlignedArray<vcp_real_calc>::_round_up(_ljc_num);
 		size_t charges_size = AlignedArray<vcp_real_calc>::_round_up(_charges_num);
@@ -193,14 +316,15 @@ public:
 		setPaddingToZero(centers_dist_lookup);
 
 		ljc_dist_lookup = centers_dist_lookup;
-		charges_dist_lookup = ljc_dist_lookup + (ljc_size + VCP_INDICES_PER_LOOKUP_SINGLE_M1)/VCP_INDICES_PER_LOOKUP_SINGLE;
-		dipoles_dist_lookup = charges_dist_lookup + (charges_size + VCP_INDICES_PER_LOOKUP_SINGLE_M1)/VCP_INDICES_PER_LOOKUP_SINGLE;
-		quadrupoles_dist_lookup = dipoles_dist_lookup + (dipoles_size + VCP_INDICES_PER_LOOKUP_SINGLE_M1)/VCP_INDICES_PER_LOOKUP_SINGLE;
+		charges_dist_lookup = ljc_dist_lookup + (ljc_size + indicesPerLookup - 1)/indicesPerLookup;
+		dipoles_dist_lookup = charges_dist_lookup + (charges_size + indicesPerLookup - 1)/indicesPerLookup;
+		quadrupoles_dist_lookup = dipoles_dist_lookup + (dipoles_size + indicesPerLookup - 1)/indicesPerLookup;
 	}
 
+	template<typename LookupOrMask>
 	void vcp_inline initDistLookupPointersSingle(
-			AlignedArray<vcp_lookupOrMask_single>& centers_dist_lookup,
-			vcp_lookupOrMask_single*& sites_dist_lookup,
+			AlignedArray<LookupOrMask>& centers_dist_lookup,
+			LookupOrMask*& sites_dist_lookup,
 			size_t sites_num) const {
 
 		centers_dist_lookup.resize_zero_shrink(sites_num, true, false);
@@ -211,6 +335,7 @@ public:
 //		const bool allow_shrink = false; // TODO shrink at some point in the future
 
 		setMolNum(molecules_arg);
+		_mol_bbox_valid = false;
 		_ljc_num = ljcenters_arg;
 		_charges_num = charges_arg;
 		_dipoles_num = dipoles_arg;
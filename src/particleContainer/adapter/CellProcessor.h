@@ -4,10 +4,13 @@
 
 #include <cstddef>
 #include <cmath>
+#include <vector>
 
 #include "molecules/MoleculeForwardDeclaration.h"
 #include "particleContainer/ParticleCellForwardDeclaration.h"
 
+class PairObserver;
+
 /**
  * Interface for traversal of cells to allow a cell-wise treatment of molecules.
  *
@@ -82,6 +85,34 @@ public:
 
 	virtual double processSingleMolecule(Molecule* m1, ParticleCell& cell2) = 0;
 
+	/**
+	 * Computes the potential energy of a test molecule (grand canonical insertion or deletion, Widom probe) with all
+	 * molecules of the given cells, without touching the forces of the cell molecules or the global values of the
+	 * traversal. A molecule of the cells at exactly the position of the test molecule is taken to be the test molecule
+	 * itself and skipped. Must not be called during a traversal, but may be called by several threads at once.
+	 *
+	 * @param testMolecule may be changed, e.g. to set up its own caches
+	 * @param energy the potential energy, if the cell processor supports test molecules
+	 * @return false if the cell processor does not support test molecules, processSingleMolecule() of a
+	 * LegacyCellProcessor has to be used then.
+	 */
+	virtual bool processTestMolecule(Molecule& /*testMolecule*/, const std::vector<ParticleCell*>& /*cells*/,
+			double& /*energy*/) {
+		return false;
+	}
+
+	/**
+	 * Registers an observer, which gets the molecule pairs of the following traversals (see PairObserver).
+	 *
+	 * @return false if the cell processor does not support observers, the observer has to traverse the pairs on its
+	 * own then.
+	 */
+	virtual bool addPairObserver(PairObserver* /*observer*/) {
+		return false;
+	}
+
+	virtual void removePairObserver(PairObserver* /*observer*/) {}
+
 	/**
 	 * Called after the cell has been considered for the last time during the traversal.
 	 */
@@ -0,0 +1,208 @@
+/**
+ * @file InstrumentedCellProcessor.cpp
+ */
+
+#include "InstrumentedCellProcessor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
+#include "particleContainer/ParticleCell.h"
+#include "WrapOpenMP.h"
+
+namespace {
+typedef std::chrono::steady_clock Clock;
+
+double secondsSince(const Clock::time_point& start) {
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+} /* anonymous namespace */
+
+InstrumentedCellProcessor::InstrumentedCellProcessor(CellProcessor* cellProcessor, bool countPairs) :
+		CellProcessor(cellProcessor->getCutoffRadius(), cellProcessor->getLJCutoffRadius()),
+		_cellProcessor(cellProcessor), _countPairs(countPairs), _timeObserver(nullptr),
+		_threadData(mardyn_get_max_threads()), _numTraversals(0) {
+}
+
+InstrumentedCellProcessor::~InstrumentedCellProcessor() {
+	delete _cellProcessor;
+}
+
+void InstrumentedCellProcessor::initTraversal() {
+	_cellProcessor->initTraversal();
+}
+
+void InstrumentedCellProcessor::preprocessCell(ParticleCell& cell) {
+	_cellProcessor->preprocessCell(cell);
+}
+
+void InstrumentedCellProcessor::processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll) {
+	const Clock::time_point start = Clock::now();
+	_cellProcessor->processCellPair(cell1, cell2, sumAll);
+	const double time = secondsSince(start);
+
+	ThreadData& threadData = _threadData[mardyn_get_thread_num()];
+
+	uint64_t pairs = 0;
+	uint64_t hits = 0;
+	// pairs of two halo cells are skipped by the cell processors, unless everything is summed up.
+	if (_countPairs and (sumAll or not (cell1.isHaloCell() and cell2.isHaloCell()))) {
+		countPairs(cell1, cell2, pairs, hits);
+	}
+	if (_timeObserver != nullptr) {
+		_timeObserver->observeCellPair(cell1, cell2, time);
+	}
+	for (ParticleCell* cell : {&cell1, &cell2}) {
+		CellCounters& counters = getCounters(threadData, cell->getCellIndex());
+		counters.pairs += pairs;
+		counters.hits += hits;
+		counters.time += 0.5 * time;
+	}
+	threadData.total.pairs += pairs;
+	threadData.total.hits += hits;
+	threadData.total.time += time;
+}
+
+void InstrumentedCellProcessor::processCell(ParticleCell& cell) {
+	const Clock::time_point start = Clock::now();
+	_cellProcessor->processCell(cell);
+	const double time = secondsSince(start);
+
+	ThreadData& threadData = _threadData[mardyn_get_thread_num()];
+
+	uint64_t pairs = 0;
+	uint64_t hits = 0;
+	if (_countPairs and not cell.isHaloCell()) {
+		countPairs(cell, pairs, hits);
+	}
+	if (_timeObserver != nullptr) {
+		_timeObserver->observeCell(cell, time);
+	}
+	CellCounters& counters = getCounters(threadData, cell.getCellIndex());
+	counters.pairs += pairs;
+	counters.hits += hits;
+	counters.time += time;
+	threadData.total.pairs += pairs;
+	threadData.total.hits += hits;
+	threadData.total.time += time;
+}
+
+double InstrumentedCellProcessor::processSingleMolecule(Molecule* m1, ParticleCell& cell2) {
+	return _cellProcessor->processSingleMolecule(m1, cell2);
+}
+
+bool InstrumentedCellProcessor::processTestMolecule(Molecule& testMolecule, const std::vector<ParticleCell*>& cells,
+		double& energy) {
+	return _cellProcessor->processTestMolecule(testMolecule, cells, energy);
+}
+
+bool InstrumentedCellProcessor::addPairObserver(PairObserver* observer) {
+	return _cellProcessor->addPairObserver(observer);
+}
+
+void InstrumentedCellProcessor::removePairObserver(PairObserver* observer) {
+	_cellProcessor->removePairObserver(observer);
+}
+
+void InstrumentedCellProcessor::postprocessCell(ParticleCell& cell) {
+	_cellProcessor->postprocessCell(cell);
+}
+
+void InstrumentedCellProcessor::endTraversal() {
+	_cellProcessor->endTraversal();
+	++_numTraversals;
+}
+
+InstrumentedCellProcessor::CellCounters InstrumentedCellProcessor::getCellCounters(unsigned long cellIndex) const {
+	CellCounters sum;
+	for (const ThreadData& threadData : _threadData) {
+		if (cellIndex < threadData.cells.size()) {
+			sum.pairs += threadData.cells[cellIndex].pairs;
+			sum.hits += threadData.cells[cellIndex].hits;
+			sum.time += threadData.cells[cellIndex].time;
+		}
+	}
+	return sum;
+}
+
+InstrumentedCellProcessor::CellCounters InstrumentedCellProcessor::getTotalCounters() const {
+	CellCounters sum;
+	for (const ThreadData& threadData : _threadData) {
+		sum.pairs += threadData.total.pairs;
+		sum.hits += threadData.total.hits;
+		sum.time += threadData.total.time;
+	}
+	return sum;
+}
+
+std::vector<double> InstrumentedCellProcessor::getThreadTimes() const {
+	std::vector<double> times;
+	for (const ThreadData& threadData : _threadData) {
+		times.push_back(threadData.total.time);
+	}
+	return times;
+}
+
+double InstrumentedCellProcessor::getThreadImbalance() const {
+	const std::vector<double> times = getThreadTimes();
+	const double sum = std::accumulate(times.begin(), times.end(), 0.);
+	if (sum == 0.) {
+		return 1.;
+	}
+	return *std::max_element(times.begin(), times.end()) * times.size() / sum;
+}
+
+void InstrumentedCellProcessor::reset() {
+	for (ThreadData& threadData : _threadData) {
+		std::fill(threadData.cells.begin(), threadData.cells.end(), CellCounters());
+		threadData.total = CellCounters();
+	}
+	_numTraversals = 0;
+}
+
+InstrumentedCellProcessor::CellCounters& InstrumentedCellProcessor::getCounters(ThreadData& threadData,
+		unsigned long cellIndex) {
+	// the number of cells changes with the container, so the thread local arrays grow on demand.
+	if (cellIndex >= threadData.cells.size()) {
+		threadData.cells.resize(cellIndex + 1);
+	}
+	return threadData.cells[cellIndex];
+}
+
+void InstrumentedCellProcessor::countPairs(ParticleCell& cell1, ParticleCell& cell2, uint64_t& pairs, uint64_t& hits) {
+	std::vector<std::array<double, 3>>& positions = _threadData[mardyn_get_thread_num()].positions;
+	positions.clear();
+	for (auto it = cell2.iterator(); it.isValid(); ++it) {
+		positions.push_back({it->r(0), it->r(1), it->r(2)});
+	}
+
+	for (auto it = cell1.iterator(); it.isValid(); ++it) {
+		const std::array<double, 3> r1 = {it->r(0), it->r(1), it->r(2)};
+		for (const std::array<double, 3>& r2 : positions) {
+			const double dx = r1[0] - r2[0];
+			const double dy = r1[1] - r2[1];
+			const double dz = r1[2] - r2[2];
+			hits += (dx * dx + dy * dy + dz * dz < _cutoffRadiusSquare) ? 1 : 0;
+		}
+		pairs += positions.size();
+	}
+}
+
+void InstrumentedCellProcessor::countPairs(ParticleCell& cell, uint64_t& pairs, uint64_t& hits) {
+	std::vector<std::array<double, 3>>& positions = _threadData[mardyn_get_thread_num()].positions;
+	positions.clear();
+	for (auto it = cell.iterator(); it.isValid(); ++it) {
+		positions.push_back({it->r(0), it->r(1), it->r(2)});
+	}
+
+	for (size_t i = 0; i < positions.size(); ++i) {
+		for (size_t j = i + 1; j < positions.size(); ++j) {
+			const double dx = positions[i][0] - positions[j][0];
+			const double dy = positions[i][1] - positions[j][1];
+			const double dz = positions[i][2] - positions[j][2];
+			hits += (dx * dx + dy * dy + dz * dz < _cutoffRadiusSquare) ? 1 : 0;
+		}
+		pairs += positions.size() - i - 1;
+	}
+}
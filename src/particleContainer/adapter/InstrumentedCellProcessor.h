@@ -0,0 +1,121 @@
+/**
+ * @file InstrumentedCellProcessor.h
+ */
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "CellProcessor.h"
+
+/**
+ * Gets the time of every call of the cell processor wrapped by an InstrumentedCellProcessor, see
+ * InstrumentedCellProcessor::setTimeObserver(). The methods are called by all threads concurrently.
+ */
+class CellTimeObserver {
+public:
+	virtual ~CellTimeObserver() = default;
+
+	virtual void observeCell(ParticleCell& cell, double time) = 0;
+
+	virtual void observeCellPair(ParticleCell& cell1, ParticleCell& cell2, double time) = 0;
+};
+
+/**
+ * Opt-in instrumentation of the force traversal (command line option --cell-instrumentation).
+ *
+ * Wraps the cell processor of the simulation and records per cell and per thread
+ * - the number of molecule pairs, for which the distance is checked,
+ * - the number of these pairs within the cutoff radius,
+ * - the time spent in the wrapped cell processor.
+ * The work of a cell pair is accounted to both cells: both get the pair counts and half of the time. The distances
+ * are checked once more on the molecule centers, so the hit rate is that of the center cutoff of the
+ * VectorizedCellProcessor. This doubles the distance computations and should be used for analysis runs only.
+ *
+ * The counters are accumulated over all traversals until reset() is called, e.g. by the VTKGridWriter after it has
+ * written them out. The totals of every thread are kept as well to quantify the load imbalance of the
+ * traversal.
+ */
+class InstrumentedCellProcessor : public CellProcessor {
+public:
+	struct CellCounters {
+		uint64_t pairs = 0;
+		uint64_t hits = 0;
+		double time = 0.;  //!< seconds
+	};
+
+	/**
+	 * @param cellProcessor the instrumented cell processor, deleted by the destructor
+	 * @param countPairs if false, only the times are recorded and the pair counters stay zero
+	 */
+	explicit InstrumentedCellProcessor(CellProcessor* cellProcessor, bool countPairs = true);
+
+	~InstrumentedCellProcessor() override;
+
+	void initTraversal() override;
+	void preprocessCell(ParticleCell& cell) override;
+	void processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll = false) override;
+	void processCell(ParticleCell& cell) override;
+	double processSingleMolecule(Molecule* m1, ParticleCell& cell2) override;
+	bool processTestMolecule(Molecule& testMolecule, const std::vector<ParticleCell*>& cells, double& energy) override;
+	bool addPairObserver(PairObserver* observer) override;
+	void removePairObserver(PairObserver* observer) override;
+	void postprocessCell(ParticleCell& cell) override;
+	void endTraversal() override;
+
+	CellProcessor* getInstrumentedCellProcessor() const { return _cellProcessor; }
+
+	//! @return false if only the times are recorded, e.g. for a load model instead of the user
+	bool isCountingPairs() const { return _countPairs; }
+
+	/**
+	 * Passes the time of every following call of the wrapped cell processor to observer, until it is reset to nullptr.
+	 * Must not be called during a traversal.
+	 */
+	void setTimeObserver(CellTimeObserver* observer) { _timeObserver = observer; }
+
+	/**
+	 * Counters of the cell with the given index in the particle container, summed over all threads.
+	 */
+	CellCounters getCellCounters(unsigned long cellIndex) const;
+
+	/**
+	 * Counters of all cells, summed over all threads. Every pair is counted once.
+	 */
+	CellCounters getTotalCounters() const;
+
+	/**
+	 * Time every thread spent in the wrapped cell processor since the last reset.
+	 */
+	std::vector<double> getThreadTimes() const;
+
+	/**
+	 * Maximal thread time divided by the mean thread time, 1 for a perfectly balanced traversal.
+	 */
+	double getThreadImbalance() const;
+
+	unsigned long getNumTraversals() const { return _numTraversals; }
+
+	void reset();
+
+private:
+	// aligned to avoid false sharing of the thread times
+	struct alignas(64) ThreadData {
+		std::vector<CellCounters> cells;
+		CellCounters total;
+		std::vector<std::array<double, 3>> positions;  //!< scratch buffer for the distance checks
+	};
+
+	CellCounters& getCounters(ThreadData& threadData, unsigned long cellIndex);
+
+	void countPairs(ParticleCell& cell1, ParticleCell& cell2, uint64_t& pairs, uint64_t& hits);
+	void countPairs(ParticleCell& cell, uint64_t& pairs, uint64_t& hits);
+
+	CellProcessor* const _cellProcessor;
+	const bool _countPairs;
+	CellTimeObserver* _timeObserver;
+	std::vector<ThreadData> _threadData;
+	unsigned long _numTraversals;
+};
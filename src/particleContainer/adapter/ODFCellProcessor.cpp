@@ -84,6 +84,13 @@ double ODFCellProcessor::processSingleMolecule(Molecule *m1, ParticleCell &cell2
 void ODFCellProcessor::postprocessCell(ParticleCell &cell) {}
 void ODFCellProcessor::endTraversal() {}
 
+void ODFCellProcessor::observePair(Molecule &molecule1, Molecule &molecule2, double /*dd*/) {
+	if (molecule1.numDipoles() != 1 or molecule2.numDipoles() != 1) {
+		return;
+	}
+	_odf->calculateOrientation(_simBoxSize, molecule1, molecule2, calcOrientationVector(molecule1));
+}
+
 std::array<double, 3> ODFCellProcessor::calcOrientationVector(const Molecule &molecule) {
 	std::array<double, 4> q1{molecule.q().qw(), molecule.q().qx(), molecule.q().qy(), molecule.q().qz()};
 	std::array<double, 3> orientationVector = {2 * (q1[1] * q1[3] + q1[0] * q1[2]), 2 * (q1[2] * q1[3] - q1[0] * q1[1]),
@@ -10,12 +10,14 @@ class ODF;
 
 #include <array>
 #include "CellProcessor.h"
+#include "PairObserver.h"
 
 /**
  * Class to calculate an orientation distribution function.
- * It calculates the distribution of relative orientations of particles using the ODF class.
+ * It calculates the distribution of relative orientations of particles using the ODF class,
+ * either in a traversal of its own or as observer of the force calculation.
  */
-class ODFCellProcessor : public CellProcessor {
+class ODFCellProcessor : public CellProcessor, public PairObserver {
 
  public:
   ODFCellProcessor(double cutoffRadius,
@@ -30,6 +32,8 @@ class ODFCellProcessor : public CellProcessor {
   void postprocessCell(ParticleCell &cell) override;
   void endTraversal() override;
 
+  void observePair(Molecule &molecule1, Molecule &molecule2, double dd) override;
+
  private:
 
   std::array<double, 3> calcOrientationVector(const Molecule & molecule);
@@ -0,0 +1,57 @@
+/**
+ * @file PairObserver.h
+ */
+
+#pragma once
+
+#include "molecules/MoleculeForwardDeclaration.h"
+
+/**
+ * Interface for the sampling of molecule pairs (e.g. RDF, ODF) during the force calculation.
+ *
+ * An observer is registered at the cell processor of the simulation (CellProcessor::addPairObserver()). While the
+ * observer is observing, the cell processor passes every molecule pair within its cutoff radius to observePair(),
+ * once per pair, following the same rules as for the macroscopic values (pairs with halo molecules are counted on
+ * one side only). A second traversal of all cell pairs is thus not needed.
+ *
+ * observePair() is called concurrently by all threads of the traversal, so the observer has to accumulate in a thread
+ * safe way, e.g. in thread local histograms.
+ */
+class PairObserver {
+public:
+	PairObserver() : _observing(false), _observedTraversal(false) {}
+
+	virtual ~PairObserver() {}
+
+	/**
+	 * @param dd squared distance of the molecules
+	 */
+	virtual void observePair(Molecule& molecule1, Molecule& molecule2, double dd) = 0;
+
+	/**
+	 * Enables the observation for the following traversals, e.g. in the sampling steps, and resets
+	 * hasObservedTraversal().
+	 */
+	void setObserving(bool observing) {
+		_observing = observing;
+		_observedTraversal = false;
+	}
+
+	bool isObserving() const { return _observing; }
+
+	/**
+	 * Called by the cell processor at the end of a traversal, in which the observer was observing.
+	 */
+	void setObservedTraversal() { _observedTraversal = true; }
+
+	/**
+	 * Whether the pairs of a traversal have been passed to the observer since the last call of setObserving(). If not
+	 * (e.g. the cell processor or the particle container do not support observers), the observer has to traverse the
+	 * pairs on its own.
+	 */
+	bool hasObservedTraversal() const { return _observedTraversal; }
+
+private:
+	bool _observing;
+	bool _observedTraversal;
+};
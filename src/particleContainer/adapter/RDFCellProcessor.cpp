@@ -32,14 +32,7 @@ void RDFCellProcessor::processCell(ParticleCell& cell) {
 				double dd = molecule2.dist2(molecule1, dummy);
 
 				if (dd < _cutoffRadiusSquare) {
-					_rdf->observeRDF(molecule1, molecule2, dd);
-					if (_rdf->doARDF()) {
-						double dummy2[3], dummy3[3];
-						double cosPhi = molecule1.orientationAngle(molecule2, dummy2, dd);
-						double cosPhiReverse = molecule2.orientationAngle(molecule1, dummy3, dd);
-						_rdf->observeARDFMolecule(dd, cosPhi, cosPhiReverse, molecule1.componentid(), molecule2.componentid());
-						
-					}
+					observePair(molecule1, molecule2, dd);
 				}
 			}
 		}
@@ -61,14 +54,7 @@ void RDFCellProcessor::processCellPair(ParticleCell& cell1, ParticleCell& cell2,
 				double dummy[3];
 				double dd = molecule2.dist2(molecule1, dummy);
 				if (dd < _cutoffRadiusSquare) {
-                    _rdf->observeRDF(molecule1, molecule2, dd);
-					if (_rdf->doARDF()) {
-						double dummy2[3], dummy3[3];
-						double cosPhi = molecule1.orientationAngle(molecule2, dummy2, dd);
-						double cosPhiReverse = molecule2.orientationAngle(molecule1, dummy3, dd);
-						_rdf->observeARDFMolecule(dd, cosPhi, cosPhiReverse, molecule1.componentid(), molecule2.componentid());
-						
-					}
+					observePair(molecule1, molecule2, dd);
 				}
 			}
 
@@ -87,14 +73,7 @@ void RDFCellProcessor::processCellPair(ParticleCell& cell1, ParticleCell& cell2,
 					double dummy[3];
 					double dd = molecule2.dist2(molecule1, dummy);
 					if (dd < _cutoffRadiusSquare) {
-	                    _rdf->observeRDF(molecule1, molecule2, dd);
-						if (_rdf->doARDF()) {
-							double dummy2[3], dummy3[3];
-							double cosPhi = molecule1.orientationAngle(molecule2, dummy2, dd);
-							double cosPhiReverse = molecule2.orientationAngle(molecule1, dummy3, dd);
-							_rdf->observeARDFMolecule(dd, cosPhi, cosPhiReverse, molecule1.componentid(), molecule2.componentid());
-						
-						}
+						observePair(molecule1, molecule2, dd);
 					}
 				}
 
@@ -117,17 +96,20 @@ void RDFCellProcessor::processCellPair(ParticleCell& cell1, ParticleCell& cell2,
 					double dd = molecule2.dist2(molecule1, dummy);
 
 					if (dd < _cutoffRadiusSquare) {
-	                    _rdf->observeRDF(molecule1, molecule2, dd);
-						if (_rdf->doARDF()) {
-							double dummy2[3], dummy3[3];
-							double cosPhi = molecule1.orientationAngle(molecule2, dummy2, dd);
-							double cosPhiReverse = molecule2.orientationAngle(molecule1, dummy3, dd);
-							_rdf->observeARDFMolecule(dd, cosPhi, cosPhiReverse, molecule1.componentid(), molecule2.componentid());
-						
-						}
+						observePair(molecule1, molecule2, dd);
 					}
 				}
 			}
 		} // isBoundaryCell
 	}
 }
+
+void RDFCellProcessor::observePair(Molecule& molecule1, Molecule& molecule2, double dd) {
+	_rdf->observeRDF(molecule1, molecule2, dd);
+	if (_rdf->doARDF()) {
+		double dummy2[3], dummy3[3];
+		double cosPhi = molecule1.orientationAngle(molecule2, dummy2, dd);
+		double cosPhiReverse = molecule2.orientationAngle(molecule1, dummy3, dd);
+		_rdf->observeARDFMolecule(dd, cosPhi, cosPhiReverse, molecule1.componentid(), molecule2.componentid());
+	}
+}
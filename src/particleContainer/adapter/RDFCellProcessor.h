@@ -9,11 +9,15 @@
 #define RDFCELLPROCESSOR_H_
 
 #include "particleContainer/adapter/CellProcessor.h"
+#include "particleContainer/adapter/PairObserver.h"
 #include "particleContainer/ParticleCellForwardDeclaration.h"
 
 class RDF;
 
-class RDFCellProcessor : public CellProcessor {
+/**
+ * Counts the molecule pairs for the RDF, either in a traversal of its own or as observer of the force calculation.
+ */
+class RDFCellProcessor : public CellProcessor, public PairObserver {
 
 private:
 	RDF* const _rdf;
@@ -40,6 +44,8 @@ public:
 	void postprocessCell(ParticleCell& /*cell*/) {}
 
 	void endTraversal() {}
+
+	void observePair(Molecule& molecule1, Molecule& molecule2, double dd) override;
 };
 
 #endif /* RDFCELLPROCESSOR_H_ */
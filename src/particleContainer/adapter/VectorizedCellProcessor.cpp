@@ -14,10 +14,13 @@
 #include "Simulation.h"
 #include <algorithm>
 #include "vectorization/MaskGatherChooser.h"
+#include "PairObserver.h"
 
 using namespace Log;
 using namespace std;
 
+VCP_ISA_TARGET_BEGIN
+
 VectorizedCellProcessor::VectorizedCellProcessor(Domain & domain, double cutoffRadius, double LJcutoffRadius) :
 		CellProcessor(cutoffRadius, LJcutoffRadius), _domain(domain),
 		// maybe move the following to somewhere else:
@@ -154,21 +157,24 @@ void VectorizedCellProcessor::endTraversal() {
 	_myRF = glob_myRF;
 	_domain.setLocalVirial(_virial + 3.0 * _myRF);
 	_domain.setLocalUpot(_upot6lj / 6.0 + _upotXpoles + _myRF);
+
+	for (PairObserver* observer : _pairObservers) {
+		if (observer->isObserving()) {
+			observer->setObservedTraversal();
+		}
+	}
 }
 
-	//const DoubleVec minus_one = DoubleVec::set1(-1.0); //currently not used, would produce warning
-	const RealCalcVec zero = RealCalcVec::zero();
-	const RealCalcVec one = RealCalcVec::set1(1.0);
-	const RealCalcVec two = RealCalcVec::set1(2.0);
-	const RealCalcVec three = RealCalcVec::set1(3.0);
-	const RealCalcVec four = RealCalcVec::set1(4.0);
-	const RealCalcVec five = RealCalcVec::set1(5.0);
-	const RealCalcVec six = RealCalcVec::set1(6.0);
-	const RealCalcVec ten = RealCalcVec::set1(10.0);
-	const RealCalcVec _05 = RealCalcVec::set1(0.5);
-	const RealCalcVec _075 = RealCalcVec::set1(0.75);
-	const RealCalcVec _1pt5 = RealCalcVec::set1(1.5);
-	const RealCalcVec _15 = RealCalcVec::set1(15.0);
+bool VectorizedCellProcessor::addPairObserver(PairObserver* observer) {
+	if (std::find(_pairObservers.begin(), _pairObservers.end(), observer) == _pairObservers.end()) {
+		_pairObservers.push_back(observer);
+	}
+	return true;
+}
+
+void VectorizedCellProcessor::removePairObserver(PairObserver* observer) {
+	_pairObservers.erase(std::remove(_pairObservers.begin(), _pairObservers.end(), observer), _pairObservers.end());
+}
 
 	template<bool calculateMacroscopic>
 	vcp_inline void VectorizedCellProcessor :: _loopBodyLJ(
@@ -293,6 +299,8 @@ void VectorizedCellProcessor::endTraversal() {
 			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
 			const MaskCalcVec& forceMask)
 	{
+		const RealCalcVec three = RealCalcVec::set1(3.0);
+
 		const RealCalcVec dx = r1_x - r2_x;
 		const RealCalcVec dy = r1_y - r2_y;
 		const RealCalcVec dz = r1_z - r2_z;
@@ -366,6 +374,9 @@ void VectorizedCellProcessor::endTraversal() {
 			const MaskCalcVec& forceMask,
 			const RealCalcVec& epsRFInvrc3)
 	{
+		const RealCalcVec three = RealCalcVec::set1(3.0);
+		const RealCalcVec five = RealCalcVec::set1(5.0);
+
 		const RealCalcVec dx = r1_x - r2_x;
 		const RealCalcVec dy = r1_y - r2_y;
 		const RealCalcVec dz = r1_z - r2_z;
@@ -457,6 +468,10 @@ void VectorizedCellProcessor::endTraversal() {
 			RealAccumVec& M_x, RealAccumVec& M_y, RealAccumVec& M_z,
 			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
 			const MaskCalcVec& forceMask) {
+		const RealCalcVec one = RealCalcVec::set1(1.0);
+		const RealCalcVec three = RealCalcVec::set1(3.0);
+		const RealCalcVec six = RealCalcVec::set1(6.0);
+		const RealCalcVec _05 = RealCalcVec::set1(0.5);
 
 		const RealCalcVec c_dx = r1_x - r2_x;
 		const RealCalcVec c_dy = r1_y - r2_y;
@@ -541,6 +556,11 @@ void VectorizedCellProcessor::endTraversal() {
 			RealAccumVec& M2_x, RealAccumVec& M2_y, RealAccumVec& M2_z,
 			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
 			const MaskCalcVec& forceMask) {
+		const RealCalcVec one = RealCalcVec::set1(1.0);
+		const RealCalcVec two = RealCalcVec::set1(2.0);
+		const RealCalcVec four = RealCalcVec::set1(4.0);
+		const RealCalcVec five = RealCalcVec::set1(5.0);
+		const RealCalcVec _1pt5 = RealCalcVec::set1(1.5);
 
 
 		const RealCalcVec c_dx = r1_x - r2_x;
@@ -666,6 +686,15 @@ void VectorizedCellProcessor::endTraversal() {
 			RealAccumVec& sum_upotXpoles, RealAccumVec& sum_virial,
 			const MaskCalcVec& forceMask)
 	{
+		const RealCalcVec one = RealCalcVec::set1(1.0);
+		const RealCalcVec two = RealCalcVec::set1(2.0);
+		const RealCalcVec three = RealCalcVec::set1(3.0);
+		const RealCalcVec four = RealCalcVec::set1(4.0);
+		const RealCalcVec five = RealCalcVec::set1(5.0);
+		const RealCalcVec ten = RealCalcVec::set1(10.0);
+		const RealCalcVec _075 = RealCalcVec::set1(0.75);
+		const RealCalcVec _15 = RealCalcVec::set1(15.0);
+
 		const RealCalcVec c_dx = r1_x - r2_x;
 		const RealCalcVec c_dy = r1_y - r2_y;
 		const RealCalcVec c_dz = r1_z - r2_z;
@@ -794,7 +823,7 @@ void VectorizedCellProcessor::endTraversal() {
 	}
 
 template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
-void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2) {
+void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2, CellDataSoA & soa2Accum) {
 	const int tid = mardyn_get_thread_num();
 	VLJCPThreadData &my_threadData = *_threadData[tid];
 
@@ -802,7 +831,7 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 	soa2.initDistLookupPointers(my_threadData._centers_dist_lookup,
 			my_threadData._ljc_dist_lookup, my_threadData._charges_dist_lookup,
 			my_threadData._dipoles_dist_lookup,
-			my_threadData._quadrupoles_dist_lookup);
+			my_threadData._quadrupoles_dist_lookup, VCP_INDICES_PER_LOOKUP_SINGLE);
 
 	// Pointer for molecules
 	const vcp_real_calc * const soa1_mol_pos_x = soa1._mol_pos.xBegin();
@@ -834,12 +863,12 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 	const vcp_real_calc * const soa2_ljc_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::X);
 	const vcp_real_calc * const soa2_ljc_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Y);
 	const vcp_real_calc * const soa2_ljc_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::LJC, Coordinate::Z);
-		 vcp_real_accum * const soa2_ljc_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
-		 vcp_real_accum * const soa2_ljc_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
-		 vcp_real_accum * const soa2_ljc_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
-		 vcp_real_accum * const soa2_ljc_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
-		 vcp_real_accum * const soa2_ljc_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
-		 vcp_real_accum * const soa2_ljc_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa2_ljc_f_x = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa2_ljc_f_y = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa2_ljc_f_z = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::LJC, Coordinate::Z);
+		 vcp_real_accum * const soa2_ljc_V_x = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::X);
+		 vcp_real_accum * const soa2_ljc_V_y = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Y);
+		 vcp_real_accum * const soa2_ljc_V_z = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::LJC, Coordinate::Z);
 	const vcp_ljc_id_t * const soa2_ljc_id = soa2._ljc_id;
 
 	vcp_lookupOrMask_single* const soa2_ljc_dist_lookup = my_threadData._ljc_dist_lookup;
@@ -863,12 +892,12 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 	const vcp_real_calc * const soa2_charges_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::X);
 	const vcp_real_calc * const soa2_charges_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::Y);
 	const vcp_real_calc * const soa2_charges_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::CHARGE, Coordinate::Z);
-		 vcp_real_accum * const soa2_charges_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::X);
-		 vcp_real_accum * const soa2_charges_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Y);
-		 vcp_real_accum * const soa2_charges_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Z);
-		 vcp_real_accum * const soa2_charges_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::X);
-		 vcp_real_accum * const soa2_charges_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Y);
-		 vcp_real_accum * const soa2_charges_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Z);
+		 vcp_real_accum * const soa2_charges_f_x = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::X);
+		 vcp_real_accum * const soa2_charges_f_y = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Y);
+		 vcp_real_accum * const soa2_charges_f_z = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::CHARGE, Coordinate::Z);
+		 vcp_real_accum * const soa2_charges_V_x = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::X);
+		 vcp_real_accum * const soa2_charges_V_y = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Y);
+		 vcp_real_accum * const soa2_charges_V_z = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::CHARGE, Coordinate::Z);
 	const vcp_real_calc * const soa2_charges_q = soa2._charges_q;
 
 	vcp_lookupOrMask_single* const soa2_charges_dist_lookup = my_threadData._charges_dist_lookup;
@@ -898,19 +927,19 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 	const vcp_real_calc * const soa2_dipoles_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::X);
 	const vcp_real_calc * const soa2_dipoles_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::Y);
 	const vcp_real_calc * const soa2_dipoles_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::DIPOLE, Coordinate::Z);
-		 vcp_real_accum * const soa2_dipoles_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::X);
-		 vcp_real_accum * const soa2_dipoles_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Y);
-		 vcp_real_accum * const soa2_dipoles_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Z);
-		 vcp_real_accum * const soa2_dipoles_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::X);
-		 vcp_real_accum * const soa2_dipoles_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Y);
-		 vcp_real_accum * const soa2_dipoles_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_dipoles_f_x = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_dipoles_f_y = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_dipoles_f_z = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::DIPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_dipoles_V_x = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_dipoles_V_y = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_dipoles_V_z = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::DIPOLE, Coordinate::Z);
 	const vcp_real_calc * const soa2_dipoles_p = soa2._dipoles_p;
 	const vcp_real_calc * const soa2_dipoles_e_x = soa2._dipoles_e.xBegin();
 	const vcp_real_calc * const soa2_dipoles_e_y = soa2._dipoles_e.yBegin();
 	const vcp_real_calc * const soa2_dipoles_e_z = soa2._dipoles_e.zBegin();
-	vcp_real_accum * const soa2_dipoles_M_x = soa2._dipoles_M.xBegin();
-	vcp_real_accum * const soa2_dipoles_M_y = soa2._dipoles_M.yBegin();
-	vcp_real_accum * const soa2_dipoles_M_z = soa2._dipoles_M.zBegin();
+	vcp_real_accum * const soa2_dipoles_M_x = soa2Accum._dipoles_M.xBegin();
+	vcp_real_accum * const soa2_dipoles_M_y = soa2Accum._dipoles_M.yBegin();
+	vcp_real_accum * const soa2_dipoles_M_z = soa2Accum._dipoles_M.zBegin();
 
 	vcp_lookupOrMask_single* const soa2_dipoles_dist_lookup = my_threadData._dipoles_dist_lookup;
 
@@ -940,19 +969,19 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 	const vcp_real_calc * const soa2_quadrupoles_r_x = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::X);
 	const vcp_real_calc * const soa2_quadrupoles_r_y = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::Y);
 	const vcp_real_calc * const soa2_quadrupoles_r_z = soa2.getBeginCalc(QuantityType::CENTER_POSITION, SiteType::QUADRUPOLE, Coordinate::Z);
-		 vcp_real_accum * const soa2_quadrupoles_f_x = soa2.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::X);
-		 vcp_real_accum * const soa2_quadrupoles_f_y = soa2.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Y);
-		 vcp_real_accum * const soa2_quadrupoles_f_z = soa2.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Z);
-		 vcp_real_accum * const soa2_quadrupoles_V_x = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::X);
-		 vcp_real_accum * const soa2_quadrupoles_V_y = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Y);
-		 vcp_real_accum * const soa2_quadrupoles_V_z = soa2.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_quadrupoles_f_x = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_quadrupoles_f_y = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_quadrupoles_f_z = soa2Accum.getBeginAccum(QuantityType::FORCE, SiteType::QUADRUPOLE, Coordinate::Z);
+		 vcp_real_accum * const soa2_quadrupoles_V_x = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::X);
+		 vcp_real_accum * const soa2_quadrupoles_V_y = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Y);
+		 vcp_real_accum * const soa2_quadrupoles_V_z = soa2Accum.getBeginAccum(QuantityType::VIRIAL, SiteType::QUADRUPOLE, Coordinate::Z);
 	const vcp_real_calc * const soa2_quadrupoles_m = soa2._quadrupoles_m;
 	const vcp_real_calc * const soa2_quadrupoles_e_x = soa2._quadrupoles_e.xBegin();
 	const vcp_real_calc * const soa2_quadrupoles_e_y = soa2._quadrupoles_e.yBegin();
 	const vcp_real_calc * const soa2_quadrupoles_e_z = soa2._quadrupoles_e.zBegin();
-	     vcp_real_accum * const soa2_quadrupoles_M_x = soa2._quadrupoles_M.xBegin();
-	     vcp_real_accum * const soa2_quadrupoles_M_y = soa2._quadrupoles_M.yBegin();
-	     vcp_real_accum * const soa2_quadrupoles_M_z = soa2._quadrupoles_M.zBegin();
+	     vcp_real_accum * const soa2_quadrupoles_M_x = soa2Accum._quadrupoles_M.xBegin();
+	     vcp_real_accum * const soa2_quadrupoles_M_y = soa2Accum._quadrupoles_M.yBegin();
+	     vcp_real_accum * const soa2_quadrupoles_M_z = soa2Accum._quadrupoles_M.zBegin();
 
 	vcp_lookupOrMask_single* const soa2_quadrupoles_dist_lookup = my_threadData._quadrupoles_dist_lookup;
 
@@ -1003,25 +1032,33 @@ void VectorizedCellProcessor::_calculatePairs(CellDataSoA & soa1, CellDataSoA &
 	//	printf("less than 8\n");
 	//}
 
+	const vcp_real_calc pruneRadiusSquare = getPruneRadiusSquare();
+
 	// Iterate over each center in the first cell.
 	const size_t soa1_mol_num = soa1.getMolNum();
 	for (size_t i = 0; i < soa1_mol_num; ++i) {//over the molecules
 		const RealCalcVec m1_r_x = RealCalcVec::broadcast(soa1_mol_pos_x + i);
 		const RealCalcVec m1_r_y = RealCalcVec::broadcast(soa1_mol_pos_y + i);
 		const RealCalcVec m1_r_z = RealCalcVec::broadcast(soa1_mol_pos_z + i);
+
+		// molecules further away from the bounding box of the second cell than the cutoff do not interact with it,
+		// so the distance lookups over all centers of the second cell can be skipped.
+		const bool m1_in_range = soa2.moleculeBoundingBoxDistanceSquare(soa1_mol_pos_x[i], soa1_mol_pos_y[i],
+				soa1_mol_pos_z[i]) <= pruneRadiusSquare;
+
 		// Iterate over centers of second cell
-		const countertype32 compute_molecule_ljc = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_ljc_idx, soa2._ljc_num,
+		const countertype32 compute_molecule_ljc = m1_in_range ? calcDistLookup<ForcePolicy, MaskGatherChooser>(i_ljc_idx, soa2._ljc_num,
 				soa2_ljc_dist_lookup, soa2_ljc_m_r_x, soa2_ljc_m_r_y, soa2_ljc_m_r_z,
-				ljrc2, end_ljc_j, m1_r_x, m1_r_y, m1_r_z);
-		const countertype32 compute_molecule_charges = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_charge_idx, soa2._charges_num,
+				ljrc2, end_ljc_j, m1_r_x, m1_r_y, m1_r_z) : 0;
+		const countertype32 compute_molecule_charges = m1_in_range ? calcDistLookup<ForcePolicy, MaskGatherChooser>(i_charge_idx, soa2._charges_num,
 				soa2_charges_dist_lookup, soa2_charges_m_r_x, soa2_charges_m_r_y, soa2_charges_m_r_z,
-				cutoffRadiusSquare,	end_charges_j, m1_r_x, m1_r_y, m1_r_z);
-		const countertype32 compute_molecule_dipoles = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_dipole_idx, soa2._dipoles_num,
+				cutoffRadiusSquare,	end_charges_j, m1_r_x, m1_r_y, m1_r_z) : 0;
+		const countertype32 compute_molecule_dipoles = m1_in_range ? calcDistLookup<ForcePolicy, MaskGatherChooser>(i_dipole_idx, soa2._dipoles_num,
 				soa2_dipoles_dist_lookup, soa2_dipoles_m_r_x, soa2_dipoles_m_r_y, soa2_dipoles_m_r_z,
-				cutoffRadiusSquare,	end_dipoles_j, m1_r_x, m1_r_y, m1_r_z);
-		const countertype32 compute_molecule_quadrupoles = calcDistLookup<ForcePolicy, MaskGatherChooser>(i_quadrupole_idx, soa2._quadrupoles_num,
+				cutoffRadiusSquare,	end_dipoles_j, m1_r_x, m1_r_y, m1_r_z) : 0;
+		const countertype32 compute_molecule_quadrupoles = m1_in_range ? calcDistLookup<ForcePolicy, MaskGatherChooser>(i_quadrupole_idx, soa2._quadrupoles_num,
 				soa2_quadrupoles_dist_lookup, soa2_quadrupoles_m_r_x, soa2_quadrupoles_m_r_y, soa2_quadrupoles_m_r_z,
-				cutoffRadiusSquare, end_quadrupoles_j, m1_r_x, m1_r_y, m1_r_z);
+				cutoffRadiusSquare, end_quadrupoles_j, m1_r_x, m1_r_y, m1_r_z) : 0;
 
 		size_t end_ljc_loop = MaskGatherChooser::getEndloop(end_ljc_j_longloop, compute_molecule_ljc);
 		size_t end_charges_loop = MaskGatherChooser::getEndloop(end_charges_j_longloop, compute_molecule_charges);
@@ -2740,7 +2777,11 @@ void VectorizedCellProcessor::processCell(ParticleCell & c) {
 	}
 	const bool CalculateMacroscopic = true;
 	const bool ApplyCutoff = true;
-	_calculatePairs<SingleCellPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa, soa);
+	_calculatePairs<SingleCellPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa, soa, soa);
+
+	if (not _pairObservers.empty()) {
+		observePairs(full_c, full_c);
+	}
 }
 
 void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell & c2, bool sumAll) {
@@ -2756,6 +2797,11 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 		return;
 	}
 
+	// if all molecules of the two cells are further apart than the cutoff, skip
+	if (soa1.moleculeBoundingBoxDistanceSquare(soa2) > getPruneRadiusSquare()) {
+		return;
+	}
+
 	const bool c1Halo = full_c1.isHaloCell();
 	const bool c2Halo = full_c2.isHaloCell();
 
@@ -2774,9 +2820,13 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 		const bool CalculateMacroscopic = true;
 
 		if (calc_soa1_soa2) {
-			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2, soa2);
 		} else {
-			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+			_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1, soa1);
+		}
+
+		if (not _pairObservers.empty()) {
+			observePairs(full_c1, full_c2);
 		}
 	} else {
 		// if one cell is empty, or both cells are Halo, skip
@@ -2800,9 +2850,13 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 			const bool CalculateMacroscopic = true;
 
 			if (calc_soa1_soa2) {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2, soa2);
 			} else {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1, soa1);
+			}
+
+			if (not _pairObservers.empty()) {
+				observePairs(full_c1, full_c2);
 			}
 
 		} else {
@@ -2812,11 +2866,144 @@ void VectorizedCellProcessor::processCellPair(ParticleCell & c1, ParticleCell &
 			const bool CalculateMacroscopic = false;
 
 			if (calc_soa1_soa2) {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2);
+				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2, soa2);
 			} else {
-				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1);
+				_calculatePairs<CellPairPolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa2, soa1, soa1);
 			}
 		}
 	}
 }
 
+
+
+void VectorizedCellProcessor::observePairs(FullParticleCell& cell1, FullParticleCell& cell2) {
+	VLJCPThreadData &my_threadData = *_threadData[mardyn_get_thread_num()];
+
+	std::vector<PairObserver*>& observers = my_threadData._activeObservers;
+	observers.clear();
+	for (PairObserver* observer : _pairObservers) {
+		if (observer->isObserving()) {
+			observers.push_back(observer);
+		}
+	}
+	if (observers.empty()) {
+		return;
+	}
+
+	// the molecules of a cell are stored in the same order as in its SoA.
+	const bool sameCell = &cell1 == &cell2;
+	std::vector<Molecule*>& molecules1 = my_threadData._observedMolecules1;
+	std::vector<Molecule*>& molecules2 = sameCell ? molecules1 : my_threadData._observedMolecules2;
+	molecules1.clear();
+	for (auto it = cell1.iterator(); it.isValid(); ++it) {
+		molecules1.push_back(&(*it));
+	}
+	if (not sameCell) {
+		molecules2.clear();
+		for (auto it = cell2.iterator(); it.isValid(); ++it) {
+			molecules2.push_back(&(*it));
+		}
+	}
+
+	CellDataSoA& soa1 = cell1.getCellDataSoA();
+	CellDataSoA& soa2 = cell2.getCellDataSoA();
+	const vcp_real_calc * const soa1_mol_pos_x = soa1._mol_pos.xBegin();
+	const vcp_real_calc * const soa1_mol_pos_y = soa1._mol_pos.yBegin();
+	const vcp_real_calc * const soa1_mol_pos_z = soa1._mol_pos.zBegin();
+	const vcp_real_calc * const soa2_mol_pos_x = soa2._mol_pos.xBegin();
+	const vcp_real_calc * const soa2_mol_pos_y = soa2._mol_pos.yBegin();
+	const vcp_real_calc * const soa2_mol_pos_z = soa2._mol_pos.zBegin();
+	const size_t soa1_mol_num = soa1.getMolNum();
+	const size_t soa2_mol_num = soa2.getMolNum();
+	mardyn_assert(molecules1.size() == soa1_mol_num and molecules2.size() == soa2_mol_num);
+
+	// slightly enlarged, so that rounding differences can not drop a pair within the cutoff.
+	const vcp_real_calc candidateRadiusSquare = static_cast<vcp_real_calc>(_cutoffRadiusSquare * (1. + 1e-5));
+	std::vector<vcp_real_calc>& dist2 = my_threadData._observedDist2;
+	dist2.resize(soa2_mol_num);
+
+	for (size_t i = 0; i < soa1_mol_num; ++i) {
+		const vcp_real_calc m1_r_x = soa1_mol_pos_x[i];
+		const vcp_real_calc m1_r_y = soa1_mol_pos_y[i];
+		const vcp_real_calc m1_r_z = soa1_mol_pos_z[i];
+		const size_t begin_j = sameCell ? i + 1 : 0;
+
+		#if defined(_OPENMP)
+		#pragma omp simd
+		#endif
+		for (size_t j = begin_j; j < soa2_mol_num; ++j) {
+			const vcp_real_calc dx = m1_r_x - soa2_mol_pos_x[j];
+			const vcp_real_calc dy = m1_r_y - soa2_mol_pos_y[j];
+			const vcp_real_calc dz = m1_r_z - soa2_mol_pos_z[j];
+			dist2[j] = dx * dx + dy * dy + dz * dz;
+		}
+
+		for (size_t j = begin_j; j < soa2_mol_num; ++j) {
+			if (dist2[j] >= candidateRadiusSquare) {
+				continue;
+			}
+			double distanceVector[3];
+			const double dd = molecules2[j]->dist2(*molecules1[i], distanceVector);
+			if (dd < _cutoffRadiusSquare) {
+				for (PairObserver* observer : observers) {
+					observer->observePair(*molecules1[i], *molecules2[j], dd);
+				}
+			}
+		}
+	}
+}
+
+bool VectorizedCellProcessor::processTestMolecule(Molecule& testMolecule, const std::vector<ParticleCell*>& cells,
+		double& energy) {
+	const int tid = mardyn_get_thread_num();
+	VLJCPThreadData &my_threadData = *_threadData[tid];
+
+	// SoA of the test molecule, set up as by Molecule::buildOwnSoA(), but without allocating
+	CellDataSoA& soa1 = my_threadData._testMoleculeSoA;
+	const size_t nLJ = testMolecule.numLJcenters();
+	const size_t nC = testMolecule.numCharges();
+	const size_t nD = testMolecule.numDipoles();
+	const size_t nQ = testMolecule.numQuadrupoles();
+	soa1.resize(1, nLJ, nC, nD, nQ);
+	soa1._mol_ljc_num[0] = nLJ;
+	soa1._mol_charges_num[0] = nC;
+	soa1._mol_dipoles_num[0] = nD;
+	soa1._mol_quadrupoles_num[0] = nQ;
+	soa1._mol_pos.x(0) = testMolecule.r(0);
+	soa1._mol_pos.y(0) = testMolecule.r(1);
+	soa1._mol_pos.z(0) = testMolecule.r(2);
+	testMolecule.setupSoACache(&soa1, 0, 0, 0, 0);
+	testMolecule.setSoA(nullptr);
+	soa1.clearAccumulators();
+	soa1.computeMoleculeBoundingBox();
+
+	const bool CalculateMacroscopic = true;
+	const bool ApplyCutoff = true;
+
+	for (ParticleCell* cell : cells) {
+		CellDataSoA& soa2 = downcastCellReferenceFull(*cell).getCellDataSoA();
+		if (soa2.getMolNum() == 0 or soa1.moleculeBoundingBoxDistanceSquare(soa2) > getPruneRadiusSquare()) {
+			continue;
+		}
+		// the forces on the cell molecules are not needed and must not be touched, they go to the scratch SoA.
+		CellDataSoA& scratch = my_threadData._scratchSoA;
+		scratch.resize(soa2.getMolNum(), soa2._ljc_num, soa2._charges_num, soa2._dipoles_num, soa2._quadrupoles_num);
+		scratch.clearAccumulators();
+		_calculatePairs<TestMoleculePolicy_<ApplyCutoff>, CalculateMacroscopic, MaskGatherC>(soa1, soa2, scratch);
+	}
+
+	vcp_real_accum upot6lj = 0.0, upotXpoles = 0.0, virial = 0.0, myRF = 0.0;
+	load_hSum_Store_Clear(&upot6lj, my_threadData._upot6ljV);
+	load_hSum_Store_Clear(&upotXpoles, my_threadData._upotXpolesV);
+	load_hSum_Store_Clear(&virial, my_threadData._virialV);
+	load_hSum_Store_Clear(&myRF, my_threadData._myRFV);
+	energy = upot6lj / 6.0 + upotXpoles + myRF;
+	return true;
+}
+
+
+CellProcessor* vcp::makeVectorizedCellProcessor(Domain& domain, double cutoffRadius, double LJcutoffRadius) {
+	return new VectorizedCellProcessor(domain, cutoffRadius, LJcutoffRadius);
+}
+
+VCP_ISA_TARGET_END
@@ -8,10 +8,12 @@
 #define VECTORIZEDCELLPROCESSOR_H_
 
 #include "CellProcessor.h"
+#include "CellDataSoA.h"
 #include "utils/AlignedArray.h"
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <algorithm>
 #include "vectorization/SIMD_TYPES.h"
 #include "vectorization/SIMD_VectorizedCellProcessorHelpers.h"
 #include "WrapOpenMP.h"
@@ -20,14 +22,21 @@
 class Component;
 class Domain;
 class Comp2Param;
-class CellDataSoA;
+class FullParticleCell;
+class PairObserver;
+class VCP1CLJRMMTest;
+
+// the class depends on the vector type, see VCP_ISA_NAMESPACE in SIMD_TYPES.h.
+VCP_ISA_TARGET_BEGIN
+namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 /**
  * \brief Vectorized calculation of the force.
  * \author Johannes Heckl
  */
 class VectorizedCellProcessor : public CellProcessor {
-	friend class VCP1CLJRMMTest;
+	friend class ::VCP1CLJRMMTest;
 public:
 	typedef std::vector<Component> ComponentList;
 
@@ -61,6 +70,20 @@ public:
         
         void processCellPair(ParticleCell& cell1, ParticleCell& cell2, bool sumAll = false);
         
+	/**
+	 * \brief Potential energy of a test molecule with the molecules of the given cells.
+	 * \details Uses the SoAs of the cells, which have to be up to date. The forces on the cell molecules are
+	 * written to a thread local scratch SoA, the energy is taken from the thread local sums and cleared again.
+	 */
+	bool processTestMolecule(Molecule& testMolecule, const std::vector<ParticleCell*>& cells, double& energy);
+
+	/**
+	 * \brief Register an observer, which gets all pairs within the cutoff, for which macroscopic values are computed.
+	 */
+	bool addPairObserver(PairObserver* observer);
+
+	void removePairObserver(PairObserver* observer);
+
 	/**
 	 * \brief Free the LennardJonesSoA for cell.
 	 */
@@ -139,7 +162,8 @@ private:
 
 	struct VLJCPThreadData {
 	public:
-		VLJCPThreadData(): _ljc_dist_lookup(nullptr), _charges_dist_lookup(nullptr), _dipoles_dist_lookup(nullptr), _quadrupoles_dist_lookup(nullptr){
+		VLJCPThreadData(): _ljc_dist_lookup(nullptr), _charges_dist_lookup(nullptr), _dipoles_dist_lookup(nullptr), _quadrupoles_dist_lookup(nullptr),
+				_testMoleculeSoA(0, 0, 0, 0, 0), _scratchSoA(0, 0, 0, 0, 0) {
 			_upot6ljV.resize(_numVectorElements);
 			_upotXpolesV.resize(_numVectorElements);
 			_virialV.resize(_numVectorElements);
@@ -181,13 +205,46 @@ private:
 		vcp_lookupOrMask_single* _quadrupoles_dist_lookup;
 
 		AlignedArray<vcp_real_accum> _upot6ljV, _upotXpolesV, _virialV, _myRFV;
+
+		/**
+		 * \brief SoA of the test molecule and scratch accumulators for the cell molecules, see processTestMolecule().
+		 */
+		CellDataSoA _testMoleculeSoA, _scratchSoA;
+
+		/**
+		 * \brief Buffers of observePairs().
+		 */
+		std::vector<PairObserver*> _activeObservers;
+		std::vector<Molecule*> _observedMolecules1, _observedMolecules2;
+		std::vector<vcp_real_calc> _observedDist2;
 	};
 
 	std::vector<VLJCPThreadData *> _threadData;
 
+	/**
+	 * \brief Registered pair observers, see PairObserver.
+	 */
+	std::vector<PairObserver*> _pairObservers;
+
+	/**
+	 * \brief Pass the molecule pairs of the two cells (or of one cell, if both are the same) to the observing observers.
+	 * \details The distances are checked on the SoA positions first, the squared distance passed to the observers is
+	 * computed from the molecules as by the scalar cell processors.
+	 */
+	void observePairs(FullParticleCell& cell1, FullParticleCell& cell2);
+
 	static const size_t _numVectorElements = VCP_VEC_SIZE;
 	size_t _numThreads;
 
+	/**
+	 * \brief Squared radius beyond which molecules are guaranteed not to interact.
+	 * \details The maximum of both cutoffs, slightly enlarged so that rounding differences between the bounding box
+	 * distances and the vectorized distance computation can never drop a pair within the cutoff.
+	 */
+	vcp_real_calc getPruneRadiusSquare() const {
+		return static_cast<vcp_real_calc>(std::max(_cutoffRadiusSquare, _LJCutoffRadiusSquare) * (1. + 1e-5));
+	}
+
 	template<bool calculateMacroscopic>
 	inline void _loopBodyLJ(
 			const RealCalcVec& m1_r_x, const RealCalcVec& m1_r_y, const RealCalcVec& m1_r_z,
@@ -314,10 +371,23 @@ private:
 	 * The boolean CalculateMacroscopic should specify, whether macroscopic values are to be calculated or not.
 	 * <br>
 	 * The class MaskGatherChooser is a class, that specifies the used loading,storing and masking routines.
+	 * <br>
+	 * The forces, virials and torques of the molecules of soa2 are accumulated in soa2Accum, which is soa2 itself
+	 * except for test molecules. soa2Accum must have the same numbers of centers as soa2.
 	 */
 	template<class ForcePolicy, bool CalculateMacroscopic, class MaskGatherChooser>
-	void _calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2);
+	void _calculatePairs(CellDataSoA & soa1, CellDataSoA & soa2, CellDataSoA & soa2Accum);
 
 }; /* end of class VectorizedCellProcessor */
 
+/**
+ * \brief Creates a VectorizedCellProcessor for the vector type of this namespace.
+ * \details Used by the runtime selection of the instruction set, see VectorizedCellProcessorDispatch.h.
+ */
+CellProcessor* makeVectorizedCellProcessor(Domain& domain, double cutoffRadius, double LJcutoffRadius);
+
+} /* namespace VCP_ISA_NAMESPACE */
+} /* namespace vcp */
+VCP_ISA_TARGET_END
+
 #endif /* VECTORIZEDCELLPROCESSOR_H_ */
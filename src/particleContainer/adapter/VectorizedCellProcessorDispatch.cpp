@@ -0,0 +1,149 @@
+/**
+ * \file
+ * \brief VectorizedCellProcessorDispatch.cpp
+ */
+
+#include "VectorizedCellProcessorDispatch.h"
+#include "VectorizedCellProcessor.h"
+#include "Simulation.h"
+#include "utils/Logger.h"
+
+#include <sstream>
+
+using Log::global_log;
+
+// The variants for the additional instruction sets are compiled in their own translation units (see src/CMakeLists.txt).
+// The VCP_DISPATCH_* macros are only defined for this file.
+namespace vcp {
+#ifdef VCP_DISPATCH_AVX
+namespace isa_avx {
+CellProcessor* makeVectorizedCellProcessor(Domain& domain, double cutoffRadius, double LJcutoffRadius);
+}
+#endif
+#ifdef VCP_DISPATCH_AVX2
+namespace isa_avx2 {
+CellProcessor* makeVectorizedCellProcessor(Domain& domain, double cutoffRadius, double LJcutoffRadius);
+}
+#endif
+#ifdef VCP_DISPATCH_AVX512
+namespace isa_avx512f {
+CellProcessor* makeVectorizedCellProcessor(Domain& domain, double cutoffRadius, double LJcutoffRadius);
+}
+#endif
+} /* namespace vcp */
+
+namespace {
+
+typedef CellProcessor* (*VCPFactory)(Domain& domain, double cutoffRadius, double LJcutoffRadius);
+
+struct CompiledVariant {
+	std::string name;
+	VCPFactory factory;
+};
+
+/**
+ * All compiled variants of the VectorizedCellProcessor, sorted by increasing capability. The first one is the
+ * baseline, i.e. the VectorizedCellProcessor of this translation unit.
+ */
+std::vector<CompiledVariant> getCompiledVariants() {
+#if VCP_VEC_TYPE==VCP_NOVEC
+	const std::string baseline = "NONE";
+#elif VCP_VEC_TYPE==VCP_VEC_SSE3
+	const std::string baseline = "SSE";
+#elif VCP_VEC_TYPE==VCP_VEC_AVX
+	const std::string baseline = "AVX";
+#elif VCP_VEC_TYPE==VCP_VEC_AVX2
+	const std::string baseline = "AVX2";
+#elif (VCP_VEC_TYPE==VCP_VEC_KNL) || (VCP_VEC_TYPE==VCP_VEC_KNL_GATHER)
+	const std::string baseline = "KNL";
+#elif (VCP_VEC_TYPE==VCP_VEC_AVX512F) || (VCP_VEC_TYPE==VCP_VEC_AVX512F_GATHER)
+	const std::string baseline = "AVX512";
+#endif
+
+	std::vector<CompiledVariant> variants{{baseline, &vcp::makeVectorizedCellProcessor}};
+#ifdef VCP_DISPATCH_AVX
+	variants.push_back({"AVX", &vcp::isa_avx::makeVectorizedCellProcessor});
+#endif
+#ifdef VCP_DISPATCH_AVX2
+	variants.push_back({"AVX2", &vcp::isa_avx2::makeVectorizedCellProcessor});
+#endif
+#ifdef VCP_DISPATCH_AVX512
+	variants.push_back({"AVX512", &vcp::isa_avx512f::makeVectorizedCellProcessor});
+#endif
+	return variants;
+}
+
+} /* anonymous namespace */
+
+std::vector<std::string> vcp::getCompiledInstructionSets() {
+	std::vector<std::string> names;
+	for (const CompiledVariant& variant : getCompiledVariants()) {
+		names.push_back(variant.name);
+	}
+	return names;
+}
+
+bool vcp::cpuSupportsInstructionSet(const std::string& instructionSet) {
+	if (instructionSet == "NONE") {
+		return true;
+	}
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+	// these checks include the operating system support for the extended registers.
+	__builtin_cpu_init();
+	if (instructionSet == "SSE") {
+		return __builtin_cpu_supports("sse3");
+	} else if (instructionSet == "AVX") {
+		return __builtin_cpu_supports("avx");
+	} else if (instructionSet == "AVX2") {
+		return __builtin_cpu_supports("avx2") and __builtin_cpu_supports("fma");
+	} else if (instructionSet == "AVX512") {
+		return __builtin_cpu_supports("avx512f") and __builtin_cpu_supports("avx512cd") and __builtin_cpu_supports("fma");
+	} else if (instructionSet == "KNL") {
+		return __builtin_cpu_supports("avx512er");
+	}
+	return false;
+#else
+	// without detection only the baseline is safe, everything else is compiled for it.
+	return instructionSet == getCompiledVariants().front().name;
+#endif
+}
+
+CellProcessor* vcp::createVectorizedCellProcessor(Domain& domain, double cutoffRadius, double LJcutoffRadius,
+		const std::string& instructionSet) {
+	const std::vector<CompiledVariant> variants = getCompiledVariants();
+	std::ostringstream compiled;
+	for (const CompiledVariant& variant : variants) {
+		compiled << " " << variant.name;
+	}
+
+	const CompiledVariant* selected = nullptr;
+	if (instructionSet.empty()) {
+		// the baseline runs everywhere the rest of the binary runs.
+		selected = &variants.front();
+		for (const CompiledVariant& variant : variants) {
+			if (cpuSupportsInstructionSet(variant.name)) {
+				selected = &variant;
+			}
+		}
+	} else {
+		for (const CompiledVariant& variant : variants) {
+			if (variant.name == instructionSet) {
+				selected = &variant;
+			}
+		}
+		if (selected == nullptr) {
+			global_log->error() << "VectorizedCellProcessor: instruction set " << instructionSet
+					<< " is not compiled into this binary. Available:" << compiled.str() << std::endl;
+			Simulation::exit(1);
+		}
+		if (selected != &variants.front() and not cpuSupportsInstructionSet(selected->name)) {
+			global_log->error() << "VectorizedCellProcessor: instruction set " << instructionSet
+					<< " is not supported by this cpu." << std::endl;
+			Simulation::exit(1);
+		}
+	}
+
+	global_log->info() << "VectorizedCellProcessor: compiled instruction sets:" << compiled.str() << ", selected "
+			<< selected->name << (instructionSet.empty() ? " (detected)" : " (requested)") << std::endl;
+	return selected->factory(domain, cutoffRadius, LJcutoffRadius);
+}
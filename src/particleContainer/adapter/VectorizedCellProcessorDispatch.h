@@ -0,0 +1,43 @@
+/**
+ * \file
+ * \brief VectorizedCellProcessorDispatch.h
+ * \details Selects the instruction set of the VectorizedCellProcessor at startup.
+ *
+ * The VectorizedCellProcessor is always compiled for the instruction set of the remaining code (VECTOR_INSTRUCTIONS).
+ * With VCP_DISPATCH_TARGETS it is additionally compiled for more capable instruction sets. Each variant lives in its
+ * own namespace (see VCP_ISA_NAMESPACE in SIMD_TYPES.h), so one binary can serve different node types.
+ */
+
+#ifndef VECTORIZEDCELLPROCESSORDISPATCH_H_
+#define VECTORIZEDCELLPROCESSORDISPATCH_H_
+
+#include <string>
+#include <vector>
+
+class CellProcessor;
+class Domain;
+
+namespace vcp {
+
+/**
+ * \brief Names of the instruction sets, for which the VectorizedCellProcessor is compiled into this binary.
+ * \details Sorted by increasing capability. The names match the options of VECTOR_INSTRUCTIONS and
+ * VCP_DISPATCH_TARGETS, the first entry is the baseline.
+ */
+std::vector<std::string> getCompiledInstructionSets();
+
+/**
+ * \brief Checks whether the executing cpu supports the given instruction set.
+ */
+bool cpuSupportsInstructionSet(const std::string& instructionSet);
+
+/**
+ * \brief Creates the VectorizedCellProcessor for the most capable instruction set, that is compiled and supported.
+ * \param instructionSet if not empty, this instruction set is used instead of the detected one.
+ */
+CellProcessor* createVectorizedCellProcessor(Domain& domain, double cutoffRadius, double LJcutoffRadius,
+		const std::string& instructionSet = "");
+
+} /* namespace vcp */
+
+#endif /* VECTORIZEDCELLPROCESSORDISPATCH_H_ */
@@ -12,6 +12,9 @@
 #include "particleContainer/adapter/ParticlePairs2PotForceAdapter.h"
 #include "particleContainer/adapter/LegacyCellProcessor.h"
 #include "particleContainer/adapter/VectorizedCellProcessor.h"
+#include "particleContainer/adapter/VectorizedCellProcessorDispatch.h"
+#include "particleContainer/adapter/CellDataSoA.h"
+#include "particleContainer/adapter/InstrumentedCellProcessor.h"
 
 #ifndef ENABLE_REDUCED_MEMORY_MODE
 TEST_SUITE_REGISTRATION(VectorizedCellProcessorTest);
@@ -386,3 +389,169 @@ void VectorizedCellProcessorTest::testMultiComponentMultiPotentials() {
 	const char* filename = "VectorizationMultiComponentMultiPotentials.inp";
 	testElectrostaticVectorization(filename, 35.0);
 }
+
+void VectorizedCellProcessorTest::testMoleculeBoundingBoxDistance() {
+	CellDataSoA soa1(2, 0, 0, 0, 0);
+	CellDataSoA soa2(1, 0, 0, 0, 0);
+
+	// an invalid box never prunes anything
+	ASSERT_DOUBLES_EQUAL(0.0, soa1.moleculeBoundingBoxDistanceSquare(100., 100., 100.), 1e-12);
+
+	soa1._mol_pos.x(0) = 0.0; soa1._mol_pos.y(0) = 0.0; soa1._mol_pos.z(0) = 0.0;
+	soa1._mol_pos.x(1) = 1.0; soa1._mol_pos.y(1) = 2.0; soa1._mol_pos.z(1) = 1.0;
+	soa1.computeMoleculeBoundingBox();
+
+	soa2._mol_pos.x(0) = 4.0; soa2._mol_pos.y(0) = 6.0; soa2._mol_pos.z(0) = 0.5;
+	soa2.computeMoleculeBoundingBox();
+
+	// inside the box
+	ASSERT_DOUBLES_EQUAL(0.0, soa1.moleculeBoundingBoxDistanceSquare(0.5, 1.0, 0.5), 1e-6);
+	// gaps of 3 in x and 4 in y
+	ASSERT_DOUBLES_EQUAL(25.0, soa1.moleculeBoundingBoxDistanceSquare(4.0, 6.0, 0.5), 1e-5);
+	ASSERT_DOUBLES_EQUAL(25.0, soa1.moleculeBoundingBoxDistanceSquare(soa2), 1e-5);
+	ASSERT_DOUBLES_EQUAL(25.0, soa2.moleculeBoundingBoxDistanceSquare(soa1), 1e-5);
+
+	// resizing invalidates the box
+	soa2.resize(0, 0, 0, 0, 0);
+	ASSERT_DOUBLES_EQUAL(0.0, soa1.moleculeBoundingBoxDistanceSquare(soa2), 1e-12);
+}
+
+void VectorizedCellProcessorTest::testInstructionSetDispatch() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testInstructionSetDispatch()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	const std::vector<std::string> instructionSets = vcp::getCompiledInstructionSets();
+	ASSERT_TRUE(not instructionSets.empty());
+
+	double forces[4][3] = { { -24, -24, 0 },
+	                        {  24, -24, 0 },
+	                        { -24,  24, 0 },
+	                        {  24,  24, 0 }};
+
+	// reading the file again would add the centers to the components a second time
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, "ForceCalculationTestU0.inp", 1.1);
+
+	for (const std::string& instructionSet : instructionSets) {
+		if (instructionSet != instructionSets.front() and not vcp::cpuSupportsInstructionSet(instructionSet)) {
+			test_log->info() << "VectorizedCellProcessorTest: skipping unsupported instruction set " << instructionSet << std::endl;
+			continue;
+		}
+
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			m->clearFM();
+		}
+
+		CellProcessor* cellProcessor = vcp::createVectorizedCellProcessor(*_domain, 1.1, 1.1, instructionSet);
+		container->traverseCells(*cellProcessor);
+
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			m->calcFM();
+		}
+
+		for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+			for (int i = 0; i < 3; i++) {
+				std::stringstream str;
+				str << instructionSet << ": Molecule id=" << m->getID() << " index i="<< i << std::endl;
+				ASSERT_DOUBLES_EQUAL_MSG(str.str(), forces[m->getID()-1][i], m->F(i), 1e-4);
+			}
+		}
+		ASSERT_DOUBLES_EQUAL(96, _domain->getLocalVirial(), 1e-4);
+
+		delete cellProcessor;
+	}
+	delete container;
+}
+
+void VectorizedCellProcessorTest::testInstrumentation() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testInstrumentation()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+	double forces[4][3] = { { -24, -24, 0 },
+	                        {  24, -24, 0 },
+	                        { -24,  24, 0 },
+	                        {  24,  24, 0 }};
+
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell, "ForceCalculationTestU0.inp", 1.1);
+
+	InstrumentedCellProcessor cellProcessor(new VectorizedCellProcessor(*_domain, 1.1, 1.1));
+	container->traverseCells(cellProcessor);
+
+	for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		m->calcFM();
+	}
+
+	for (auto m = container->iterator(ParticleIterator::ALL_CELLS); m.isValid(); ++m) {
+		for (int i = 0; i < 3; i++) {
+			std::stringstream str;
+			str << "Molecule id=" << m->getID() << " index i="<< i << std::endl;
+			ASSERT_DOUBLES_EQUAL_MSG(str.str(), forces[m->getID()-1][i], m->F(i), 1e-4);
+		}
+	}
+	ASSERT_DOUBLES_EQUAL(96, _domain->getLocalVirial(), 1e-4);
+
+	// the diagonals are outside of the cutoff.
+	const InstrumentedCellProcessor::CellCounters total = cellProcessor.getTotalCounters();
+	ASSERT_EQUAL(1ul, cellProcessor.getNumTraversals());
+	ASSERT_EQUAL(static_cast<uint64_t>(4), total.hits);
+	ASSERT_TRUE(total.pairs >= 6);
+	ASSERT_TRUE(cellProcessor.getThreadImbalance() >= 1.);
+
+	cellProcessor.reset();
+	ASSERT_EQUAL(static_cast<uint64_t>(0), cellProcessor.getTotalCounters().pairs);
+
+	delete container;
+}
+
+void VectorizedCellProcessorTest::testTestMoleculeEnergies() {
+	if (_domainDecomposition->getNumProcs() != 1) {
+		test_log->info() << "VectorizedCellProcessorTest::testTestMoleculeEnergies()"
+				<< " not executed (rerun with only 1 Process!)" << std::endl;
+		return;
+	}
+
+#if defined(MARDYN_DPDP)
+	double Tolerance = 1e-11;
+#else
+	double Tolerance = 1e-05;
+#endif
+	const double ScenarioCutoff = 35.0;
+	ParticleContainer* container = initializeFromFile(ParticleContainerFactory::LinkedCell,
+			"VectorizationMultiComponentMultiPotentials.inp", ScenarioCutoff);
+
+	// the force calculation sets up the SoAs of the cells.
+	VectorizedCellProcessor cellProcessor(*_domain, ScenarioCutoff, ScenarioCutoff);
+	container->traverseCells(cellProcessor);
+
+	std::vector<Molecule> testMolecules;
+	unsigned long nextId = 100000;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		testMolecules.push_back(*m);
+		Molecule insertion = *m;
+		for (int d = 0; d < 3; ++d) {
+			insertion.setr(d, std::min(m->r(d) + 0.7 + 0.3 * d, container->getBoundingBoxMax(d) - 1e-3));
+		}
+		insertion.setid(nextId++);
+		testMolecules.push_back(insertion);
+	}
+
+	ParticlePairs2PotForceAdapter forceAdapter(*_domain);
+	std::vector<double> energies;
+	container->getEnergies(&forceAdapter, testMolecules, cellProcessor, energies);
+	ASSERT_EQUAL(testMolecules.size(), energies.size());
+
+	LegacyCellProcessor legacyCellProcessor(ScenarioCutoff, ScenarioCutoff, &forceAdapter);
+	for (size_t i = 0; i < testMolecules.size(); ++i) {
+		const double legacyEnergy = container->getEnergy(&forceAdapter, &testMolecules[i], legacyCellProcessor);
+		std::stringstream str;
+		str << "test molecule id=" << testMolecules[i].getID() << std::endl;
+		ASSERT_DOUBLES_EQUAL_MSG(str.str(), legacyEnergy, energies[i], Tolerance * std::max(1.0, std::abs(legacyEnergy)));
+	}
+
+	delete container;
+}
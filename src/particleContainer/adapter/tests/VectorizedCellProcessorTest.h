@@ -36,6 +36,14 @@ class VectorizedCellProcessorTest : public utils::TestWithSimulationSetup {
 
 	TEST_METHOD(testMultiComponentMultiPotentials);
 
+	TEST_METHOD(testMoleculeBoundingBoxDistance);
+
+	TEST_METHOD(testInstructionSetDispatch);
+
+	TEST_METHOD(testInstrumentation);
+
+	TEST_METHOD(testTestMoleculeEnergies);
+
 	TEST_SUITE_END();
 
 public:
@@ -120,5 +128,30 @@ public:
 	 */
 	void testMultiComponentMultiPotentials();
 
+	/**
+	 * Checks the molecule bounding box of CellDataSoA, which is used to skip cell pairs and molecules
+	 * that are further apart than the cutoff.
+	 */
+	void testMoleculeBoundingBoxDistance();
+
+	/**
+	 * Runs the scenario of testForcePotentialCalculationU0 with every compiled instruction set of the
+	 * VectorizedCellProcessor, that the cpu supports (see VectorizedCellProcessorDispatch.h).
+	 */
+	void testInstructionSetDispatch();
+
+	/**
+	 * Runs the scenario of testForcePotentialCalculationU0 with an instrumented VectorizedCellProcessor, which must
+	 * not change the result and has to find the 4 interacting pairs.
+	 */
+	void testInstrumentation();
+
+	/**
+	 * Computes the energies of test molecules (copies of molecules of the container as deletion candidates and shifted
+	 * copies as insertions) with ParticleContainer::getEnergies() and the VectorizedCellProcessor and compares them to
+	 * the energies of the LegacyCellProcessor.
+	 */
+	void testTestMoleculeEnergies();
+
 };
 #endif /* VECTORIZEDCELLPROCESSORTEST_H_ */
@@ -2,6 +2,10 @@
 
 #include "SIMD_TYPES.h"
 
+VCP_ISA_TARGET_BEGIN
+namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
+
 class MaskingChooser {
 private:
 	MaskCalcVec compute_molecule=MaskCalcVec::zero();
@@ -217,3 +221,7 @@ public:
 		_numUnmasked += forceMask.countUnmasked();
 	}
 };
+
+} /* namespace VCP_ISA_NAMESPACE */
+} /* namespace vcp */
+VCP_ISA_TARGET_END
@@ -10,13 +10,17 @@
 
 #include "./SIMD_TYPES.h"
 
+VCP_ISA_TARGET_BEGIN
 namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 template<typename FloatOrDouble>
 class MaskVec {
 };
 
+} /* namespace VCP_ISA_NAMESPACE */
 } /* namespace vcp */
+VCP_ISA_TARGET_END
 
 // SPECIALIZATIONS: suggested to view via vimdiff
 #include "MaskVecFloat.h"
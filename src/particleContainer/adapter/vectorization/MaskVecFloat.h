@@ -12,7 +12,9 @@
 
 // keep this file and MaskVecDouble as close as possible, so that they can be examined via diff!
 
+VCP_ISA_TARGET_BEGIN
 namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 template<>
 class MaskVec<float> {
@@ -179,6 +181,8 @@ public:
 	}
 };
 
+} /* namespace VCP_ISA_NAMESPACE */
 } /* namespace vcp */
+VCP_ISA_TARGET_END
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_MASKVECFLOAT_H_ */
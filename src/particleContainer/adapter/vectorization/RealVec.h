@@ -16,13 +16,17 @@
 
 #include "utils/Logger.h"
 
+VCP_ISA_TARGET_BEGIN
 namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 template<typename FloatOrDouble>
 class RealVec {
 }; /* class RealVec */
 
+} /* namespace VCP_ISA_NAMESPACE */
 } /* namespace vcp */
+VCP_ISA_TARGET_END
 
 // SPECIALIZATIONS: suggested to view via vimdiff
 #include "RealVecFloat.h"
@@ -12,7 +12,9 @@
 
 // keep this file and RealVecFloat as close as possible, so that they can be examined via diff!
 
+VCP_ISA_TARGET_BEGIN
 namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
 
 template<>
 class RealVec<double> {
@@ -542,6 +544,8 @@ public:
 
 }; /* class RealCalcVec */
 
+} /* namespace VCP_ISA_NAMESPACE */
 } /* namespace vcp */
+VCP_ISA_TARGET_END
 
 #endif /* SRC_PARTICLECONTAINER_ADAPTER_VECTORIZATION_REALVECDOUBLE_H_ */
@@ -64,6 +64,8 @@ using namespace vcp;
     #error "SIMD_DEFINITIONS included without SIMD_TYPES! Never include this file directly! Include it only via SIMD_TYPES!"
 #endif /* defined SIMD_TYPES_H */
 
+VCP_ISA_TARGET_BEGIN
+
 #if VCP_VEC_TYPE==VCP_NOVEC
 	static vcp_inline MaskCalcVec vcp_simd_getInitMask(const size_t& /*i*/){
 		return true;
@@ -195,4 +197,6 @@ static vcp_inline T vcp_floor_to_vec_size(const T& num){
 	return num & (~static_cast<T>(VCP_VEC_SIZE_M1));
 }
 
+VCP_ISA_TARGET_END
+
 #endif /* SIMD_DEFINITIONS_H */
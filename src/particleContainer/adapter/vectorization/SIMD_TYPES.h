@@ -37,7 +37,7 @@
 
 // The following error should NEVER occur, since it signalizes, that the macros, used by THIS translation unit are defined anywhere else in the program.
 #if defined(VCP_VEC_TYPE) || defined(VCP_NOVEC) || defined(VCP_VEC_SSE3) || defined(VCP_VEC_AVX) || defined(VCP_VEC_AVX2) || \
-	defined(VCP_VEC_KNL) || defined(VCP_VEC_KNL_GATHER)
+	defined(VCP_VEC_KNL) || defined(VCP_VEC_KNL_GATHER) || defined(VCP_ISA_NAMESPACE) || defined(VCP_ISA_TARGET)
 	#error conflicting macro definitions
 #endif
 
@@ -61,7 +61,18 @@
 #endif
 
 // define symbols for vectorization
-#if defined(__AVX512F__) && defined(__AVX512ER__)
+// The translation units of VCP_DISPATCH_TARGETS (see cmake/modules/vectorization.cmake) are compiled with the flags of
+// the baseline, their instruction set is named by VCP_DISPATCH_TARGET_* instead.
+#if defined(VCP_DISPATCH_TARGET_AVX)
+	#define VCP_VEC_TYPE VCP_VEC_AVX
+	#define VCP_ISA_TARGET "avx"
+#elif defined(VCP_DISPATCH_TARGET_AVX2)
+	#define VCP_VEC_TYPE VCP_VEC_AVX2
+	#define VCP_ISA_TARGET "avx2,fma"
+#elif defined(VCP_DISPATCH_TARGET_AVX512)
+	#define VCP_VEC_TYPE VCP_VEC_AVX512F
+	#define VCP_ISA_TARGET "avx512f,avx512cd,fma"
+#elif defined(__AVX512F__) && defined(__AVX512ER__)
 	#if defined(__VCP_GATHER__)
 		#define VCP_VEC_TYPE VCP_VEC_KNL_GATHER
 	#else
@@ -93,6 +104,47 @@
 	#define VCP_VEC_TYPE VCP_NOVEC
 #endif
 
+// Everything whose layout or code depends on the vector type lives in an inline namespace named after it.
+// Translation units compiled for different instruction sets can thus be linked into the same binary without clashing
+// symbols (see VCP_DISPATCH_TARGETS in cmake/modules/vectorization.cmake).
+#if VCP_VEC_TYPE==VCP_NOVEC
+	#define VCP_ISA_NAMESPACE isa_novec
+#elif VCP_VEC_TYPE==VCP_VEC_SSE3
+	#define VCP_ISA_NAMESPACE isa_sse3
+#elif VCP_VEC_TYPE==VCP_VEC_AVX
+	#define VCP_ISA_NAMESPACE isa_avx
+#elif VCP_VEC_TYPE==VCP_VEC_AVX2
+	#define VCP_ISA_NAMESPACE isa_avx2
+#elif VCP_VEC_TYPE==VCP_VEC_KNL
+	#define VCP_ISA_NAMESPACE isa_knl
+#elif VCP_VEC_TYPE==VCP_VEC_KNL_GATHER
+	#define VCP_ISA_NAMESPACE isa_knl_gather
+#elif VCP_VEC_TYPE==VCP_VEC_AVX512F
+	#define VCP_ISA_NAMESPACE isa_avx512f
+#elif VCP_VEC_TYPE==VCP_VEC_AVX512F_GATHER
+	#define VCP_ISA_NAMESPACE isa_avx512f_gather
+#endif
+
+// Only the code between VCP_ISA_TARGET_BEGIN and VCP_ISA_TARGET_END is compiled for VCP_ISA_TARGET. Everything else in
+// the translation unit, in particular inline functions and templates of other headers, keeps the baseline flags, so the
+// copies the linker picks are the same in all translation units. Headers have to be included outside of these regions.
+#if defined(VCP_ISA_TARGET)
+	#define VCP_PRAGMA_(x) _Pragma(#x)
+	#define VCP_PRAGMA(x) VCP_PRAGMA_(x)
+	#if defined(__clang__)
+		#define VCP_ISA_TARGET_BEGIN VCP_PRAGMA(clang attribute push(__attribute__((target(VCP_ISA_TARGET))), apply_to = function))
+		#define VCP_ISA_TARGET_END VCP_PRAGMA(clang attribute pop)
+	#elif defined(__GNUC__)
+		#define VCP_ISA_TARGET_BEGIN VCP_PRAGMA(GCC push_options) VCP_PRAGMA(GCC target(VCP_ISA_TARGET))
+		#define VCP_ISA_TARGET_END VCP_PRAGMA(GCC pop_options)
+	#else
+		#error VCP_DISPATCH_TARGETS requires a compiler supporting target attributes.
+	#endif
+#else
+	#define VCP_ISA_TARGET_BEGIN
+	#define VCP_ISA_TARGET_END
+#endif
+
 // Include necessary files if we vectorize.
 #if VCP_VEC_TYPE==VCP_NOVEC
 	// no file to include
@@ -14,6 +14,9 @@
 #include "SIMD_TYPES.h"
 #include "utils/AlignedArray.h"
 
+// the helpers use the intrinsics of the vector type, see VCP_ISA_TARGET_BEGIN in SIMD_TYPES.h.
+VCP_ISA_TARGET_BEGIN
+
 /**
  * unpacks eps_24 and sig2 from the eps_sigI array according to the index array id_j (for mic+avx2: use gather)
  * @param eps_24 vector in which eps_24 is saved
@@ -338,6 +341,9 @@ void vcp_simd_load_sub_store_masked(vcp_real_accum * const addr, size_t offset,
 }
 
 
+namespace vcp {
+inline namespace VCP_ISA_NAMESPACE {
+
 /**
  * \brief Policy class for single cell force calculation.
  */
@@ -421,6 +427,23 @@ public:
 	}
 }; /* end of class CellPairPolicy_ */
 
+/**
+ * \brief Policy class for the energy of a test molecule with the molecules of a cell.
+ * \details A molecule of the cell at exactly the position of the test molecule is the test molecule itself (e.g. a
+ * deletion candidate), so pairs at distance zero are masked out in addition to the cell pair logic.
+ */
+template<bool ApplyCutoff>
+class TestMoleculePolicy_ : public CellPairPolicy_<ApplyCutoff> {
+public:
+	vcp_inline static MaskCalcVec GetForceMask (const RealCalcVec& m_r2, const RealCalcVec& rc2, MaskCalcVec& j_mask)
+	{
+		return (m_r2 != RealCalcVec::zero()) and CellPairPolicy_<ApplyCutoff>::GetForceMask(m_r2, rc2, j_mask);
+	}
+}; /* end of class TestMoleculePolicy_ */
+
+} /* namespace VCP_ISA_NAMESPACE */
+} /* namespace vcp */
+
 /**
  * \brief The dist lookup for a molecule and all centers of a type
  */
@@ -471,5 +494,6 @@ static vcp_inline calcDistLookup (const size_t & i_center_idx, const size_t & so
 
 }
 
+VCP_ISA_TARGET_END
 
 #endif /* SIMD_VECTORIZEDCELLPROCESSORHELPERS_H */
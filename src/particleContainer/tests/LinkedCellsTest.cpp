@@ -644,3 +644,126 @@ void LinkedCellsTest::doForceComparisonTest(std::string inputFile,
 	delete containerTest;
 
 }
+
+#ifndef ENABLE_REDUCED_MEMORY_MODE
+void LinkedCellsTest::testPersistentSoACaches() {
+	Component twoCenters(1);
+	twoCenters.addLJcenter(0.1, 0, 0, 1, 1, 1, 0, false);
+	twoCenters.addLJcenter(-0.1, 0, 0, 1, 1, 1, 0, false);
+
+	double bBoxMin[3] = {0.0, 0.0, 0.0};
+	double bBoxMax[3] = {2.0, 2.0, 2.0};
+	LinkedCells LC(bBoxMin, bBoxMax, 1.0);
+
+	Molecule dummyMolecule1(1, &_components[0], 0.1, 0.1, 0.1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+	Molecule dummyMolecule2(2, &_components[0], 0.2, 0.2, 0.2, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+	Molecule dummyMolecule3(3, &_components[0], 0.3, 0.3, 0.3, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+	LC.addParticle(dummyMolecule1);
+	LC.addParticle(dummyMolecule2);
+	LC.addParticle(dummyMolecule3);
+	LC.updateMoleculeCaches();
+
+	// move the molecules and add some force: the layout is reused, positions and forces have to be updated
+	double force[3] = {1.0, 2.0, 3.0};
+	for (auto it = LC.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		it->setr(0, it->r(0) + 0.05);
+		it->Fljcenteradd(0, force);
+		it->calcFM();
+	}
+	LC.updateMoleculeCaches();
+	for (auto it = LC.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		ASSERT_DOUBLES_EQUAL(it->r(0), it->ljcenter_d_abs(0)[0], 1e-6);
+		ASSERT_DOUBLES_EQUAL(it->r(1), it->ljcenter_d_abs(0)[1], 1e-6);
+		ASSERT_DOUBLES_EQUAL(0.0, it->ljcenter_F(0)[2], 1e-12);
+		ASSERT_DOUBLES_EQUAL(0.0, it->F(2), 1e-12);
+	}
+
+	// move a molecule into the neighbouring cell: the molecules of both cells have changed
+	for (auto it = LC.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		if (it->getID() == 3ul) {
+			it->setr(0, 1.5);
+		}
+	}
+	LC.update();
+	LC.updateMoleculeCaches();
+	for (auto it = LC.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		ASSERT_DOUBLES_EQUAL(it->r(0), it->ljcenter_d_abs(0)[0], 1e-6);
+		ASSERT_DOUBLES_EQUAL(it->r(2), it->ljcenter_d_abs(0)[2], 1e-6);
+	}
+
+	// change the number of centers and the order of the molecules: the layout has to be set up again
+	auto first = LC.iterator(ParticleIterator::ALL_CELLS);
+	first.deleteCurrentParticle();
+	for (auto it = LC.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		if (it->getID() == 2ul) {
+			it->setComponent(&twoCenters);
+		}
+	}
+	LC.updateMoleculeCaches();
+	unsigned long numMolecules = 0;
+	for (auto it = LC.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		++numMolecules;
+		ASSERT_DOUBLES_EQUAL(it->r(0) + it->ljcenter_d(0)[0], it->ljcenter_d_abs(0)[0], 1e-6);
+		if (it->getID() == 2ul) {
+			ASSERT_EQUAL(2u, it->numLJcenters());
+			ASSERT_DOUBLES_EQUAL(it->r(0) - 0.1, it->ljcenter_d_abs(1)[0], 1e-6);
+		}
+	}
+	ASSERT_EQUAL(2ul, numMolecules);
+}
+void LinkedCellsTest::testPersistentSoACachesAfterUpdate() {
+	double bBoxMin[3] = {0.0, 0.0, 0.0};
+	double bBoxMax[3] = {2.0, 2.0, 2.0};
+	LinkedCells LC(bBoxMin, bBoxMax, 1.0);
+
+	Molecule dummyMolecule1(1, &_components[0], 0.1, 0.1, 0.1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+	Molecule dummyMolecule2(2, &_components[0], 0.2, 0.2, 0.2, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+	Molecule dummyMolecule3(3, &_components[0], 1.5, 1.5, 1.5, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+	Molecule dummyMolecule4(4, &_components[0], 1.5, 0.1, 0.1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0);
+	LC.addParticle(dummyMolecule1);
+	LC.addParticle(dummyMolecule2);
+	LC.addParticle(dummyMolecule3);
+	LC.addParticle(dummyMolecule4);
+	LC.update();
+	LC.updateMoleculeCaches();
+
+	// move the molecules within their cells and molecule 4 into the cell of molecules 1 and 2
+	const double point1[3] = {0.1, 0.1, 0.1};
+	const double point3[3] = {1.5, 1.5, 1.5};
+	const unsigned long cell1 = LC.getCellIndexOfPoint(point1);
+	const unsigned long cell3 = LC.getCellIndexOfPoint(point3);
+	for (auto it = LC.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		for (unsigned short d = 0; d < 3; ++d) {
+			it->setr(d, it->r(d) + 0.05);
+		}
+		if (it->getID() == 4ul) {
+			it->setr(0, 0.3);
+			it->setr(1, 0.3);
+			it->setr(2, 0.3);
+		}
+	}
+	LC.update();
+
+	// the cell of molecule 3 is unchanged, the cell molecule 4 entered has to set up its layout again
+	ASSERT_TRUE(LC._cells[cell3].isSoALayoutValid());
+	ASSERT_TRUE(not LC._cells[cell1].isSoALayoutValid());
+	LC.updateMoleculeCaches();
+	ASSERT_TRUE(LC._cells[cell1].isSoALayoutValid());
+
+	// a force step without moving molecules between cells: all SoA layouts are reused
+	for (auto it = LC.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		it->setr(0, it->r(0) + 0.01);
+	}
+	LC.update();
+	ASSERT_TRUE(LC._cells[cell1].isSoALayoutValid());
+	ASSERT_TRUE(LC._cells[cell3].isSoALayoutValid());
+	LC.updateMoleculeCaches();
+	unsigned long numMolecules = 0;
+	for (auto it = LC.iterator(ParticleIterator::ALL_CELLS); it.isValid(); ++it) {
+		++numMolecules;
+		ASSERT_DOUBLES_EQUAL(it->r(0), it->ljcenter_d_abs(0)[0], 1e-6);
+		ASSERT_DOUBLES_EQUAL(it->r(1), it->ljcenter_d_abs(0)[1], 1e-6);
+	}
+	ASSERT_EQUAL(4ul, numMolecules);
+}
+#endif
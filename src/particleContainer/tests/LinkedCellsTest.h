@@ -27,6 +27,9 @@ class LinkedCellsTest: public ParticleContainerTest {
 	TEST_METHOD(testCellBorderAndFlagManager);
 
 #ifndef ENABLE_REDUCED_MEMORY_MODE
+	TEST_METHOD(testPersistentSoACaches);
+	TEST_METHOD(testPersistentSoACachesAfterUpdate);
+
 	TEST_METHOD(testFullShellMPIDirectPP);
 	TEST_METHOD(testFullShellMPIDirect);
 
@@ -97,6 +100,10 @@ public:
 
 	void testCellBorderAndFlagManager();
 
+	void testPersistentSoACaches();
+
+	void testPersistentSoACachesAfterUpdate();
+
 private:
 
 	void doForceComparisonTest(std::string inputFile, TraversalTuner<ParticleCell>::traversalNames traversal, unsigned cellsInCutoff, std::string neighbourCommScheme, std::string commScheme);
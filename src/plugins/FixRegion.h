@@ -54,6 +54,8 @@ public:
 	void afterForces(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp,
 					 unsigned long simstep) override;
 
+	bool requiresForcesBeforeIntegration() const override { return true; }
+
 	void endStep(ParticleContainer* particleContainer, DomainDecompBase* domainDecomp, Domain* domain,
 				 unsigned long simstep) override;
 
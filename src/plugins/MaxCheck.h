@@ -106,6 +106,9 @@ public:
 			unsigned long simstep
 	) override;
 
+	//! limits the forces and velocities in afterForces()
+	bool requiresForcesBeforeIntegration() const override { return true; }
+
 	void endStep(
 			ParticleContainer *particleContainer,
 			DomainDecompBase *domainDecomp, Domain *domain,
@@ -90,6 +90,9 @@ public:
             unsigned long simstep
     ) override;
 
+    //! reflects the velocities in afterForces()
+    bool requiresForcesBeforeIntegration() const override { return true; }
+
 	void endStep(
 			ParticleContainer *particleContainer,
 			DomainDecompBase *domainDecomp, Domain *domain,
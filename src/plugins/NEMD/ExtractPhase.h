@@ -70,6 +70,9 @@ public:
             unsigned long simstep
     ) override;
 
+    //! deletes molecules in afterForces()
+    bool requiresForcesBeforeIntegration() const override { return true; }
+
 	void endStep(
 			ParticleContainer *particleContainer,
 			DomainDecompBase *domainDecomp, Domain *domain,
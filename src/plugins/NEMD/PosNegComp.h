@@ -52,6 +52,9 @@ public:
             unsigned long simstep
     ) override;
 
+    //! changes the components of molecules in afterForces()
+    bool requiresForcesBeforeIntegration() const override { return true; }
+
 	void endStep(
 			ParticleContainer *particleContainer,
 			DomainDecompBase *domainDecomp, Domain *domain,
@@ -117,6 +117,13 @@ public:
             unsigned long simstep
     ) {};
 
+    /** @brief Whether afterForces() changes forces, velocities or the molecules themselves
+     *
+     * The integrator then must not update the molecules before afterForces() ran, so it can not sum up the forces
+     * in its own pass (see fusedForceUpdate of the Leapfrog integrator). Plugins that only read keep the default.
+     */
+    virtual bool requiresForcesBeforeIntegration() const { return false; }
+
 
     // make pure virtual?
     /** @brief Method endStep will be called at the end of each time step.
@@ -36,6 +36,7 @@
 #include "io/SysMonOutput.h"
 #include "io/TimerWriter.h"
 #include "io/VISWriter.h"
+#include "io/VTUMoleculeWriter.h"
 #include "io/XyzWriter.h"
 
 // General plugins
@@ -118,6 +119,7 @@ void PluginFactory<PluginBase>::registerDefaultPlugins() {
 	REGISTER_PLUGIN(TimerWriter);
 	REGISTER_PLUGIN(VectorizationTuner);
 	REGISTER_PLUGIN(VISWriter);
+	REGISTER_PLUGIN(VTUMoleculeWriter);
 	REGISTER_PLUGIN(WallPotential);
 	REGISTER_PLUGIN(XyzWriter);
 #ifdef VTK
@@ -12,6 +12,7 @@
 #include "plugins/profiles/DOFProfile.h"
 #include "plugins/profiles/VirialProfile.h"
 #include "plugins/profiles/Virial2DProfile.h"
+#include "WrapOpenMP.h"
 
 /**
 * @brief Read in Information about write/record frequencies, Sampling Grid and which profiles are enabled.
@@ -30,7 +31,8 @@ void SpatialProfile::readXML(XMLfileUnits& xmlconfig) {
 	xmlconfig.getNodeValue("profiledComponent", _profiledCompString);
 	global_log->info() << "[SpatialProfile] Profiled Component:" << _profiledCompString << endl;
 	
-	if (_profiledCompString != "all") {
+	_allComponents = (_profiledCompString == "all");
+	if (not _allComponents) {
 		_profiledComp = std::stoi(_profiledCompString);
 	}
 
@@ -219,10 +221,17 @@ void SpatialProfile::init(ParticleContainer* particleContainer, DomainDecompBase
 			_profiles[i]->reset(uID);
 		}
 	}
+
+	// Local values of all bins for every thread, so the recording needs neither atomics nor allocations
+	_threadLocalBins.resize(mardyn_get_max_threads());
+	for (auto& localBins : _threadLocalBins) {
+		localBins.assign(_uIDs * _comms, 0.0);
+	}
 }
 
 /**
- * @brief Iterates over all molecules and passes them together with their Bin ID to the profiles for further processing.
+ * @brief Iterates over all molecules in parallel and passes them together with the local values of their bin to the
+ * profiles for further processing. Every thread records into its own bins, which are summed up before the communication.
  * If the current timestep hits the writefrequency the profile writes/resets are triggered here.
  * All of this only occurs after the initStatistics are passed.
  * @param particleContainer
@@ -234,16 +243,20 @@ void SpatialProfile::endStep(ParticleContainer* particleContainer, DomainDecompB
 							 unsigned long simstep) {
 	int mpi_rank = domainDecomp->getRank();
 
-	unsigned xun, yun, zun;
 	if ((simstep >= _initStatistics) && (simstep % _profileRecordingTimesteps == 0)) {
-		long uID;
+		// Loop over all particles and bin them with uIDs into the local bins of the thread
+		#if defined(_OPENMP)
+		#pragma omp parallel
+		#endif
+		{
+			std::vector<double>& localBins = _threadLocalBins[mardyn_get_thread_num()];
+			for (auto thismol = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); thismol.isValid(); ++thismol) {
+				if (not _allComponents and thismol->componentid() != _profiledComp - 1) {
+					continue;
+				}
 
-		// Loop over all particles and bin them with uIDs
-		for (auto thismol = particleContainer->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); thismol.isValid(); ++thismol) {
-			
-			if ((_profiledCompString != "all") && (thismol->componentid() == _profiledComp-1)) {
-				
 				// Get uID
+				long uID;
 				if (samplInfo.cylinder) {
 					uID = getCylUID(thismol);
 					if (uID == -1) {
@@ -251,29 +264,17 @@ void SpatialProfile::endStep(ParticleContainer* particleContainer, DomainDecompB
 						continue;
 					}
 				} else {
-					uID = getCartesianUID(thismol);
-				}
-				// pass mol + uID to all profiles
-				for (unsigned i = 0; i < _profiles.size(); i++) {
-					_profiles[i]->record(*thismol, (unsigned) uID);
-				}
-			}
-			
-			if (_profiledCompString == "all"){
-							
-				// Get uID
-				if (samplInfo.cylinder) {
-					uID = getCylUID(thismol);
-					if (uID == -1) {
-						// Invalid uID -> Molecule not in cylinder -> continue
+					const unsigned long cartesianUID = getCartesianUID(thismol);
+					if (cartesianUID >= _uIDs) {
+						// Molecule outside of the sampling grid (e.g. rounded up to the upper boundary) -> continue
 						continue;
 					}
-				} else {
-					uID = getCartesianUID(thismol);
+					uID = static_cast<long>(cartesianUID);
 				}
-				// pass mol + uID to all profiles
+				// pass mol + local values of the bin to all profiles
+				double* localValues = localBins.data() + uID * _comms;
 				for (unsigned i = 0; i < _profiles.size(); i++) {
-					_profiles[i]->record(*thismol, (unsigned) uID);
+					_profiles[i]->record(*thismol, localValues + _profileOffsets[i]);
 				}
 			}
 		}
@@ -286,13 +287,15 @@ void SpatialProfile::endStep(ParticleContainer* particleContainer, DomainDecompB
 		// COLLECTIVE COMMUNICATION
 		global_log->info() << "[SpatialProfile] uIDs: " << _uIDs << " acc. Data: " << _accumulatedDatasets << "\n";
 
+		mergeThreadLocalBins();
+
 		// Initialize Communication with number of bins * number of total comms needed per bin by all profiles.
 		domainDecomp->collCommInit(_comms * _uIDs);
 
 		// Append Communications
 		for (unsigned long uID = 0; uID < _uIDs; uID++) {
 			for (unsigned i = 0; i < _profiles.size(); i++) {
-				_profiles[i]->collectAppend(domainDecomp, uID);
+				_profiles[i]->collectAppend(domainDecomp, _threadLocalBins[0].data() + uID * _comms + _profileOffsets[i]);
 			}
 		}
 
@@ -323,10 +326,30 @@ void SpatialProfile::endStep(ParticleContainer* particleContainer, DomainDecompB
 				_profiles[i]->reset(uID);
 			}
 		}
+		for (auto& localBins : _threadLocalBins) {
+			std::fill(localBins.begin(), localBins.end(), 0.0);
+		}
 		_accumulatedDatasets = 0;
 	}
 }
 
+/**
+ * @brief Sums up the local values of all threads in the ones of thread 0. The bins are distributed among the threads.
+ */
+void SpatialProfile::mergeThreadLocalBins() {
+	const long numValues = _uIDs * _comms;
+	const int numThreads = _threadLocalBins.size();
+	double* const merged = _threadLocalBins[0].data();
+	#if defined(_OPENMP)
+	#pragma omp parallel for schedule(static)
+	#endif
+	for (long i = 0; i < numValues; i++) {
+		for (int t = 1; t < numThreads; t++) {
+			merged[i] += _threadLocalBins[t][i];
+		}
+	}
+}
+
 /**
  * @brief getCartesianUID samples the domain cartesian coordinate bins.
  *
@@ -412,6 +435,7 @@ long SpatialProfile::getCylUID(ParticleIterator& thismol) {
 void SpatialProfile::addProfile(ProfileBase* profile) {
 	global_log->info() << "[SpatialProfile] Profile added: \n";
 	_profiles.push_back(profile);
+	_profileOffsets.push_back(_comms);
 	_comms += profile->comms();
 }
 
@@ -5,6 +5,8 @@
 #ifndef MARDYN_TRUNK_SPATIALPROFILE_H
 #define MARDYN_TRUNK_SPATIALPROFILE_H
 
+#include <optional>
+
 #include <plugins/profiles/ProfileBase.h>
 #include "PluginBase.h"
 #include "Domain.h"
@@ -66,6 +68,7 @@ class Virial2DProfile;
 * \endcode
  */
 class SpatialProfile : public PluginBase {
+	friend class SpatialProfileTest;
 
 public:
 
@@ -118,12 +121,18 @@ private:
 	std::string _mode;
 	std::string _profiledCompString;
 	unsigned int _profiledComp;
+	bool _allComponents; // profiledComponent is "all"
 
 
 	unsigned long _uIDs; //!< Total number of unique IDs with the selected Grid. This is the number of total bins in the Sampling grid.
 
 	vector<ProfileBase*> _profiles; // vector holding all enabled profiles
 	int _comms = 0; // total number of communications per bin needed by all profiles.
+	vector<int> _profileOffsets; // offset of the local values of each profile within the _comms values of a bin
+
+	//! local values of all bins (_comms per bin) recorded by every thread, summed up in the ones of thread 0 before the
+	//! communication
+	std::vector<std::vector<double>> _threadLocalBins;
 
 	// Needed for XML check for enabled profiles.
 	bool _ALL = false;
@@ -136,6 +145,8 @@ private:
 
 	void addProfile(ProfileBase* profile);
 
+	void mergeThreadLocalBins();
+
 	std::optional<std::function<unsigned long(void)>> getNumFixRegion;
 
 };
@@ -14,18 +14,17 @@
 class DensityProfile final : public ProfileBase {
 public:
 	~DensityProfile() final = default;
-    void record(Molecule &mol, unsigned long uID) final  {
-        _localProfile[uID] += 1;
+    void record(Molecule &mol, double *localValues) final  {
+        localValues[0] += 1;
     }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendInt(_localProfile[uID]);
+    void collectAppend(DomainDecompBase *domainDecomp, const double *localValues) final {
+        domainDecomp->collCommAppendInt((int) localValues[0]);
     }
     void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
         _globalProfile[uID] = domainDecomp->collCommGetInt();
     }
     void output(string prefix, long unsigned accumulatedDatasets) final;
     void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0;
         _globalProfile[uID] = 0;
     }
     int comms() final {return 1;}
@@ -35,8 +34,6 @@ public:
     }
 
 private:
-    // Local 1D Profile
-    std::map<unsigned, int> _localProfile;
     // Global 1D Profile
     std::map<unsigned, int> _globalProfile;
 
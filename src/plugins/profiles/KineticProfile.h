@@ -14,21 +14,20 @@
 class KineticProfile final : public ProfileBase {
 public:
     ~KineticProfile() final = default;
-    void record(Molecule &mol, unsigned long uID) final  {
+    void record(Molecule &mol, double *localValues) final  {
         double mv2 = 0.0;
         double Iw2 = 0.0;
         mol.calculate_mv2_Iw2(mv2, Iw2);
-        _localProfile[uID] += mv2 + Iw2;
+        localValues[0] += mv2 + Iw2;
     }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendDouble(_localProfile[uID]);
+    void collectAppend(DomainDecompBase *domainDecomp, const double *localValues) final {
+        domainDecomp->collCommAppendDouble(localValues[0]);
     }
     void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
         _globalProfile[uID] = domainDecomp->collCommGetDouble();
     }
     void output(string prefix, long unsigned accumulatedDatasets) final;
     void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0.0;
         _globalProfile[uID] = 0.0;
     }
     int comms() final {return 1;}
@@ -38,8 +37,6 @@ public:
     }
 
 private:
-    // Local 1D Profile
-    std::map<unsigned, double> _localProfile;
     // Global 1D Profile
     std::map<unsigned, double> _globalProfile;
 
@@ -43,19 +43,21 @@ public:
 	 */
 	virtual void init(SamplingInformation& samplingInformation) { _samplInfo = samplingInformation; };
 
-	/** @brief The recording step defines what kind of data needs to be recorded for a single molecule with a corresponding uID.
+	/** @brief The recording step defines what kind of data needs to be recorded for a single molecule.
 	 *
+	 * SpatialProfile calls this concurrently from all threads, each of them with its own bins, so the profile must not
+	 * modify any of its members here.
 	 * @param mol Reference to Molecule, needed to extract info such as velocity or Virial.
-	 * @param uID uID of molecule in sampling grid, needed to put data in right spot in the profile arrays.
+	 * @param localValues The comms() local values of the bin of the molecule, to which its data is added.
 	 */
-	virtual void record(Molecule& mol, unsigned long uID) = 0;
+	virtual void record(Molecule& mol, double* localValues) = 0;
 
-	/** @brief Append all necessary communication per bin to the DomainDecomposition. Append from e.g. _localProfile.
+	/** @brief Append all necessary communication per bin to the DomainDecomposition.
 	 *
 	 * @param domainDecomp DomainDecomposition handling the communication.
-	 * @param uID uID of molecule in sampling grid, needed to put data in right spot in the profile arrays.
+	 * @param localValues The comms() local values of one bin, summed up over all threads.
 	 */
-	virtual void collectAppend(DomainDecompBase* domainDecomp, unsigned long uID) = 0;
+	virtual void collectAppend(DomainDecompBase* domainDecomp, const double* localValues) = 0;
 
 	/** @brief Get global values after AllReduceSum per bin. Write to e.g. _globalProfile.
 	 *
@@ -73,14 +75,16 @@ public:
 	 */
 	virtual void output(string prefix, long unsigned accumulatedDatasets) = 0;
 
-	/** @brief Used to reset all array contents for a specific uID in order to start the next recording timeframe.
+	/** @brief Used to reset the global values for a specific uID in order to start the next recording timeframe.
+	 * The local values are reset by SpatialProfile.
 	 *
 	 * @param uID uID of molecule in sampling grid, needed to put data in right spot in the profile arrays.
 	 */
 	virtual void reset(unsigned long uID) = 0;
 
 	/** @brief 1D profiles like a number density profile should return 1 here. 3D profiles that have 3 entries per bin
-	 * that need to be communicated would need to return 3. Adjust as needed. Same number as commAppends in collectAppend.
+	 * that need to be communicated would need to return 3. Adjust as needed. Same number as commAppends in collectAppend
+	 * and as local values recorded by record.
 	 *
 	 * @return Number of nedded communications per bin so the communicator can be setup correctly.
 	 */
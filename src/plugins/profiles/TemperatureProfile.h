@@ -17,21 +17,20 @@ class KineticProfile;
 class TemperatureProfile final : public ProfileBase {
 public:
 	TemperatureProfile(DOFProfile * dofProf, KineticProfile * kinProf) :
-			_dofProfile(dofProf), _kineticProfile(kinProf), _localProfile(), _globalProfile() {
+			_dofProfile(dofProf), _kineticProfile(kinProf), _globalProfile() {
 	}
     ~TemperatureProfile() final = default;
-    void record(Molecule &mol, unsigned long uID) final  {
-        _localProfile[uID] += 1;
+    void record(Molecule &mol, double *localValues) final  {
+        localValues[0] += 1;
     }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendLongDouble(_localProfile[uID]);
+    void collectAppend(DomainDecompBase *domainDecomp, const double *localValues) final {
+        domainDecomp->collCommAppendLongDouble(localValues[0]);
     }
     void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
         _globalProfile[uID] = domainDecomp->collCommGetLongDouble();
     }
     void output(string prefix, long unsigned accumulatedDatasets) final;
     void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0.0;
         _globalProfile[uID] = 0.0;
     }
     int comms() final {return 1;}
@@ -40,8 +39,6 @@ private:
     DOFProfile * _dofProfile;
     KineticProfile * _kineticProfile;
 
-    // Local 1D Profile
-    std::map<unsigned, long double> _localProfile;
     // Global 1D Profile
     std::map<unsigned, long double> _globalProfile;
 
@@ -18,17 +18,17 @@ class DensityProfile;
 class Velocity3dProfile final : public ProfileBase {
 public:
 	Velocity3dProfile(DensityProfile * densProf) :
-			_densityProfile(densProf), _local3dProfile(), _global3dProfile() {
+			_densityProfile(densProf), _global3dProfile() {
 	}
     ~Velocity3dProfile() final = default;
-    void record(Molecule &mol, unsigned long uID) final  {
+    void record(Molecule &mol, double *localValues) final  {
         for(unsigned short d = 0; d < 3; d++){
-            _local3dProfile[uID][d] += mol.v(d);
+            localValues[d] += mol.v(d);
         }
     }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
+    void collectAppend(DomainDecompBase *domainDecomp, const double *localValues) final {
         for(unsigned short d = 0; d < 3; d++){
-            domainDecomp->collCommAppendDouble(_local3dProfile[uID][d]);
+            domainDecomp->collCommAppendDouble(localValues[d]);
         }
     }
     void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
@@ -39,7 +39,6 @@ public:
     void output(string prefix, long unsigned accumulatedDatasets) final;
     void reset(unsigned long uID) final  {
         for(unsigned d = 0; d < 3; d++){
-            _local3dProfile[uID][d] = 0.0;
             _global3dProfile[uID][d] = 0.0;
         }
     }
@@ -49,8 +48,6 @@ public:
 private:
     DensityProfile * _densityProfile;
 
-    // Local 3D Profile
-    std::map<unsigned, std::array<double,3>> _local3dProfile;
     // Global 3D Profile
     std::map<unsigned, std::array<double,3>> _global3dProfile;
 
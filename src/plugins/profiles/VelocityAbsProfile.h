@@ -16,10 +16,10 @@ class DensityProfile;
 class VelocityAbsProfile final : public ProfileBase {
 public:
 	VelocityAbsProfile(DensityProfile * dens) :
-			_densityProfile(dens), _localProfile(), _globalProfile() {
+			_densityProfile(dens), _globalProfile() {
 	}
     ~VelocityAbsProfile() final = default;
-    void record(Molecule& mol, unsigned long uID) final  {
+    void record(Molecule& mol, double* localValues) final  {
         double absV = 0.0;
         double v;
         for(unsigned short d = 0; d < 3; d++){
@@ -27,17 +27,16 @@ public:
             absV += v*v;
         }
         absV = sqrt(absV);
-        _localProfile[uID] += absV;
+        localValues[0] += absV;
     }
-    void collectAppend(DomainDecompBase *domainDecomp, unsigned long uID) final {
-        domainDecomp->collCommAppendDouble(_localProfile[uID]);
+    void collectAppend(DomainDecompBase *domainDecomp, const double *localValues) final {
+        domainDecomp->collCommAppendDouble(localValues[0]);
     }
     void collectRetrieve(DomainDecompBase *domainDecomp, unsigned long uID) final {
         _globalProfile[uID] = domainDecomp->collCommGetDouble();
     }
     void output(string prefix, long unsigned accumulatedDatasets) final;
     void reset(unsigned long uID) final  {
-        _localProfile[uID] = 0.0;
         _globalProfile[uID] = 0.0;
     }
     // set correct number of communications needed for this profile
@@ -46,8 +45,6 @@ public:
 private:
     DensityProfile * _densityProfile;
 
-    // Local 1D Profile
-    std::map<unsigned, double> _localProfile;
     // Global 1D Profile
     std::map<unsigned, double> _globalProfile;
 
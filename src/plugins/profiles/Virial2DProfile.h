@@ -17,21 +17,21 @@ class KineticProfile;
 class Virial2DProfile : public ProfileBase {
 public:
 	Virial2DProfile(DensityProfile* densProf, DOFProfile * dofProf, KineticProfile * kinProf) :
-			_densityProfile(densProf), _dofProfile(dofProf), _kineticProfile(kinProf), _local3dProfile(), _global3dProfile() {
+			_densityProfile(densProf), _dofProfile(dofProf), _kineticProfile(kinProf), _global3dProfile() {
 			}
 
 	~Virial2DProfile() final = default;
 	
 	
-	void record(Molecule& mol, unsigned long uID) final {
+	void record(Molecule& mol, double* localValues) final {
 		for (unsigned short d = 0; d < 3; d++) {
-			_local3dProfile[uID][d] += mol.Vi(d);
+			localValues[d] += mol.Vi(d);
 		}
 	}
 
-	void collectAppend(DomainDecompBase* domainDecomp, unsigned long uID) final {
+	void collectAppend(DomainDecompBase* domainDecomp, const double* localValues) final {
 		for (unsigned short d = 0; d < 3; d++) {
-			domainDecomp->collCommAppendDouble(_local3dProfile[uID][d]);
+			domainDecomp->collCommAppendDouble(localValues[d]);
 		}
 	}
 
@@ -46,7 +46,6 @@ public:
 
 	void reset(unsigned long uID) final {
 		for (unsigned d = 0; d < 3; d++) {
-			_local3dProfile[uID][d] = 0.0;
 			_global3dProfile[uID][d] = 0.0;
 		}
 	}
@@ -58,8 +57,6 @@ private:
 	DOFProfile* _dofProfile;
 	KineticProfile* _kineticProfile;
 
-	// Local 3D Profile
-	std::map<unsigned, std::array<double, 3>> _local3dProfile;
 	// Global 3D Profile
 	std::map<unsigned, std::array<double, 3>> _global3dProfile;
 
@@ -20,19 +20,19 @@
 class VirialProfile : public ProfileBase {
 public:
 	VirialProfile(DensityProfile* densProf) :
-			_densityProfile{densProf}, _local3dProfile(), _global3dProfile() {};
+			_densityProfile{densProf}, _global3dProfile() {};
 
 	~VirialProfile() = default;
 
-	void record(Molecule& mol, unsigned long uID) final {
+	void record(Molecule& mol, double* localValues) final {
 		for (unsigned short d = 0; d < 3; d++) {
-			_local3dProfile[uID][d] += mol.Vi(d);
+			localValues[d] += mol.Vi(d);
 		}
 	}
 
-	void collectAppend(DomainDecompBase* domainDecomp, unsigned long uID) final {
+	void collectAppend(DomainDecompBase* domainDecomp, const double* localValues) final {
 		for (unsigned short d = 0; d < 3; d++) {
-			domainDecomp->collCommAppendDouble(_local3dProfile[uID][d]);
+			domainDecomp->collCommAppendDouble(localValues[d]);
 		}
 	}
 
@@ -51,7 +51,6 @@ public:
 
 	void reset(unsigned long uID) final {
 		for (unsigned d = 0; d < 3; d++) {
-			_local3dProfile[uID][d] = 0.0;
 			_global3dProfile[uID][d] = 0.0;
 		}
 	}
@@ -61,8 +60,6 @@ public:
 private:
 	DensityProfile* _densityProfile;
 
-	// Local 3D Profile
-	std::map<unsigned, std::array<double, 3>> _local3dProfile;
 	// Global 3D Profile
 	std::map<unsigned, std::array<double, 3>> _global3dProfile;
 
@@ -0,0 +1,82 @@
+#include "SpatialProfileTest.h"
+
+#include <cmath>
+#include <vector>
+
+#include "WrapOpenMP.h"
+#include "plugins/profiles/DensityProfile.h"
+#include "plugins/profiles/Velocity3dProfile.h"
+#include "plugins/profiles/VirialProfile.h"
+
+TEST_SUITE_REGISTRATION(SpatialProfileTest);
+
+SpatialProfileTest::SpatialProfileTest() {}
+
+SpatialProfileTest::~SpatialProfileTest() {}
+
+void SpatialProfileTest::testThreadLocalBins() {
+	std::unique_ptr<ParticleContainer> container{
+		initializeFromFile(ParticleContainerFactory::LinkedCell, "1clj-regular-12x12x12.inp", 1.0)};
+	unsigned long numMolecules = 0;
+	for (auto m = container->iterator(ParticleIterator::ONLY_INNER_AND_BOUNDARY); m.isValid(); ++m) {
+		double virial[3] = {0.1 * (m->getID() % 5), 0.2, -0.3 * (m->getID() % 3)};
+		m->setVi(virial);
+		for (unsigned short d = 0; d < 3; ++d) {
+			m->setv(d, 0.01 * ((m->getID() + d) % 11) - 0.05);
+		}
+		++numMolecules;
+	}
+
+	const int maxThreads = mardyn_get_max_threads();
+	const int numThreads[2] = {1, maxThreads};
+	std::vector<double> mergedBins[2];
+	int numComms = 0;
+	for (int run = 0; run < 2; ++run) {
+#if defined(_OPENMP)
+		omp_set_num_threads(numThreads[run]);
+#endif
+		SpatialProfile plugin;
+		plugin._mode = "cartesian";
+		plugin.samplInfo.cylinder = false;
+		plugin.samplInfo.universalProfileUnit[0] = 1;
+		plugin.samplInfo.universalProfileUnit[1] = 4;
+		plugin.samplInfo.universalProfileUnit[2] = 3;
+		plugin._allComponents = true;
+		plugin._writeFrequency = 1000;
+		plugin._initStatistics = 0;
+		plugin._profileRecordingTimesteps = 1;
+		plugin._densProfile = new DensityProfile();
+		plugin.addProfile(plugin._densProfile);
+		plugin._vel3dProfile = new Velocity3dProfile(plugin._densProfile);
+		plugin.addProfile(plugin._vel3dProfile);
+		plugin._virialProfile = new VirialProfile(plugin._densProfile);
+		plugin.addProfile(plugin._virialProfile);
+		plugin.init(container.get(), _domainDecomposition, _domain);
+		ASSERT_EQUAL(numThreads[run], static_cast<int>(plugin._threadLocalBins.size()));
+
+		plugin.endStep(container.get(), _domainDecomposition, _domain, 1);
+		plugin.endStep(container.get(), _domainDecomposition, _domain, 2);
+		plugin.mergeThreadLocalBins();
+		mergedBins[run] = plugin._threadLocalBins[0];
+		numComms = plugin._comms;
+
+		for (auto profile : plugin._profiles) {
+			delete profile;
+		}
+	}
+#if defined(_OPENMP)
+	omp_set_num_threads(maxThreads);
+#endif
+
+	ASSERT_EQUAL(mergedBins[0].size(), mergedBins[1].size());
+	for (size_t i = 0; i < mergedBins[0].size(); ++i) {
+		ASSERT_DOUBLES_EQUAL(mergedBins[0][i], mergedBins[1][i], 1e-10 * std::fabs(mergedBins[0][i]) + 1e-12);
+	}
+
+	// the density profile comes first, every molecule was recorded in both steps
+	double numRecorded = 0.;
+	for (size_t i = 0; i < mergedBins[0].size(); i += numComms) {
+		numRecorded += mergedBins[0][i];
+	}
+	ASSERT_DOUBLES_EQUAL(2. * numMolecules, numRecorded, 1e-12);
+}
@@ -0,0 +1,26 @@
+#ifndef SPATIALPROFILETEST_H
+#define SPATIALPROFILETEST_H
+
+#include "utils/TestWithSimulationSetup.h"
+#include "plugins/SpatialProfile.h"
+
+class SpatialProfileTest : public utils::TestWithSimulationSetup {
+
+	TEST_SUITE(SpatialProfileTest);
+	TEST_METHOD(testThreadLocalBins);
+	TEST_SUITE_END;
+
+public:
+
+	SpatialProfileTest();
+
+	virtual ~SpatialProfileTest();
+
+	/**
+	 * Records the same molecules with one and with all threads, the merged bins have to match.
+	 */
+	void testThreadLocalBins();
+
+};
+
+#endif //SPATIALPROFILETEST_H
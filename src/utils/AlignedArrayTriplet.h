@@ -112,6 +112,15 @@ public:
 		}
 	}
 
+	/**
+	 * \brief Set all entries of the three arrays (including the padding) to zero.
+	 */
+	void zeroAll() {
+		if (_numEntriesPerArray > 0) {
+			std::memset(xBegin(), 0, 3 * _numEntriesPerArray * sizeof(T));
+		}
+	}
+
 	/**
 	 * \brief Reallocate the array. All content may be lost.
 	 */
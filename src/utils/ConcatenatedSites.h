@@ -164,6 +164,11 @@ public:
 		setPaddingToZero(_data);
 	}
 
+	/**
+	 * \brief	Set the values of all sites to zero
+	 */
+	void zero() { _data.zeroAll(); }
+
 	/**
 	 * \brief	Get the size of currently occupied memory
 	 * \return	Number of allocated bytes